@@ -24,7 +24,10 @@ public:
   // if resizable, the threadpool will automatically grow if all threads are busy when pushing a new task
   // if waitPendingTasks when destroying the threadpool it will block the caller until all task have been executed. If
   // not, it will clear the pending tasks and wait only for the running tasks.
-  explicit ThreadPool(size_t numThreads, bool resizable = false, bool waitPendingTasks = false);
+  // if maxPendingTasks is not 0, pushTask will block the caller while there are maxPendingTasks tasks waiting to be
+  // executed (back-pressure). A non resizable threadpool with one thread executes the tasks in the order they were pushed
+  explicit ThreadPool(size_t numThreads, bool resizable = false, bool waitPendingTasks = false,
+                      size_t maxPendingTasks = 0);
   void pushTask(Task task);
   ~ThreadPool();
 
@@ -38,7 +41,9 @@ private:
   std::list<std::thread> threads_;
   mutable std::mutex mutex_;
   std::condition_variable condVar_;
+  std::condition_variable pushCondVar_;
   std::queue<Task> tasks_;
+  size_t maxPendingTasks_;
   bool running_;
   bool resizable_;
   bool waitPendingTasks_;
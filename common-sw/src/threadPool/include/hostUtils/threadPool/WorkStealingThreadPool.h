@@ -0,0 +1,78 @@
+/*-------------------------------------------------------------------------
+ * Copyright (c) 2025 Ainekko, Co.
+ * SPDX-License-Identifier: Apache-2.0
+ *-------------------------------------------------------------------------*/
+
+#pragma once
+#include <hostUtils/threadPool/ThreadPoolExport.h>
+#include "function2.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace threadPool {
+
+// Same API as ThreadPool, intended for many small tasks pushed concurrently.
+// Each worker owns a lock-free deque: tasks pushed from a worker thread (i.e. from inside a running task) go to its own
+// deque without locking, tasks pushed from any other thread are spread round robin among per worker inboxes, each one
+// with its own lock. Idle workers take tasks from their deque, then from their inbox, and then steal from the others.
+// There is no ordering guarantee between tasks.
+class THREAD_POOL_API WorkStealingThreadPool {
+public:
+  using Task = fu2::unique_function<void()>;
+  // if waitPendingTasks when destroying the threadpool it will block the caller until all task have been executed. If
+  // not, it will clear the pending tasks and wait only for the running tasks.
+  // if pinThreads, the workers are pinned one per CPU following the order of the CPUs the process is allowed to run on,
+  // so restricting the process to the CPUs of a NUMA node (numactl, taskset) keeps all the workers on that node.
+  explicit WorkStealingThreadPool(size_t numThreads, bool waitPendingTasks = false, bool pinThreads = false);
+  void pushTask(Task task);
+  ~WorkStealingThreadPool();
+
+  // this will block the caller until the threadpool has no more tasks
+  void blockUntilDrained();
+
+private:
+  // Chase-Lev deque of fixed capacity. Only the owner pushes and pops (LIFO) at the bottom, other workers steal (FIFO)
+  // from the top.
+  class Deque {
+  public:
+    static constexpr int64_t kCapacity = 1024;
+    bool push(Task* task);
+    Task* pop();
+    Task* steal();
+
+  private:
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::array<std::atomic<Task*>, kCapacity> buffer_{};
+  };
+  struct Worker {
+    Deque deque_;
+    std::mutex inboxMutex_;
+    std::deque<Task*> inbox_;
+    std::thread thread_;
+  };
+
+  Task* findTask(size_t workerIdx);
+  void workerFunc(size_t workerIdx);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> nextInbox_{0};
+  // number of tasks pushed but not yet taken by any worker
+  std::atomic<size_t> pendingTasks_{0};
+  std::atomic<size_t> sleepingWorkers_{0};
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCondVar_;
+  std::atomic<bool> running_{true};
+  bool waitPendingTasks_;
+};
+
+} // namespace threadPool
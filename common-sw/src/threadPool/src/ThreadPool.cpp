@@ -17,8 +17,9 @@
 #define TP_LOG_IF(severity, condition) ET_LOG_IF(THREADPOOL, severity, condition)
 
 using namespace threadPool;
-ThreadPool::ThreadPool(size_t numThreads, bool resizable, bool waitPendingTasks)
-  : running_(true)
+ThreadPool::ThreadPool(size_t numThreads, bool resizable, bool waitPendingTasks, size_t maxPendingTasks)
+  : maxPendingTasks_(maxPendingTasks)
+  , running_(true)
   , resizable_(resizable)
   , waitPendingTasks_(waitPendingTasks) {
   addThreads(numThreads);
@@ -31,6 +32,10 @@ void ThreadPool::pushTask(Task task) {
   } else {
     TP_VLOG(MID) << "Pushing a new task into threadpool " << std::hex << this;
     std::unique_lock lock(mutex_);
+    if (maxPendingTasks_ > 0 && tasks_.size() >= maxPendingTasks_) {
+      TP_VLOG(MID) << "Threadpool " << std::hex << this << " has too many pending tasks, waiting for a free slot.";
+      pushCondVar_.wait(lock, [this] { return !running_ || tasks_.size() < maxPendingTasks_; });
+    }
     if (resizable_ && !tasks_.empty()) {
       TP_VLOG(MID) << "All threads busy, adding a new thread to the resizable thread pool. Prev num threads: "
                    << threads_.size();
@@ -48,6 +53,7 @@ void ThreadPool::blockUntilDrained() {
     TP_VLOG(MID) << "Waiting until tasks are drained: " << tasks_.size();
     lock.unlock();
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    lock.lock();
   }
   TP_VLOG(MID) << "All tasks are drained.";
 }
@@ -64,6 +70,7 @@ ThreadPool::~ThreadPool() {
   running_ = false;
   lock.unlock();
   condVar_.notify_all();
+  pushCondVar_.notify_all();
   TP_VLOG(LOW) << "Waiting for all threads in threadpool " << std::hex << this;
   for (auto& t : threads_) {
     t.join();
@@ -89,6 +96,9 @@ void ThreadPool::workerFunc() {
       auto task = std::move(tasks_.front());
       tasks_.pop();
       lock.unlock();
+      if (maxPendingTasks_ > 0) {
+        pushCondVar_.notify_one();
+      }
       task();
     }
   }
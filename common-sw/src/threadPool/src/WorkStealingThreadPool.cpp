@@ -0,0 +1,222 @@
+/*-------------------------------------------------------------------------
+ * Copyright (c) 2025 Ainekko, Co.
+ * SPDX-License-Identifier: Apache-2.0
+ *-------------------------------------------------------------------------*/
+#include "hostUtils/threadPool/WorkStealingThreadPool.h"
+#include <chrono>
+#include <cstring>
+#include <g3log/loglevels.hpp>
+#include <hostUtils/logging/Logger.h>
+#include <hostUtils/logging/Logging.h>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+
+#define TP_LOG(severity) ET_LOG(THREADPOOL, severity)
+#define TP_DLOG(severity) ET_DLOG(THREADPOOL, severity)
+#define TP_VLOG(severity) ET_VLOG(THREADPOOL, severity)
+#define TP_LOG_IF(severity, condition) ET_LOG_IF(THREADPOOL, severity, condition)
+
+using namespace threadPool;
+
+namespace {
+// the pool and worker index of the current thread, if it is a worker
+thread_local const WorkStealingThreadPool* tCurrentPool = nullptr;
+thread_local size_t tCurrentWorker = 0;
+
+std::vector<int> getAllowedCpus() {
+  std::vector<int> cpus;
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) {
+    for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpuSet)) {
+        cpus.emplace_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+} // namespace
+
+bool WorkStealingThreadPool::Deque::push(Task* task) {
+  static_assert((kCapacity & (kCapacity - 1)) == 0, "Deque capacity must be a power of two");
+  auto b = bottom_.load(std::memory_order_relaxed);
+  auto t = top_.load(std::memory_order_acquire);
+  if (b - t >= kCapacity) {
+    return false;
+  }
+  buffer_[static_cast<size_t>(b & (kCapacity - 1))].store(task, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+  return true;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::Deque::pop() {
+  auto b = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto t = top_.load(std::memory_order_relaxed);
+  if (t > b) {
+    // empty
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  auto task = buffer_[static_cast<size_t>(b & (kCapacity - 1))].load(std::memory_order_relaxed);
+  if (t == b) {
+    // last task, race against the thieves for it
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::Deque::steal() {
+  auto t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto b = bottom_.load(std::memory_order_acquire);
+  if (t >= b) {
+    return nullptr;
+  }
+  auto task = buffer_[static_cast<size_t>(t & (kCapacity - 1))].load(std::memory_order_relaxed);
+  if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return task;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t numThreads, bool waitPendingTasks, bool pinThreads)
+  : waitPendingTasks_(waitPendingTasks) {
+  for (auto i = 0U; i < numThreads; ++i) {
+    workers_.emplace_back(std::make_unique<Worker>());
+  }
+  auto cpus = pinThreads ? getAllowedCpus() : std::vector<int>{};
+  for (auto i = 0U; i < numThreads; ++i) {
+    auto& thread = workers_[i]->thread_;
+    thread = std::thread(&WorkStealingThreadPool::workerFunc, this, i);
+    if (!cpus.empty()) {
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      CPU_SET(cpus[i % cpus.size()], &cpuSet);
+      if (auto res = pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet); res != 0) {
+        TP_LOG(WARNING) << "Can't pin threadpool worker " << i << " to CPU " << cpus[i % cpus.size()] << ": "
+                        << strerror(res);
+      }
+    }
+  }
+}
+
+void WorkStealingThreadPool::pushTask(Task task) {
+  if (workers_.empty()) {
+    TP_VLOG(MID) << "Running thread pool with no threads (debugging), so execute the task directly";
+    task();
+    return;
+  }
+  // counted before being queued, so pendingTasks_ never underflows when a worker takes the task right away
+  pendingTasks_.fetch_add(1);
+  auto t = new Task(std::move(task));
+  if (tCurrentPool != this || !workers_[tCurrentWorker]->deque_.push(t)) {
+    auto& worker = *workers_[nextInbox_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+    std::lock_guard lock(worker.inboxMutex_);
+    worker.inbox_.emplace_back(t);
+  }
+  if (sleepingWorkers_.load() > 0) {
+    // taking the lock ensures the worker is either waiting or will see the new pending task
+    { std::lock_guard lock(sleepMutex_); }
+    sleepCondVar_.notify_one();
+  }
+}
+
+void WorkStealingThreadPool::blockUntilDrained() {
+  while (pendingTasks_ > 0) {
+    TP_VLOG(MID) << "Waiting until tasks are drained: " << pendingTasks_;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  TP_VLOG(MID) << "All tasks are drained.";
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  TP_LOG(INFO) << "Destroying work stealing threadpool " << std::hex << this;
+  if (waitPendingTasks_) {
+    blockUntilDrained();
+  }
+  running_ = false;
+  { std::lock_guard lock(sleepMutex_); }
+  sleepCondVar_.notify_all();
+  TP_VLOG(LOW) << "Waiting for all threads in threadpool " << std::hex << this;
+  for (auto& w : workers_) {
+    w->thread_.join();
+  }
+  // clear the tasks which weren't executed
+  for (auto& w : workers_) {
+    while (auto task = w->deque_.pop()) {
+      delete task;
+    }
+    for (auto task : w->inbox_) {
+      delete task;
+    }
+  }
+  workers_.clear();
+  TP_VLOG(LOW) << "Threadpool " << std::hex << this << " destroyed.";
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::findTask(size_t workerIdx) {
+  auto& self = *workers_[workerIdx];
+  if (auto task = self.deque_.pop(); task != nullptr) {
+    return task;
+  }
+  // move the inbox to the own deque, so other workers can steal from it without locking
+  {
+    std::lock_guard lock(self.inboxMutex_);
+    if (!self.inbox_.empty()) {
+      auto task = self.inbox_.front();
+      self.inbox_.pop_front();
+      while (!self.inbox_.empty() && self.deque_.push(self.inbox_.front())) {
+        self.inbox_.pop_front();
+      }
+      return task;
+    }
+  }
+  auto numWorkers = workers_.size();
+  for (auto i = 1U; i < numWorkers; ++i) {
+    if (auto task = workers_[(workerIdx + i) % numWorkers]->deque_.steal(); task != nullptr) {
+      return task;
+    }
+  }
+  // the owner of a busy inbox could be running a long task
+  for (auto i = 1U; i < numWorkers; ++i) {
+    auto& victim = *workers_[(workerIdx + i) % numWorkers];
+    std::unique_lock lock(victim.inboxMutex_, std::try_to_lock);
+    if (lock.owns_lock() && !victim.inbox_.empty()) {
+      auto task = victim.inbox_.front();
+      victim.inbox_.pop_front();
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingThreadPool::workerFunc(size_t workerIdx) {
+  tCurrentPool = this;
+  tCurrentWorker = workerIdx;
+  while (running_) {
+    if (auto task = std::unique_ptr<Task>(findTask(workerIdx)); task) {
+      pendingTasks_.fetch_sub(1);
+      (*task)();
+      continue;
+    }
+    if (pendingTasks_ > 0) {
+      // there are tasks but they are being moved or taken by other workers
+      std::this_thread::yield();
+      continue;
+    }
+    TP_VLOG(MID) << "No tasks to execute, waiting for next task.";
+    std::unique_lock lock(sleepMutex_);
+    ++sleepingWorkers_;
+    sleepCondVar_.wait(lock, [this] { return !running_ || pendingTasks_ > 0; });
+    --sleepingWorkers_;
+  }
+}
@@ -0,0 +1,91 @@
+//******************************************************************************
+// Copyright (c) 2025 Ainekko, Co.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------------
+
+#include "hostUtils/threadPool/ThreadPool.h"
+#include "hostUtils/threadPool/WorkStealingThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <hostUtils/logging/Logger.h>
+#include <hostUtils/logging/Logging.h>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace threadPool;
+
+#define BENCH_LOG(severity) ET_LOG(THREADPOOL, severity)
+
+namespace {
+constexpr auto kNumWorkers = 4U;
+constexpr auto kTasksPerProducer = 200000U;
+
+// pushes kTasksPerProducer tiny tasks from each producer thread and returns the throughput in tasks per second, from
+// the first push till the last task has been executed
+template <typename Pool> double runTinyTasks(Pool& pool, size_t numProducers) {
+  std::atomic<size_t> executed = 0;
+  auto total = numProducers * kTasksPerProducer;
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (auto i = 0U; i < numProducers; ++i) {
+    producers.emplace_back([&pool, &executed] {
+      for (auto j = 0U; j < kTasksPerProducer; ++j) {
+        pool.pushTask([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+  }
+  for (auto& p : producers) {
+    p.join();
+  }
+  while (executed < total) {
+    std::this_thread::yield();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(total) / elapsed.count();
+}
+
+void report(const std::string& name, size_t numProducers, double tasksPerSecond) {
+  BENCH_LOG(INFO) << name << " " << kNumWorkers << " workers, " << numProducers
+                  << " producers: " << static_cast<uint64_t>(tasksPerSecond) << " tasks/s";
+}
+} // namespace
+
+TEST(ThreadPoolBenchmark, tinyTasks) {
+  for (auto numProducers : {1U, 4U, 8U}) {
+    ThreadPool tp(kNumWorkers);
+    report("ThreadPool", numProducers, runTinyTasks(tp, numProducers));
+    WorkStealingThreadPool wstp(kNumWorkers);
+    report("WorkStealingThreadPool", numProducers, runTinyTasks(wstp, numProducers));
+  }
+}
+
+TEST(ThreadPoolBenchmark, tinyTasksFromWorkers) {
+  // tasks pushed from inside the pool, e.g. a copy split into chunks by a task
+  ThreadPool tp(kNumWorkers);
+  WorkStealingThreadPool wstp(kNumWorkers);
+  auto run = [](auto& pool) {
+    std::atomic<size_t> executed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = 0U; i < kNumWorkers; ++i) {
+      pool.pushTask([&pool, &executed] {
+        for (auto j = 0U; j < kTasksPerProducer; ++j) {
+          pool.pushTask([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+        }
+      });
+    }
+    while (executed < kNumWorkers * kTasksPerProducer) {
+      std::this_thread::yield();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(kNumWorkers * kTasksPerProducer) / elapsed.count();
+  };
+  report("ThreadPool (pushed from workers)", kNumWorkers, run(tp));
+  report("WorkStealingThreadPool (pushed from workers)", kNumWorkers, run(wstp));
+}
+
+int main(int argc, char** argv) {
+  logging::LoggerDefault logger_;
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
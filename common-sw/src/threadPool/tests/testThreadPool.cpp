@@ -4,11 +4,13 @@
 //------------------------------------------------------------------------------
 
 #include "hostUtils/threadPool/ThreadPool.h"
+#include "hostUtils/threadPool/WorkStealingThreadPool.h"
 #include <atomic>
 #include <chrono>
 #include <gtest/gtest.h>
 #include <hostUtils/logging/Logger.h>
 #include <thread>
+#include <vector>
 using namespace threadPool;
 TEST(ThreadPool, simple) {
   bool taskExecuted = false;
@@ -30,6 +32,112 @@ TEST(ThreadPool, 1000tasks) {
   ASSERT_EQ(acum, (1000 * 1001) / 2);
 }
 
+TEST(ThreadPool, boundedOrdered) {
+  constexpr auto kMaxPendingTasks = 4U;
+  std::atomic<bool> release = false;
+  std::vector<int> executed;
+  {
+    ThreadPool tp(1, false, true, kMaxPendingTasks);
+    tp.pushTask([&release] {
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+    // wait till the blocking task is being executed, so it doesn't count as pending
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::atomic<int> pushed = 0;
+    std::thread producer([&tp, &executed, &pushed] {
+      for (int i = 0; i < 100; ++i) {
+        tp.pushTask([&executed, i] { executed.emplace_back(i); });
+        ++pushed;
+      }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // the producer must be blocked once the pending queue is full
+    ASSERT_EQ(pushed, kMaxPendingTasks);
+    release = true;
+    producer.join();
+  }
+  ASSERT_EQ(executed.size(), 100U);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(executed[static_cast<size_t>(i)], i);
+  }
+}
+
+TEST(ThreadPool, drainedOnDestruction) {
+  std::atomic<bool> release = false;
+  std::atomic<int> executed = 0;
+  std::thread releaser;
+  {
+    ThreadPool tp(1, false, true);
+    tp.pushTask([&release] {
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+    for (int i = 0; i < 100; ++i) {
+      tp.pushTask([&executed] { ++executed; });
+    }
+    // release the blocking task once the destructor is already waiting for the pending ones
+    releaser = std::thread([&release] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      release = true;
+    });
+  }
+  releaser.join();
+  ASSERT_EQ(executed, 100);
+}
+
+TEST(WorkStealingThreadPool, 1000tasks) {
+  std::atomic<int> acum = 0;
+  {
+    WorkStealingThreadPool tp(20, true);
+    for (int i = 1; i <= 1000; ++i) {
+      tp.pushTask([&acum, i] { acum += i; });
+    }
+  }
+  ASSERT_EQ(acum, (1000 * 1001) / 2);
+}
+
+TEST(WorkStealingThreadPool, nestedTasks) {
+  // each task pushes more tasks from the worker, overflowing its deque, so the other workers have to steal them
+  constexpr auto kNumTasks = 10 * 1024;
+  std::atomic<int> executed = 0;
+  WorkStealingThreadPool tp(4, true);
+  tp.pushTask([&tp, &executed] {
+    for (int i = 0; i < kNumTasks; ++i) {
+      tp.pushTask([&executed] { ++executed; });
+    }
+    ++executed;
+  });
+  tp.blockUntilDrained();
+  for (int i = 0; i < 1000 && executed < kNumTasks + 1; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(executed, kNumTasks + 1);
+}
+
+TEST(WorkStealingThreadPool, manyProducersPinned) {
+  constexpr auto kNumProducers = 8;
+  constexpr auto kTasksPerProducer = 10000;
+  std::atomic<int> executed = 0;
+  {
+    WorkStealingThreadPool tp(4, true, true);
+    std::vector<std::thread> producers;
+    for (int i = 0; i < kNumProducers; ++i) {
+      producers.emplace_back([&tp, &executed] {
+        for (int j = 0; j < kTasksPerProducer; ++j) {
+          tp.pushTask([&executed] { ++executed; });
+        }
+      });
+    }
+    for (auto& p : producers) {
+      p.join();
+    }
+  }
+  ASSERT_EQ(executed, kNumProducers * kTasksPerProducer);
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   testing::InitGoogleTest(&argc, argv);
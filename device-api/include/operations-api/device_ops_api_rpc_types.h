@@ -308,6 +308,89 @@ struct device_ops_p2pdma_writelist_rsp_t {
   uint32_t  pad; /**< Padding for alignment */
 } __attribute__((packed, aligned(8)));
 
+/*! \struct device_ops_memset_cmd_t
+    \brief Command to fill a device memory region with a pattern. The fill is done by the device,
+           no data is transferred over PCIe. The pattern is repeated from dst_device_phy_addr on,
+           so byte i of the region takes byte (i % pattern_size) of the pattern.
+*/
+struct device_ops_memset_cmd_t {
+  struct cmd_header_t command_info;
+  uint64_t  dst_device_phy_addr; /**< Device address of the region to fill */
+  uint64_t  size; /**< Size of the region in bytes, no alignment required */
+  uint64_t  pattern; /**< Fill pattern, its first pattern_size bytes (little endian) are used */
+  uint8_t  pattern_size; /**< Size of the pattern in bytes: 1, 2, 4 or 8 */
+  uint8_t  pad[7]; /**< Padding for alignment */
+} __attribute__((packed, aligned(8)));
+
+/*! \struct device_ops_memset_rsp_t
+    \brief Memset command response
+*/
+struct device_ops_memset_rsp_t {
+  struct rsp_header_t response_info; /**< Response header */
+  uint64_t  device_cmd_start_ts; /**< Timestamp (in cycles) at which the command was dispatched */
+  uint64_t  device_cmd_execute_dur; /**< Time transpired between command dispatch and command completion */
+  uint64_t  device_cmd_wait_dur; /**< Time transpired between command arrival and dispatch */
+  dev_ops_api_dma_response_e  status; /**< Status of the memset operation */
+  uint32_t  pad; /**< Padding for alignment */
+} __attribute__((packed, aligned(8)));
+
+/*! \struct device_ops_memcpy_d2d_cmd_t
+    \brief Command to copy a region of the device memory into another one of the same device. The copy
+           is done by the device, no data is transferred over PCIe. The regions must not overlap.
+*/
+struct device_ops_memcpy_d2d_cmd_t {
+  struct cmd_header_t command_info;
+  uint64_t  src_device_phy_addr; /**< Device address of the region to copy from */
+  uint64_t  dst_device_phy_addr; /**< Device address of the region to copy to */
+  uint64_t  size; /**< Size of the copy in bytes, no alignment required */
+} __attribute__((packed, aligned(8)));
+
+/*! \struct device_ops_memcpy_d2d_rsp_t
+    \brief Device to device memcpy command response
+*/
+struct device_ops_memcpy_d2d_rsp_t {
+  struct rsp_header_t response_info; /**< Response header */
+  uint64_t  device_cmd_start_ts; /**< Timestamp (in cycles) at which the command was dispatched */
+  uint64_t  device_cmd_execute_dur; /**< Time transpired between command dispatch and command completion */
+  uint64_t  device_cmd_wait_dur; /**< Time transpired between command arrival and dispatch */
+  dev_ops_api_dma_response_e  status; /**< Status of the copy operation */
+  uint32_t  pad; /**< Padding for alignment */
+} __attribute__((packed, aligned(8)));
+
+/*! \struct device_ops_cq_coalesce_config_cmd_t
+    \brief Configure the completion coalescing of the submission queue the command is sent to. Once
+           enabled, the completions of the following commands of that queue are packed in batched
+           responses, flushed when max_count completions are packed or timeout_us after the first one.
+           A max_count of 0 or 1 disables the coalescing, flushing the pending completions.
+*/
+struct device_ops_cq_coalesce_config_cmd_t {
+  struct cmd_header_t command_info;
+  uint32_t  timeout_us; /**< Time in microseconds after which a non empty batch is flushed */
+  uint16_t  max_count; /**< Number of completions after which the batch is flushed */
+  uint8_t  pad[2]; /**< Padding for alignment */
+} __attribute__((packed, aligned(8)));
+
+/*! \struct device_ops_cq_coalesce_config_rsp_t
+    \brief Completion coalescing configuration response
+*/
+struct device_ops_cq_coalesce_config_rsp_t {
+  struct rsp_header_t response_info; /**< Response header */
+  dev_ops_api_cq_coalesce_config_response_e  status; /**< Configuration status */
+  uint8_t  pad[4]; /**< Padding for alignment */
+} __attribute__((packed, aligned(8)));
+
+/*! \struct device_ops_batched_rsp_t
+    \brief Several command responses packed in a single completion queue entry. The responses
+           follow the header back to back, each one with its own response header; all response
+           sizes are multiple of 8 bytes so every packed response stays 64-bit aligned.
+*/
+struct device_ops_batched_rsp_t {
+  struct rsp_header_t response_info; /**< Response header, tag_id is not used */
+  uint16_t  count; /**< Number of responses packed in the payload */
+  uint8_t  pad[6]; /**< Padding for alignment */
+  uint8_t  payload[]; /**< Packed responses */
+} __attribute__((packed, aligned(8)));
+
 /*! \struct device_ops_trace_rt_config_cmd_t
     \brief Configure the trace configuration
 */
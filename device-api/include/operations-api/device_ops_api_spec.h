@@ -41,6 +41,46 @@
 */
 #define DEVICE_OPS_DMA_LIST_NODES_MAX             4
 
+/*! \def DEVICE_OPS_MEMSET_PATTERN_SIZE_MAX
+    \brief Maximum size in bytes of the pattern supported by the memset command
+*/
+#define DEVICE_OPS_MEMSET_PATTERN_SIZE_MAX        8
+
+/*! \def DEVICE_OPS_CQ_COALESCE_COUNT_MAX
+    \brief Maximum number of completions packed in a single batched response
+*/
+#define DEVICE_OPS_CQ_COALESCE_COUNT_MAX          16
+
+/*! \def DEVICE_OPS_CQ_COALESCE_PAYLOAD_MAX
+    \brief Maximum size in bytes of the responses packed in a single batched response
+*/
+#define DEVICE_OPS_CQ_COALESCE_PAYLOAD_MAX        512
+
+/*! \def DEVICE_OPS_CQ_COALESCE_TIMEOUT_US_MAX
+    \brief Maximum time in microseconds a completion can be held back before its batch is flushed
+*/
+#define DEVICE_OPS_CQ_COALESCE_TIMEOUT_US_MAX     10000
+
+/*! \def DEVICE_OPS_CQ_COALESCE_MIN_API_MAJOR
+    \brief Major version of the first device-ops-api supporting the completion coalescing configuration command
+*/
+#define DEVICE_OPS_CQ_COALESCE_MIN_API_MAJOR      2
+
+/*! \def DEVICE_OPS_CQ_COALESCE_MIN_API_MINOR
+    \brief Minor version of the first device-ops-api supporting the completion coalescing configuration command
+*/
+#define DEVICE_OPS_CQ_COALESCE_MIN_API_MINOR      7
+
+/*! \def DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MAJOR
+    \brief Major version of the first device-ops-api supporting the memset and device to device memcpy commands
+*/
+#define DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MAJOR   2
+
+/*! \def DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MINOR
+    \brief Minor version of the first device-ops-api supporting the memset and device to device memcpy commands
+*/
+#define DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MINOR   7
+
 /* Device Ops API Enumerations */
 
 typedef uint32_t trace_rt_type_e;
@@ -167,6 +207,17 @@ enum DEV_OPS_API_DMA_RESPONSE {
   DEV_OPS_API_DMA_RESPONSE_DRIVER_ABORT_FAILED = 12, /**<  */
 };
 
+typedef uint32_t dev_ops_api_cq_coalesce_config_response_e;
+
+/*! \enum DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE
+    \brief
+*/
+enum DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE {
+  DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_SUCCESS = 0, /**<  */
+  DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_INVALID_COUNT = 1, /**< max_count above DEVICE_OPS_CQ_COALESCE_COUNT_MAX */
+  DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_INVALID_TIMEOUT = 2, /**< timeout_us is 0 or above DEVICE_OPS_CQ_COALESCE_TIMEOUT_US_MAX */
+};
+
 typedef uint32_t dev_ops_api_echo_response_e;
 
 /*! \enum DEV_OPS_API_ECHO_RESPONSE
@@ -293,6 +344,13 @@ enum device_ops_api_msg_e {
     DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_READLIST_RSP, /**< < P2P DMA readlist command response */
     DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_WRITELIST_CMD, /**< < Single list command to perform multiple P2P DMA write transfers */
     DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_WRITELIST_RSP, /**< < P2P DMA writelist command response */
+    DEV_OPS_API_MID_DEVICE_OPS_MEMSET_CMD, /**< < Command to fill a device memory region with a pattern */
+    DEV_OPS_API_MID_DEVICE_OPS_MEMSET_RSP, /**< < Memset command response */
+    DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_CMD, /**< < Command to copy between two regions of the device memory */
+    DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_RSP, /**< < Device to device memcpy command response */
+    DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD, /**< < Configure the completion coalescing of the submission queue the command is sent to */
+    DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_RSP, /**< < Completion coalescing configuration response */
+    DEV_OPS_API_MID_DEVICE_OPS_BATCHED_RSP, /**< < Several command responses packed in a single completion queue entry */
     DEV_OPS_API_MID_LAST  = 1023
 };
 
@@ -246,9 +246,11 @@
 #define MM_BASE_ID 2048U
 
 /*! \def MM_MAX_PARALLEL_KERNELS
-    \brief Maximum number of kerenls in parallel supported by MM runtime
+    \brief Maximum number of kerenls in parallel supported by MM runtime. Each kernel
+    gets its own Kernel Worker (KW) and kernels only run in parallel if their shire
+    masks are disjoint, otherwise the launch waits for the shires to be free.
 */
-#define MM_MAX_PARALLEL_KERNELS 1
+#define MM_MAX_PARALLEL_KERNELS 2
 
 /*! \def DISPATCHER_BASE_HART_ID
     \brief Base HART ID for the Dispatcher
@@ -332,6 +334,26 @@
 */
 #define KW_NUM MM_MAX_PARALLEL_KERNELS
 
+/*! \def MEMW_BASE_HART_ID
+    \brief Base HART ID for the device Memory Workers, which help the SQWs
+    with memset and device to device memcpy commands.
+    Note that memory workers use the odd hart of the Kernel Worker Minions.
+    \warning DO NOT MODIFY!
+*/
+#define MEMW_BASE_HART_ID (KW_BASE_HART_ID + 1U)
+
+/*! \def MEMW_THREAD_ID
+    \brief Thread ID for the device Memory Worker
+    Note that memory workers use odd thread of the same Minion.
+    \warning DO NOT MODIFY!
+*/
+#define MEMW_THREAD_ID 1U
+
+/*! \def MEMW_NUM
+    \brief Number of device Memory Workers
+*/
+#define MEMW_NUM KW_NUM
+
 /*! \def DMAW_BASE_HART_ID
     \brief Base HART ID for the DMA Worker
 */
@@ -387,6 +409,17 @@ static_assert(((MM_SQ_COUNT * MM_SQ_SIZE) + (MM_SQ_HP_COUNT * MM_SQ_HP_SIZE) +
 static_assert((SPW_BASE_HART_ID > DISPATCHER_BASE_HART_ID) && (SPW_BASE_HART_ID < SQW_BASE_HART_ID),
     "SP Worker Hart ID overlapping");
 
+/* Ensure that KW Hart IDs don't overlap with DMAW Hart IDs */
+static_assert((KW_BASE_HART_ID + (KW_NUM * HARTS_PER_MINION)) <= DMAW_BASE_HART_ID,
+    "KW Hart IDs overlapping with DMAW Hart IDs");
+
+/* Ensure that MEMW Harts are the odd harts of the KW Minions */
+static_assert(MEMW_NUM <= KW_NUM, "MEMW Hart IDs not within KW Minions");
+
+/* Ensure that parallel kernels are in sync with FW memory layout */
+static_assert(MM_MAX_PARALLEL_KERNELS <= MAX_SIMULTANEOUS_KERNELS,
+    "Number of parallel kernels not synced with memory layout file.");
+
 /* Ensure that MM SQs are in sync with FW memory layout */
 static_assert(MM_SQ_COUNT <= MM_SQ_COUNT_MAX,
     "Number of MM Submission Queues not synced with memory layout file.");
@@ -93,6 +93,36 @@ int32_t Host_Iface_SQ_Pop_Cmd(uint8_t sq_id, void *rx_buff);
 */
 int32_t Host_Iface_CQ_Push_Cmd(uint8_t cq_id, const void *p_cmd, uint32_t cmd_size);
 
+/*! \fn int32_t Host_Iface_CQ_Push_Completion(uint8_t cq_id, uint8_t sq_id, const void *p_rsp,
+    uint32_t rsp_size)
+    \brief Interface to push the completion of a command popped from a submission
+    queue. The response is packed in a batched response when completion coalescing
+    is enabled for the submission queue, else it is pushed directly
+    \param cq_id Completion queue ID
+    \param sq_id Submission queue ID the command was popped from
+    \param p_rsp Pointer to the response
+    \param rsp_size Response size
+    \return Status indicating success or negative error
+*/
+int32_t Host_Iface_CQ_Push_Completion(
+    uint8_t cq_id, uint8_t sq_id, const void *p_rsp, uint32_t rsp_size);
+
+/*! \fn int32_t Host_Iface_CQ_Coalesce_Config(uint8_t sq_id, uint16_t max_count,
+    uint64_t timeout_cycles)
+    \brief Interface to configure the completion coalescing of a submission queue
+    \param sq_id Submission queue ID
+    \param max_count Completions per batched response, 0 or 1 to disable coalescing
+    \param timeout_cycles Cycles a non empty batch is held before being flushed
+    \return Status indicating success or negative error
+*/
+int32_t Host_Iface_CQ_Coalesce_Config(uint8_t sq_id, uint16_t max_count, uint64_t timeout_cycles);
+
+/*! \fn void Host_Iface_CQ_Coalesce_Processing(void)
+    \brief Interface to flush the completion batches whose timeout expired
+    \return none
+*/
+void Host_Iface_CQ_Coalesce_Processing(void);
+
 /*! \fn bool Host_Iface_Interrupt_Status(void)
     \brief Query host interface interrupt status to check if host iface
     processing is needed
@@ -51,6 +51,18 @@
 #define DMAW_MAX_ELEMENT_SIZE \
     (MEM_REGION_DMA_ELEMENT_SIZE * MEM_REGION_DMA_ELEMENT_SIZE_STEP * 1024 * 1024)
 
+/*! \def DMAW_STRIPE_MIN_SIZE
+    \brief A macro that provides the minimum size in bytes of a DMA stripe.
+    A list command is only split across several channels when every channel
+    gets at least this much data, smaller commands stay on a single channel.
+*/
+#define DMAW_STRIPE_MIN_SIZE (256U * 1024U)
+
+/*! \def DMAW_STRIPE_ALIGNMENT
+    \brief A macro that provides the alignment in bytes of the stripe boundaries
+*/
+#define DMAW_STRIPE_ALIGNMENT 64U
+
 /*! \enum dma_chan_state_e
     \brief Enum that provides the state of a DMA channel
 */
@@ -59,7 +71,8 @@ typedef enum {
     DMA_CHAN_STATE_RESERVED = 1,
     DMA_CHAN_STATE_IN_USE = 2,
     DMA_CHAN_STATE_ERROR = 3,
-    DMA_CHAN_STATE_ABORTING = 4
+    DMA_CHAN_STATE_ABORTING = 4,
+    DMA_CHAN_STATE_STRIPE_DONE = 5
 } dma_chan_state_e;
 
 /*! \enum dma_chan_type_e
@@ -96,7 +109,11 @@ typedef struct dma_channel_status_cb {
     uint64_t transfer_size;    /* Transfer size of data. This is only valid when channel state
                                        is 'in use'. */
     uint16_t rsp_id;           /* Holds the response ID of the command */
-    uint8_t pad[6];            /* Padding for alignment */
+    uint8_t stripe_leader;     /* Channel that holds the stripe bookkeeping of the command */
+    uint8_t stripe_mask;       /* Mask of channels the command is striped on. Valid on leader. */
+    uint32_t stripes_pending;  /* Number of stripes still in flight. Valid on leader. */
+    uint32_t stripe_status;    /* First error reported by a stripe. Valid on leader. */
+    uint8_t pad[4];            /* Padding for alignment */
 } dma_channel_status_cb_t;
 
 /*! \fn void DMAW_Init(void)
@@ -128,27 +145,60 @@ int32_t DMAW_Read_Find_Idle_Chan_And_Reserve(dma_read_chan_id_e *chan_id, uint8_
 */
 int32_t DMAW_Write_Find_Idle_Chan_And_Reserve(dma_write_chan_id_e *chan_id, uint8_t sqw_idx);
 
-/*! \fn int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e chan_id,
-    const struct cmd_header_t *cmd_info, uint16_t xfer_count, uint8_t sqw_idx,
-    execution_cycles_t *cycles, uint8_t sw_timer_idx)
+/*! \fn uint8_t DMAW_Read_Reserve_Stripe_Chans(dma_read_chan_id_e *chan_ids,
+    const struct cmd_header_t *cmd_info, uint8_t xfer_count)
+    \brief Reserves additional idle DMA read channels to stripe a list command on.
+    It never waits for a channel to become idle, and leaves one idle channel for
+    the other commands when channels of the direction are held or waited for.
+    \param chan_ids Array of PCIE_DMA_RD_CHANNEL_COUNT channel IDs, first entry
+    must hold a channel already reserved for the command
+    \param cmd_info Pointer to command buffer
+    \param xfer_count Number of transfer nodes in command
+    \return Number of channels reserved for the command, including the first one
+*/
+uint8_t DMAW_Read_Reserve_Stripe_Chans(
+    dma_read_chan_id_e *chan_ids, const struct cmd_header_t *cmd_info, uint8_t xfer_count);
+
+/*! \fn uint8_t DMAW_Write_Reserve_Stripe_Chans(dma_write_chan_id_e *chan_ids,
+    const struct cmd_header_t *cmd_info, uint8_t xfer_count)
+    \brief Reserves additional idle DMA write channels to stripe a list command on.
+    It never waits for a channel to become idle, and leaves one idle channel for
+    the other commands when channels of the direction are held or waited for.
+    \param chan_ids Array of PCIE_DMA_WRT_CHANNEL_COUNT channel IDs, first entry
+    must hold a channel already reserved for the command
+    \param cmd_info Pointer to command buffer
+    \param xfer_count Number of transfer nodes in command
+    \return Number of channels reserved for the command, including the first one
+*/
+uint8_t DMAW_Write_Reserve_Stripe_Chans(
+    dma_write_chan_id_e *chan_ids, const struct cmd_header_t *cmd_info, uint8_t xfer_count);
+
+/*! \fn int32_t DMAW_Read_Trigger_Transfer(const dma_read_chan_id_e *chan_ids,
+    uint8_t chan_count, const struct cmd_header_t *cmd_info, uint8_t xfer_count,
+    uint8_t sqw_idx, const execution_cycles_t *cycles)
     \brief This function is used to trigger a DMA read transaction by calling the
-    PCIe device driver routine
-    \param chan_id DMA channel ID
+    PCIe device driver routine. The transfer is striped evenly across the given
+    channels and the command completes once every stripe is done.
+    \param chan_ids Reserved DMA channel IDs
+    \param chan_count Number of reserved DMA channels
     \param cmd Pointer to command buffer
     \param xfer_count Number of transfer nodes in command.
     \param sqw_idx SQW ID
     \param cycles Pointer to latency cycles struct
     \return Status success or error
 */
-int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e chan_id, const struct cmd_header_t *cmd_info,
-    uint8_t xfer_count, uint8_t sqw_idx, const execution_cycles_t *cycles);
+int32_t DMAW_Read_Trigger_Transfer(const dma_read_chan_id_e *chan_ids, uint8_t chan_count,
+    const struct cmd_header_t *cmd_info, uint8_t xfer_count, uint8_t sqw_idx,
+    const execution_cycles_t *cycles);
 
-/*! \fn int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e chan_id,
-    const struct cmd_header_t *cmd_info, uint16_t xfer_count, uint8_t sqw_idx,
-    execution_cycles_t *cycles, uint8_t sw_timer_idx, dma_flags_e flags)
+/*! \fn int32_t DMAW_Write_Trigger_Transfer(const dma_write_chan_id_e *chan_ids,
+    uint8_t chan_count, const struct cmd_header_t *cmd_info, uint8_t xfer_count,
+    uint8_t sqw_idx, const execution_cycles_t *cycles, dma_flags_e flags)
     \brief This function is used to trigger a DMA write transaction by calling the
-    PCIe device driver routine
-    \param chan_id DMA channel ID
+    PCIe device driver routine. The transfer is striped evenly across the given
+    channels and the command completes once every stripe is done.
+    \param chan_ids Reserved DMA channel IDs
+    \param chan_count Number of reserved DMA channels
     \param cmd Pointer to command buffer
     \param xfer_count Number of transfer nodes in command.
     \param sqw_idx SQW ID
@@ -156,7 +206,7 @@ int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e chan_id, const struct cmd_
     \param flags DMA flag to set a specific DMA action.
     \return Status success or error
 */
-int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e chan_id,
+int32_t DMAW_Write_Trigger_Transfer(const dma_write_chan_id_e *chan_ids, uint8_t chan_count,
     const struct cmd_header_t *cmd_info, uint8_t xfer_count, uint8_t sqw_idx,
     const execution_cycles_t *cycles, dma_flags_e flags);
 
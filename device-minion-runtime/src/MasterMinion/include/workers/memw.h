@@ -0,0 +1,72 @@
+/***********************************************************************
+*
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*
+************************************************************************/
+
+/***********************************************************************/
+/*! \file memw.h
+    \brief A C header that defines the device Memory Worker's public
+    interfaces.
+*/
+/***********************************************************************/
+#ifndef MEMW_DEFS_H
+#define MEMW_DEFS_H
+
+/* mm specific headers */
+#include "config/mm_config.h"
+
+/*! \def MEMW_MAX_HART_ID
+    \brief A macro that provides the maximum HART ID the MEMW is configured
+    to execute on.
+*/
+#define MEMW_MAX_HART_ID (MEMW_BASE_HART_ID + (MEMW_NUM * HARTS_PER_MINION))
+
+/*! \def MEMW_WORKER_0
+    \brief A macro that provides the minion index of the first Memory
+    worker within the master shire.
+*/
+#define MEMW_WORKER_0 ((MEMW_BASE_HART_ID - MM_BASE_ID) / HARTS_PER_MINION)
+
+/*! \fn void MEMW_Init(void)
+    \brief Initialize device Memory Workers
+    \return none
+*/
+void MEMW_Init(void);
+
+/*! \fn void MEMW_Launch(uint32_t memw_idx)
+    \brief Launch the device Memory Worker thread
+    \param memw_idx Memory Worker index
+    \return none
+*/
+void MEMW_Launch(uint32_t memw_idx);
+
+/*! \fn int32_t MEMW_Memset(uint8_t sqw_idx, uint64_t dst, uint64_t size, uint64_t pattern,
+    uint8_t pattern_size)
+    \brief Fills a device memory region with a pattern, byte i of the region gets
+    byte (i % pattern_size) of the pattern. The region is split between the calling
+    SQW and the Memory Workers. Stops early if the SQW gets aborted.
+    \param sqw_idx Index of the calling SQW
+    \param dst Device address of the region
+    \param size Size of the region in bytes
+    \param pattern Fill pattern
+    \param pattern_size Size of the pattern in bytes, a power of two up to 8
+    \return Status success or error
+*/
+int32_t MEMW_Memset(
+    uint8_t sqw_idx, uint64_t dst, uint64_t size, uint64_t pattern, uint8_t pattern_size);
+
+/*! \fn int32_t MEMW_Memcpy(uint8_t sqw_idx, uint64_t dst, uint64_t src, uint64_t size)
+    \brief Copies a device memory region into another, non overlapping, one. The
+    regions are split between the calling SQW and the Memory Workers. Stops early if
+    the SQW gets aborted.
+    \param sqw_idx Index of the calling SQW
+    \param dst Device address of the destination region
+    \param src Device address of the source region
+    \param size Size of the regions in bytes
+    \return Status success or error
+*/
+int32_t MEMW_Memcpy(uint8_t sqw_idx, uint64_t dst, uint64_t src, uint64_t size);
+
+#endif /* MEMW_DEFS_H */
@@ -28,6 +28,16 @@ enum statw_resource_type {
     STATW_RESOURCE_L2_L3_WRITE,
 };
 
+/*! \struct statw_dma_chan_stats
+    \brief Utilization counters of a single DMA channel. Counters accumulate
+    from the last stats reset.
+*/
+struct statw_dma_chan_stats {
+    uint64_t bytes;       /* Bytes moved by the channel */
+    uint64_t busy_cycles; /* Cycles the channel spent executing transfers */
+    uint64_t transfers;   /* Number of transfers, or stripes of a transfer, executed */
+};
+
 enum statw_pmu_sampling_state {
     STATW_PMU_SAMPLING_START,
     STATW_PMU_SAMPLING_RESET_AND_START,
@@ -144,6 +154,29 @@ void STATW_Launch(uint32_t hart_id);
 */
 void STATW_Add_New_Sample_Atomically(statw_resource_type_e resource_type, uint64_t current_sample);
 
+/*! \fn void STATW_Add_DMA_Chan_Sample(statw_resource_type_e resource_type, uint8_t chan,
+    uint64_t bytes, uint64_t busy_cycles)
+    \brief This function adds a completed transfer to the utilization counters of a DMA channel.
+    \param resource_type STATW_RESOURCE_DMA_READ or STATW_RESOURCE_DMA_WRITE
+    \param chan DMA channel ID
+    \param bytes Number of bytes moved by the transfer
+    \param busy_cycles Number of cycles the transfer kept the channel busy
+    \return None.
+*/
+void STATW_Add_DMA_Chan_Sample(
+    statw_resource_type_e resource_type, uint8_t chan, uint64_t bytes, uint64_t busy_cycles);
+
+/*! \fn int32_t STATW_Get_DMA_Chan_Stats(statw_resource_type_e resource_type, uint8_t chan,
+    struct statw_dma_chan_stats *stats)
+    \brief Get the utilization counters of a DMA channel.
+    \param resource_type STATW_RESOURCE_DMA_READ or STATW_RESOURCE_DMA_WRITE
+    \param chan DMA channel ID
+    \param stats Pointer to stats to populate.
+    \return status success or error.
+*/
+int32_t STATW_Get_DMA_Chan_Stats(
+    statw_resource_type_e resource_type, uint8_t chan, struct statw_dma_chan_stats *stats);
+
 /*! \fn uint32_t STATW_Get_Minion_Freq(void)
     \brief Returns the Minion frequency in MHz.
     \return Frequency value in mega hertz.
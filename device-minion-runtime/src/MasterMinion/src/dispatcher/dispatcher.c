@@ -35,6 +35,7 @@
 #include "workers/sqw_hp.h"
 #include "workers/kw.h"
 #include "workers/dmaw.h"
+#include "workers/memw.h"
 #include "workers/cw.h"
 #include "services/cm_iface.h"
 #include "services/host_iface.h"
@@ -187,6 +188,8 @@ __attribute__((noreturn)) void Dispatcher_Launch(uint32_t hart_id)
     SQW_Init();
     Log_Write(LOG_LEVEL_INFO, "Dispatcher:KW_Init\r\n");
     KW_Init();
+    Log_Write(LOG_LEVEL_INFO, "Dispatcher:MEMW_Init\r\n");
+    MEMW_Init();
     Log_Write(LOG_LEVEL_INFO, "Dispatcher:DMAW_Init\r\n");
     DMAW_Init();
 
@@ -30,6 +30,7 @@
 #include "workers/sqw_hp.h"
 #include "workers/kw.h"
 #include "workers/dmaw.h"
+#include "workers/memw.h"
 #include "workers/statw.h"
 #include "services/log.h"
 
@@ -103,6 +104,13 @@ int main(void)
         local_spinwait_wait(&Launch_Wait, 1, 0);
         KW_Launch((hart_id - KW_BASE_HART_ID) / HARTS_PER_MINION);
     }
+    else if ((hart_id >= MEMW_BASE_HART_ID) && (hart_id < MEMW_MAX_HART_ID) &&
+             !EVEN_HART(hart_id))
+    {
+        /* Spin wait till dispatcher initialization is complete */
+        local_spinwait_wait(&Launch_Wait, 1, 0);
+        MEMW_Launch((hart_id - MEMW_BASE_HART_ID) / HARTS_PER_MINION);
+    }
     else if ((hart_id >= DMAW_BASE_HART_ID) && (hart_id < DMAW_MAX_HART_ID) && EVEN_HART(hart_id))
     {
         /* Spin wait till dispatcher initialization is complete */
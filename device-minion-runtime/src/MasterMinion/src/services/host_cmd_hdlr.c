@@ -16,6 +16,7 @@
 /* mm_et_svcs */
 #include <etsoc/drivers/pmu/pmu.h>
 #include <etsoc/isa/cacheops.h>
+#include <etsoc/isa/etsoc_memory.h>
 #include <system/layout.h>
 
 /* mm specific headers */
@@ -28,8 +29,10 @@
 #include "workers/kw.h"
 #include "workers/cw.h"
 #include "workers/dmaw.h"
+#include "workers/memw.h"
 #include "workers/sqw.h"
 #include "workers/sqw_hp.h"
+#include "workers/statw.h"
 #include "config/mm_config.h"
 
 /* mm_rt_helpers */
@@ -43,6 +46,21 @@
 */
 #define TRACE_NODE_INDEX 0
 
+/*! \struct device_mem_op_t
+    \brief Describes a device memory operation done by the master shire harts (memset, device
+           to device memcpy), so they share the same command handler.
+*/
+typedef struct device_mem_op {
+    const char *name;         /**< Operation name used in the logs */
+    msg_id_t cmd_msg_id;      /**< Command message ID, used for tracing */
+    msg_id_t rsp_msg_id;      /**< Response message ID */
+    mm2sp_error_type_e ops_api_error; /**< Error type reported to SP when the operation fails */
+    int32_t (*verify_args)(const void *command); /**< Validates the command arguments */
+    int32_t (*execute)(const void *command, uint8_t sqw_idx); /**< Performs the operation */
+    void (*log_failure)(const void *command, uint8_t sqw_idx, const char *fail_msg,
+        int32_t status); /**< Logs the command arguments of a failed operation */
+} device_mem_op_t;
+
 /*! \def DMA_TO_DEVICEAPI_STATUS
     \brief Helper macro to convert DMA Error to DEVICE API Errors
 */
@@ -1262,7 +1280,8 @@ static inline int32_t dma_readlist_cmd_handler(
     struct cmd_header_t *cmd_info = (struct cmd_header_t *)command_buffer;
     struct device_ops_dma_readlist_rsp_t rsp;
     dma_flags_e dma_flag;
-    dma_write_chan_id_e chan = DMA_CHAN_ID_WRITE_INVALID;
+    dma_write_chan_id_e chans[PCIE_DMA_WRT_CHANNEL_COUNT] = { DMA_CHAN_ID_WRITE_INVALID };
+    uint8_t chan_count = 0;
     int32_t status = STATUS_SUCCESS;
     uint8_t dma_xfer_count = 0;
     uint8_t loop_cnt;
@@ -1311,14 +1330,24 @@ static inline int32_t dma_readlist_cmd_handler(
         if (status == STATUS_SUCCESS)
         {
             /* Obtain the next available DMA write channel */
-            status = DMAW_Write_Find_Idle_Chan_And_Reserve(&chan, sqw_idx);
+            status = DMAW_Write_Find_Idle_Chan_And_Reserve(&chans[0], sqw_idx);
+            chan_count = 1;
+        }
+
+        /* Stripe large transfers across the DMA write channels that are idle.
+        Trace buffer transfers are kept on a single channel. */
+        if ((status == STATUS_SUCCESS) && (dma_flag == DMA_NORMAL))
+        {
+            chan_count = DMAW_Write_Reserve_Stripe_Chans(chans, cmd_info, dma_xfer_count);
         }
     }
 
     if (status == STATUS_SUCCESS)
     {
-        Log_Write(LOG_LEVEL_DEBUG, "TID[%u]:SQW[%d]:%s_READ:channel_used:%d, dma xfer count=%d\r\n",
-            cmd_info->cmd_hdr.tag_id, sqw_idx, read_cmds[read_type], chan, dma_xfer_count);
+        Log_Write(LOG_LEVEL_DEBUG,
+            "TID[%u]:SQW[%d]:%s_READ:channel_used:%d, channels=%d, dma xfer count=%d\r\n",
+            cmd_info->cmd_hdr.tag_id, sqw_idx, read_cmds[read_type], chans[0], chan_count,
+            dma_xfer_count);
 
         if (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_CMD)
         {
@@ -1382,8 +1411,8 @@ static inline int32_t dma_readlist_cmd_handler(
         cycles.exec_start_cycles = PMC_Get_Current_Cycles();
 
         /* Initiate DMA write transfer */
-        status =
-            DMAW_Write_Trigger_Transfer(chan, cmd_info, dma_xfer_count, sqw_idx, &cycles, dma_flag);
+        status = DMAW_Write_Trigger_Transfer(
+            chans, chan_count, cmd_info, dma_xfer_count, sqw_idx, &cycles, dma_flag);
     }
 
     if (status != STATUS_SUCCESS)
@@ -1571,11 +1600,12 @@ static inline int32_t dma_writelist_cmd_verify_limits(
 *
 ***********************************************************************/
 static inline int32_t dma_writelist_cmd_handler(
-    const void *command_buffer, uint8_t sqw_idx, uint64_t start_cycles)
+    void *command_buffer, uint8_t sqw_idx, uint64_t start_cycles)
 {
     const struct cmd_header_t *cmd_info = (const struct cmd_header_t *)command_buffer;
     struct device_ops_dma_writelist_rsp_t rsp;
-    dma_read_chan_id_e chan = DMA_CHAN_ID_READ_INVALID;
+    dma_read_chan_id_e chans[PCIE_DMA_RD_CHANNEL_COUNT] = { DMA_CHAN_ID_READ_INVALID };
+    uint8_t chan_count = 0;
     uint8_t dma_xfer_count = 0;
     uint8_t loop_cnt;
     int32_t status = STATUS_SUCCESS;
@@ -1609,15 +1639,22 @@ static inline int32_t dma_writelist_cmd_handler(
         if (status == STATUS_SUCCESS)
         {
             /* Obtain the next available DMA read channel */
-            status = DMAW_Read_Find_Idle_Chan_And_Reserve(&chan, sqw_idx);
+            status = DMAW_Read_Find_Idle_Chan_And_Reserve(&chans[0], sqw_idx);
+        }
+
+        if (status == STATUS_SUCCESS)
+        {
+            /* Stripe large transfers across the DMA read channels that are idle */
+            chan_count = DMAW_Read_Reserve_Stripe_Chans(chans, cmd_info, dma_xfer_count);
         }
     }
 
     if (status == STATUS_SUCCESS)
     {
         Log_Write(LOG_LEVEL_DEBUG,
-            "TID[%u]:SQW[%d]:%s_WRITELIST:channel_used:%d, dma xfer count=%d \r\n",
-            cmd_info->cmd_hdr.tag_id, sqw_idx, write_cmds[write_type], chan, dma_xfer_count);
+            "TID[%u]:SQW[%d]:%s_WRITELIST:channel_used:%d, channels=%d, dma xfer count=%d \r\n",
+            cmd_info->cmd_hdr.tag_id, sqw_idx, write_cmds[write_type], chans[0], chan_count,
+            dma_xfer_count);
 
         if (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD)
         {
@@ -1685,7 +1722,8 @@ static inline int32_t dma_writelist_cmd_handler(
         cycles.exec_start_cycles = PMC_Get_Current_Cycles();
 
         /* Initiate DMA read transfer */
-        status = DMAW_Read_Trigger_Transfer(chan, cmd_info, dma_xfer_count, sqw_idx, &cycles);
+        status = DMAW_Read_Trigger_Transfer(
+            chans, chan_count, cmd_info, dma_xfer_count, sqw_idx, &cycles);
     }
 
     if (status != STATUS_SUCCESS)
@@ -1800,6 +1838,461 @@ static inline int32_t dma_writelist_cmd_handler(
     return status;
 }
 
+/************************************************************************
+*
+*   FUNCTION
+*
+*       host_managed_dram_region_is_valid
+*
+*   DESCRIPTION
+*
+*       Checks that a device memory region lies in host managed DRAM.
+*
+*   INPUTS
+*
+*       addr              Start address of the region
+*       size              Size of the region in bytes
+*
+*   OUTPUTS
+*
+*       bool              True if the region is valid, false otherwise.
+*
+***********************************************************************/
+static inline bool host_managed_dram_region_is_valid(uint64_t addr, uint64_t size)
+{
+    uint64_t end_addr = addr + size;
+
+    /* end_addr check covers uint64_t overflow */
+    return (addr >= HOST_MANAGED_DRAM_START) && (end_addr > addr) &&
+           (end_addr <= MM_Config_Get_DRAM_End_Address());
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       device_mem_op_cmd_handler
+*
+*   DESCRIPTION
+*
+*       Process a device memory operation command, and transmit response.
+*       The PCIe DMA engine can only move data between host and device
+*       memory, so the operation is done by the SQW and the memory workers;
+*       no data crosses PCIe.
+*
+*   INPUTS
+*
+*       op               Device memory operation to perform
+*       command_buffer   Buffer containing command to process
+*       sqw_idx          Submission queue index
+*       start_cycle      Cycle count to measure wait latency
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t device_mem_op_cmd_handler(
+    const device_mem_op_t *op, const void *command_buffer, uint8_t sqw_idx, uint64_t start_cycles)
+{
+    const struct cmd_header_t *cmd_info = (const struct cmd_header_t *)command_buffer;
+    /* The memset and memcpy D2D responses share the same layout */
+    struct device_ops_memset_rsp_t rsp = { 0 };
+    uint64_t exec_start_cycles = 0;
+    int32_t status = STATUS_SUCCESS;
+
+    TRACE_LOG_CMD_STATUS(op->cmd_msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_RECEIVED)
+
+    /* Compute Wait Cycles (cycles the command was sitting in SQ prior to launch) */
+    rsp.device_cmd_start_ts = start_cycles;
+    rsp.device_cmd_wait_dur = PMC_GET_LATENCY(start_cycles);
+
+    /* Get the SQW state to check for command abort */
+    if (SQW_Get_State(sqw_idx) == SQW_STATE_ABORTED)
+    {
+        status = HOST_CMD_STATUS_ABORTED;
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        status = op->verify_args(command_buffer);
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        TRACE_LOG_CMD_STATUS(
+            op->cmd_msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_EXECUTING)
+
+        exec_start_cycles = PMC_Get_Current_Cycles();
+        status = op->execute(command_buffer, sqw_idx);
+        rsp.device_cmd_execute_dur = PMC_GET_LATENCY(exec_start_cycles);
+    }
+
+    /* Construct and transmit response */
+    rsp.response_info.rsp_hdr.tag_id = cmd_info->cmd_hdr.tag_id;
+    rsp.response_info.rsp_hdr.msg_id = op->rsp_msg_id;
+    rsp.response_info.rsp_hdr.size =
+        sizeof(struct device_ops_memset_rsp_t) - sizeof(struct cmn_header_t);
+
+    if (status == STATUS_SUCCESS)
+    {
+        rsp.status = DEV_OPS_API_DMA_RESPONSE_COMPLETE;
+    }
+    else
+    {
+        char mem_op_fail_msg[8] = "Failed\0";
+        mem_op_fail_msg[sizeof(mem_op_fail_msg) - 1] = 0;
+
+        /* Populate the error type response */
+        DMA_TO_DEVICEAPI_STATUS(status, rsp.status, mem_op_fail_msg)
+
+        op->log_failure(command_buffer, sqw_idx, mem_op_fail_msg, status);
+    }
+
+    status = Host_Iface_CQ_Push_Completion(0, sqw_idx, &rsp, sizeof(rsp));
+
+    if (status == STATUS_SUCCESS)
+    {
+        /* Check for abort status for trace logging */
+        if (rsp.status == DEV_OPS_API_DMA_RESPONSE_COMPLETE)
+        {
+            TRACE_LOG_CMD_STATUS(
+                op->cmd_msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_SUCCEEDED)
+        }
+        else if (rsp.status == DEV_OPS_API_DMA_RESPONSE_HOST_ABORTED)
+        {
+            TRACE_LOG_CMD_STATUS(
+                op->cmd_msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_ABORTED)
+        }
+        else
+        {
+            TRACE_LOG_CMD_STATUS(
+                op->cmd_msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_FAILED)
+        }
+
+        Log_Write(LOG_LEVEL_DEBUG, "TID[%u]:SQW[%d]:HostCommandHandler:CQ_Push:%s_RSP\r\n",
+            cmd_info->cmd_hdr.tag_id, sqw_idx, op->name);
+    }
+    else
+    {
+        TRACE_LOG_CMD_STATUS(op->cmd_msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_FAILED)
+
+        Log_Write(LOG_LEVEL_ERROR,
+            "TID[%u]:SQW[%d]:HostCommandHandler:Push:%s_RSP:Host_CQ:Failed\r\n",
+            cmd_info->cmd_hdr.tag_id, sqw_idx, op->name);
+        SP_Iface_Report_Error(MM_RECOVERABLE_FW_MM_SQW_ERROR, MM_CQ_PUSH_ERROR);
+    }
+
+    /* Decrement commands count being processed by given SQW */
+    SQW_Decrement_Command_Count(sqw_idx);
+
+    /* Check for device API error */
+    if (rsp.status != DEV_OPS_API_DMA_RESPONSE_COMPLETE)
+    {
+        /* Report device API error to SP */
+        SP_Iface_Report_Error(op->ops_api_error, (int16_t)rsp.status);
+    }
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memset_cmd_verify_args
+*
+*   DESCRIPTION
+*
+*       Function used to verify the memset command region and pattern.
+*
+*   INPUTS
+*
+*       command           Memset command to verify
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memset_cmd_verify_args(const void *command)
+{
+    const struct device_ops_memset_cmd_t *cmd = (const struct device_ops_memset_cmd_t *)command;
+    int32_t status = STATUS_SUCCESS;
+
+    /* Only power of two pattern sizes, so the pattern repeats every 8 bytes */
+    if ((cmd->size == 0) || (cmd->pattern_size == 0) ||
+        (cmd->pattern_size > DEVICE_OPS_MEMSET_PATTERN_SIZE_MAX) ||
+        ((cmd->pattern_size & (cmd->pattern_size - 1U)) != 0))
+    {
+        status = DMAW_ERROR_INVALID_XFER_SIZE;
+    }
+    else if (!host_managed_dram_region_is_valid(cmd->dst_device_phy_addr, cmd->size))
+    {
+        status = DMAW_ERROR_DRIVER_INAVLID_DEV_ADDRESS;
+    }
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memset_fill_region
+*
+*   DESCRIPTION
+*
+*       Fills the memset command region with its pattern, see MEMW_Memset.
+*
+*   INPUTS
+*
+*       command          Verified memset command
+*       sqw_idx          Submission queue index
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memset_fill_region(const void *command, uint8_t sqw_idx)
+{
+    const struct device_ops_memset_cmd_t *cmd = (const struct device_ops_memset_cmd_t *)command;
+
+    return MEMW_Memset(
+        sqw_idx, cmd->dst_device_phy_addr, cmd->size, cmd->pattern, cmd->pattern_size);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memset_log_failure
+*
+*   DESCRIPTION
+*
+*       Logs the arguments of a failed memset command.
+*
+*   INPUTS
+*
+*       command          Failed memset command
+*       sqw_idx          Submission queue index
+*       fail_msg         Failure description
+*       status           Failure status
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+static void memset_log_failure(
+    const void *command, uint8_t sqw_idx, const char *fail_msg, int32_t status)
+{
+    const struct device_ops_memset_cmd_t *cmd = (const struct device_ops_memset_cmd_t *)command;
+
+    Log_Write(LOG_LEVEL_ERROR,
+        "TID[%u]:SQW[%d]:HostCmdHdlr:MEMSET:%s:%d:dst:0x%lx:size:0x%lx:pattern_size:%d\r\n",
+        cmd->command_info.cmd_hdr.tag_id, sqw_idx, fail_msg, status, cmd->dst_device_phy_addr,
+        cmd->size, cmd->pattern_size);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memset_cmd_handler
+*
+*   DESCRIPTION
+*
+*       Process host memset command, and transmit response. The region is
+*       filled by the SQW with the help of the memory workers, see
+*       device_mem_op_cmd_handler.
+*
+*   INPUTS
+*
+*       command_buffer   Buffer containing command to process
+*       sqw_idx          Submission queue index
+*       start_cycle      Cycle count to measure wait latency
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static inline int32_t memset_cmd_handler(
+    void *command_buffer, uint8_t sqw_idx, uint64_t start_cycles)
+{
+    static const device_mem_op_t memset_op = { .name = "MEMSET",
+        .cmd_msg_id = DEV_OPS_API_MID_DEVICE_OPS_MEMSET_CMD,
+        .rsp_msg_id = DEV_OPS_API_MID_DEVICE_OPS_MEMSET_RSP,
+        .ops_api_error = MM_RECOVERABLE_OPS_API_MEMSET,
+        .verify_args = memset_cmd_verify_args,
+        .execute = memset_fill_region,
+        .log_failure = memset_log_failure };
+    const struct device_ops_memset_cmd_t *cmd =
+        (const struct device_ops_memset_cmd_t *)command_buffer;
+
+    Log_Write(LOG_LEVEL_DEBUG,
+        "TID[%u]:SQW[%d]:HostCommandHandler:Processing:MEMSET_CMD:dst:%" PRIx64 ":size:%" PRIx64
+        ":pattern_size:%d\r\n",
+        cmd->command_info.cmd_hdr.tag_id, sqw_idx, cmd->dst_device_phy_addr, cmd->size,
+        cmd->pattern_size);
+
+    return device_mem_op_cmd_handler(&memset_op, command_buffer, sqw_idx, start_cycles);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memcpy_d2d_cmd_verify_args
+*
+*   DESCRIPTION
+*
+*       Function used to verify the device to device memcpy command regions.
+*
+*   INPUTS
+*
+*       command           Memcpy command to verify
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memcpy_d2d_cmd_verify_args(const void *command)
+{
+    const struct device_ops_memcpy_d2d_cmd_t *cmd =
+        (const struct device_ops_memcpy_d2d_cmd_t *)command;
+    int32_t status = STATUS_SUCCESS;
+
+    if (cmd->size == 0)
+    {
+        status = DMAW_ERROR_INVALID_XFER_SIZE;
+    }
+    else if (!host_managed_dram_region_is_valid(cmd->src_device_phy_addr, cmd->size) ||
+             !host_managed_dram_region_is_valid(cmd->dst_device_phy_addr, cmd->size))
+    {
+        status = DMAW_ERROR_DRIVER_INAVLID_DEV_ADDRESS;
+    }
+    /* Overlapping regions are not supported, the copy is done forwards by chunks */
+    else if ((cmd->src_device_phy_addr < (cmd->dst_device_phy_addr + cmd->size)) &&
+             (cmd->dst_device_phy_addr < (cmd->src_device_phy_addr + cmd->size)))
+    {
+        status = DMAW_ERROR_DRIVER_INAVLID_DEV_ADDRESS;
+    }
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memcpy_d2d_copy_region
+*
+*   DESCRIPTION
+*
+*       Copies the memcpy command source region into the destination one,
+*       see MEMW_Memcpy.
+*
+*   INPUTS
+*
+*       command          Verified memcpy command
+*       sqw_idx          Submission queue index
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memcpy_d2d_copy_region(const void *command, uint8_t sqw_idx)
+{
+    const struct device_ops_memcpy_d2d_cmd_t *cmd =
+        (const struct device_ops_memcpy_d2d_cmd_t *)command;
+
+    return MEMW_Memcpy(sqw_idx, cmd->dst_device_phy_addr, cmd->src_device_phy_addr, cmd->size);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memcpy_d2d_log_failure
+*
+*   DESCRIPTION
+*
+*       Logs the arguments of a failed device to device memcpy command.
+*
+*   INPUTS
+*
+*       command          Failed memcpy command
+*       sqw_idx          Submission queue index
+*       fail_msg         Failure description
+*       status           Failure status
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+static void memcpy_d2d_log_failure(
+    const void *command, uint8_t sqw_idx, const char *fail_msg, int32_t status)
+{
+    const struct device_ops_memcpy_d2d_cmd_t *cmd =
+        (const struct device_ops_memcpy_d2d_cmd_t *)command;
+
+    Log_Write(LOG_LEVEL_ERROR,
+        "TID[%u]:SQW[%d]:HostCmdHdlr:MEMCPY_D2D:%s:%d:src:0x%lx:dst:0x%lx:size:0x%lx\r\n",
+        cmd->command_info.cmd_hdr.tag_id, sqw_idx, fail_msg, status, cmd->src_device_phy_addr,
+        cmd->dst_device_phy_addr, cmd->size);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memcpy_d2d_cmd_handler
+*
+*   DESCRIPTION
+*
+*       Process host device to device memcpy command, and transmit response.
+*       The copy is done by the SQW with the help of the memory workers, see
+*       device_mem_op_cmd_handler.
+*
+*   INPUTS
+*
+*       command_buffer   Buffer containing command to process
+*       sqw_idx          Submission queue index
+*       start_cycle      Cycle count to measure wait latency
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static inline int32_t memcpy_d2d_cmd_handler(
+    void *command_buffer, uint8_t sqw_idx, uint64_t start_cycles)
+{
+    static const device_mem_op_t memcpy_d2d_op = { .name = "MEMCPY_D2D",
+        .cmd_msg_id = DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_CMD,
+        .rsp_msg_id = DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_RSP,
+        .ops_api_error = MM_RECOVERABLE_OPS_API_MEMCPY_D2D,
+        .verify_args = memcpy_d2d_cmd_verify_args,
+        .execute = memcpy_d2d_copy_region,
+        .log_failure = memcpy_d2d_log_failure };
+    const struct device_ops_memcpy_d2d_cmd_t *cmd =
+        (const struct device_ops_memcpy_d2d_cmd_t *)command_buffer;
+
+    Log_Write(LOG_LEVEL_DEBUG,
+        "TID[%u]:SQW[%d]:HostCommandHandler:Processing:MEMCPY_D2D_CMD:src:%" PRIx64 ":dst:%" PRIx64
+        ":size:%" PRIx64 "\r\n",
+        cmd->command_info.cmd_hdr.tag_id, sqw_idx, cmd->src_device_phy_addr,
+        cmd->dst_device_phy_addr, cmd->size);
+
+    return device_mem_op_cmd_handler(&memcpy_d2d_op, command_buffer, sqw_idx, start_cycles);
+}
+
 /************************************************************************
 *
 *   FUNCTION
@@ -2106,6 +2599,145 @@ static inline int32_t trace_rt_config_cmd_handler(void *command_buffer, uint8_t
     return status;
 }
 
+/************************************************************************
+*
+*   FUNCTION
+*
+*       cq_coalesce_config_cmd_handler
+*
+*   DESCRIPTION
+*
+*       Process host completion coalescing configuration command, and
+*       transmit response. The configuration applies to the SQ the command
+*       was popped from, and its response is never coalesced.
+*
+*   INPUTS
+*
+*       command_buffer   Buffer containing command to process
+*       sqw_idx          Submission queue index
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static inline int32_t cq_coalesce_config_cmd_handler(void *command_buffer, uint8_t sqw_idx)
+{
+    const struct device_ops_cq_coalesce_config_cmd_t *cmd =
+        (struct device_ops_cq_coalesce_config_cmd_t *)command_buffer;
+    struct device_ops_cq_coalesce_config_rsp_t rsp = { 0 };
+    int32_t status = STATUS_SUCCESS;
+
+    TRACE_LOG_CMD_STATUS(DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD, sqw_idx,
+        cmd->command_info.cmd_hdr.tag_id, CMD_STATUS_RECEIVED)
+
+    Log_Write(LOG_LEVEL_DEBUG,
+        "TID[%u]:SQW[%d]:HostCmdHdlr:CQ_COALESCE_CONFIG:max_count:%d:timeout_us:%d\r\n",
+        cmd->command_info.cmd_hdr.tag_id, sqw_idx, cmd->max_count, cmd->timeout_us);
+
+    /* Verify the arguments, the timeout is ignored when coalescing is disabled */
+    if (cmd->max_count > DEVICE_OPS_CQ_COALESCE_COUNT_MAX)
+    {
+        status = HOST_CMD_ERROR_CQ_COALESCE_INVALID_COUNT;
+    }
+    else if ((cmd->max_count > 1) &&
+             ((cmd->timeout_us == 0) || (cmd->timeout_us > DEVICE_OPS_CQ_COALESCE_TIMEOUT_US_MAX)))
+    {
+        status = HOST_CMD_ERROR_CQ_COALESCE_INVALID_TIMEOUT;
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        TRACE_LOG_CMD_STATUS(DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD, sqw_idx,
+            cmd->command_info.cmd_hdr.tag_id, CMD_STATUS_EXECUTING)
+
+        /* Minion frequency is in MHz, which is the number of cycles per microsecond */
+        status = Host_Iface_CQ_Coalesce_Config(sqw_idx, cmd->max_count,
+            (uint64_t)cmd->timeout_us * STATW_Get_Minion_Freq());
+    }
+
+    /* Construct and transmit response */
+    rsp.response_info.rsp_hdr.tag_id = cmd->command_info.cmd_hdr.tag_id;
+    rsp.response_info.rsp_hdr.msg_id = DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_RSP;
+
+    if (status == STATUS_SUCCESS)
+    {
+        rsp.status = DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_SUCCESS;
+    }
+    else if (status == HOST_CMD_ERROR_CQ_COALESCE_INVALID_COUNT)
+    {
+        rsp.status = DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_INVALID_COUNT;
+    }
+    else if (status == HOST_CMD_ERROR_CQ_COALESCE_INVALID_TIMEOUT)
+    {
+        rsp.status = DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_INVALID_TIMEOUT;
+    }
+    else
+    {
+        /* The configuration is applied, only flushing the pending completions failed */
+        rsp.status = DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_SUCCESS;
+    }
+
+    if (rsp.status != DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_SUCCESS)
+    {
+        Log_Write(LOG_LEVEL_ERROR,
+            "TID[%u]:SQW[%d]:HostCmdHdlr:CQ_COALESCE_CONFIG:Failed:%d:max_count:%d:timeout_us:%d\r\n",
+            cmd->command_info.cmd_hdr.tag_id, sqw_idx, status, cmd->max_count, cmd->timeout_us);
+    }
+
+#if TEST_FRAMEWORK
+    /* For SP2MM command response, we need to provide the total size = header + payload */
+    rsp.response_info.rsp_hdr.size = sizeof(struct device_ops_cq_coalesce_config_rsp_t);
+    status = SP_Iface_Push_Rsp_To_SP2MM_CQ(&rsp, sizeof(rsp));
+#else
+    rsp.response_info.rsp_hdr.size =
+        sizeof(struct device_ops_cq_coalesce_config_rsp_t) - sizeof(struct cmn_header_t);
+    status = Host_Iface_CQ_Push_Cmd(0, &rsp, sizeof(rsp));
+#endif
+
+    if (status == STATUS_SUCCESS)
+    {
+        if (rsp.status == DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_SUCCESS)
+        {
+            TRACE_LOG_CMD_STATUS(DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD, sqw_idx,
+                cmd->command_info.cmd_hdr.tag_id, CMD_STATUS_SUCCEEDED)
+        }
+        else
+        {
+            TRACE_LOG_CMD_STATUS(DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD, sqw_idx,
+                cmd->command_info.cmd_hdr.tag_id, CMD_STATUS_FAILED)
+        }
+
+        Log_Write(LOG_LEVEL_DEBUG,
+            "TID[%u]:SQW[%d]:HostCommandHandler:CQ_Push:CQ_COALESCE_CONFIG_RSP\r\n",
+            cmd->command_info.cmd_hdr.tag_id, sqw_idx);
+    }
+    else
+    {
+        TRACE_LOG_CMD_STATUS(DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD, sqw_idx,
+            cmd->command_info.cmd_hdr.tag_id, CMD_STATUS_FAILED)
+
+        Log_Write(LOG_LEVEL_ERROR,
+            "TID[%u]:SQW[%d]:HostCommandHandler:Push:CQ_COALESCE_CONFIG_RSP:Host_CQ:Failed\r\n",
+            cmd->command_info.cmd_hdr.tag_id, sqw_idx);
+        SP_Iface_Report_Error(MM_RECOVERABLE_FW_MM_SQW_ERROR, MM_CQ_PUSH_ERROR);
+    }
+
+#if !TEST_FRAMEWORK
+    /* Decrement commands count being processed by given SQW */
+    SQW_Decrement_Command_Count(sqw_idx);
+
+    /* Check for device API error */
+    if (rsp.status != DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_SUCCESS)
+    {
+        /* Report device API error to SP */
+        SP_Iface_Report_Error(MM_RECOVERABLE_OPS_API_CQ_COALESCE_CONFIG, (int16_t)rsp.status);
+    }
+#endif
+
+    return status;
+}
+
 /************************************************************************
 *
 *   FUNCTION
@@ -2203,12 +2835,21 @@ int32_t Host_Command_Handler(void *command_buffer, uint8_t sqw_idx, uint64_t sta
         case DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_WRITELIST_CMD:
             status = dma_writelist_cmd_handler(command_buffer, sqw_idx, start_cycles);
             break;
+        case DEV_OPS_API_MID_DEVICE_OPS_MEMSET_CMD:
+            status = memset_cmd_handler(command_buffer, sqw_idx, start_cycles);
+            break;
+        case DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_CMD:
+            status = memcpy_d2d_cmd_handler(command_buffer, sqw_idx, start_cycles);
+            break;
         case DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONTROL_CMD:
             status = trace_rt_control_cmd_handler(command_buffer, sqw_idx);
             break;
         case DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONFIG_CMD:
             status = trace_rt_config_cmd_handler(command_buffer, sqw_idx);
             break;
+        case DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD:
+            status = cq_coalesce_config_cmd_handler(command_buffer, sqw_idx);
+            break;
         default:
             Log_Write(LOG_LEVEL_ERROR, "TID[%u]:SQW[%d]:HostCmdHdlr:UnsupportedCmd\r\n",
                 hdr->cmd_hdr.tag_id, sqw_idx);
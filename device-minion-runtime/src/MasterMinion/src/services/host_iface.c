@@ -15,6 +15,9 @@
         Host_Iface_SQ_Pop_Cmd
         Host_Iface_Optimized_SQ_Update_Tail
         Host_Iface_CQ_Push_Cmd
+        Host_Iface_CQ_Push_Completion
+        Host_Iface_CQ_Coalesce_Config
+        Host_Iface_CQ_Coalesce_Processing
         Host_Iface_Interrupt_Status
         Host_Iface_Processing
         Host_Iface_SQs_Deinit
@@ -24,6 +27,8 @@
 /* mm_rt_svcs */
 #include <transports/vq/vq.h>
 #include <etsoc/drivers/pcie/pcie_int.h>
+#include <etsoc/drivers/pmu/pmu.h>
+#include <etsoc/isa/atomic.h>
 
 /* etsoc_hal */
 #include "hwinc/hal_device.h"
@@ -36,6 +41,35 @@
 #include "workers/sqw_hp.h"
 #include "drivers/plic.h"
 
+/* mm_rt_helpers */
+#include "error_codes.h"
+
+/*! \def CQ_BATCH_PAYLOAD_WORDS
+    \brief Number of 64-bit words of responses a CQ batch can hold.
+*/
+#define CQ_BATCH_PAYLOAD_WORDS (DEVICE_OPS_CQ_COALESCE_PAYLOAD_MAX / sizeof(uint64_t))
+
+/*! \struct host_iface_cq_coalesce_cfg_t
+    \brief Completion coalescing configuration of a submission queue
+*/
+typedef struct host_iface_cq_coalesce_cfg_ {
+    uint64_t timeout_cycles; /* Cycles a non empty batch is held before being flushed */
+    uint16_t max_count;      /* Completions per batch, 0 or 1 when coalescing is disabled */
+    uint8_t pad[6];
+} host_iface_cq_coalesce_cfg_t;
+
+/*! \struct host_iface_cq_batch_t
+    \brief Completions of a submission queue waiting to be pushed to a completion
+    queue as a single batched response. Protected by the lock of the completion queue.
+*/
+typedef struct host_iface_cq_batch_ {
+    uint64_t flush_cycles; /* Cycle count after which the batch is flushed */
+    uint16_t count;        /* Number of packed responses, 0 when the batch is empty */
+    uint16_t payload_size; /* Size in bytes of the packed responses */
+    uint8_t pad[4];
+    uint64_t payload[CQ_BATCH_PAYLOAD_WORDS];
+} host_iface_cq_batch_t;
+
 /*! \struct host_iface_sqs_hp_cb_t
     \brief Host interface control block that manages
     high priority submissions queues
@@ -65,6 +99,8 @@ typedef struct host_iface_cqs_cb_ {
     uint32_t per_vqueue_size;
     spinlock_t vqueue_locks[MM_CQ_COUNT];
     vq_cb_t vqueues[MM_CQ_COUNT];
+    host_iface_cq_coalesce_cfg_t coalesce_cfgs[MM_SQ_COUNT];
+    host_iface_cq_batch_t batches[MM_CQ_COUNT][MM_SQ_COUNT];
 } host_iface_cqs_cb_t;
 
 /*! \var host_iface_sqs_hp_cb_t Host_SQs_HP
@@ -96,6 +132,9 @@ static volatile bool Host_Iface_Interrupt_Flag __attribute__((aligned(64))) = fa
 
 /* Local fn proptotypes */
 static void host_iface_rxisr(uint32_t intID);
+static int32_t host_iface_cq_push_locked(uint8_t cq_id, const void *p_cmd, uint32_t cmd_size);
+static int32_t host_iface_cq_flush_batch_locked(uint8_t cq_id, uint8_t sq_id);
+static int32_t host_iface_cq_flush_batches_locked(uint8_t cq_id);
 
 static void host_iface_rxisr(uint32_t intID)
 {
@@ -117,6 +156,94 @@ static void host_iface_rxisr(uint32_t intID)
     }
 }
 
+static int32_t host_iface_cq_push_locked(uint8_t cq_id, const void *p_cmd, uint32_t cmd_size)
+{
+    int32_t status;
+
+    /* TODO: SW-5781 Polling here until we are able to push response */
+    do
+    {
+        /* Push the response to circular buffer */
+        status = VQ_Push(&Host_CQs.vqueues[cq_id], p_cmd, cmd_size);
+        if (status != STATUS_SUCCESS)
+        {
+            Log_Write(LOG_LEVEL_WARNING, "HostIface:CQ[%d] push warning: status code: %d\n", cq_id,
+                status);
+        }
+    } while (status == CIRCBUFF_ERROR_FULL);
+
+    if (status == STATUS_SUCCESS)
+    {
+        FENCE
+        status = pcie_interrupt_host(MM_CQ_NOTIFY_VECTOR);
+
+        if (status != STATUS_SUCCESS)
+        {
+            Log_Write(
+                LOG_LEVEL_ERROR, "HostIface:CQ_Push:ERROR: Notification (Error: %d)\r\n", status);
+        }
+    }
+    else
+    {
+        Log_Write(LOG_LEVEL_ERROR, "HostIface:CQ_Push:ERROR: VQ Push (Error: %d)\r\n", status);
+    }
+
+    return status;
+}
+
+static int32_t host_iface_cq_flush_batch_locked(uint8_t cq_id, uint8_t sq_id)
+{
+    host_iface_cq_batch_t *batch = &Host_CQs.batches[cq_id][sq_id];
+    uint64_t rsp_buffer[(sizeof(struct device_ops_batched_rsp_t) / sizeof(uint64_t)) +
+                        CQ_BATCH_PAYLOAD_WORDS] __attribute__((aligned(8)));
+    struct device_ops_batched_rsp_t *rsp = (struct device_ops_batched_rsp_t *)rsp_buffer;
+    uint64_t *payload = (uint64_t *)rsp->payload;
+    uint16_t count = atomic_load_local_16(&batch->count);
+    uint16_t payload_size = atomic_load_local_16(&batch->payload_size);
+
+    if (count == 0)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* Build the batched response from the packed responses */
+    for (uint32_t word = 0; word < (payload_size / sizeof(uint64_t)); word++)
+    {
+        payload[word] = atomic_load_local_64(&batch->payload[word]);
+    }
+    rsp->response_info.rsp_hdr.tag_id = 0;
+    rsp->response_info.rsp_hdr.msg_id = DEV_OPS_API_MID_DEVICE_OPS_BATCHED_RSP;
+    rsp->response_info.rsp_hdr.flags = 0;
+    rsp->response_info.rsp_hdr.size = (uint16_t)(sizeof(struct device_ops_batched_rsp_t) -
+                                                 sizeof(struct cmn_header_t) + payload_size);
+    rsp->count = count;
+
+    /* Empty the batch before pushing, a failed push is reported to the caller */
+    atomic_store_local_16(&batch->count, 0);
+    atomic_store_local_16(&batch->payload_size, 0);
+    atomic_store_local_64(&batch->flush_cycles, UINT64_MAX);
+
+    return host_iface_cq_push_locked(
+        cq_id, rsp, sizeof(struct device_ops_batched_rsp_t) + payload_size);
+}
+
+static int32_t host_iface_cq_flush_batches_locked(uint8_t cq_id)
+{
+    int32_t status = STATUS_SUCCESS;
+
+    for (uint8_t sq_id = 0; sq_id < MM_SQ_COUNT; sq_id++)
+    {
+        int32_t flush_status = host_iface_cq_flush_batch_locked(cq_id, sq_id);
+
+        if (flush_status != STATUS_SUCCESS)
+        {
+            status = flush_status;
+        }
+    }
+
+    return status;
+}
+
 /************************************************************************
 *
 *   FUNCTION
@@ -282,6 +409,12 @@ int32_t Host_Iface_CQs_Init(void)
         /* Initialize the spinlock */
         init_local_spinlock(&Host_CQs.vqueue_locks[cq_index], 0);
 
+        /* Completion batches start empty */
+        for (uint32_t sq_index = 0; sq_index < MM_SQ_COUNT; sq_index++)
+        {
+            atomic_store_local_64(&Host_CQs.batches[cq_index][sq_index].flush_cycles, UINT64_MAX);
+        }
+
         /* Initialize the CQ circular buffer */
         status = VQ_Init(&Host_CQs.vqueues[cq_index],
             VQ_CIRCBUFF_BASE_ADDR(MM_CQS_BASE_ADDRESS, cq_index, MM_CQ_SIZE), MM_CQ_SIZE, 0,
@@ -405,43 +538,231 @@ int32_t Host_Iface_CQ_Push_Cmd(uint8_t cq_id, const void *p_cmd, uint32_t cmd_si
     /* Acquire the lock. Multiple threads can call this function. */
     acquire_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
 
-    /* TODO: SW-5781 Polling here until we are able to push response */
-    do
+    /* Flush the coalesced completions first so the host receives the responses in order */
+    status = host_iface_cq_flush_batches_locked(cq_id);
+
+    if (status == STATUS_SUCCESS)
     {
-        /* Push the response to circular buffer */
-        status = VQ_Push(&Host_CQs.vqueues[cq_id], p_cmd, cmd_size);
-        if (status != STATUS_SUCCESS)
+        status = host_iface_cq_push_locked(cq_id, p_cmd, cmd_size);
+    }
+
+    /* Release the lock */
+    release_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       Host_Iface_CQ_Push_Completion
+*
+*   DESCRIPTION
+*
+*       This function is used to push the completion of a command popped
+*       from a SQ to host completion queue. When completion coalescing is
+*       enabled for the SQ, the response is packed in the batch of the SQ
+*       which is pushed as a single batched response once it holds the
+*       configured number of completions, its timeout expires or a response
+*       is pushed directly to the same completion queue.
+*
+*   INPUTS
+*
+*       cq_id      ID of the CQ to push the completion to.
+*       sq_id      ID of the SQ the command was popped from.
+*       p_rsp      Pointer to the response.
+*       rsp_size   Response size, a multiple of 8 bytes
+*
+*   OUTPUTS
+*
+*       int32_t     Status indicating success or negative error
+*
+***********************************************************************/
+int32_t Host_Iface_CQ_Push_Completion(
+    uint8_t cq_id, uint8_t sq_id, const void *p_rsp, uint32_t rsp_size)
+{
+    host_iface_cq_batch_t *batch = &Host_CQs.batches[cq_id][sq_id];
+    const uint64_t *rsp_words = (const uint64_t *)p_rsp;
+    int32_t status = STATUS_SUCCESS;
+    uint16_t max_count;
+    uint16_t count;
+    uint16_t payload_size;
+
+    /* Acquire the lock. Multiple threads can call this function. */
+    acquire_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+
+    max_count = atomic_load_local_16(&Host_CQs.coalesce_cfgs[sq_id].max_count);
+
+    if ((max_count <= 1) || (rsp_size > DEVICE_OPS_CQ_COALESCE_PAYLOAD_MAX) ||
+        ((rsp_size % sizeof(uint64_t)) != 0))
+    {
+        /* Coalescing disabled or response that can not be packed, push it directly */
+        status = host_iface_cq_flush_batches_locked(cq_id);
+
+        if (status == STATUS_SUCCESS)
         {
-            Log_Write(LOG_LEVEL_WARNING, "HostIface:CQ[%d] push warning: status code: %d\n", cq_id,
-                status);
+            status = host_iface_cq_push_locked(cq_id, p_rsp, rsp_size);
         }
-    } while (status == CIRCBUFF_ERROR_FULL);
+
+        release_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+
+        return status;
+    }
+
+    /* Flush the batch first if the response does not fit in it */
+    if ((atomic_load_local_16(&batch->payload_size) + rsp_size) > DEVICE_OPS_CQ_COALESCE_PAYLOAD_MAX)
+    {
+        status = host_iface_cq_flush_batch_locked(cq_id, sq_id);
+    }
 
     if (status == STATUS_SUCCESS)
     {
-        FENCE
-        status = pcie_interrupt_host(MM_CQ_NOTIFY_VECTOR);
+        count = atomic_load_local_16(&batch->count);
+        payload_size = atomic_load_local_16(&batch->payload_size);
 
-        /* Release the lock */
-        release_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+        /* Pack the response in the batch */
+        for (uint32_t word = 0; word < (rsp_size / sizeof(uint64_t)); word++)
+        {
+            atomic_store_local_64(
+                &batch->payload[(payload_size / sizeof(uint64_t)) + word], rsp_words[word]);
+        }
+        atomic_store_local_16(&batch->payload_size, (uint16_t)(payload_size + rsp_size));
+        atomic_store_local_16(&batch->count, (uint16_t)(count + 1U));
 
-        if (status != STATUS_SUCCESS)
+        /* The timeout of the batch starts with its first completion */
+        if (count == 0)
         {
-            Log_Write(
-                LOG_LEVEL_ERROR, "HostIface:CQ_Push:ERROR: Notification (Error: %d)\r\n", status);
+            atomic_store_local_64(&batch->flush_cycles,
+                PMC_Get_Current_Cycles() +
+                    atomic_load_local_64(&Host_CQs.coalesce_cfgs[sq_id].timeout_cycles));
+        }
+
+        if ((count + 1U) >= max_count)
+        {
+            status = host_iface_cq_flush_batch_locked(cq_id, sq_id);
         }
     }
-    else
+
+    /* Release the lock */
+    release_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       Host_Iface_CQ_Coalesce_Config
+*
+*   DESCRIPTION
+*
+*       This function configures the completion coalescing of a SQ. The
+*       completions already packed for the SQ are flushed so the new
+*       configuration applies to the following commands only.
+*
+*   INPUTS
+*
+*       sq_id            ID of the SQ to configure.
+*       max_count        Completions per batch, 0 or 1 to disable coalescing.
+*       timeout_cycles   Cycles a non empty batch is held before being flushed.
+*
+*   OUTPUTS
+*
+*       int32_t     Status indicating success or negative error
+*
+***********************************************************************/
+int32_t Host_Iface_CQ_Coalesce_Config(uint8_t sq_id, uint16_t max_count, uint64_t timeout_cycles)
+{
+    int32_t status = STATUS_SUCCESS;
+
+    if (max_count > DEVICE_OPS_CQ_COALESCE_COUNT_MAX)
     {
-        /* Release the lock */
-        release_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+        return HOST_CMD_ERROR_CQ_COALESCE_INVALID_COUNT;
+    }
 
-        Log_Write(LOG_LEVEL_ERROR, "HostIface:CQ_Push:ERROR: VQ Push (Error: %d)\r\n", status);
+    if ((max_count > 1) && (timeout_cycles == 0))
+    {
+        return HOST_CMD_ERROR_CQ_COALESCE_INVALID_TIMEOUT;
+    }
+
+    for (uint8_t cq_id = 0; cq_id < MM_CQ_COUNT; cq_id++)
+    {
+        acquire_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+
+        int32_t flush_status = host_iface_cq_flush_batch_locked(cq_id, sq_id);
+
+        /* Update the configuration while holding all the CQ locks */
+        if (cq_id == (MM_CQ_COUNT - 1))
+        {
+            atomic_store_local_64(&Host_CQs.coalesce_cfgs[sq_id].timeout_cycles, timeout_cycles);
+            atomic_store_local_16(&Host_CQs.coalesce_cfgs[sq_id].max_count, max_count);
+        }
+
+        if (flush_status != STATUS_SUCCESS)
+        {
+            status = flush_status;
+        }
+    }
+
+    for (uint8_t cq_id = 0; cq_id < MM_CQ_COUNT; cq_id++)
+    {
+        release_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
     }
 
     return status;
 }
 
+/************************************************************************
+*
+*   FUNCTION
+*
+*       Host_Iface_CQ_Coalesce_Processing
+*
+*   DESCRIPTION
+*
+*       This function flushes the completion batches whose timeout expired.
+*       It is meant to be called periodically by a worker loop.
+*
+*   INPUTS
+*
+*       None
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+void Host_Iface_CQ_Coalesce_Processing(void)
+{
+    uint64_t current_cycles = PMC_Get_Current_Cycles();
+
+    for (uint8_t cq_id = 0; cq_id < MM_CQ_COUNT; cq_id++)
+    {
+        for (uint8_t sq_id = 0; sq_id < MM_SQ_COUNT; sq_id++)
+        {
+            host_iface_cq_batch_t *batch = &Host_CQs.batches[cq_id][sq_id];
+
+            /* Check the deadline without the lock, empty batches never expire */
+            if (current_cycles < atomic_load_local_64(&batch->flush_cycles))
+            {
+                continue;
+            }
+
+            acquire_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+
+            /* Check again, the batch could have been flushed in the meantime */
+            if (current_cycles >= atomic_load_local_64(&batch->flush_cycles))
+            {
+                (void)host_iface_cq_flush_batch_locked(cq_id, sq_id);
+            }
+
+            release_local_spinlock(&Host_CQs.vqueue_locks[cq_id]);
+        }
+    }
+}
+
 /************************************************************************
 *
 *   FUNCTION
@@ -15,7 +15,8 @@
     1. DMAW_Launch - An infinite loop that polls for completion of DMA
     transactions on active DMA channels. On detecting completion of
     a an configured DMA transaction, a DMA complete response is
-    constructed and transmitted to host.
+    constructed and transmitted to host. The write DMAW also flushes the
+    coalesced completion batches whose timeout expired.
     2. It implements, and exposes the below listed public interfaces to
     other master shire runtime components present in the system
     to facilitate DMAW management
@@ -24,6 +25,8 @@
         DMAW_Init
         DMAW_Read_Find_Idle_Chan_And_Reserve
         DMAW_Write_Find_Idle_Chan_And_Reserve
+        DMAW_Read_Reserve_Stripe_Chans
+        DMAW_Write_Reserve_Stripe_Chans
         DMAW_Read_Trigger_Transfer
         DMAW_Write_Trigger_Transfer
         DMAW_Launch
@@ -55,6 +58,7 @@
 */
 typedef CACHE_STRUCT ({
     dma_channel_status_cb_t chan_status_cb[PCIE_DMA_RD_CHANNEL_COUNT];
+    uint32_t chan_waiters; /* Number of SQWs searching for an idle channel */
 }) dmaw_read_cb_t;
 
 /*! \struct dmaw_write_cb_t
@@ -63,8 +67,18 @@ typedef CACHE_STRUCT ({
 */
 typedef CACHE_STRUCT ({
     dma_channel_status_cb_t chan_status_cb[PCIE_DMA_WRT_CHANNEL_COUNT];
+    uint32_t chan_waiters; /* Number of SQWs searching for an idle channel */
 }) dmaw_write_cb_t;
 
+/*! \struct dmaw_stripe_cursor_t
+    \brief Position in the transfer list of a DMA command while the command
+    is being split into per channel stripes.
+*/
+typedef struct {
+    uint8_t xfer_index;   /* Index of the transfer node the next stripe starts in */
+    uint32_t xfer_offset; /* Offset within the transfer node the next stripe starts at */
+} dmaw_stripe_cursor_t;
+
 /*! \var dmaw_read_cb_t DMAW_Read_CB
     \brief Global DMA Read Control Block
     \warning Not thread safe!, used by minions in
@@ -86,6 +100,14 @@ static dmaw_write_cb_t DMAW_Write_CB = { 0 };
 #define DMAW_BYTES_PER_CYCLE_TO_MBPS(bytes, cycles) \
     ((bytes * STATW_Get_Minion_Freq()) / (cycles ? cycles : 1))
 
+/*! \def DMAW_GET_STRIPE_SIZE
+    \brief A helper macro to compute the size of a stripe when a transfer is split
+    evenly across channels. Stripe boundaries are kept aligned to DMAW_STRIPE_ALIGNMENT.
+*/
+#define DMAW_GET_STRIPE_SIZE(transfer_size, stripe_count)                  \
+    ((((transfer_size) / (stripe_count)) + (DMAW_STRIPE_ALIGNMENT - 1U)) & \
+        ~((uint64_t)DMAW_STRIPE_ALIGNMENT - 1U))
+
 /************************************************************************
 *
 *   FUNCTION
@@ -123,6 +145,9 @@ void DMAW_Init(void)
         atomic_store_local_64(&DMAW_Read_CB.chan_status_cb[i].dmaw_cycles.cmd_start_cycles, 0U);
         atomic_store_local_64(&DMAW_Read_CB.chan_status_cb[i].dmaw_cycles.wait_cycles, 0U);
         atomic_store_local_64(&DMAW_Read_CB.chan_status_cb[i].dmaw_cycles.prev_cycles, 0U);
+        atomic_store_local_8(&DMAW_Read_CB.chan_status_cb[i].stripe_leader, (uint8_t)i);
+        atomic_store_local_8(&DMAW_Read_CB.chan_status_cb[i].stripe_mask, 0U);
+        atomic_store_local_32(&DMAW_Read_CB.chan_status_cb[i].stripes_pending, 0U);
     }
 
     /* Initialize DMA Write channel status */
@@ -134,8 +159,14 @@ void DMAW_Init(void)
         atomic_store_local_64(&DMAW_Write_CB.chan_status_cb[i].dmaw_cycles.cmd_start_cycles, 0U);
         atomic_store_local_64(&DMAW_Write_CB.chan_status_cb[i].dmaw_cycles.wait_cycles, 0U);
         atomic_store_local_64(&DMAW_Write_CB.chan_status_cb[i].dmaw_cycles.prev_cycles, 0U);
+        atomic_store_local_8(&DMAW_Write_CB.chan_status_cb[i].stripe_leader, (uint8_t)i);
+        atomic_store_local_8(&DMAW_Write_CB.chan_status_cb[i].stripe_mask, 0U);
+        atomic_store_local_32(&DMAW_Write_CB.chan_status_cb[i].stripes_pending, 0U);
     }
 
+    atomic_store_local_32(&DMAW_Read_CB.chan_waiters, 0U);
+    atomic_store_local_32(&DMAW_Write_CB.chan_waiters, 0U);
+
     return;
 }
 
@@ -166,6 +197,9 @@ int32_t DMAW_Read_Find_Idle_Chan_And_Reserve(dma_read_chan_id_e *chan_id, uint8_
     bool read_chan_reserved = false;
     sqw_state_e sqw_state;
 
+    /* Let striped commands know a channel is wanted */
+    atomic_add_local_32(&DMAW_Read_CB.chan_waiters, 1U);
+
     /* Try to find idle channel until aborted */
     do
     {
@@ -188,6 +222,8 @@ int32_t DMAW_Read_Find_Idle_Chan_And_Reserve(dma_read_chan_id_e *chan_id, uint8_
         sqw_state = SQW_Get_State(sqw_idx);
     } while (!read_chan_reserved && (sqw_state != SQW_STATE_ABORTED));
 
+    atomic_add_local_32(&DMAW_Read_CB.chan_waiters, (uint32_t)-1);
+
     /* Verify SQW state */
     if (sqw_state == SQW_STATE_ABORTED)
     {
@@ -232,6 +268,9 @@ int32_t DMAW_Write_Find_Idle_Chan_And_Reserve(dma_write_chan_id_e *chan_id, uint
     bool write_chan_reserved = false;
     sqw_state_e sqw_state;
 
+    /* Let striped commands know a channel is wanted */
+    atomic_add_local_32(&DMAW_Write_CB.chan_waiters, 1U);
+
     /* Try to find idle channel until aborted */
     do
     {
@@ -253,6 +292,8 @@ int32_t DMAW_Write_Find_Idle_Chan_And_Reserve(dma_write_chan_id_e *chan_id, uint
         sqw_state = SQW_Get_State(sqw_idx);
     } while (!write_chan_reserved && (sqw_state != SQW_STATE_ABORTED));
 
+    atomic_add_local_32(&DMAW_Write_CB.chan_waiters, (uint32_t)-1);
+
     /* Verify SQW state */
     if (sqw_state == SQW_STATE_ABORTED)
     {
@@ -274,77 +315,343 @@ int32_t DMAW_Write_Find_Idle_Chan_And_Reserve(dma_write_chan_id_e *chan_id, uint
 *
 *   FUNCTION
 *
-*       DMAW_Read_Trigger_Transfer
+*       dmaw_get_xfer_node
 *
 *   DESCRIPTION
 *
-*       This function is used to trigger a DMA Read transaction by calling
-*       the PCIe device driver routine.
+*       Helper function to read the source address, destination address
+*       and size of a transfer node from any of the DMA list commands.
 *
 *   INPUTS
 *
-*       read_chan_id    DMA channel ID
 *       cmd_info        Pointer to command buffer
-*       xfer_count      Number of transfer nodes in command.
-*       sqw_idx         SQW ID
-*       cycles          Pointer to latency cycles struct
+*       xfer_index      Index of the transfer node in command
+*       src_addr        Pointer to populate with source address
+*       dst_addr        Pointer to populate with destination address
+*       size            Pointer to populate with size of the node
 *
 *   OUTPUTS
 *
-*       int32_t          status success or error
+*       None
 *
 ***********************************************************************/
-int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e read_chan_id,
-    const struct cmd_header_t *cmd_info, uint8_t xfer_count, uint8_t sqw_idx,
-    const execution_cycles_t *cycles)
+static inline void dmaw_get_xfer_node(const struct cmd_header_t *cmd_info, uint8_t xfer_index,
+    uint64_t *src_addr, uint64_t *dst_addr, uint32_t *size)
 {
-    uint64_t transfer_size = 0;
-    int32_t status = STATUS_SUCCESS;
-    dma_channel_status_t chan_status;
+    if (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD)
+    {
+        const struct device_ops_dma_writelist_cmd_t *dmalist_cmd =
+            (const struct device_ops_dma_writelist_cmd_t *)cmd_info;
+
+        *src_addr = dmalist_cmd->list[xfer_index].src_host_phy_addr;
+        *dst_addr = dmalist_cmd->list[xfer_index].dst_device_phy_addr;
+        *size = dmalist_cmd->list[xfer_index].size;
+    }
+    else if (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_WRITELIST_CMD)
+    {
+        const struct device_ops_p2pdma_writelist_cmd_t *p2p_dmalist_cmd =
+            (const struct device_ops_p2pdma_writelist_cmd_t *)cmd_info;
+
+        *src_addr = p2p_dmalist_cmd->list[xfer_index].src_device_bus_addr;
+        *dst_addr = p2p_dmalist_cmd->list[xfer_index].dst_device_phy_addr;
+        *size = p2p_dmalist_cmd->list[xfer_index].size;
+    }
+    else if (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_CMD)
+    {
+        const struct device_ops_dma_readlist_cmd_t *dmalist_cmd =
+            (const struct device_ops_dma_readlist_cmd_t *)cmd_info;
+
+        *src_addr = dmalist_cmd->list[xfer_index].src_device_phy_addr;
+        *dst_addr = dmalist_cmd->list[xfer_index].dst_host_phy_addr;
+        *size = dmalist_cmd->list[xfer_index].size;
+    }
+    else
+    {
+        const struct device_ops_p2pdma_readlist_cmd_t *p2p_dmalist_cmd =
+            (const struct device_ops_p2pdma_readlist_cmd_t *)cmd_info;
 
-    /* Set tag ID, set channel state to active, set SQW Index */
-    chan_status.tag_id = cmd_info->cmd_hdr.tag_id;
-    chan_status.sqw_idx = sqw_idx;
-    chan_status.channel_state = DMA_CHAN_STATE_IN_USE;
-    atomic_store_local_16(&DMAW_Read_CB.chan_status_cb[read_chan_id].rsp_id,
-        (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD) ?
-            DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_RSP :
-            DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_WRITELIST_RSP);
+        *src_addr = p2p_dmalist_cmd->list[xfer_index].src_device_phy_addr;
+        *dst_addr = p2p_dmalist_cmd->list[xfer_index].dst_device_bus_addr;
+        *size = p2p_dmalist_cmd->list[xfer_index].size;
+    }
+}
 
-    /* To start indexing from zero, decrement the count by one. */
-    uint8_t last_i = (uint8_t)(xfer_count - 1);
+/************************************************************************
+*
+*   FUNCTION
+*
+*       dmaw_get_transfer_size
+*
+*   DESCRIPTION
+*
+*       Helper function to compute the total size of a DMA list command.
+*
+*   INPUTS
+*
+*       cmd_info        Pointer to command buffer
+*       xfer_count      Number of transfer nodes in command.
+*
+*   OUTPUTS
+*
+*       uint64_t        Total transfer size in bytes
+*
+***********************************************************************/
+static inline uint64_t dmaw_get_transfer_size(
+    const struct cmd_header_t *cmd_info, uint8_t xfer_count)
+{
+    uint64_t transfer_size = 0;
 
-    /* Configure DMA for all transfers one-by-one. */
-    for (uint8_t xfer_index = 0; (xfer_index <= last_i) && (status == STATUS_SUCCESS); ++xfer_index)
+    for (uint8_t xfer_index = 0; xfer_index < xfer_count; ++xfer_index)
     {
         uint64_t src_addr;
         uint64_t dst_addr;
         uint32_t size;
 
-        if (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD)
-        {
-            const struct device_ops_dma_writelist_cmd_t *dmalist_cmd =
-                (const struct device_ops_dma_writelist_cmd_t *)cmd_info;
+        dmaw_get_xfer_node(cmd_info, xfer_index, &src_addr, &dst_addr, &size);
+        transfer_size += size;
+    }
 
-            src_addr = dmalist_cmd->list[xfer_index].src_host_phy_addr;
-            dst_addr = dmalist_cmd->list[xfer_index].dst_device_phy_addr;
-            size = dmalist_cmd->list[xfer_index].size;
+    return transfer_size;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       dmaw_get_stripe_count
+*
+*   DESCRIPTION
+*
+*       Helper function to compute the number of stripes worth using for
+*       a DMA list command. Every stripe gets at least DMAW_STRIPE_MIN_SIZE
+*       bytes.
+*
+*   INPUTS
+*
+*       cmd_info        Pointer to command buffer
+*       xfer_count      Number of transfer nodes in command.
+*       max_stripes     Number of channels available for the command
+*
+*   OUTPUTS
+*
+*       uint8_t         Number of stripes
+*
+***********************************************************************/
+static inline uint8_t dmaw_get_stripe_count(
+    const struct cmd_header_t *cmd_info, uint8_t xfer_count, uint8_t max_stripes)
+{
+    uint64_t stripe_count = dmaw_get_transfer_size(cmd_info, xfer_count) / DMAW_STRIPE_MIN_SIZE;
+
+    if (stripe_count > max_stripes)
+    {
+        stripe_count = max_stripes;
+    }
+
+    return (stripe_count == 0) ? 1U : (uint8_t)stripe_count;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       dmaw_get_stripe_chan_limit
+*
+*   DESCRIPTION
+*
+*       Helper function to compute how many channels of a direction a list
+*       command may be striped on. When other DMA commands hold channels of
+*       the direction, or SQWs are waiting for one, a channel is left idle
+*       for them so a large command doesn't serialize the DMA traffic of the
+*       other SQs behind it. This trades some bandwidth of the large command
+*       for the latency of the others.
+*
+*   INPUTS
+*
+*       chan_cb         Channel control blocks of the direction
+*       chan_total      Number of channels of the direction
+*       chan_waiters    Pointer to number of SQWs waiting for a channel
+*
+*   OUTPUTS
+*
+*       uint8_t         Max number of channels, including the one already
+*                       reserved for the command
+*
+***********************************************************************/
+static inline uint8_t dmaw_get_stripe_chan_limit(
+    dma_channel_status_cb_t *chan_cb, uint8_t chan_total, uint32_t *chan_waiters)
+{
+    uint8_t idle_count = 0;
+
+    for (uint8_t ch = 0; ch < chan_total; ch++)
+    {
+        if (atomic_load_local_32(&chan_cb[ch].status.channel_state) == DMA_CHAN_STATE_IDLE)
+        {
+            idle_count++;
         }
-        else
+    }
+
+    /* The command holds one channel, any other busy channel belongs to another command */
+    if ((idle_count > 0) &&
+        (((idle_count + 1U) < chan_total) || (atomic_load_local_32(chan_waiters) > 0)))
+    {
+        idle_count--;
+    }
+
+    return (uint8_t)(idle_count + 1U);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       DMAW_Read_Reserve_Stripe_Chans
+*
+*   DESCRIPTION
+*
+*       Reserves additional idle DMA read channels to stripe a list command
+*       on. Only channels that are idle right now are taken, so striping
+*       never holds a command back waiting for a busy channel.
+*       One idle channel is left for the other commands when DMA read
+*       channels are contended.
+*
+*   INPUTS
+*
+*       chan_ids    Array of channel IDs, first entry holds the channel
+*                   already reserved for the command
+*       cmd_info    Pointer to command buffer
+*       xfer_count  Number of transfer nodes in command.
+*
+*   OUTPUTS
+*
+*       uint8_t     Number of channels reserved for the command
+*
+***********************************************************************/
+uint8_t DMAW_Read_Reserve_Stripe_Chans(
+    dma_read_chan_id_e *chan_ids, const struct cmd_header_t *cmd_info, uint8_t xfer_count)
+{
+    uint8_t stripe_count = dmaw_get_stripe_count(cmd_info, xfer_count,
+        dmaw_get_stripe_chan_limit(
+            DMAW_Read_CB.chan_status_cb, PCIE_DMA_RD_CHANNEL_COUNT, &DMAW_Read_CB.chan_waiters));
+    uint8_t chan_count = 1;
+
+    for (uint8_t ch = 0; (ch < PCIE_DMA_RD_CHANNEL_COUNT) && (chan_count < stripe_count); ch++)
+    {
+        /* Compare for idle state and reserve */
+        if (atomic_compare_and_exchange_local_32(
+                &DMAW_Read_CB.chan_status_cb[ch].status.channel_state, DMA_CHAN_STATE_IDLE,
+                DMA_CHAN_STATE_RESERVED) == DMA_CHAN_STATE_IDLE)
         {
-            const struct device_ops_p2pdma_writelist_cmd_t *p2p_dmalist_cmd =
-                (const struct device_ops_p2pdma_writelist_cmd_t *)cmd_info;
+            chan_ids[chan_count++] = ch;
+        }
+    }
+
+    return chan_count;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       DMAW_Write_Reserve_Stripe_Chans
+*
+*   DESCRIPTION
+*
+*       Reserves additional idle DMA write channels to stripe a list command
+*       on. Only channels that are idle right now are taken, so striping
+*       never holds a command back waiting for a busy channel.
+*       One idle channel is left for the other commands when DMA write
+*       channels are contended.
+*
+*   INPUTS
+*
+*       chan_ids    Array of channel IDs, first entry holds the channel
+*                   already reserved for the command
+*       cmd_info    Pointer to command buffer
+*       xfer_count  Number of transfer nodes in command.
+*
+*   OUTPUTS
+*
+*       uint8_t     Number of channels reserved for the command
+*
+***********************************************************************/
+uint8_t DMAW_Write_Reserve_Stripe_Chans(
+    dma_write_chan_id_e *chan_ids, const struct cmd_header_t *cmd_info, uint8_t xfer_count)
+{
+    uint8_t stripe_count = dmaw_get_stripe_count(cmd_info, xfer_count,
+        dmaw_get_stripe_chan_limit(
+            DMAW_Write_CB.chan_status_cb, PCIE_DMA_WRT_CHANNEL_COUNT, &DMAW_Write_CB.chan_waiters));
+    uint8_t chan_count = 1;
 
-            src_addr = p2p_dmalist_cmd->list[xfer_index].src_device_bus_addr;
-            dst_addr = p2p_dmalist_cmd->list[xfer_index].dst_device_phy_addr;
-            size = p2p_dmalist_cmd->list[xfer_index].size;
+    for (uint8_t ch = 0; (ch < PCIE_DMA_WRT_CHANNEL_COUNT) && (chan_count < stripe_count); ch++)
+    {
+        /* Compare for idle state and reserve */
+        if (atomic_compare_and_exchange_local_32(
+                &DMAW_Write_CB.chan_status_cb[ch].status.channel_state, DMA_CHAN_STATE_IDLE,
+                DMA_CHAN_STATE_RESERVED) == DMA_CHAN_STATE_IDLE)
+        {
+            chan_ids[chan_count++] = ch;
         }
+    }
 
-        /* Add DMA list data node for current transfer in the list.Enable completion interrupt for last transfer node. */
-        status = dma_config_read_add_data_node(src_addr, dst_addr, size, read_chan_id, xfer_index,
-            (xfer_index == last_i ? true : false));
+    return chan_count;
+}
 
-        transfer_size += size;
+/************************************************************************
+*
+*   FUNCTION
+*
+*       dmaw_read_config_stripe
+*
+*   DESCRIPTION
+*
+*       Helper function to build the transfer list of one stripe of a DMA
+*       read transaction. A list node crossing the stripe boundary is split
+*       between the two stripes.
+*
+*   INPUTS
+*
+*       read_chan_id    DMA channel ID
+*       cmd_info        Pointer to command buffer
+*       cursor          Position in the command list where the stripe starts,
+*                       advanced to where the next stripe starts
+*       stripe_size     Number of bytes in the stripe
+*       sqw_idx         SQW ID
+*
+*   OUTPUTS
+*
+*       int32_t          status success or error
+*
+***********************************************************************/
+static inline int32_t dmaw_read_config_stripe(dma_read_chan_id_e read_chan_id,
+    const struct cmd_header_t *cmd_info, dmaw_stripe_cursor_t *cursor, uint64_t stripe_size,
+    uint8_t sqw_idx)
+{
+    int32_t status = STATUS_SUCCESS;
+    uint32_t node_index = 0;
+
+    /* Configure DMA for all transfers of the stripe one-by-one. */
+    while ((stripe_size > 0) && (status == STATUS_SUCCESS))
+    {
+        uint64_t src_addr;
+        uint64_t dst_addr;
+        uint32_t size;
+        uint32_t node_size;
+
+        dmaw_get_xfer_node(cmd_info, cursor->xfer_index, &src_addr, &dst_addr, &size);
+        src_addr += cursor->xfer_offset;
+        dst_addr += cursor->xfer_offset;
+        node_size = size - cursor->xfer_offset;
+
+        if (node_size > stripe_size)
+        {
+            node_size = (uint32_t)stripe_size;
+        }
+        stripe_size -= node_size;
+
+        /* Add DMA list data node for current transfer in the stripe.
+        Enable completion interrupt for last transfer node. */
+        status = dma_config_read_add_data_node(
+            src_addr, dst_addr, node_size, read_chan_id, node_index, (stripe_size == 0));
 
         if (status == DMA_DRIVER_ERROR_INVALID_ADDRESS)
         {
@@ -362,13 +669,23 @@ int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e read_chan_id,
             status = DMAW_ERROR_DRIVER_DATA_CONFIG_FAILED;
         }
 
-        Log_Write(LOG_LEVEL_DEBUG, "DMAW_Read:Config:Added read data node No:%u\r\n", xfer_index);
+        Log_Write(LOG_LEVEL_DEBUG, "DMAW_Read:Config:Chan:%d:Added read data node No:%u\r\n",
+            read_chan_id, node_index);
+
+        /* Move to the next list node once this one is fully consumed */
+        node_index++;
+        cursor->xfer_offset += node_size;
+        if (cursor->xfer_offset == size)
+        {
+            cursor->xfer_index++;
+            cursor->xfer_offset = 0;
+        }
     }
 
     if (status == STATUS_SUCCESS)
     {
         /* Add DMA list link node at the end ot transfer list. */
-        status = dma_config_read_add_link_node(read_chan_id, xfer_count);
+        status = dma_config_read_add_link_node(read_chan_id, node_index);
 
         if (status != STATUS_SUCCESS)
         {
@@ -382,61 +699,6 @@ int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e read_chan_id,
             "DMAW_Read:Config:Added DMA red Link node at the end of list transfer.\r\n");
     }
 
-    if (status == STATUS_SUCCESS)
-    {
-        /* Start the DMA channel */
-        status = dma_start_read(read_chan_id);
-
-        if (status != STATUS_SUCCESS)
-        {
-            Log_Write(LOG_LEVEL_DEBUG, "SQ[%d]:Failed to started DMA read channel:Status:%d!\r\n",
-                sqw_idx, status);
-            status = DMAW_ERROR_DRIVER_CHAN_START_FAILED;
-        }
-    }
-
-    if (status == STATUS_SUCCESS)
-    {
-        /* Log the command state in trace */
-        TRACE_LOG_CMD_STATUS(
-            cmd_info->cmd_hdr.msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_EXECUTING)
-
-        /* Update cycles value into the Global Channel Status data structure */
-        atomic_store_local_64(
-            &DMAW_Read_CB.chan_status_cb[read_chan_id].dmaw_cycles.cmd_start_cycles,
-            cycles->cmd_start_cycles);
-        atomic_store_local_64(
-            &DMAW_Read_CB.chan_status_cb[read_chan_id].dmaw_cycles.exec_start_cycles,
-            cycles->exec_start_cycles);
-        atomic_store_local_64(&DMAW_Read_CB.chan_status_cb[read_chan_id].dmaw_cycles.wait_cycles,
-            cycles->wait_cycles);
-        atomic_store_local_64(
-            &DMAW_Read_CB.chan_status_cb[read_chan_id].transfer_size, transfer_size);
-
-        /* Update the global structure to make it visible to DMAW */
-        atomic_store_local_64(
-            &DMAW_Read_CB.chan_status_cb[read_chan_id].status.raw_u64, chan_status.raw_u64);
-
-        Log_Write(LOG_LEVEL_DEBUG, "SQ[%d]:DMAW_Read_Trigger_Transfer:Success!\r\n", sqw_idx);
-
-        status = STATUS_SUCCESS;
-    }
-    else
-    {
-        /* Release the DMA resources */
-        chan_status.tag_id = 0;
-        chan_status.sqw_idx = 0;
-        chan_status.channel_state = DMA_CHAN_STATE_IDLE;
-
-        atomic_store_local_64(
-            &DMAW_Read_CB.chan_status_cb[read_chan_id].status.raw_u64, chan_status.raw_u64);
-
-        Log_Write(LOG_LEVEL_ERROR, "SQ[%d]:TID:%u:DMAW Read Config Failed:%d!\r\n", sqw_idx,
-            cmd_info->cmd_hdr.tag_id, status);
-
-        SP_Iface_Report_Error(MM_RECOVERABLE_FW_MM_DMAW_ERROR, MM_DMA_WRITE_CONFIG_ERROR);
-    }
-
     return status;
 }
 
@@ -444,20 +706,22 @@ int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e read_chan_id,
 *
 *   FUNCTION
 *
-*       DMAW_Write_Trigger_Transfer
+*       dmaw_write_config_stripe
 *
 *   DESCRIPTION
 *
-*       This function is used to trigger a DMA write transaction by calling
-*       the PCIe device driver routine.
+*       Helper function to build the transfer list of one stripe of a DMA
+*       write transaction. A list node crossing the stripe boundary is split
+*       between the two stripes.
 *
 *   INPUTS
 *
 *       write_chan_id   DMA channel ID
 *       cmd_info        Pointer to command buffer
-*       xfer_count      Number of transfer nodes in command.
+*       cursor          Position in the command list where the stripe starts,
+*                       advanced to where the next stripe starts
+*       stripe_size     Number of bytes in the stripe
 *       sqw_idx         SQW ID
-*       cycles          Pointer to latency cycles struct
 *       flags           DMA flag to set a specific DMA action.
 *
 *   OUTPUTS
@@ -465,57 +729,36 @@ int32_t DMAW_Read_Trigger_Transfer(dma_read_chan_id_e read_chan_id,
 *       int32_t          status success or error
 *
 ***********************************************************************/
-int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e write_chan_id,
-    const struct cmd_header_t *cmd_info, uint8_t xfer_count, uint8_t sqw_idx,
-    const execution_cycles_t *cycles, dma_flags_e flags)
+static inline int32_t dmaw_write_config_stripe(dma_write_chan_id_e write_chan_id,
+    const struct cmd_header_t *cmd_info, dmaw_stripe_cursor_t *cursor, uint64_t stripe_size,
+    uint8_t sqw_idx, dma_flags_e flags)
 {
-    uint64_t transfer_size = 0;
     int32_t status = STATUS_SUCCESS;
-    dma_channel_status_t chan_status;
+    uint32_t node_index = 0;
 
-    /* Set tag ID, set channel state to active, set SQW Index */
-    chan_status.tag_id = cmd_info->cmd_hdr.tag_id;
-    chan_status.sqw_idx = sqw_idx;
-    chan_status.channel_state = DMA_CHAN_STATE_IN_USE;
-    atomic_store_local_16(&DMAW_Write_CB.chan_status_cb[write_chan_id].rsp_id,
-        (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_CMD) ?
-            DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_RSP :
-            DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_READLIST_RSP);
-
-    /* To start indexing from zero, decrement the count by one. */
-    uint8_t last_i = (uint8_t)(xfer_count - 1);
-
-    /* Configure DMA for all transfers one-by-one. */
-    for (uint8_t xfer_index = 0; (xfer_index <= last_i) && (status == STATUS_SUCCESS); ++xfer_index)
+    /* Configure DMA for all transfers of the stripe one-by-one. */
+    while ((stripe_size > 0) && (status == STATUS_SUCCESS))
     {
         uint64_t src_addr;
         uint64_t dst_addr;
         uint32_t size;
+        uint32_t node_size;
 
-        if (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_CMD)
-        {
-            const struct device_ops_dma_readlist_cmd_t *dmalist_cmd =
-                (const struct device_ops_dma_readlist_cmd_t *)cmd_info;
+        dmaw_get_xfer_node(cmd_info, cursor->xfer_index, &src_addr, &dst_addr, &size);
+        src_addr += cursor->xfer_offset;
+        dst_addr += cursor->xfer_offset;
+        node_size = size - cursor->xfer_offset;
 
-            src_addr = dmalist_cmd->list[xfer_index].src_device_phy_addr;
-            dst_addr = dmalist_cmd->list[xfer_index].dst_host_phy_addr;
-            size = dmalist_cmd->list[xfer_index].size;
-        }
-        else
+        if (node_size > stripe_size)
         {
-            const struct device_ops_p2pdma_readlist_cmd_t *p2p_dmalist_cmd =
-                (const struct device_ops_p2pdma_readlist_cmd_t *)cmd_info;
-
-            src_addr = p2p_dmalist_cmd->list[xfer_index].src_device_phy_addr;
-            dst_addr = p2p_dmalist_cmd->list[xfer_index].dst_device_bus_addr;
-            size = p2p_dmalist_cmd->list[xfer_index].size;
+            node_size = (uint32_t)stripe_size;
         }
+        stripe_size -= node_size;
 
-        /* Add DMA list data node for current transfer in the list. Enable completion interrupt for last transfer node.*/
-        status = dma_config_write_add_data_node(src_addr, dst_addr, size, write_chan_id, xfer_index,
-            flags, (xfer_index == last_i ? true : false));
-
-        transfer_size += size;
+        /* Add DMA list data node for current transfer in the stripe.
+        Enable completion interrupt for last transfer node. */
+        status = dma_config_write_add_data_node(
+            src_addr, dst_addr, node_size, write_chan_id, node_index, flags, (stripe_size == 0));
 
         if (status == DMA_DRIVER_ERROR_INVALID_ADDRESS)
         {
@@ -532,13 +775,23 @@ int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e write_chan_id,
             status = DMAW_ERROR_DRIVER_DATA_CONFIG_FAILED;
         }
 
-        Log_Write(LOG_LEVEL_DEBUG, "DMAW_Write:Config:Added write data node No:%u\r\n", xfer_index);
+        Log_Write(LOG_LEVEL_DEBUG, "DMAW_Write:Config:Chan:%d:Added write data node No:%u\r\n",
+            write_chan_id, node_index);
+
+        /* Move to the next list node once this one is fully consumed */
+        node_index++;
+        cursor->xfer_offset += node_size;
+        if (cursor->xfer_offset == size)
+        {
+            cursor->xfer_index++;
+            cursor->xfer_offset = 0;
+        }
     }
 
     if (status == STATUS_SUCCESS)
     {
         /* Add DMA list link node at the end ot transfer list. */
-        status = dma_config_write_add_link_node(write_chan_id, xfer_count);
+        status = dma_config_write_add_link_node(write_chan_id, node_index);
 
         if (status != STATUS_SUCCESS)
         {
@@ -552,17 +805,88 @@ int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e write_chan_id,
             "DMAW:Config:Added DMA write Link node at the end of list transfer.\r\n");
     }
 
-    if (status == STATUS_SUCCESS)
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       DMAW_Read_Trigger_Transfer
+*
+*   DESCRIPTION
+*
+*       This function is used to trigger a DMA Read transaction by calling
+*       the PCIe device driver routine. The transaction is split in equally
+*       sized stripes, one per reserved channel. All stripes are configured
+*       before any channel is started, and the channels are handed over to
+*       DMAW only once all of them are running.
+*
+*   INPUTS
+*
+*       read_chan_ids   Reserved DMA channel IDs
+*       chan_count      Number of reserved DMA channels
+*       cmd_info        Pointer to command buffer
+*       xfer_count      Number of transfer nodes in command.
+*       sqw_idx         SQW ID
+*       cycles          Pointer to latency cycles struct
+*
+*   OUTPUTS
+*
+*       int32_t          status success or error
+*
+***********************************************************************/
+int32_t DMAW_Read_Trigger_Transfer(const dma_read_chan_id_e *read_chan_ids, uint8_t chan_count,
+    const struct cmd_header_t *cmd_info, uint8_t xfer_count, uint8_t sqw_idx,
+    const execution_cycles_t *cycles)
+{
+    dmaw_stripe_cursor_t cursor = { .xfer_index = 0, .xfer_offset = 0 };
+    uint64_t transfer_size = dmaw_get_transfer_size(cmd_info, xfer_count);
+    uint64_t stripe_size = DMAW_GET_STRIPE_SIZE(transfer_size, chan_count);
+    dma_read_chan_id_e leader_chan_id = read_chan_ids[0];
+    int32_t status = STATUS_SUCCESS;
+    dma_channel_status_t chan_status;
+    uint8_t started_count = 0;
+    uint8_t stripe_mask = 0;
+    uint16_t rsp_id = (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD) ?
+                          DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_RSP :
+                          DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_WRITELIST_RSP;
+
+    /* Configure the transfer list of every stripe. Last stripe takes the remainder. */
+    for (uint8_t stripe = 0; (stripe < chan_count) && (status == STATUS_SUCCESS); stripe++)
     {
-        /* Start the DMA channel */
-        status = dma_start_write(write_chan_id);
+        dma_read_chan_id_e read_chan_id = read_chan_ids[stripe];
+        uint64_t size = (stripe == (chan_count - 1)) ? transfer_size : stripe_size;
 
-        if (status != STATUS_SUCCESS)
+        status = dmaw_read_config_stripe(read_chan_id, cmd_info, &cursor, size, sqw_idx);
+        transfer_size -= size;
+
+        atomic_store_local_64(&DMAW_Read_CB.chan_status_cb[read_chan_id].transfer_size, size);
+        atomic_store_local_16(&DMAW_Read_CB.chan_status_cb[read_chan_id].rsp_id, rsp_id);
+        atomic_store_local_8(
+            &DMAW_Read_CB.chan_status_cb[read_chan_id].stripe_leader, leader_chan_id);
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        /* Start the DMA channels */
+        for (; started_count < chan_count; started_count++)
         {
-            Log_Write(LOG_LEVEL_DEBUG, "SQ[%d]:Failed to started DMA write channel:Status:%d!\r\n",
-                sqw_idx, status);
-            status = DMAW_ERROR_DRIVER_CHAN_START_FAILED;
+            status = dma_start_read(read_chan_ids[started_count]);
+
+            if (status != STATUS_SUCCESS)
+            {
+                Log_Write(LOG_LEVEL_DEBUG,
+                    "SQ[%d]:Failed to started DMA read channel %d:Status:%d!\r\n", sqw_idx,
+                    read_chan_ids[started_count], status);
+                break;
+            }
+            stripe_mask = (uint8_t)(stripe_mask | (1U << read_chan_ids[started_count]));
         }
+
+        /* The command fails only if none of its stripes could be started. Otherwise
+        it completes with the running stripes and reports the failure in its response. */
+        status = (started_count > 0) ? STATUS_SUCCESS : DMAW_ERROR_DRIVER_CHAN_START_FAILED;
     }
 
     if (status == STATUS_SUCCESS)
@@ -571,25 +895,193 @@ int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e write_chan_id,
         TRACE_LOG_CMD_STATUS(
             cmd_info->cmd_hdr.msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_EXECUTING)
 
-        /* Update cycles value into the Global Channel Status data structure */
-        atomic_store_local_64(
-            &DMAW_Write_CB.chan_status_cb[write_chan_id].dmaw_cycles.cmd_start_cycles,
-            cycles->cmd_start_cycles);
-        atomic_store_local_64(
-            &DMAW_Write_CB.chan_status_cb[write_chan_id].dmaw_cycles.exec_start_cycles,
-            cycles->exec_start_cycles);
-        atomic_store_local_64(&DMAW_Write_CB.chan_status_cb[write_chan_id].dmaw_cycles.wait_cycles,
-            cycles->wait_cycles);
-        atomic_store_local_64(
-            &DMAW_Write_CB.chan_status_cb[write_chan_id].transfer_size, transfer_size);
+        /* Update the stripe bookkeeping before any stripe is visible to DMAW */
+        atomic_store_local_32(&DMAW_Read_CB.chan_status_cb[leader_chan_id].stripe_status,
+            (started_count == chan_count) ? DEV_OPS_API_DMA_RESPONSE_COMPLETE :
+                                            DEV_OPS_API_DMA_RESPONSE_DRIVER_CHAN_START_FAILED);
+        atomic_store_local_8(&DMAW_Read_CB.chan_status_cb[leader_chan_id].stripe_mask, stripe_mask);
+        atomic_store_local_32(
+            &DMAW_Read_CB.chan_status_cb[leader_chan_id].stripes_pending, started_count);
+
+        for (uint8_t stripe = 0; stripe < chan_count; stripe++)
+        {
+            dma_read_chan_id_e read_chan_id = read_chan_ids[stripe];
+
+            /* Set tag ID, set channel state to active, set SQW Index.
+            Channels that could not be started are released. */
+            chan_status.tag_id = (stripe < started_count) ? cmd_info->cmd_hdr.tag_id : 0;
+            chan_status.sqw_idx = (stripe < started_count) ? sqw_idx : 0;
+            chan_status.channel_state =
+                (stripe < started_count) ? DMA_CHAN_STATE_IN_USE : DMA_CHAN_STATE_IDLE;
+
+            /* Update cycles value into the Global Channel Status data structure */
+            atomic_store_local_64(
+                &DMAW_Read_CB.chan_status_cb[read_chan_id].dmaw_cycles.cmd_start_cycles,
+                cycles->cmd_start_cycles);
+            atomic_store_local_64(
+                &DMAW_Read_CB.chan_status_cb[read_chan_id].dmaw_cycles.exec_start_cycles,
+                cycles->exec_start_cycles);
+            atomic_store_local_64(
+                &DMAW_Read_CB.chan_status_cb[read_chan_id].dmaw_cycles.wait_cycles,
+                cycles->wait_cycles);
+
+            /* Update the global structure to make it visible to DMAW */
+            atomic_store_local_64(
+                &DMAW_Read_CB.chan_status_cb[read_chan_id].status.raw_u64, chan_status.raw_u64);
+        }
 
-        /* Update the global structure to make it visible to DMAW */
-        atomic_store_local_64(
-            &DMAW_Write_CB.chan_status_cb[write_chan_id].status.raw_u64, chan_status.raw_u64);
+        Log_Write(LOG_LEVEL_DEBUG, "SQ[%d]:DMAW_Read_Trigger_Transfer:Success:Stripes:%d!\r\n",
+            sqw_idx, started_count);
+    }
+    else
+    {
+        /* Release the DMA resources */
+        chan_status.tag_id = 0;
+        chan_status.sqw_idx = 0;
+        chan_status.channel_state = DMA_CHAN_STATE_IDLE;
 
-        Log_Write(LOG_LEVEL_DEBUG, "SQ[%d]:DMAW_Write_Trigger_Transfer:Success!\r\n", sqw_idx);
+        for (uint8_t stripe = 0; stripe < chan_count; stripe++)
+        {
+            atomic_store_local_64(
+                &DMAW_Read_CB.chan_status_cb[read_chan_ids[stripe]].status.raw_u64,
+                chan_status.raw_u64);
+        }
 
-        status = STATUS_SUCCESS;
+        Log_Write(LOG_LEVEL_ERROR, "SQ[%d]:TID:%u:DMAW Read Config Failed:%d!\r\n", sqw_idx,
+            cmd_info->cmd_hdr.tag_id, status);
+
+        SP_Iface_Report_Error(MM_RECOVERABLE_FW_MM_DMAW_ERROR, MM_DMA_WRITE_CONFIG_ERROR);
+    }
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       DMAW_Write_Trigger_Transfer
+*
+*   DESCRIPTION
+*
+*       This function is used to trigger a DMA write transaction by calling
+*       the PCIe device driver routine. The transaction is split in equally
+*       sized stripes, one per reserved channel. All stripes are configured
+*       before any channel is started, and the channels are handed over to
+*       DMAW only once all of them are running.
+*
+*   INPUTS
+*
+*       write_chan_ids  Reserved DMA channel IDs
+*       chan_count      Number of reserved DMA channels
+*       cmd_info        Pointer to command buffer
+*       xfer_count      Number of transfer nodes in command.
+*       sqw_idx         SQW ID
+*       cycles          Pointer to latency cycles struct
+*       flags           DMA flag to set a specific DMA action.
+*
+*   OUTPUTS
+*
+*       int32_t          status success or error
+*
+***********************************************************************/
+int32_t DMAW_Write_Trigger_Transfer(const dma_write_chan_id_e *write_chan_ids, uint8_t chan_count,
+    const struct cmd_header_t *cmd_info, uint8_t xfer_count, uint8_t sqw_idx,
+    const execution_cycles_t *cycles, dma_flags_e flags)
+{
+    dmaw_stripe_cursor_t cursor = { .xfer_index = 0, .xfer_offset = 0 };
+    uint64_t transfer_size = dmaw_get_transfer_size(cmd_info, xfer_count);
+    uint64_t stripe_size = DMAW_GET_STRIPE_SIZE(transfer_size, chan_count);
+    dma_write_chan_id_e leader_chan_id = write_chan_ids[0];
+    int32_t status = STATUS_SUCCESS;
+    dma_channel_status_t chan_status;
+    uint8_t started_count = 0;
+    uint8_t stripe_mask = 0;
+    uint16_t rsp_id = (cmd_info->cmd_hdr.msg_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_CMD) ?
+                          DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_RSP :
+                          DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_READLIST_RSP;
+
+    /* Configure the transfer list of every stripe. Last stripe takes the remainder. */
+    for (uint8_t stripe = 0; (stripe < chan_count) && (status == STATUS_SUCCESS); stripe++)
+    {
+        dma_write_chan_id_e write_chan_id = write_chan_ids[stripe];
+        uint64_t size = (stripe == (chan_count - 1)) ? transfer_size : stripe_size;
+
+        status = dmaw_write_config_stripe(write_chan_id, cmd_info, &cursor, size, sqw_idx, flags);
+        transfer_size -= size;
+
+        atomic_store_local_64(&DMAW_Write_CB.chan_status_cb[write_chan_id].transfer_size, size);
+        atomic_store_local_16(&DMAW_Write_CB.chan_status_cb[write_chan_id].rsp_id, rsp_id);
+        atomic_store_local_8(
+            &DMAW_Write_CB.chan_status_cb[write_chan_id].stripe_leader, leader_chan_id);
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        /* Start the DMA channels */
+        for (; started_count < chan_count; started_count++)
+        {
+            status = dma_start_write(write_chan_ids[started_count]);
+
+            if (status != STATUS_SUCCESS)
+            {
+                Log_Write(LOG_LEVEL_DEBUG,
+                    "SQ[%d]:Failed to started DMA write channel %d:Status:%d!\r\n", sqw_idx,
+                    write_chan_ids[started_count], status);
+                break;
+            }
+            stripe_mask = (uint8_t)(stripe_mask | (1U << write_chan_ids[started_count]));
+        }
+
+        /* The command fails only if none of its stripes could be started. Otherwise
+        it completes with the running stripes and reports the failure in its response. */
+        status = (started_count > 0) ? STATUS_SUCCESS : DMAW_ERROR_DRIVER_CHAN_START_FAILED;
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        /* Log the command state in trace */
+        TRACE_LOG_CMD_STATUS(
+            cmd_info->cmd_hdr.msg_id, sqw_idx, cmd_info->cmd_hdr.tag_id, CMD_STATUS_EXECUTING)
+
+        /* Update the stripe bookkeeping before any stripe is visible to DMAW */
+        atomic_store_local_32(&DMAW_Write_CB.chan_status_cb[leader_chan_id].stripe_status,
+            (started_count == chan_count) ? DEV_OPS_API_DMA_RESPONSE_COMPLETE :
+                                            DEV_OPS_API_DMA_RESPONSE_DRIVER_CHAN_START_FAILED);
+        atomic_store_local_8(
+            &DMAW_Write_CB.chan_status_cb[leader_chan_id].stripe_mask, stripe_mask);
+        atomic_store_local_32(
+            &DMAW_Write_CB.chan_status_cb[leader_chan_id].stripes_pending, started_count);
+
+        for (uint8_t stripe = 0; stripe < chan_count; stripe++)
+        {
+            dma_write_chan_id_e write_chan_id = write_chan_ids[stripe];
+
+            /* Set tag ID, set channel state to active, set SQW Index.
+            Channels that could not be started are released. */
+            chan_status.tag_id = (stripe < started_count) ? cmd_info->cmd_hdr.tag_id : 0;
+            chan_status.sqw_idx = (stripe < started_count) ? sqw_idx : 0;
+            chan_status.channel_state =
+                (stripe < started_count) ? DMA_CHAN_STATE_IN_USE : DMA_CHAN_STATE_IDLE;
+
+            /* Update cycles value into the Global Channel Status data structure */
+            atomic_store_local_64(
+                &DMAW_Write_CB.chan_status_cb[write_chan_id].dmaw_cycles.cmd_start_cycles,
+                cycles->cmd_start_cycles);
+            atomic_store_local_64(
+                &DMAW_Write_CB.chan_status_cb[write_chan_id].dmaw_cycles.exec_start_cycles,
+                cycles->exec_start_cycles);
+            atomic_store_local_64(
+                &DMAW_Write_CB.chan_status_cb[write_chan_id].dmaw_cycles.wait_cycles,
+                cycles->wait_cycles);
+
+            /* Update the global structure to make it visible to DMAW */
+            atomic_store_local_64(
+                &DMAW_Write_CB.chan_status_cb[write_chan_id].status.raw_u64, chan_status.raw_u64);
+        }
+
+        Log_Write(LOG_LEVEL_DEBUG, "SQ[%d]:DMAW_Write_Trigger_Transfer:Success:Stripes:%d!\r\n",
+            sqw_idx, started_count);
     }
     else
     {
@@ -598,8 +1090,12 @@ int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e write_chan_id,
         chan_status.sqw_idx = 0;
         chan_status.channel_state = DMA_CHAN_STATE_IDLE;
 
-        atomic_store_local_64(
-            &DMAW_Write_CB.chan_status_cb[write_chan_id].status.raw_u64, chan_status.raw_u64);
+        for (uint8_t stripe = 0; stripe < chan_count; stripe++)
+        {
+            atomic_store_local_64(
+                &DMAW_Write_CB.chan_status_cb[write_chan_ids[stripe]].status.raw_u64,
+                chan_status.raw_u64);
+        }
 
         Log_Write(LOG_LEVEL_ERROR, "SQ[%d]:TID:%u:DMAW Write Config Failed:%d!\r\n", sqw_idx,
             cmd_info->cmd_hdr.tag_id, status);
@@ -610,6 +1106,71 @@ int32_t DMAW_Write_Trigger_Transfer(dma_write_chan_id_e write_chan_id,
     return status;
 }
 
+/************************************************************************
+*
+*   FUNCTION
+*
+*       dmaw_stripe_done
+*
+*   DESCRIPTION
+*
+*       Helper function to account a completed stripe of a DMA command.
+*       The channel of a stripe that is not the last one of its command is
+*       parked until the command completes. The last stripe releases all
+*       the channels of the command.
+*
+*   INPUTS
+*
+*       chan_cb         Pointer to the channel status CBs
+*       chan_count      Number of channels in chan_cb
+*       chan            DMA channel ID of the completed stripe
+*       rsp_status      Pointer to status of the stripe, updated with the
+*                       status of the whole command
+*       transfer_size   Pointer to populate with the command transfer size
+*
+*   OUTPUTS
+*
+*       bool            true if all the stripes of the command are done
+*
+***********************************************************************/
+static inline bool dmaw_stripe_done(dma_channel_status_cb_t *chan_cb, uint8_t chan_count,
+    uint8_t chan, uint32_t *rsp_status, uint64_t *transfer_size)
+{
+    uint8_t leader = atomic_load_local_8(&chan_cb[chan].stripe_leader);
+    uint8_t stripe_mask;
+
+    /* Keep the first error reported by any of the stripes */
+    if (*rsp_status != DEV_OPS_API_DMA_RESPONSE_COMPLETE)
+    {
+        atomic_compare_and_exchange_local_32(
+            &chan_cb[leader].stripe_status, DEV_OPS_API_DMA_RESPONSE_COMPLETE, *rsp_status);
+    }
+
+    /* Park the channel until the remaining stripes are done */
+    if (atomic_add_local_32(&chan_cb[leader].stripes_pending, (uint32_t)-1) != 1U)
+    {
+        atomic_store_local_32(&chan_cb[chan].status.channel_state, DMA_CHAN_STATE_STRIPE_DONE);
+        return false;
+    }
+
+    *rsp_status = atomic_load_local_32(&chan_cb[leader].stripe_status);
+    stripe_mask = atomic_load_local_8(&chan_cb[leader].stripe_mask);
+    *transfer_size = 0;
+
+    /* Update global DMA channel status of all stripes
+    NOTE: Channel state must be made idle once all resources are read */
+    for (uint8_t ch = 0; ch < chan_count; ch++)
+    {
+        if (stripe_mask & (1U << ch))
+        {
+            *transfer_size += atomic_load_local_64(&chan_cb[ch].transfer_size);
+            atomic_store_local_32(&chan_cb[ch].status.channel_state, DMA_CHAN_STATE_IDLE);
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************
 *
 *   FUNCTION
@@ -689,10 +1250,26 @@ static inline void process_dma_read_chan_in_use(dma_read_chan_id_e read_chan)
         /* Read the response ID */
         uint16_t rsp_id = atomic_load_local_16(&DMAW_Read_CB.chan_status_cb[read_chan].rsp_id);
 
-        /* Update global DMA channel status
-        NOTE: Channel state must be made idle once all resources are read */
-        atomic_store_local_32(
-            &DMAW_Read_CB.chan_status_cb[read_chan].status.channel_state, DMA_CHAN_STATE_IDLE);
+        /* Compute stripe execution latency */
+        exec_duration = PMC_GET_LATENCY(dma_rd_cycles.exec_start_cycles);
+
+        /* Accumulate DMA execution cycles. Any previous exceution cycles will be
+        deducted from total transaction cycles and previous execution cycles will be reset. */
+        atomic_add_local_64(
+            &DMAW_Read_CB.chan_status_cb[read_chan].dma_trans_cycles, exec_duration);
+
+        /* Update the per channel utilization counters */
+        STATW_Add_DMA_Chan_Sample(
+            STATW_RESOURCE_DMA_WRITE, read_chan, transfer_size, exec_duration);
+
+        /* Only the last stripe of the command releases the channels and responds */
+        if (!dmaw_stripe_done(DMAW_Read_CB.chan_status_cb, PCIE_DMA_RD_CHANNEL_COUNT, read_chan,
+                &rsp_status, &transfer_size))
+        {
+            Log_Write(LOG_LEVEL_DEBUG, "DMAW:Tag_ID=%u:Read stripe done on chan %d\r\n",
+                read_chan_status.tag_id, read_chan);
+            return;
+        }
 
         /* Decrement the commands count being processed by the
         given SQW. Should be done after clearing channel state */
@@ -710,15 +1287,13 @@ static inline void process_dma_read_chan_in_use(dma_read_chan_id_e read_chan)
             writelist_rsp.response_info.rsp_hdr.msg_id = rsp_id;
             writelist_rsp.device_cmd_start_ts = dma_rd_cycles.cmd_start_cycles;
             writelist_rsp.device_cmd_wait_dur = dma_rd_cycles.wait_cycles;
-            /* Compute command execution latency */
-            exec_duration = PMC_GET_LATENCY(dma_rd_cycles.exec_start_cycles);
             writelist_rsp.device_cmd_execute_dur = exec_duration;
 
             Log_Write(LOG_LEVEL_DEBUG, "DMAW:Pushing:DMA_WRITELIST_CMD_RSP:tag_id=%x->Host_CQ\r\n",
                 writelist_rsp.response_info.rsp_hdr.tag_id);
 
-            status = Host_Iface_CQ_Push_Cmd(
-                0, &writelist_rsp, sizeof(struct device_ops_dma_writelist_rsp_t));
+            status = Host_Iface_CQ_Push_Completion(0, read_chan_status.sqw_idx, &writelist_rsp,
+                sizeof(struct device_ops_dma_writelist_rsp_t));
         }
         else
         {
@@ -732,23 +1307,16 @@ static inline void process_dma_read_chan_in_use(dma_read_chan_id_e read_chan)
             p2p_writelist_rsp.response_info.rsp_hdr.msg_id = rsp_id;
             p2p_writelist_rsp.device_cmd_start_ts = dma_rd_cycles.cmd_start_cycles;
             p2p_writelist_rsp.device_cmd_wait_dur = dma_rd_cycles.wait_cycles;
-            /* Compute command execution latency */
-            exec_duration = PMC_GET_LATENCY(dma_rd_cycles.exec_start_cycles);
             p2p_writelist_rsp.device_cmd_execute_dur = exec_duration;
 
             Log_Write(LOG_LEVEL_DEBUG,
                 "DMAW:Pushing:P2PDMA_WRITELIST_CMD_RSP:tag_id=%x->Host_CQ\r\n",
                 p2p_writelist_rsp.response_info.rsp_hdr.tag_id);
 
-            status = Host_Iface_CQ_Push_Cmd(
-                0, &p2p_writelist_rsp, sizeof(struct device_ops_p2pdma_writelist_rsp_t));
+            status = Host_Iface_CQ_Push_Completion(0, read_chan_status.sqw_idx, &p2p_writelist_rsp,
+                sizeof(struct device_ops_p2pdma_writelist_rsp_t));
         }
 
-        /* Accumulate DMA execution cycles. Any previous exceution cycles will be
-        deducted from total transaction cycles and previous execution cycles will be reset. */
-        atomic_add_local_64(
-            &DMAW_Read_CB.chan_status_cb[read_chan].dma_trans_cycles, exec_duration);
-
         /* Calculate and log the DMA BW */
         STATW_Add_New_Sample_Atomically(
             STATW_RESOURCE_DMA_WRITE, DMAW_BYTES_PER_CYCLE_TO_MBPS(transfer_size, exec_duration));
@@ -877,15 +1445,6 @@ static inline void process_dma_read_chan_aborting(
     /* Read the response ID */
     uint16_t rsp_id = atomic_load_local_16(&DMAW_Read_CB.chan_status_cb[read_chan].rsp_id);
 
-    /* Update global DMA channel status
-    NOTE: Channel state must be made idle once all resources are read */
-    atomic_store_local_32(
-        &DMAW_Read_CB.chan_status_cb[read_chan].status.channel_state, DMA_CHAN_STATE_IDLE);
-
-    /* Decrement the commands count being processed by the
-    given SQW. Should be done after clearing channel state */
-    SQW_Decrement_Command_Count(read_chan_status.sqw_idx);
-
     if (status == DMAW_ERROR_DRIVER_ABORT_FAILED)
     {
         abort_rsp_status = DEV_OPS_API_DMA_RESPONSE_DRIVER_ABORT_FAILED;
@@ -895,6 +1454,31 @@ static inline void process_dma_read_chan_aborting(
         abort_rsp_status = DEV_OPS_API_DMA_RESPONSE_HOST_ABORTED;
     }
 
+    /* Compute stripe execution latency */
+    abort_exec_duration = PMC_GET_LATENCY(dma_read_cycles.exec_start_cycles);
+
+    /* Accumulate DMA execution cycles. Any previous exceution cycles will be
+    deducted from total transaction cycles and previous execution cycles will be reset. */
+    atomic_add_local_64(
+        &DMAW_Read_CB.chan_status_cb[read_chan].dma_trans_cycles, abort_exec_duration);
+
+    /* Update the per channel utilization counters */
+    STATW_Add_DMA_Chan_Sample(
+        STATW_RESOURCE_DMA_WRITE, read_chan, abort_transfer_size, abort_exec_duration);
+
+    /* Only the last stripe of the command releases the channels and responds */
+    if (!dmaw_stripe_done(DMAW_Read_CB.chan_status_cb, PCIE_DMA_RD_CHANNEL_COUNT, read_chan,
+            &abort_rsp_status, &abort_transfer_size))
+    {
+        Log_Write(LOG_LEVEL_DEBUG, "DMAW:Tag_ID=%u:Read stripe done on chan %d\r\n",
+            read_chan_status.tag_id, read_chan);
+        return;
+    }
+
+    /* Decrement the commands count being processed by the
+    given SQW. Should be done after clearing channel state */
+    SQW_Decrement_Command_Count(read_chan_status.sqw_idx);
+
     if (rsp_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_RSP)
     {
         struct device_ops_dma_writelist_rsp_t abort_writelist_rsp;
@@ -907,8 +1491,6 @@ static inline void process_dma_read_chan_aborting(
         abort_writelist_rsp.response_info.rsp_hdr.msg_id = rsp_id;
         abort_writelist_rsp.device_cmd_start_ts = dma_read_cycles.cmd_start_cycles;
         abort_writelist_rsp.device_cmd_wait_dur = dma_read_cycles.wait_cycles;
-        /* Compute command execution latency */
-        abort_exec_duration = PMC_GET_LATENCY(dma_read_cycles.exec_start_cycles);
         abort_writelist_rsp.device_cmd_execute_dur = abort_exec_duration;
 
         status = Host_Iface_CQ_Push_Cmd(
@@ -926,19 +1508,12 @@ static inline void process_dma_read_chan_aborting(
         abort_p2p_rsp.response_info.rsp_hdr.msg_id = rsp_id;
         abort_p2p_rsp.device_cmd_start_ts = dma_read_cycles.cmd_start_cycles;
         abort_p2p_rsp.device_cmd_wait_dur = dma_read_cycles.wait_cycles;
-        /* Compute command execution latency */
-        abort_exec_duration = PMC_GET_LATENCY(dma_read_cycles.exec_start_cycles);
         abort_p2p_rsp.device_cmd_execute_dur = abort_exec_duration;
 
         status = Host_Iface_CQ_Push_Cmd(
             0, &abort_p2p_rsp, sizeof(struct device_ops_p2pdma_writelist_rsp_t));
     }
 
-    /* Accumulate DMA execution cycles. Any previous exceution cycles will be
-    deducted from total transaction cycles and previous execution cycles will be reset. */
-    atomic_add_local_64(
-        &DMAW_Read_CB.chan_status_cb[read_chan].dma_trans_cycles, abort_exec_duration);
-
     /* Calculate and log the DMA BW */
     /* TODO: In case of abort, read the actual number of bytes transferred from DMA engine instead of total transfer size */
     STATW_Add_New_Sample_Atomically(STATW_RESOURCE_DMA_WRITE,
@@ -1046,10 +1621,26 @@ static inline void process_dma_write_chan_in_use(dma_write_chan_id_e write_chan)
         /* Read the response ID */
         uint16_t rsp_id = atomic_load_local_16(&DMAW_Write_CB.chan_status_cb[write_chan].rsp_id);
 
-        /* Update global DMA channel status
-        NOTE: Channel state must be made idle once all resources are read */
-        atomic_store_local_32(
-            &DMAW_Write_CB.chan_status_cb[write_chan].status.channel_state, DMA_CHAN_STATE_IDLE);
+        /* Compute stripe execution latency */
+        exec_duration = PMC_GET_LATENCY(dma_write_cycles.exec_start_cycles);
+
+        /* Accumulate DMA execution cycles. Any previous exceution cycles will be
+        deducted from total transaction cycles and previous execution cycles will be reset. */
+        atomic_add_local_64(
+            &DMAW_Write_CB.chan_status_cb[write_chan].dma_trans_cycles, exec_duration);
+
+        /* Update the per channel utilization counters */
+        STATW_Add_DMA_Chan_Sample(
+            STATW_RESOURCE_DMA_READ, write_chan, transfer_size, exec_duration);
+
+        /* Only the last stripe of the command releases the channels and responds */
+        if (!dmaw_stripe_done(DMAW_Write_CB.chan_status_cb, PCIE_DMA_WRT_CHANNEL_COUNT,
+                write_chan, &rsp_status, &transfer_size))
+        {
+            Log_Write(LOG_LEVEL_DEBUG, "DMAW:Tag_ID=%u:Write stripe done on chan %d\r\n",
+                write_chan_status.tag_id, write_chan);
+            return;
+        }
 
         /* Decrement the commands count being processed by the
         given SQW. Should be done after clearing channel state */
@@ -1067,12 +1658,10 @@ static inline void process_dma_write_chan_in_use(dma_write_chan_id_e write_chan)
             readlist_rsp.response_info.rsp_hdr.msg_id = rsp_id;
             readlist_rsp.device_cmd_start_ts = dma_write_cycles.cmd_start_cycles;
             readlist_rsp.device_cmd_wait_dur = dma_write_cycles.wait_cycles;
-            /* Compute command execution latency */
-            exec_duration = PMC_GET_LATENCY(dma_write_cycles.exec_start_cycles);
             readlist_rsp.device_cmd_execute_dur = exec_duration;
 
-            status = Host_Iface_CQ_Push_Cmd(
-                0, &readlist_rsp, sizeof(struct device_ops_dma_readlist_rsp_t));
+            status = Host_Iface_CQ_Push_Completion(0, write_chan_status.sqw_idx, &readlist_rsp,
+                sizeof(struct device_ops_dma_readlist_rsp_t));
         }
         else
         {
@@ -1086,19 +1675,12 @@ static inline void process_dma_write_chan_in_use(dma_write_chan_id_e write_chan)
             p2p_readlist_rsp.response_info.rsp_hdr.msg_id = rsp_id;
             p2p_readlist_rsp.device_cmd_start_ts = dma_write_cycles.cmd_start_cycles;
             p2p_readlist_rsp.device_cmd_wait_dur = dma_write_cycles.wait_cycles;
-            /* Compute command execution latency */
-            exec_duration = PMC_GET_LATENCY(dma_write_cycles.exec_start_cycles);
             p2p_readlist_rsp.device_cmd_execute_dur = exec_duration;
 
-            status = Host_Iface_CQ_Push_Cmd(
-                0, &p2p_readlist_rsp, sizeof(struct device_ops_p2pdma_readlist_rsp_t));
+            status = Host_Iface_CQ_Push_Completion(0, write_chan_status.sqw_idx, &p2p_readlist_rsp,
+                sizeof(struct device_ops_p2pdma_readlist_rsp_t));
         }
 
-        /* Accumulate DMA execution cycles. Any previous exceution cycles will be
-        deducted from total transaction cycles and previous execution cycles will be reset. */
-        atomic_add_local_64(
-            &DMAW_Write_CB.chan_status_cb[write_chan].dma_trans_cycles, exec_duration);
-
         /* Calculate and log the DMA BW */
         STATW_Add_New_Sample_Atomically(
             STATW_RESOURCE_DMA_READ, DMAW_BYTES_PER_CYCLE_TO_MBPS(transfer_size, exec_duration));
@@ -1230,15 +1812,6 @@ static inline void process_dma_write_chan_aborting(
     /* Read the response ID */
     uint16_t rsp_id = atomic_load_local_16(&DMAW_Write_CB.chan_status_cb[write_chan].rsp_id);
 
-    /* Update global DMA channel status
-    NOTE: Channel state must be made idle once all resources are read */
-    atomic_store_local_32(
-        &DMAW_Write_CB.chan_status_cb[write_chan].status.channel_state, DMA_CHAN_STATE_IDLE);
-
-    /* Decrement the commands count being processed by the
-    given SQW. Should be done after clearing channel state */
-    SQW_Decrement_Command_Count(write_chan_status.sqw_idx);
-
     if (status == DMAW_ERROR_DRIVER_ABORT_FAILED)
     {
         abort_rsp_status = DEV_OPS_API_DMA_RESPONSE_DRIVER_ABORT_FAILED;
@@ -1248,6 +1821,31 @@ static inline void process_dma_write_chan_aborting(
         abort_rsp_status = DEV_OPS_API_DMA_RESPONSE_HOST_ABORTED;
     }
 
+    /* Compute stripe execution latency */
+    abort_exec_duration = PMC_GET_LATENCY(dma_write_cycles.exec_start_cycles);
+
+    /* Accumulate DMA execution cycles. Any previous exceution cycles will be
+    deducted from total transaction cycles and previous execution cycles will be reset. */
+    atomic_add_local_64(
+        &DMAW_Write_CB.chan_status_cb[write_chan].dma_trans_cycles, abort_exec_duration);
+
+    /* Update the per channel utilization counters */
+    STATW_Add_DMA_Chan_Sample(
+        STATW_RESOURCE_DMA_READ, write_chan, abort_transfer_size, abort_exec_duration);
+
+    /* Only the last stripe of the command releases the channels and responds */
+    if (!dmaw_stripe_done(DMAW_Write_CB.chan_status_cb, PCIE_DMA_WRT_CHANNEL_COUNT, write_chan,
+            &abort_rsp_status, &abort_transfer_size))
+    {
+        Log_Write(LOG_LEVEL_DEBUG, "DMAW:Tag_ID=%u:Write stripe done on chan %d\r\n",
+            write_chan_status.tag_id, write_chan);
+        return;
+    }
+
+    /* Decrement the commands count being processed by the
+    given SQW. Should be done after clearing channel state */
+    SQW_Decrement_Command_Count(write_chan_status.sqw_idx);
+
     if (rsp_id == DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_RSP)
     {
         struct device_ops_dma_readlist_rsp_t abort_readlist_rsp;
@@ -1260,8 +1858,6 @@ static inline void process_dma_write_chan_aborting(
         abort_readlist_rsp.response_info.rsp_hdr.msg_id = rsp_id;
         abort_readlist_rsp.device_cmd_start_ts = dma_write_cycles.cmd_start_cycles;
         abort_readlist_rsp.device_cmd_wait_dur = dma_write_cycles.wait_cycles;
-        /* Compute command execution latency */
-        abort_exec_duration = PMC_GET_LATENCY(dma_write_cycles.exec_start_cycles);
         abort_readlist_rsp.device_cmd_execute_dur = abort_exec_duration;
 
         status = Host_Iface_CQ_Push_Cmd(
@@ -1279,19 +1875,12 @@ static inline void process_dma_write_chan_aborting(
         abort_p2p_rsp.response_info.rsp_hdr.msg_id = rsp_id;
         abort_p2p_rsp.device_cmd_start_ts = dma_write_cycles.cmd_start_cycles;
         abort_p2p_rsp.device_cmd_wait_dur = dma_write_cycles.wait_cycles;
-        /* Compute command execution latency */
-        abort_exec_duration = PMC_GET_LATENCY(dma_write_cycles.exec_start_cycles);
         abort_p2p_rsp.device_cmd_execute_dur = abort_exec_duration;
 
         status = Host_Iface_CQ_Push_Cmd(
             0, &abort_p2p_rsp, sizeof(struct device_ops_p2pdma_readlist_rsp_t));
     }
 
-    /* Accumulate DMA execution cycles. Any previous exceution cycles will be
-    deducted from total transaction cycles and previous execution cycles will be reset. */
-    atomic_add_local_64(
-        &DMAW_Write_CB.chan_status_cb[write_chan].dma_trans_cycles, abort_exec_duration);
-
     /* Calculate and log the DMA BW */
     /* TODO: In case of abort, read the actual number of bytes transferred from DMA engine instead of total transfer size */
     STATW_Add_New_Sample_Atomically(STATW_RESOURCE_DMA_READ,
@@ -1415,6 +2004,10 @@ __attribute__((noreturn)) static inline void dmaw_launch_write_worker(uint32_t h
                 process_dma_write_chan_aborting(write_ch_index, channel_aborted);
             }
         }
+
+        /* This hart never sleeps, so it also flushes the completion batches
+        whose coalescing timeout expired */
+        Host_Iface_CQ_Coalesce_Processing();
     }
 }
 
@@ -417,6 +417,7 @@ static int32_t kw_reserve_kernel_slot(
                 *kernel = &KW_CB.kernels[i];
                 *slot_index = i;
                 slot_reserved = true;
+                break;
             }
         }
         /* Read the SQW state */
@@ -474,65 +475,74 @@ static void kw_unreserve_kernel_slot(kernel_instance_t *kernel)
 *
 *       Local fn helper to mark compute minions in-use. The shire mask
 *       provided by caller determines the minions to be marked in-use.
+*       The shires are checked and marked atomically under the resource
+*       lock and recorded in the kernel slot, so kernels with disjoint
+*       shire masks can be reserved concurrently. The lock is not held
+*       while waiting for busy shires, so other slots can still be found
+*       (e.g. for abort) and released meanwhile.
 *
 *   INPUTS
 *
 *       sqw_idx         Submission queue index
 *       tag_id          Tag ID of the command
 *       req_shire_mask  Shire mask of compute minions to be marked in-use
+*       kernel          Kernel slot to record the reserved shires in
 *
 *   OUTPUTS
 *
 *       int32_t          status success or error
 *
 ***********************************************************************/
-static int32_t kw_reserve_kernel_shires(uint8_t sqw_idx, uint16_t tag_id, uint64_t req_shire_mask)
+static int32_t kw_reserve_kernel_shires(
+    uint8_t sqw_idx, uint16_t tag_id, uint64_t req_shire_mask, kernel_instance_t *kernel)
 {
     int32_t status;
     sqw_state_e sqw_state;
 
-    /* Acquire the lock */
-    acquire_local_spinlock(&KW_CB.resource_lock);
-
     /* Find and wait for the requested shire mask to get free */
     do
     {
+        /* Acquire the lock */
+        acquire_local_spinlock(&KW_CB.resource_lock);
+
         /* Check the required shires are available and ready */
         status = CW_Check_Shires_Available_And_Free(req_shire_mask);
 
+        if (status == STATUS_SUCCESS)
+        {
+            /* Mark the shires as busy and assign them to the kernel slot */
+            CW_Update_Shire_State(req_shire_mask, CW_SHIRE_STATE_BUSY);
+            atomic_store_local_64(&kernel->kernel_shire_mask, req_shire_mask);
+        }
+
+        /* Release the lock */
+        release_local_spinlock(&KW_CB.resource_lock);
+
         /* Read the SQW state */
         sqw_state = SQW_Get_State(sqw_idx);
     } while ((status != STATUS_SUCCESS) && (status != CW_SHIRE_UNAVAILABLE) &&
              (sqw_state != SQW_STATE_ABORTED));
 
-    if ((status == STATUS_SUCCESS) && (sqw_state != SQW_STATE_ABORTED))
+    if ((status == STATUS_SUCCESS) && (sqw_state == SQW_STATE_ABORTED))
     {
-        /* Mark the shires as busy */
-        CW_Update_Shire_State(req_shire_mask, CW_SHIRE_STATE_BUSY);
+        /* The SQW was aborted after the shires were reserved, give them back */
+        atomic_store_local_64(&kernel->kernel_shire_mask, 0U);
+        CW_Update_Shire_State(req_shire_mask, CW_SHIRE_STATE_FREE);
+    }
 
-        /* Release the lock */
-        release_local_spinlock(&KW_CB.resource_lock);
+    if (sqw_state == SQW_STATE_ABORTED)
+    {
+        status = KW_ABORTED_KERNEL_SHIRES_SEARCH;
+        Log_Write(LOG_LEVEL_ERROR, "TID[%u]:SQW[%d]:KW:ABORTED:kernel shires search\r\n", tag_id,
+            sqw_idx);
     }
-    else
+    else if (status != STATUS_SUCCESS)
     {
-        /* Release the lock */
-        release_local_spinlock(&KW_CB.resource_lock);
-
-        /* Verify SQW state */
-        if (sqw_state == SQW_STATE_ABORTED)
-        {
-            status = KW_ABORTED_KERNEL_SHIRES_SEARCH;
-            Log_Write(LOG_LEVEL_ERROR, "TID[%u]:SQW[%d]:KW:ABORTED:kernel shires search\r\n",
-                tag_id, sqw_idx);
-        }
-        else
-        {
-            status = KW_ERROR_CW_SHIRES_NOT_READY;
-            Log_Write(LOG_LEVEL_ERROR,
-                "TID[%u]:SQW[%d]:KW:ERROR:kernel shires unavailable:Requested:0x%lx:Booted:0x%lx\r\n",
-                tag_id, sqw_idx, req_shire_mask, CW_Get_Booted_Shires());
-            SP_Iface_Report_Error(MM_RECOVERABLE_FW_MM_KW_ERROR, MM_CM_RESERVE_SLOT_ERROR);
-        }
+        status = KW_ERROR_CW_SHIRES_NOT_READY;
+        Log_Write(LOG_LEVEL_ERROR,
+            "TID[%u]:SQW[%d]:KW:ERROR:kernel shires unavailable:Requested:0x%lx:Booted:0x%lx\r\n",
+            tag_id, sqw_idx, req_shire_mask, CW_Get_Booted_Shires());
+        SP_Iface_Report_Error(MM_RECOVERABLE_FW_MM_KW_ERROR, MM_CM_RESERVE_SLOT_ERROR);
     }
 
     return status;
@@ -894,13 +904,9 @@ int32_t KW_Dispatch_Kernel_Launch_Cmd(
             /* Reserve compute shires needed for the requested
             kernel launch */
             status = kw_reserve_kernel_shires(
-                sqw_idx, cmd->command_info.cmd_hdr.tag_id, cmd->shire_mask);
+                sqw_idx, cmd->command_info.cmd_hdr.tag_id, cmd->shire_mask, kernel);
 
-            if (status == STATUS_SUCCESS)
-            {
-                atomic_store_local_64(&kernel->kernel_shire_mask, cmd->shire_mask);
-            }
-            else
+            if (status != STATUS_SUCCESS)
             {
                 /* Make reserved kernel slot available again */
                 kw_unreserve_kernel_slot(kernel);
@@ -1660,7 +1666,7 @@ __attribute__((noreturn)) void KW_Launch(uint32_t kw_idx)
 #else
         launch_rsp->response_info.rsp_hdr.size = (uint16_t)(rsp_size - sizeof(struct cmn_header_t));
         /* Send kernel launch response to host */
-        status = Host_Iface_CQ_Push_Cmd(0, launch_rsp, rsp_size);
+        status = Host_Iface_CQ_Push_Completion(0, local_sqw_idx, launch_rsp, rsp_size);
 #endif
 
         /* Accumlate kernel execution cycles. */
@@ -0,0 +1,572 @@
+/***********************************************************************
+*
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*
+************************************************************************/
+/***********************************************************************/
+/*! \file memw.c
+    \brief A C module that implements the device Memory Worker's
+    public and private interfaces. The PCIe DMA engine can only move
+    data between host and device memory, so the device memory commands
+    (memset, device to device memcpy) are done by the master shire harts. The SQW processing the
+    command splits the region in cache line aligned slices, keeps the
+    first one and hands the others to the memory workers, which run on
+    the otherwise idle odd harts of the Kernel Worker minions.
+    1. MEMW_Launch - An infinite loop that unblocks on FCC notification
+    from an SQW, processes its slice and flags it as done
+
+    Public interfaces:
+        MEMW_Init
+        MEMW_Launch
+        MEMW_Memset
+        MEMW_Memcpy
+*/
+/***********************************************************************/
+/* mm_rt_svcs */
+#include <etsoc/isa/atomic.h>
+#include <etsoc/common/common_defs.h>
+#include <etsoc/isa/etsoc_memory.h>
+#include <etsoc/isa/sync.h>
+#include <etsoc/isa/utils.h>
+
+/* mm_rt_helpers */
+#include "error_codes.h"
+
+/* mm specific headers */
+#include "config/mm_config.h"
+#include "services/log.h"
+#include "workers/memw.h"
+#include "workers/sqw.h"
+
+/*! \def MEMW_CHUNK_SIZE
+    \brief Number of bytes processed between two checks of the SQW abort
+    state. Each chunk is evicted to L3 once written, so it is visible to the
+    DMA engine and to the compute minions.
+*/
+#define MEMW_CHUNK_SIZE (1024U * 1024U)
+
+/*! \def MEMW_SPLIT_MIN_SIZE
+    \brief Regions smaller than this are processed by the SQW alone, waking
+    up the memory workers would cost more than what they save.
+*/
+#define MEMW_SPLIT_MIN_SIZE (256U * 1024U)
+
+/*! \def MEMW_NUM_SLICES
+    \brief Number of slices a region is split in, one for the SQW and one
+    per memory worker.
+*/
+#define MEMW_NUM_SLICES (MEMW_NUM + 1U)
+
+/*! \enum memw_op_e
+    \brief Device memory operations done by the memory workers.
+*/
+typedef enum { MEMW_OP_MEMSET = 0, MEMW_OP_MEMCPY } memw_op_e;
+
+/*! \struct memw_job_t
+    \brief Device memory operation being split between an SQW and the
+    memory workers.
+*/
+typedef struct memw_job_ {
+    uint64_t dst;
+    uint64_t src;
+    uint64_t size;
+    uint64_t pattern;
+    uint32_t op;
+    uint32_t sqw_idx;
+    uint32_t pattern_size;
+} memw_job_t;
+
+/*! \struct memw_slice_t
+    \brief Part of the job given to a memory worker, as offsets from the start
+    of the region.
+*/
+typedef struct memw_slice_ {
+    uint64_t begin;
+    uint64_t end;
+    uint32_t status;
+    uint32_t done;
+} memw_slice_t;
+
+/*! \typedef memw_cb_t
+    \brief Memory Worker Control Block structure. The workers are shared by
+    all the SQWs, only one of them can use them at a time.
+*/
+typedef CACHE_STRUCT({
+    uint32_t owner; /* 0 if free, index + 1 of the SQW using the workers otherwise */
+    fcc_sync_cb_t sqw2memw[MEMW_NUM];
+    memw_job_t job;
+    memw_slice_t slices[MEMW_NUM];
+}) memw_cb_t;
+
+/*! \var memw_cb_t MEMW_CB
+    \brief Global Memory Worker Control Block
+*/
+static memw_cb_t MEMW_CB = {{ 0 }};
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memw_evict_range
+*
+*   DESCRIPTION
+*
+*       Evicts to L3 every cache line touched by [begin, end).
+*
+*   INPUTS
+*
+*       begin            First byte of the range
+*       end              One past the last byte of the range
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+static inline void memw_evict_range(uint64_t begin, uint64_t end)
+{
+    uint64_t line_begin = begin & ~(uint64_t)(CACHE_LINE_SIZE - 1U);
+    uint64_t line_end = ALIGN(end, CACHE_LINE_SIZE);
+
+    ETSOC_MEM_EVICT((void *)(uintptr_t)line_begin, line_end - line_begin, to_L3)
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memw_memset_range
+*
+*   DESCRIPTION
+*
+*       Fills [begin, end) of the job region, chunk by chunk, and evicts
+*       each chunk to L3. It stops early if the SQW gets aborted.
+*
+*   INPUTS
+*
+*       job              Memset job
+*       begin            Offset of the first byte to fill
+*       end              Offset one past the last byte to fill
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memw_memset_range(const memw_job_t *job, uint64_t begin, uint64_t end)
+{
+    const uint8_t *pattern = (const uint8_t *)&job->pattern;
+    uint8_t *dst = (uint8_t *)(uintptr_t)job->dst;
+    uint64_t offset = begin;
+    uint64_t fill_word = 0;
+    int32_t status = STATUS_SUCCESS;
+
+    while ((offset < end) && (status == STATUS_SUCCESS))
+    {
+        uint64_t chunk_end = offset + MEMW_CHUNK_SIZE;
+        uint64_t chunk_start = offset;
+
+        if (chunk_end > end)
+        {
+            chunk_end = end;
+        }
+
+        /* Unaligned head, byte by byte */
+        for (; (offset < chunk_end) && !IS_ALIGNED(&dst[offset], 8); ++offset)
+        {
+            dst[offset] = pattern[offset % job->pattern_size];
+        }
+
+        /* The pattern size divides 8, so the same word fits every aligned double word */
+        if (fill_word == 0)
+        {
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                fill_word |= (uint64_t)pattern[(offset + i) % job->pattern_size] << (i * 8);
+            }
+        }
+        for (; (offset + 8) <= chunk_end; offset += 8)
+        {
+            *(uint64_t *)(uintptr_t)&dst[offset] = fill_word;
+        }
+
+        /* Unaligned tail, byte by byte */
+        for (; offset < chunk_end; ++offset)
+        {
+            dst[offset] = pattern[offset % job->pattern_size];
+        }
+
+        memw_evict_range(job->dst + chunk_start, job->dst + chunk_end);
+
+        /* Get the SQW state to check for command abort */
+        if (SQW_Get_State((uint8_t)job->sqw_idx) == SQW_STATE_ABORTED)
+        {
+            status = HOST_CMD_STATUS_ABORTED;
+        }
+    }
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memw_memcpy_range
+*
+*   DESCRIPTION
+*
+*       Copies [begin, end) of the job source region into the destination
+*       one, chunk by chunk. The source chunk is evicted first, so no stale
+*       line is read from the MM caches, and the destination chunk is
+*       evicted to L3 once written. It stops early if the SQW gets aborted.
+*
+*   INPUTS
+*
+*       job              Memcpy job
+*       begin            Offset of the first byte to copy
+*       end              Offset one past the last byte to copy
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memw_memcpy_range(const memw_job_t *job, uint64_t begin, uint64_t end)
+{
+    uint64_t offset = begin;
+    int32_t status = STATUS_SUCCESS;
+
+    while ((offset < end) && (status == STATUS_SUCCESS))
+    {
+        uint64_t chunk_size = end - offset;
+
+        if (chunk_size > MEMW_CHUNK_SIZE)
+        {
+            chunk_size = MEMW_CHUNK_SIZE;
+        }
+
+        memw_evict_range(job->src + offset, job->src + offset + chunk_size);
+        ETSOC_Memory_Read_Write_Cacheable((const void *)(uintptr_t)(job->src + offset),
+            (void *)(uintptr_t)(job->dst + offset), chunk_size);
+        memw_evict_range(job->dst + offset, job->dst + offset + chunk_size);
+
+        offset += chunk_size;
+
+        /* Get the SQW state to check for command abort */
+        if (SQW_Get_State((uint8_t)job->sqw_idx) == SQW_STATE_ABORTED)
+        {
+            status = HOST_CMD_STATUS_ABORTED;
+        }
+    }
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memw_process_range
+*
+*   DESCRIPTION
+*
+*       Processes [begin, end) of the job region.
+*
+*   INPUTS
+*
+*       job              Job to process
+*       begin            Offset of the first byte to process
+*       end              Offset one past the last byte to process
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memw_process_range(const memw_job_t *job, uint64_t begin, uint64_t end)
+{
+    int32_t status = STATUS_SUCCESS;
+
+    if (job->op == MEMW_OP_MEMSET)
+    {
+        status = memw_memset_range(job, begin, end);
+    }
+    else if (job->op == MEMW_OP_MEMCPY)
+    {
+        status = memw_memcpy_range(job, begin, end);
+    }
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memw_slice_begin
+*
+*   DESCRIPTION
+*
+*       Computes the offset where a slice of the job region starts. Every
+*       slice but the first one starts at a cache line, so no two harts
+*       write or evict the same line.
+*
+*   INPUTS
+*
+*       job              Job being split
+*       slice            Slice index, MEMW_NUM_SLICES gives the region end
+*
+*   OUTPUTS
+*
+*       uint64_t          Offset of the first byte of the slice.
+*
+***********************************************************************/
+static uint64_t memw_slice_begin(const memw_job_t *job, uint32_t slice)
+{
+    uint64_t begin = 0;
+
+    if (slice >= MEMW_NUM_SLICES)
+    {
+        begin = job->size;
+    }
+    else if (slice > 0)
+    {
+        begin = ALIGN(job->dst + ((job->size / MEMW_NUM_SLICES) * slice), CACHE_LINE_SIZE) -
+                job->dst;
+        if (begin > job->size)
+        {
+            begin = job->size;
+        }
+    }
+
+    return begin;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       memw_execute
+*
+*   DESCRIPTION
+*
+*       Executes a job on the calling SQW. Large regions are split with the
+*       memory workers if no other SQW is using them, the SQW processes the
+*       first slice and then waits for the workers to finish theirs.
+*
+*   INPUTS
+*
+*       job              Job to execute
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+static int32_t memw_execute(const memw_job_t *job)
+{
+    int32_t status;
+
+    if ((job->size < MEMW_SPLIT_MIN_SIZE) ||
+        (atomic_compare_and_exchange_local_32(&MEMW_CB.owner, 0U, job->sqw_idx + 1U) != 0U))
+    {
+        return memw_process_range(job, 0, job->size);
+    }
+
+    atomic_store_local_64(&MEMW_CB.job.dst, job->dst);
+    atomic_store_local_64(&MEMW_CB.job.src, job->src);
+    atomic_store_local_64(&MEMW_CB.job.size, job->size);
+    atomic_store_local_64(&MEMW_CB.job.pattern, job->pattern);
+    atomic_store_local_32(&MEMW_CB.job.op, job->op);
+    atomic_store_local_32(&MEMW_CB.job.sqw_idx, job->sqw_idx);
+    atomic_store_local_32(&MEMW_CB.job.pattern_size, job->pattern_size);
+
+    for (uint32_t i = 0; i < MEMW_NUM; i++)
+    {
+        atomic_store_local_64(&MEMW_CB.slices[i].begin, memw_slice_begin(job, i + 1U));
+        atomic_store_local_64(&MEMW_CB.slices[i].end, memw_slice_begin(job, i + 2U));
+        atomic_store_local_32(&MEMW_CB.slices[i].done, 0U);
+
+        global_fcc_notify(atomic_load_local_8(&MEMW_CB.sqw2memw[i].fcc_id),
+            &MEMW_CB.sqw2memw[i].fcc_flag, MEMW_WORKER_0 + i, MEMW_THREAD_ID);
+    }
+
+    status = memw_process_range(job, 0, memw_slice_begin(job, 1U));
+
+    for (uint32_t i = 0; i < MEMW_NUM; i++)
+    {
+        while (atomic_load_local_32(&MEMW_CB.slices[i].done) == 0U)
+        {
+            /* Spin until the worker is done, they check the SQW abort state too */
+        }
+
+        if (status == STATUS_SUCCESS)
+        {
+            status = (int32_t)atomic_load_local_32(&MEMW_CB.slices[i].status);
+        }
+    }
+
+    atomic_store_local_32(&MEMW_CB.owner, 0U);
+
+    return status;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       MEMW_Init
+*
+*   DESCRIPTION
+*
+*       Initialize device Memory Workers
+*
+*   INPUTS
+*
+*       None
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+void MEMW_Init(void)
+{
+    atomic_store_local_32(&MEMW_CB.owner, 0U);
+
+    for (uint32_t i = 0; i < MEMW_NUM; i++)
+    {
+        /* Initialize FCC flags used by the memory worker */
+        atomic_store_local_8(&MEMW_CB.sqw2memw[i].fcc_id, FCC_0);
+        global_fcc_init(&MEMW_CB.sqw2memw[i].fcc_flag);
+
+        atomic_store_local_32(&MEMW_CB.slices[i].done, 0U);
+    }
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       MEMW_Launch
+*
+*   DESCRIPTION
+*
+*       Launch a device Memory Worker
+*
+*   INPUTS
+*
+*       memw_idx         Memory Worker index
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+__attribute__((noreturn)) void MEMW_Launch(uint32_t memw_idx)
+{
+    memw_slice_t *const slice = &MEMW_CB.slices[memw_idx];
+    memw_job_t job;
+    int32_t status;
+
+    Log_Write(LOG_LEVEL_INFO, "MEMW[%d]\r\n", memw_idx);
+
+    while (1)
+    {
+        /* Wait on FCC notification from the SQW splitting a job */
+        global_fcc_wait(atomic_load_local_8(&MEMW_CB.sqw2memw[memw_idx].fcc_id),
+            &MEMW_CB.sqw2memw[memw_idx].fcc_flag);
+
+        job.dst = atomic_load_local_64(&MEMW_CB.job.dst);
+        job.src = atomic_load_local_64(&MEMW_CB.job.src);
+        job.size = atomic_load_local_64(&MEMW_CB.job.size);
+        job.pattern = atomic_load_local_64(&MEMW_CB.job.pattern);
+        job.op = atomic_load_local_32(&MEMW_CB.job.op);
+        job.sqw_idx = atomic_load_local_32(&MEMW_CB.job.sqw_idx);
+        job.pattern_size = atomic_load_local_32(&MEMW_CB.job.pattern_size);
+
+        status = memw_process_range(
+            &job, atomic_load_local_64(&slice->begin), atomic_load_local_64(&slice->end));
+
+        Log_Write(LOG_LEVEL_DEBUG, "MEMW[%d]:SQW[%d]:Slice:Done:%d\r\n", memw_idx, job.sqw_idx,
+            status);
+
+        atomic_store_local_32(&slice->status, (uint32_t)status);
+        atomic_store_local_32(&slice->done, 1U);
+    }
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       MEMW_Memset
+*
+*   DESCRIPTION
+*
+*       Fills a device memory region with a pattern, byte i of the region
+*       gets byte (i % pattern_size) of the pattern.
+*
+*   INPUTS
+*
+*       sqw_idx          Index of the calling SQW
+*       dst              Device address of the region
+*       size             Size of the region in bytes
+*       pattern          Fill pattern
+*       pattern_size     Size of the pattern in bytes
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+int32_t MEMW_Memset(
+    uint8_t sqw_idx, uint64_t dst, uint64_t size, uint64_t pattern, uint8_t pattern_size)
+{
+    const memw_job_t job = { .dst = dst,
+        .src = 0,
+        .size = size,
+        .pattern = pattern,
+        .op = MEMW_OP_MEMSET,
+        .sqw_idx = sqw_idx,
+        .pattern_size = pattern_size };
+
+    return memw_execute(&job);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       MEMW_Memcpy
+*
+*   DESCRIPTION
+*
+*       Copies a device memory region into another, non overlapping, one.
+*
+*   INPUTS
+*
+*       sqw_idx          Index of the calling SQW
+*       dst              Device address of the destination region
+*       src              Device address of the source region
+*       size             Size of the regions in bytes
+*
+*   OUTPUTS
+*
+*       int32_t           Successful status or error code.
+*
+***********************************************************************/
+int32_t MEMW_Memcpy(uint8_t sqw_idx, uint64_t dst, uint64_t src, uint64_t size)
+{
+    const memw_job_t job = { .dst = dst,
+        .src = src,
+        .size = size,
+        .pattern = 0,
+        .op = MEMW_OP_MEMCPY,
+        .sqw_idx = sqw_idx,
+        .pattern_size = 0 };
+
+    return memw_execute(&job);
+}
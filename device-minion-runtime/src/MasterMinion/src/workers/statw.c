@@ -18,6 +18,8 @@
         STATW_Get_MM_Stats
         STATW_Reset_MM_Stats
         STATW_Add_New_Sample_Atomically
+        STATW_Add_DMA_Chan_Sample
+        STATW_Get_DMA_Chan_Stats
 
 */
 /***********************************************************************/
@@ -62,6 +64,12 @@
     resource.avg = statw_recalculate_cma(resource.avg, current_sample, sample_count); \
     STATW_RECALC_MIN_MAX(resource, current_sample)
 
+/* The per channel counters are reported in a fixed size trace sample */
+#if (PCIE_DMA_WRT_CHANNEL_COUNT > TRACE_DMA_CHAN_STATS_CHANNEL_COUNT) || \
+    (PCIE_DMA_RD_CHANNEL_COUNT > TRACE_DMA_CHAN_STATS_CHANNEL_COUNT)
+#error "DMA channel count exceeds the channels reported in dma_chan_stats_sample"
+#endif
+
 /*! \def STATW_PMU_REQ_COUNT_TO_MBPS
     \brief Helper macro to convert request count to PMU to MB/Sec.
     Every request is 64 bytes long.
@@ -153,6 +161,10 @@ typedef CACHE_STRUCT({
     struct resource_value cm_bw; /* Reserve whole cache line for this to reduce the serialization
                                          among Worker Harts reading/writing on same cache line */
     uint64_t pad3[5];
+    struct statw_dma_chan_stats
+        pcie_dma_read_chan_stats[PCIE_DMA_WRT_CHANNEL_COUNT]; /* Updated by the DMAW for write */
+    struct statw_dma_chan_stats
+        pcie_dma_write_chan_stats[PCIE_DMA_RD_CHANNEL_COUNT]; /* Updated by the DMAW for read */
     uint64_t saved_trace_entry;
     uint32_t sampling_flag;
     uint32_t reset_sampling_flag;
@@ -687,6 +699,137 @@ void STATW_Add_New_Sample_Atomically(statw_resource_type_e resource_type, uint64
     atomic_store_local_64(&resource->max, MAX(prev_max, current_sample));
 }
 
+/************************************************************************
+*
+*   FUNCTION
+*
+*       STATW_Add_DMA_Chan_Sample
+*
+*   DESCRIPTION
+*
+*       This functions adds a completed transfer to the utilization
+*       counters of a DMA channel.
+*
+*   INPUTS
+*
+*       resource_type   STATW_RESOURCE_DMA_READ or STATW_RESOURCE_DMA_WRITE
+*       chan            DMA channel ID
+*       bytes           Number of bytes moved by the transfer
+*       busy_cycles     Number of cycles the transfer kept the channel busy
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+void STATW_Add_DMA_Chan_Sample(
+    statw_resource_type_e resource_type, uint8_t chan, uint64_t bytes, uint64_t busy_cycles)
+{
+    struct statw_dma_chan_stats *chan_stats = (resource_type == STATW_RESOURCE_DMA_READ) ?
+                                                  &STATW_CB.pcie_dma_read_chan_stats[chan] :
+                                                  &STATW_CB.pcie_dma_write_chan_stats[chan];
+
+    atomic_add_local_64(&chan_stats->bytes, bytes);
+    atomic_add_local_64(&chan_stats->busy_cycles, busy_cycles);
+    atomic_add_local_64(&chan_stats->transfers, 1U);
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       STATW_Get_DMA_Chan_Stats
+*
+*   DESCRIPTION
+*
+*       This function returns the utilization counters of a DMA channel.
+*
+*   INPUTS
+*
+*       resource_type   STATW_RESOURCE_DMA_READ or STATW_RESOURCE_DMA_WRITE
+*       chan            DMA channel ID
+*       stats           Pointer to stats to populate
+*
+*   OUTPUTS
+*
+*       success or error
+*
+***********************************************************************/
+int32_t STATW_Get_DMA_Chan_Stats(
+    statw_resource_type_e resource_type, uint8_t chan, struct statw_dma_chan_stats *stats)
+{
+    const struct statw_dma_chan_stats *chan_stats;
+    uint8_t chan_count;
+
+    if (resource_type == STATW_RESOURCE_DMA_READ)
+    {
+        chan_stats = STATW_CB.pcie_dma_read_chan_stats;
+        chan_count = PCIE_DMA_WRT_CHANNEL_COUNT;
+    }
+    else
+    {
+        chan_stats = STATW_CB.pcie_dma_write_chan_stats;
+        chan_count = PCIE_DMA_RD_CHANNEL_COUNT;
+    }
+
+    if ((stats == NULL) || (chan >= chan_count))
+    {
+        Log_Write(LOG_LEVEL_ERROR, "STATW_Get_DMA_Chan_Stats: invalid argument\n");
+        return STATW_ERROR_GET_DMA_CHAN_STATS_INVALID_ARG;
+    }
+
+    stats->bytes = atomic_load_local_64(&chan_stats[chan].bytes);
+    stats->busy_cycles = atomic_load_local_64(&chan_stats[chan].busy_cycles);
+    stats->transfers = atomic_load_local_64(&chan_stats[chan].transfers);
+
+    return STATUS_SUCCESS;
+}
+
+/************************************************************************
+*
+*   FUNCTION
+*
+*       statw_fill_dma_chan_stats
+*
+*   DESCRIPTION
+*
+*       This functions fills the per channel DMA counters in the given
+*       DMA channel stats sample struct.
+*
+*   INPUTS
+*
+*       chan_sample     Pointer to the DMA channel stats sample
+*
+*   OUTPUTS
+*
+*       None
+*
+***********************************************************************/
+static void statw_fill_dma_chan_stats(struct dma_chan_stats_sample *chan_sample)
+{
+    struct statw_dma_chan_stats chan_stats;
+
+    for (uint8_t chan = 0; chan < PCIE_DMA_WRT_CHANNEL_COUNT; chan++)
+    {
+        if (STATW_Get_DMA_Chan_Stats(STATW_RESOURCE_DMA_READ, chan, &chan_stats) == STATUS_SUCCESS)
+        {
+            chan_sample->read[chan].bytes = chan_stats.bytes;
+            chan_sample->read[chan].busy_cycles = chan_stats.busy_cycles;
+            chan_sample->read[chan].transfers = chan_stats.transfers;
+        }
+    }
+
+    for (uint8_t chan = 0; chan < PCIE_DMA_RD_CHANNEL_COUNT; chan++)
+    {
+        if (STATW_Get_DMA_Chan_Stats(STATW_RESOURCE_DMA_WRITE, chan, &chan_stats) == STATUS_SUCCESS)
+        {
+            chan_sample->write[chan].bytes = chan_stats.bytes;
+            chan_sample->write[chan].busy_cycles = chan_stats.busy_cycles;
+            chan_sample->write[chan].transfers = chan_stats.transfers;
+        }
+    }
+}
+
 /************************************************************************
 *
 *   FUNCTION
@@ -768,6 +911,20 @@ static void statw_sample_init(struct compute_resources_sample *local_stats_cb)
     atomic_store_local_64(&STATW_CB.pcie_dma_write_bw.max, STATW_RESOURCE_DEFAULT_MAX);
     atomic_store_local_64(&STATW_CB.pcie_dma_write_bw.min, STATW_RESOURCE_DEFAULT_MIN);
 
+    for (uint8_t chan = 0; chan < PCIE_DMA_WRT_CHANNEL_COUNT; chan++)
+    {
+        atomic_store_local_64(&STATW_CB.pcie_dma_read_chan_stats[chan].bytes, 0U);
+        atomic_store_local_64(&STATW_CB.pcie_dma_read_chan_stats[chan].busy_cycles, 0U);
+        atomic_store_local_64(&STATW_CB.pcie_dma_read_chan_stats[chan].transfers, 0U);
+    }
+
+    for (uint8_t chan = 0; chan < PCIE_DMA_RD_CHANNEL_COUNT; chan++)
+    {
+        atomic_store_local_64(&STATW_CB.pcie_dma_write_chan_stats[chan].bytes, 0U);
+        atomic_store_local_64(&STATW_CB.pcie_dma_write_chan_stats[chan].busy_cycles, 0U);
+        atomic_store_local_64(&STATW_CB.pcie_dma_write_chan_stats[chan].transfers, 0U);
+    }
+
     local_stats_cb->ddr_read_bw.avg = STATW_RESOURCE_DEFAULT_AVG;
     local_stats_cb->ddr_read_bw.max = STATW_RESOURCE_DEFAULT_MAX;
     local_stats_cb->ddr_read_bw.min = STATW_RESOURCE_DEFAULT_MIN;
@@ -842,6 +999,7 @@ static void statw_init(struct compute_resources_sample *local_stats_cb)
 __attribute__((noreturn)) void STATW_Launch(uint32_t hart_id)
 {
     struct compute_resources_sample data_sample = { 0 };
+    struct dma_chan_stats_sample chan_sample = { 0 };
     uint64_t prev_timestamp;
     uint64_t shire_mask;
     struct trace_custom_event_t *entry;
@@ -915,6 +1073,18 @@ __attribute__((noreturn)) void STATW_Launch(uint32_t hart_id)
                 /* Save the trace entry for retrieval in STATW_Get_MM_Stats via Trace_Event_Copy */
                 atomic_store_local_64(&STATW_CB.saved_trace_entry, (uint64_t)entry);
             }
+
+            /* Log the per channel DMA counters next to the aggregated sample */
+            statw_fill_dma_chan_stats(&chan_sample);
+            entry = (struct trace_custom_event_t *)Trace_Custom_Event(Trace_Get_MM_Stats_CB(),
+                TRACE_CUSTOM_TYPE_MM_DMA_CHAN_STATS, (const uint8_t *)&chan_sample,
+                sizeof(chan_sample));
+
+            if (entry != NULL)
+            {
+                Trace_Evict_Event_MM_Stats(
+                    entry, (sizeof(struct trace_custom_event_t) + sizeof(chan_sample)));
+            }
         }
     }
 }
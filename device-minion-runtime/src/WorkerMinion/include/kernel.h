@@ -89,11 +89,13 @@ void kernel_info_get_attributes(uint32_t shire_id, uint8_t *kw_base_id, uint8_t
 */
 uint64_t kernel_info_set_thread_returned(uint32_t shire_id, uint64_t thread_id);
 
-/*! \fn uint64_t kernel_launch_get_pending_shire_mask(void)
-    \brief This function returns the shires pending to complete the kernel launch.
+/*! \fn uint64_t kernel_launch_get_pending_shire_mask(uint32_t shire_id)
+    \brief This function returns the shires pending to complete the kernel launch
+    running on the given shire.
+    \param shire_id ID of the shire
     \return Returns the shire mask of pending shires
 */
-uint64_t kernel_launch_get_pending_shire_mask(void);
+uint64_t kernel_launch_get_pending_shire_mask(uint32_t shire_id);
 
 /*! \fn uint64_t kernel_launch_set_global_exception_mask(uint32_t shire_id)
     \brief This function sets the global exception mask for the current kernel launch. This helps us to
@@ -134,10 +134,12 @@ static void send_exception_message(uint64_t mcause, uint64_t mepc, uint64_t mtva
         /* Get the kernel info attributes */
         kernel_info_get_attributes(shire_id, &kw_base_id, &slot_index);
 
-        /* Send exception message to appropriate kernel worker */
-        status = CM_To_MM_Iface_Unicast_Send((uint64_t)(kw_base_id + slot_index),
-            (uint64_t)(CM_MM_KW_HART_UNICAST_BUFF_BASE_IDX + slot_index),
-            (cm_iface_message_t *)&message);
+        /* Send exception message to appropriate kernel worker. KWs run on the first hart of
+        consecutive minions */
+        status =
+            CM_To_MM_Iface_Unicast_Send((uint64_t)(kw_base_id + (slot_index * HARTS_PER_MINION)),
+                (uint64_t)(CM_MM_KW_HART_UNICAST_BUFF_BASE_IDX + slot_index),
+                (cm_iface_message_t *)&message);
 
         if (status != STATUS_SUCCESS)
         {
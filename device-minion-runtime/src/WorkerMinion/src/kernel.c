@@ -97,18 +97,25 @@ typedef CACHE_STRUCT ({
     };
 }) kernel_launch_info_t;
 
+/* Kernel launch state shared by all the shires of a kernel launch. Kernels with disjoint shire
+masks can run at the same time, so there is one per kernel worker slot. Aligned to cache line
+so that the global atomics of different slots don't contend */
+typedef CACHE_STRUCT ({
+    spinlock_t pre_launch_barrier;
+    uint32_t execution_status;
+    uint64_t shire_mask; /* Shires pending to complete the kernel launch */
+    uint64_t exception_mask;
+    uint64_t system_abort_mask;
+}) kernel_launch_global_info_t;
+
 /***************/
 /* Global Data */
 /***************/
 static const uint8_t tensor_zeros[64] __attribute__((aligned(64))) = { 0 };
 static spinlock_t pre_launch_local_barrier[NUM_SHIRES] = { 0 };
-static spinlock_t pre_launch_global_barrier = { 0 };
 static local_fcc_barrier_t post_launch_barrier[NUM_SHIRES] = { 0 };
 static kernel_launch_info_t kernel_launch_info[NUM_SHIRES] = { 0 };
-static uint64_t kernel_launch_shire_mask __attribute__((aligned(64))) = 0;
-static uint64_t kernel_launch_global_exception_mask __attribute__((aligned(64))) = 0;
-static uint64_t kernel_launch_global_system_abort_mask __attribute__((aligned(64))) = 0;
-static uint32_t kernel_launch_global_execution_status __attribute__((aligned(64))) = 0;
+static kernel_launch_global_info_t kernel_launch_global_info[MAX_SIMULTANEOUS_KERNELS] = { 0 };
 
 /***********************/
 /* Function Prototypes */
@@ -154,7 +161,7 @@ static bool pre_launch_synchronize_shires(
         /* Last shire resets the global barrier */
         if (prev_shire == (num_shires - 1))
         {
-            init_global_spinlock(&pre_launch_global_barrier, 0);
+            init_global_spinlock(global_lock, 0);
 
             kernel_last_thread = true;
         }
@@ -168,19 +175,34 @@ static bool pre_launch_synchronize_shires(
     return kernel_last_thread;
 }
 
+static inline uint8_t kernel_info_get_slot_index(uint32_t shire_id)
+{
+    kernel_launch_info_t kernel_info;
+
+    kernel_info.raw_u32 = atomic_load_local_32(&kernel_launch_info[shire_id].raw_u32);
+
+    return kernel_info.slot_index;
+}
+
 uint64_t kernel_launch_set_global_exception_mask(uint32_t shire_id)
 {
-    return atomic_or_global_64(&kernel_launch_global_exception_mask, (1ULL << shire_id));
+    const uint8_t slot_index = kernel_info_get_slot_index(shire_id);
+
+    return atomic_or_global_64(
+        &kernel_launch_global_info[slot_index].exception_mask, (1ULL << shire_id));
 }
 
-uint64_t kernel_launch_get_pending_shire_mask(void)
+uint64_t kernel_launch_get_pending_shire_mask(uint32_t shire_id)
 {
-    return atomic_load_global_64(&kernel_launch_shire_mask);
+    const uint8_t slot_index = kernel_info_get_slot_index(shire_id);
+
+    return atomic_load_global_64(&kernel_launch_global_info[slot_index].shire_mask);
 }
 
-static inline uint64_t kernel_launch_reset_shire_mask(uint32_t shire_id)
+static inline uint64_t kernel_launch_reset_shire_mask(uint8_t slot_index, uint32_t shire_id)
 {
-    return atomic_and_global_64(&kernel_launch_shire_mask, ~(1ULL << shire_id));
+    return atomic_and_global_64(
+        &kernel_launch_global_info[slot_index].shire_mask, ~(1ULL << shire_id));
 }
 
 uint64_t kernel_info_reset_launched_thread(uint32_t shire_id, uint64_t thread_id)
@@ -341,8 +363,9 @@ int64_t launch_kernel(mm_to_cm_message_kernel_params_t kernel)
     }
 
     /* Wait until all the Shires involved in the kernel launch reach this sync point */
-    kernel_last_thread = pre_launch_synchronize_shires(&pre_launch_global_barrier,
-        pre_launch_local_barrier, (uint32_t)__builtin_popcountll(kernel.shire_mask));
+    kernel_last_thread = pre_launch_synchronize_shires(
+        &kernel_launch_global_info[kernel.slot_index].pre_launch_barrier, pre_launch_local_barrier,
+        (uint32_t)__builtin_popcountll(kernel.shire_mask));
 
     /* Set the thread state to kernel launched */
     kernel_info_set_thread_launched(get_shire_id(), hart_id & (HARTS_PER_SHIRE - 1));
@@ -528,11 +551,11 @@ static void pre_kernel_setup(const mm_to_cm_message_kernel_params_t *kernel)
         atomic_store_local_64(&kernel_launch_info[shire_id].system_abort_mask, 0);
         /* TODO: Improvement: The global atomic to reset kernel launch globals should be done
         by the first shire involved in kernel launch only, not all shires. */
-        atomic_store_global_64(&kernel_launch_shire_mask, kernel->shire_mask);
-        atomic_store_global_64(&kernel_launch_global_exception_mask, 0);
-        atomic_store_global_64(&kernel_launch_global_system_abort_mask, 0);
-        atomic_store_global_32(
-            &kernel_launch_global_execution_status, KERNEL_COMPLETE_STATUS_SUCCESS);
+        kernel_launch_global_info_t *global_info = &kernel_launch_global_info[kernel->slot_index];
+        atomic_store_global_64(&global_info->shire_mask, kernel->shire_mask);
+        atomic_store_global_64(&global_info->exception_mask, 0);
+        atomic_store_global_64(&global_info->system_abort_mask, 0);
+        atomic_store_global_32(&global_info->execution_status, KERNEL_COMPLETE_STATUS_SUCCESS);
 
         /* Init all FLBs */
         for (uint64_t barrier = 0; barrier < FLB_COUNT; barrier++)
@@ -556,8 +579,9 @@ static void pre_kernel_setup(const mm_to_cm_message_kernel_params_t *kernel)
     {
         /* Before evicting L3, make sure all the accesses to L3
         are complete and all the shires reach this sync point */
-        pre_launch_synchronize_shires(&pre_launch_global_barrier, pre_launch_local_barrier,
-            (uint32_t)__builtin_popcountll(kernel->shire_mask));
+        pre_launch_synchronize_shires(
+            &kernel_launch_global_info[kernel->slot_index].pre_launch_barrier,
+            pre_launch_local_barrier, (uint32_t)__builtin_popcountll(kernel->shire_mask));
 
         if ((hart_id % 64U == 0) && (shire_id < 32))
         {
@@ -639,7 +663,8 @@ static void pre_kernel_setup(const mm_to_cm_message_kernel_params_t *kernel)
     asm volatile("fence");
 }
 
-static void process_kernel_completion_status(int64_t return_value, uint64_t return_type)
+static void process_kernel_completion_status(
+    uint8_t slot_index, int64_t return_value, uint64_t return_type)
 {
     const uint32_t shire_id = get_shire_id();
     const uint32_t hart_id = get_hart_id();
@@ -661,7 +686,8 @@ static void process_kernel_completion_status(int64_t return_value, uint64_t retu
                  &kernel_launch_info[shire_id].system_abort_mask, 1ULL << thread_id) == 0))
         {
             /* Set the global system abort flag to indicate that this particular shire was aborted */
-            atomic_or_global_64(&kernel_launch_global_system_abort_mask, 1ULL << shire_id);
+            atomic_or_global_64(
+                &kernel_launch_global_info[slot_index].system_abort_mask, 1ULL << shire_id);
         }
         else if (return_type == KERNEL_RETURN_BUS_ERROR)
         {
@@ -693,6 +719,7 @@ static void kernel_launch_post_cleanup(
     const uint32_t minion_mask = (shire_id == MASTER_SHIRE) ? 0xFFFF0000U : 0xFFFFFFFFU;
     const uint64_t thread_mask = (shire_id == MASTER_SHIRE) ? 0xFFFFFFFF00000000U :
                                                               0xFFFFFFFFFFFFFFFFU;
+    kernel_launch_global_info_t *global_info = &kernel_launch_global_info[kernel->slot_index];
     int8_t status;
 
     /* Enable supervisor interrupts. Now the IPIs will trap to trap handler */
@@ -704,7 +731,7 @@ static void kernel_launch_post_cleanup(
         Trace_Update_UMode_Buffer_Header();
     }
 
-    process_kernel_completion_status(return_value, return_type);
+    process_kernel_completion_status(kernel->slot_index, return_value, return_type);
 
     /* Wait for memory accesses and tensor ops */
     WAIT_FOR_MEM_AND_TENSOR_OPS
@@ -731,7 +758,7 @@ static void kernel_launch_post_cleanup(
     if ((prev_completed_threads | (1ULL << thread_id)) == thread_mask)
     {
         /* Decrement the kernel launch shire count */
-        uint64_t prev_shire_mask = kernel_launch_reset_shire_mask(shire_id);
+        uint64_t prev_shire_mask = kernel_launch_reset_shire_mask(kernel->slot_index, shire_id);
         uint32_t exec_status = kernel_info_get_execution_status(shire_id);
 
         Log_Write(LOG_LEVEL_DEBUG, "kernel_launch_post_cleanup:All harts returned:Shire:%d\r\n",
@@ -742,8 +769,8 @@ static void kernel_launch_post_cleanup(
         {
             /* Collect the first error generated by a shire
             involved in kernel launch and save it globally */
-            atomic_compare_and_exchange_global_32(&kernel_launch_global_execution_status,
-                KERNEL_COMPLETE_STATUS_SUCCESS, exec_status);
+            atomic_compare_and_exchange_global_32(
+                &global_info->execution_status, KERNEL_COMPLETE_STATUS_SUCCESS, exec_status);
         }
 
         /* Disable Supervisor global interrupts just before sending msg (possibly) to MM */
@@ -756,23 +783,22 @@ static void kernel_launch_post_cleanup(
             msg.header.id = CM_TO_MM_MESSAGE_ID_KERNEL_COMPLETE;
             msg.shire_id = shire_id;
             msg.slot_index = kernel->slot_index;
-            msg.status = atomic_load_global_32(&kernel_launch_global_execution_status);
+            msg.status = atomic_load_global_32(&global_info->execution_status);
 
             if (msg.status != KERNEL_COMPLETE_STATUS_SUCCESS)
             {
-                msg.exception_mask = atomic_load_global_64(&kernel_launch_global_exception_mask);
-                msg.system_abort_mask =
-                    atomic_load_global_64(&kernel_launch_global_system_abort_mask);
+                msg.exception_mask = atomic_load_global_64(&global_info->exception_mask);
+                msg.system_abort_mask = atomic_load_global_64(&global_info->system_abort_mask);
             }
 
             Log_Write(LOG_LEVEL_DEBUG,
                 "kernel_launch_post_cleanup:Kernel launch complete:Shire:%d\r\n", shire_id);
 
-            /* Send the message to KW */
-            status =
-                CM_To_MM_Iface_Unicast_Send((uint64_t)(kernel->kw_base_id + kernel->slot_index),
-                    (uint64_t)(CM_MM_KW_HART_UNICAST_BUFF_BASE_IDX + kernel->slot_index),
-                    (cm_iface_message_t *)&msg);
+            /* Send the message to KW. KWs run on the first hart of consecutive minions */
+            status = CM_To_MM_Iface_Unicast_Send(
+                (uint64_t)(kernel->kw_base_id + (kernel->slot_index * HARTS_PER_MINION)),
+                (uint64_t)(CM_MM_KW_HART_UNICAST_BUFF_BASE_IDX + kernel->slot_index),
+                (cm_iface_message_t *)&msg);
 
             if (status != STATUS_SUCCESS)
             {
@@ -278,6 +278,11 @@ RESERVED
 */
 #define STATW_ERROR_UPDATE_PMU_SAMPLING_STATE_TIMEOUT -1502
 
+/*! \def STATW_ERROR_GET_DMA_CHAN_STATS_INVALID_ARG
+    \brief Stat Worker - Get DMA channel stats invalid argument
+*/
+#define STATW_ERROR_GET_DMA_CHAN_STATS_INVALID_ARG -1503
+
 /*************************************
  * Define Trace error codes.         *
  *************************************/
@@ -415,6 +420,16 @@ RESERVED
 */
 #define HOST_CMD_ERROR_CM_RESET_FAILED -2008
 
+/*! \def HOST_CMD_ERROR_CQ_COALESCE_INVALID_COUNT
+    \brief Host command handler - Completion coalescing count above the maximum
+*/
+#define HOST_CMD_ERROR_CQ_COALESCE_INVALID_COUNT -2009
+
+/*! \def HOST_CMD_ERROR_CQ_COALESCE_INVALID_TIMEOUT
+    \brief Host command handler - Invalid completion coalescing timeout
+*/
+#define HOST_CMD_ERROR_CQ_COALESCE_INVALID_TIMEOUT -2010
+
 /**************************************
  * Define Software Timer error codes. *
  **************************************/
@@ -135,6 +135,13 @@ enum class TraceBufferType {
   TraceBufferTypeNum
 };
 
+/// \brief This struct describes a command for the MM, see `sendCommandsMasterMinion()`
+struct DEVICE_LAYER_EXPORT CmdDescMM {
+  std::byte* command_; ///< buffer which contains the command itself
+  size_t commandSize_; ///< size of the command + payload buffer
+  CmdFlagMM flags_;    ///< command options
+};
+
 class DEVICE_LAYER_EXPORT Exception : public dbg::StackException {
   using dbg::StackException::StackException;
 };
@@ -234,6 +241,27 @@ public:
   ///
   virtual bool receiveResponseServiceProcessor(int device, std::vector<std::byte>& response) = 0;
 
+  /// \brief Sends several commands to the same master minion submission queue, in order. Implementations can write
+  /// them all before notifying the device; by default they are sent one by one with `sendCommandMasterMinion()`. It stops
+  /// at the first command which doesn't fit in the queue, the caller should send it and the following ones later, as
+  /// with `sendCommandMasterMinion()`.
+  ///
+  /// @param[in] device indicating which device to send the commands.
+  /// @param[in] sqIdx indicates which submission queue to send the commands to.
+  /// @param[in] commands array of commands to send. All of them must have the same `isHpSq_` flag.
+  /// @param[in] count number of commands in the array.
+  ///
+  /// @returns the number of commands sent, from the beginning of the array
+  ///
+  virtual size_t sendCommandsMasterMinion(int device, int sqIdx, const CmdDescMM* commands, size_t count) {
+    size_t sent = 0;
+    while (sent < count && sendCommandMasterMinion(device, sqIdx, commands[sent].command_,
+                                                   commands[sent].commandSize_, commands[sent].flags_)) {
+      ++sent;
+    }
+    return sent;
+  }
+
   /// \brief Virtual Destructor to enable polymorphic release of the IDeviceAsync instances.
   virtual ~IDeviceAsync() = default;
 };
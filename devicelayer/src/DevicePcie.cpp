@@ -4,12 +4,14 @@
  *-------------------------------------------------------------------------*/
 #include "DevicePcie.h"
 #include "Utils.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <dirent.h>
 #include <fcntl.h>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <mutex>
 #include <regex>
 #include <stdio.h>
@@ -351,6 +353,11 @@ void DevicePcie::setupDeviceInfo(int device, DevInfo& deviceInfo, bool enableMgm
     wrap_ioctl(deviceInfo.fdOps_, ETSOC1_IOCTL_GET_SQ_COUNT, &deviceInfo.mmSqCount_);
     wrap_ioctl(deviceInfo.fdOps_, ETSOC1_IOCTL_GET_SQ_MAX_MSG_SIZE, &deviceInfo.mmSqMaxMsgSize_);
     wrap_ioctl(deviceInfo.fdOps_, ETSOC1_IOCTL_GET_P2PDMA_DEVICE_COMPAT_BITMAP, &deviceInfo.p2pCompatBitmap_);
+    // An empty list is rejected with EINVAL by the drivers which know ETSOC1_IOCTL_PUSH_SQ_LIST, older ones fail with
+    // ENOTTY
+    cmd_desc_list emptyList{nullptr, 0};
+    deviceInfo.pushSqListSupported_ =
+      ::ioctl(deviceInfo.fdOps_, ETSOC1_IOCTL_PUSH_SQ_LIST, &emptyList) == 0 || errno != ENOTTY;
 
     logs << std::endl;
     logInfoLine(logs, "PCIe target:", path);
@@ -674,6 +681,35 @@ bool DevicePcie::sendCommandMasterMinion(int device, int sqIdx, std::byte* comma
   return wrap_ioctl(deviceInfo.fdOps_, ETSOC1_IOCTL_PUSH_SQ, &cmdInfo);
 }
 
+size_t DevicePcie::sendCommandsMasterMinion(int device, int sqIdx, const CmdDescMM* commands, size_t count) {
+  CHECK_OPS_ENABLED();
+  CHECK_VALID_DEVICE(device);
+  const auto& deviceInfo = devices_[static_cast<unsigned long>(device)];
+  if (!deviceInfo.pushSqListSupported_) {
+    return IDeviceAsync::sendCommandsMasterMinion(device, sqIdx, commands, count);
+  }
+  if (sqIdx >= deviceInfo.mmSqCount_) {
+    throw Exception("Invalid queue");
+  }
+  if (count == 0) {
+    return 0;
+  }
+  count = std::min(count, static_cast<size_t>(std::numeric_limits<uint16_t>::max()));
+  std::vector<cmd_desc> cmdInfos(count);
+  for (size_t i = 0; i < count; ++i) {
+    cmdInfos[i].cmd = commands[i].command_;
+    cmdInfos[i].size = static_cast<uint16_t>(commands[i].commandSize_);
+    cmdInfos[i].sq_index = static_cast<uint16_t>(sqIdx);
+    cmdInfos[i].flags = parseCmdFlagMM(commands[i].flags_);
+  }
+  cmd_desc_list cmdList;
+  cmdList.cmds = cmdInfos.data();
+  cmdList.count = static_cast<uint16_t>(count);
+  // returns the number of commands pushed, the queue being full for the first command is not an error (EAGAIN)
+  auto res = wrap_ioctl(deviceInfo.fdOps_, ETSOC1_IOCTL_PUSH_SQ_LIST, &cmdList);
+  return res ? static_cast<size_t>(res.rc_) : 0;
+}
+
 void DevicePcie::setSqThresholdMasterMinion(int device, int sqIdx, uint32_t bytesNeeded) {
   CHECK_OPS_ENABLED();
   CHECK_VALID_DEVICE(device);
@@ -17,6 +17,7 @@ public:
 
   // IDeviceAsync
   bool sendCommandMasterMinion(int device, int sqIdx, std::byte* command, size_t commandSize, CmdFlagMM flags) override;
+  size_t sendCommandsMasterMinion(int device, int sqIdx, const CmdDescMM* commands, size_t count) override;
   void setSqThresholdMasterMinion(int device, int sqIdx, uint32_t bytesNeeded) override;
   void waitForEpollEventsMasterMinion(int device, uint64_t& sq_bitmap, bool& cq_available,
                                       std::chrono::milliseconds timeout = std::chrono::seconds(10)) override;
@@ -68,6 +69,7 @@ private:
     int fdMgmt_;
     int epFdMgmt_;
     uint64_t p2pCompatBitmap_;
+    bool pushSqListSupported_;
   };
 
   void setupDeviceInfo(int device, DevInfo& deviceInfo, bool enableMgmt, bool enableOps,
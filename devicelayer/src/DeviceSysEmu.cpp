@@ -130,9 +130,34 @@ size_t DeviceSysEmu::getTraceBufferSizeMasterMinion(int, TraceBufferType traceTy
   return traceBufSize;
 }
 
-// Stub only since SysEmu is to be deprecated
-bool DeviceSysEmu::getTraceBufferServiceProcessor(int, TraceBufferType, std::vector<std::byte>&) {
-  return false;
+bool DeviceSysEmu::getTraceBufferServiceProcessor(int, TraceBufferType traceType, std::vector<std::byte>& traceBuf) {
+  int regionType;
+  switch (traceType) {
+  case TraceBufferType::TraceBufferSP:
+    regionType = SP_DEV_INTF_MEM_REGION_TYPE_MNGT_SPFW_TRACE;
+    break;
+  case TraceBufferType::TraceBufferMM:
+    regionType = SP_DEV_INTF_MEM_REGION_TYPE_MNGT_MMFW_TRACE;
+    break;
+  case TraceBufferType::TraceBufferCM:
+    regionType = SP_DEV_INTF_MEM_REGION_TYPE_MNGT_CMFW_TRACE;
+    break;
+  case TraceBufferType::TraceBufferSPStats:
+    regionType = SP_DEV_INTF_MEM_REGION_TYPE_MNGT_SP_STATS_TRACE;
+    break;
+  case TraceBufferType::TraceBufferMMStats:
+    regionType = SP_DEV_INTF_MEM_REGION_TYPE_MNGT_MM_STATS_TRACE;
+    break;
+  default:
+    throw Exception("Unsupported trace type!");
+  }
+  const auto& region = spInfo_.mem_regions[regionType];
+  if (region.bar_size == 0) {
+    return false;
+  }
+  traceBuf.resize(region.bar_size);
+  sysEmu_->mmioRead(barAddress_[region.bar] + region.bar_offset, region.bar_size, traceBuf.data());
+  return true;
 }
 
 // Stub only since SysEmu is to be deprecated
@@ -196,46 +221,69 @@ DeviceSysEmu::~DeviceSysEmu() {
 }
 
 bool DeviceSysEmu::sendCommand(QueueInfo& queueInfo, std::byte* command, size_t commandSize, bool& clearEvent) {
+  CmdDescMM desc{command, commandSize, CmdFlagMM{}};
+  return sendCommands(queueInfo, &desc, 1, clearEvent) == 1;
+}
+
+size_t DeviceSysEmu::sendCommands(QueueInfo& queueInfo, const CmdDescMM* commands, size_t count, bool& clearEvent) {
   Checker checker{*this};
   clearEvent = true;
-  if (auto size = *reinterpret_cast<uint16_t*>(command) != commandSize) {
-    throw Exception(std::string{"Command size does not match (Header size: "} + std::to_string(size) +
-                    " command size: " + std::to_string(commandSize) + " )");
+
+  // Validate the whole batch first, the head offset is advanced as the commands are queued for writing
+  for (size_t i = 0; i < count; ++i) {
+    if (auto size = *reinterpret_cast<uint16_t*>(commands[i].command_); size != commands[i].commandSize_) {
+      throw Exception(std::string{"Command size does not match (Header size: "} + std::to_string(size) +
+                      " command size: " + std::to_string(commands[i].commandSize_) + " )");
+    }
   }
 
   // read tail_offset
   sysEmu_->mmioRead(queueInfo.bufferAddress_ + offsetof(CircBuffCb, tail_offset), sizeof(queueInfo.cb_.tail_offset),
                     reinterpret_cast<std::byte*>(&queueInfo.cb_.tail_offset));
 
-  // check if there is enough space
-  if (getAvailSpace(queueInfo.cb_) < commandSize) {
-    return false;
-  }
+  // All the commands that fit (each one in up to two parts if it wraps) and the new head offset are written in a
+  // single round trip
+  std::vector<emu::ISysEmu::MmioWrite> writes;
+  writes.reserve(2 * count + 1);
+  size_t sent = 0;
+  for (; sent < count; ++sent) {
+    auto command = commands[sent].command_;
+    auto commandSize = commands[sent].commandSize_;
+
+    // check if there is enough space
+    if (getAvailSpace(queueInfo.cb_) < commandSize) {
+      break;
+    }
 
-  // Check if buffer wrap is required
-  if (queueInfo.cb_.head_offset + commandSize > queueInfo.cb_.length) {
-    auto bytesUntilEnd = queueInfo.cb_.length - queueInfo.cb_.head_offset;
-    sysEmu_->mmioWrite(queueInfo.bufferAddress_ + sizeof(CircBuffCb) + queueInfo.cb_.head_offset, bytesUntilEnd,
-                       command);
-    queueInfo.cb_.head_offset = 0;
-    commandSize -= bytesUntilEnd;
-    command += bytesUntilEnd;
-  }
+    // Check if buffer wrap is required
+    if (queueInfo.cb_.head_offset + commandSize > queueInfo.cb_.length) {
+      auto bytesUntilEnd = queueInfo.cb_.length - queueInfo.cb_.head_offset;
+      writes.push_back(
+        {queueInfo.bufferAddress_ + sizeof(CircBuffCb) + queueInfo.cb_.head_offset, bytesUntilEnd, command});
+      queueInfo.cb_.head_offset = 0;
+      commandSize -= bytesUntilEnd;
+      command += bytesUntilEnd;
+    }
 
-  sysEmu_->mmioWrite(queueInfo.bufferAddress_ + sizeof(CircBuffCb) + queueInfo.cb_.head_offset, commandSize, command);
+    writes.push_back({queueInfo.bufferAddress_ + sizeof(CircBuffCb) + queueInfo.cb_.head_offset, commandSize, command});
+    queueInfo.cb_.head_offset = (queueInfo.cb_.head_offset + commandSize) % queueInfo.cb_.length;
+  }
+  if (sent == 0) {
+    return 0;
+  }
 
   // Update the head offset
-  queueInfo.cb_.head_offset = (queueInfo.cb_.head_offset + commandSize) % queueInfo.cb_.length;
-  sysEmu_->mmioWrite(queueInfo.bufferAddress_ + offsetof(CircBuffCb, head_offset), sizeof(queueInfo.cb_.head_offset),
-                     reinterpret_cast<std::byte*>(&queueInfo.cb_.head_offset));
+  writes.push_back({queueInfo.bufferAddress_ + offsetof(CircBuffCb, head_offset), sizeof(queueInfo.cb_.head_offset),
+                    reinterpret_cast<std::byte*>(&queueInfo.cb_.head_offset)});
+  sysEmu_->mmioWritev(writes.data(), writes.size());
 
-  // The availability of queue after the command is sent
+  // The availability of queue after the commands are sent
   if (getAvailSpace(queueInfo.cb_) >= queueInfo.thresholdBytes_) {
     clearEvent = false;
   }
 
-  DV_VLOG(LOW) << "Command sent. Sysemu ptr: " << sysEmu_.get();
-  return true;
+  DV_VLOG(LOW) << sent << " command(s) sent. Sysemu ptr: " << sysEmu_.get();
+  return sent;
 }
 
 bool DeviceSysEmu::sendCommandMasterMinion(int, int sqIdx, std::byte* command, size_t commandSize, CmdFlagMM flags) {
@@ -262,6 +310,39 @@ bool DeviceSysEmu::sendCommandMasterMinion(int, int sqIdx, std::byte* command, s
   return res;
 }
 
+size_t DeviceSysEmu::sendCommandsMasterMinion(int, int sqIdx, const CmdDescMM* commands, size_t count) {
+  if (count == 0) {
+    return 0;
+  }
+  std::lock_guard lock(mutex_);
+  Checker checker{*this};
+  auto sq_idx = static_cast<uint32_t>(sqIdx);
+  auto isHpSq = commands[0].flags_.isHpSq_;
+  if (sq_idx >= (isHpSq ? hpSubmissionQueuesMM_.size() : submissionQueuesMM_.size())) {
+    throw Exception("Invalid queue");
+  }
+  for (size_t i = 1; i < count; ++i) {
+    if (commands[i].flags_.isHpSq_ != isHpSq) {
+      throw Exception("All the commands must be sent to the same queue");
+    }
+  }
+
+  bool clearEvent = true;
+  auto sent = sendCommands(isHpSq ? hpSubmissionQueuesMM_[sq_idx] : submissionQueuesMM_[sq_idx], commands, count,
+                           clearEvent);
+  if (sent > 0) {
+    sysEmu_->raiseDevicePuPlicPcieMessageInterrupt();
+  }
+
+  // No bitmap for high priority queues
+  if (clearEvent && !isHpSq) {
+    // clear corresponding bit
+    mmSqBitmap_ &= ~(1U << sq_idx);
+  }
+
+  return sent;
+}
+
 bool DeviceSysEmu::sendCommandServiceProcessor(int, std::byte* command, size_t commandSize, CmdFlagSP) {
   std::lock_guard lock(mutex_);
   Checker checker{*this};
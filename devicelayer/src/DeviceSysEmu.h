@@ -35,6 +35,7 @@ public:
 
   // IDeviceAsync
   bool sendCommandMasterMinion(int device, int sqIdx, std::byte* command, size_t commandSize, CmdFlagMM flags) override;
+  size_t sendCommandsMasterMinion(int device, int sqIdx, const CmdDescMM* commands, size_t count) override;
   void setSqThresholdMasterMinion(int device, int sqIdx, uint32_t bytesNeeded) override;
   void waitForEpollEventsMasterMinion(int device, uint64_t& sqBitmap, bool& cqAvailable,
                                       std::chrono::milliseconds timeout = std::chrono::seconds(10)) override;
@@ -96,6 +97,8 @@ private:
   void checkSysemuLastError() const;
 
   bool sendCommand(QueueInfo& queue, std::byte* command, size_t commandSize, bool& clearEvent);
+  // returns the number of commands written, they are all published with a single head offset update
+  size_t sendCommands(QueueInfo& queue, const CmdDescMM* commands, size_t count, bool& clearEvent);
   bool receiveResponse(QueueInfo& queue, std::vector<std::byte>& response, bool& clearEvent);
 
   bool checkForEventEPOLLIN(const QueueInfo& queueInfo) const;
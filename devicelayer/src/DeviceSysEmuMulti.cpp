@@ -38,6 +38,9 @@ bool DeviceSysEmuMulti::sendCommandMasterMinion(int device, int sqIdx, std::byte
                                                 CmdFlagMM flags) {
   return getDevice(device).sendCommandMasterMinion(device, sqIdx, command, commandSize, flags);
 }
+size_t DeviceSysEmuMulti::sendCommandsMasterMinion(int device, int sqIdx, const CmdDescMM* commands, size_t count) {
+  return getDevice(device).sendCommandsMasterMinion(device, sqIdx, commands, count);
+}
 void DeviceSysEmuMulti::setSqThresholdMasterMinion(int device, int sqIdx, uint32_t bytesNeeded) {
   return getDevice(device).setSqThresholdMasterMinion(device, sqIdx, bytesNeeded);
 }
@@ -19,6 +19,12 @@ void SysEmuHostListener::memoryWriteFromHost(uint64_t address, size_t size, cons
   IHostListener::memoryWriteFromHost(address, size, src);
 }
 
+std::byte* SysEmuHostListener::hostMemoryPointer(uint64_t address, size_t size) {
+  DV_VLOG(HIGH) << "Device requested host memory pointer: addr: " << std::hex << address << ", size: " << size;
+  // Host addresses given to the device are virtual addresses of this process
+  return reinterpret_cast<std::byte*>(address);
+}
+
 std::future<void> SysEmuHostListener::getPcieReadyFuture() {
   return pcieReady_.get_future();
 }
@@ -14,6 +14,7 @@ public:
   // IHostListener interface
   void memoryReadFromHost(uint64_t address, size_t size, std::byte* dst) override;
   void memoryWriteFromHost(uint64_t address, size_t size, const std::byte* src) override;
+  std::byte* hostMemoryPointer(uint64_t address, size_t size) override;
   void pcieReady() override;
 
   void onSysemuFatalError(const std::string& error) override;
@@ -82,44 +82,24 @@ public:
     while (!lock.try_lock()) {
       // spin-lock
     }
-    auto cmd = reinterpret_cast<device_ops_api::cmn_header_t*>(command);
-    device_ops_api::rsp_header_t rsp;
-    rsp.rsp_hdr.tag_id = cmd->tag_id;
-    switch (cmd->msg_id) {
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_LAUNCH_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_LAUNCH_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_ABORT_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_ABORT_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_ABORT_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_ABORT_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONFIG_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONFIG_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONTROL_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONTROL_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CM_RESET_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CM_RESET_RSP;
-      break;
-    case device_ops_api::DEV_OPS_API_MID_CHECK_DEVICE_OPS_API_COMPATIBILITY_CMD:
-      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_API_COMPATIBILITY_RSP;
-      break;
-    default:
-      throw Exception("Please, add command with msg_id: " + std::to_string(cmd->msg_id));
-    }
-    responsesMasterMinion_[device].push(rsp);
+    pushResponseMasterMinion(device, command);
+    cvMm_.notify_all();
     return true;
   }
 
+  size_t sendCommandsMasterMinion(int device, int, const CmdDescMM* commands, size_t count) override {
+    checkDevice(device);
+    std::unique_lock lock(mmMutex_, std::defer_lock);
+    while (!lock.try_lock()) {
+      // spin-lock
+    }
+    for (size_t i = 0; i < count; ++i) {
+      pushResponseMasterMinion(device, commands[i].command_);
+    }
+    cvMm_.notify_all();
+    return count;
+  }
+
   void setSqThresholdMasterMinion(int, int, uint32_t) override {
     // does nothing in fake
   }
@@ -299,6 +279,56 @@ public:
   }
 
 private:
+  // mmMutex_ must be held
+  void pushResponseMasterMinion(int device, std::byte* command) {
+    auto cmd = reinterpret_cast<device_ops_api::cmn_header_t*>(command);
+    device_ops_api::rsp_header_t rsp;
+    rsp.rsp_hdr.tag_id = cmd->tag_id;
+    rsp.rsp_hdr.size = 0;
+    rsp.rsp_hdr.flags = 0;
+    switch (cmd->msg_id) {
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_MEMSET_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_MEMSET_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_LAUNCH_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_LAUNCH_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_ABORT_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_ABORT_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_ABORT_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_ABORT_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONFIG_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONFIG_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONTROL_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONTROL_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CM_RESET_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CM_RESET_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_CHECK_DEVICE_OPS_API_COMPATIBILITY_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_API_COMPATIBILITY_RSP;
+      break;
+    case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD:
+      rsp.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_RSP;
+      break;
+    default:
+      throw Exception("Please, add command with msg_id: " + std::to_string(cmd->msg_id));
+    }
+    responsesMasterMinion_[device].push(rsp);
+  }
+
   std::unordered_map<int, std::queue<device_ops_api::rsp_header_t>> responsesMasterMinion_;
   std::unordered_map<int, std::queue<device_ops_api::dev_mgmt_rsp_header_t>> responsesServiceProcessor_;
   std::condition_variable cvMm_;
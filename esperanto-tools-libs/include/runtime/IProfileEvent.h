@@ -71,10 +71,11 @@ enum class Class {
   SyncTime,
   IdentifyThread,
   MemoryStats,
+  Memset,
   COUNT
 };
 
-enum class ResponseType { DMARead, DMAWrite, Kernel, DMAP2P, COUNT };
+enum class ResponseType { DMARead, DMAWrite, Kernel, DMAP2P, Memset, MemcpyD2D, COUNT };
 
 Class class_from_string(const std::string& str);
 Type type_from_string(const std::string& str);
@@ -112,7 +113,7 @@ public:
   Class getClass() const;
   TimePoint getTimeStamp() const;
   std::string getThreadId() const;
-  ExtraMetadata getExtras() const;
+  const ExtraMetadata& getExtras() const;
 
   std::thread::id getNumericThreadId() const;
 
@@ -4,6 +4,7 @@
  *-------------------------------------------------------------------------*/
 #pragma once
 
+#include <istream>
 #include <ostream>
 #include <runtime/IRuntimeExport.h>
 
@@ -19,8 +20,10 @@ namespace rt {
 ///
 class ETRT_API IProfiler {
 public:
-  /// \brief Profiler user can choose what profiling output generate, Json format or Binary format
-  enum class OutputType { Json, Binary };
+  /// \brief Profiler user can choose what profiling output generate, Json format or Binary format. Compact format is
+  /// the raw encoding used by the profiler recording path, it is the cheapest to produce and can be converted later to
+  /// Json or Binary with \ref profiling::convertCompactTrace
+  enum class OutputType { Json, Binary, Compact };
 
   /// \brief Virtual Destructor to enable polymorphic release of IProfiler
   /// instances
@@ -65,6 +68,14 @@ protected:
   static thread_local std::string threadName_;
 };
 
+/// \brief Converts a trace generated with OutputType::Compact into Json or Binary output.
+///
+/// @param[in] input stream containing the compact trace. Make sure its opened in binary mode.
+/// @param[out] output stream where the converted trace will be written.
+/// @param[in] outputType must be OutputType::Json or OutputType::Binary
+///
+ETRT_API void convertCompactTrace(std::istream& input, std::ostream& output, IProfiler::OutputType outputType);
+
 } // namespace profiling
 } // namespace rt
 
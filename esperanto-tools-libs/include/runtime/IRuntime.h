@@ -69,15 +69,43 @@ public:
   ///
   void freeDevice(DeviceId device, std::byte* buffer);
 
+  /// \brief Allocates a host buffer registered for DMA with the given device. Memcpy operations (see
+  /// memcpyHostToDevice and memcpyDeviceToHost) whose host memory lies inside a registered buffer skip the CMA staging
+  /// buffer: the DMA commands read or write the registered buffer directly, so there is no extra host memcpy. The
+  /// memory is obtained from the device layer (see dev::IDeviceLayer::allocDmaBuffer), since the driver can only DMA
+  /// from buffers it has mapped.
+  ///
+  /// @param[in] device handler indicating which device will access the buffer
+  /// @param[in] size indicates the buffer size in bytes
+  ///
+  /// @returns a host memory pointer the user can read from and write to
+  ///
+  /// NOTE: in the client runtime (see IRuntime::create(const std::string&)) the buffer is shared memory mapped by the
+  /// server too; memcpies from / to it are staged by the server without reading or writing the client process. If the
+  /// server is too old to support it, a plain host buffer is returned.
+  ///
+  std::byte* registerHostBuffer(DeviceId device, size_t size);
+
+  /// \brief Unregisters and deallocates a host buffer previously obtained with registerHostBuffer. No memcpy operation
+  /// involving the buffer can be in flight.
+  ///
+  /// @param[in] device handler indicating the device the buffer was registered with
+  /// @param[in] buffer host memory pointer previously returned by registerHostBuffer
+  ///
+  void unregisterHostBuffer(DeviceId device, std::byte* buffer);
+
   /// \brief Creates a new stream and associates it to the given device. A stream is an abstraction of a "pipeline"
   /// where you can push operations (mem copies or kernel launches) and enforce the dependencies between these
-  /// operations
+  /// operations. Each stream is assigned to one of the device submission queues depending on their load and the
+  /// stream priority; an idle stream can be moved to a less loaded submission queue.
   ///
   /// @param[in] device handler indicating in which device to associate the stream
+  /// @param[in] priority latency sensitive streams avoid sharing submission queues with normal priority streams, see
+  /// \ref StreamPriority
   ///
   /// @returns a stream handler
   ///
-  StreamId createStream(DeviceId device);
+  StreamId createStream(DeviceId device, StreamPriority priority = StreamPriority::Normal);
 
   /// \brief Destroys a previously created stream
   ///
@@ -270,6 +298,46 @@ public:
   EventId memcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDst, const std::byte* d_src, std::byte* d_dst,
                                size_t size, bool barrier = true);
 
+  /// \brief Queues a memcpy operation between two buffers of the same device. The copy is done by the device itself,
+  /// no data goes through the host. The device memory must be a valid region previously allocated by a mallocDevice;
+  /// neither the addresses nor the size need to be aligned, but the source and destination regions can't overlap.
+  /// It needs a device-api 2.7 or later firmware; it throws if the checked device-api version is older (see
+  /// Options::checkDeviceApiVersion_).
+  ///
+  /// @param[in] stream handler indicating in which stream to queue the memcpy operation
+  /// @param[in] d_src device memory buffer to copy from
+  /// @param[in] d_dst device memory buffer to copy to
+  /// @param[in] size indicates the size of the memcpy
+  /// @param[in] barrier this parameter indicates if the memcpy operation should be postponed till all previous works
+  /// issued into this stream finish (a barrier). Typically the source is the result of a previous kernel, hence the
+  /// default value is true. All memcpy operations are always asynchronous.
+  ///
+  /// @returns EventId is a handler of an event which can be waited for (waitForEventId) to synchronize when the memcpy
+  /// ends.
+  ///
+  EventId memcpyDeviceToDevice(StreamId stream, const std::byte* d_src, std::byte* d_dst, size_t size,
+                               bool barrier = true);
+
+  /// \brief Queues a memset operation, which fills a device memory region with a repeated pattern. The fill is done
+  /// by the device itself, no data is transferred from the host. The device memory must be a valid region previously
+  /// allocated by a mallocDevice; neither the address nor the size need to be aligned. It needs a device-api 2.7 or
+  /// later firmware; it throws if the checked device-api version is older (see Options::checkDeviceApiVersion_).
+  ///
+  /// @param[in] stream handler indicating in which stream to queue the memset operation
+  /// @param[in] d_dst device memory buffer to fill
+  /// @param[in] pattern contains the pattern to repeat; its first patternSize little endian bytes are used, so byte i
+  /// of the region is set to byte (i % patternSize) of the pattern
+  /// @param[in] size indicates the size in bytes of the region to fill
+  /// @param[in] patternSize is the size in bytes of the pattern. Must be 1, 2, 4 or 8
+  /// @param[in] barrier this parameter indicates if the memset operation should be postponed till all previous works
+  /// issued into this stream finish (a barrier). All memset operations are always asynchronous.
+  ///
+  /// @returns EventId is a handler of an event which can be waited for (waitForEventId) to synchronize when the memset
+  /// ends.
+  ///
+  EventId memset(StreamId stream, std::byte* d_dst, uint64_t pattern, size_t size, uint32_t patternSize = 1,
+                 bool barrier = false);
+
   /// \brief This will block the caller thread until the given event is dispatched or the timeout is reached. This
   /// primitive allows to synchronize with the device execution.
   ///
@@ -380,6 +448,58 @@ public:
   ///
   bool isP2PEnabled(DeviceId one, DeviceId other) const;
 
+  /// \brief Starts capturing the stream into a graph. While capturing, kernelLaunch and memcpy operations issued into
+  /// the stream are validated and encoded into device commands but not executed; they are appended to the graph as
+  /// nodes, numbered in capture order starting at 0. The graph can be replayed any number of times with launchGraph,
+  /// paying only the patching of each command.
+  ///
+  /// Only kernel launches whose arguments are embedded in the command (see kernelLaunch) and without a core dump file
+  /// path, memcpies whose host memory lies in registered host buffers (see registerHostBuffer), memsets and memcpies
+  /// within the device can be captured; other operations throw while capturing.
+  ///
+  /// @param[in] stream handler indicating which stream to capture.
+  ///
+  /// NOTE: the events returned by the captured operations are already dispatched; use the event returned by
+  /// launchGraph to synchronize with a replay.
+  ///
+  void beginCapture(StreamId stream);
+
+  /// \brief Ends the capture started with beginCapture and returns the captured graph. The graph is immutable, except
+  /// for the kernel arguments (see setGraphKernelArgs).
+  ///
+  /// @param[in] stream handler indicating which stream was being captured.
+  ///
+  /// @returns GraphId handler of the captured graph.
+  ///
+  GraphId endCapture(StreamId stream);
+
+  /// \brief Queues all the commands of a graph into a stream, in a single batch. The stream must be associated to the
+  /// same device as the captured stream. The kernels and registered host buffers used by the graph must be kept alive
+  /// while the graph can be launched.
+  ///
+  /// @param[in] stream handler indicating in which stream to queue the graph.
+  /// @param[in] graph handler of the graph to replay.
+  ///
+  /// @returns EventId is a handler of an event which can be waited for (waitForEventId) to synchronize when all the
+  /// graph commands end.
+  ///
+  EventId launchGraph(StreamId stream, GraphId graph);
+
+  /// \brief Replaces the arguments of a captured kernel launch, for the next launchGraph calls.
+  ///
+  /// @param[in] graph handler of the graph.
+  /// @param[in] node index of the kernel launch node, in capture order.
+  /// @param[in] kernel_args buffer containing the new parameters.
+  /// @param[in] kernel_args_size size of the kernel_args buffer, it must match the size of the captured arguments.
+  ///
+  void setGraphKernelArgs(GraphId graph, size_t node, const std::byte* kernel_args, size_t kernel_args_size);
+
+  /// \brief Destroys a graph. Replays already queued are not affected.
+  ///
+  /// @param[in] graph handler of the graph to destroy.
+  ///
+  void destroyGraph(GraphId graph);
+
   /// \brief Virtual Destructor to enable polymorphic release of the runtime instances
   virtual ~IRuntime();
   ///
@@ -422,7 +542,7 @@ private:
   virtual std::byte* doMallocDevice(DeviceId device, size_t size, uint32_t alignment = kCacheLineSize) = 0;
   virtual void doFreeDevice(DeviceId device, std::byte* buffer) = 0;
 
-  virtual StreamId doCreateStream(DeviceId device) = 0;
+  virtual StreamId doCreateStream(DeviceId device, StreamPriority priority) = 0;
   virtual void doDestroyStream(StreamId stream) = 0;
 
   virtual EventId doKernelLaunch(StreamId stream, KernelId kernel, const std::byte* kernel_args,
@@ -463,6 +583,42 @@ private:
   virtual bool doIsP2PEnabled(DeviceId, DeviceId) const {
     return false;
   }
+
+  virtual std::byte* doRegisterHostBuffer(DeviceId, size_t) {
+    throw Exception("Registered host buffers are not supported by this runtime");
+  }
+
+  virtual void doUnregisterHostBuffer(DeviceId, std::byte*) {
+    throw Exception("Registered host buffers are not supported by this runtime");
+  }
+
+  virtual EventId doMemset(StreamId, std::byte*, uint64_t, size_t, uint32_t, bool) {
+    throw Exception("Memset is not supported by this runtime");
+  }
+
+  virtual EventId doMemcpyDeviceToDevice(StreamId, const std::byte*, std::byte*, size_t, bool) {
+    throw Exception("Device to device memcpy within a device is not supported by this runtime");
+  }
+
+  virtual void doBeginCapture(StreamId) {
+    throw Exception("Graph capture is not supported by this runtime");
+  }
+
+  virtual GraphId doEndCapture(StreamId) {
+    throw Exception("Graph capture is not supported by this runtime");
+  }
+
+  virtual EventId doLaunchGraph(StreamId, GraphId) {
+    throw Exception("Graph capture is not supported by this runtime");
+  }
+
+  virtual void doSetGraphKernelArgs(GraphId, size_t, const std::byte*, size_t) {
+    throw Exception("Graph capture is not supported by this runtime");
+  }
+
+  virtual void doDestroyGraph(GraphId) {
+    throw Exception("Graph capture is not supported by this runtime");
+  }
 };
 
 } // namespace rt
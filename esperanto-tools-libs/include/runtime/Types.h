@@ -8,6 +8,7 @@
 
 #include <hostUtils/debug/StackException.h>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -42,11 +43,41 @@ enum class DeviceId : int {};
 /// \brief KernelId Handler
 enum class KernelId : int {};
 
+/// \brief GraphId Handler, a sequence of commands captured from a stream (see IRuntime::beginCapture)
+enum class GraphId : int {};
+
+/// \brief Scheduling priority of a stream, used to choose its submission queue (see IRuntime::createStream)
+enum class StreamPriority {
+  Normal,          /// < bulk work; shares the least loaded submission queues
+  LatencySensitive /// < placed on submission queues without normal priority streams whenever possible, so bulk work
+                   /// doesn't delay its commands
+};
+
+/// \brief How the runtime waits for device responses
+enum class ResponseReceiveMode {
+  Polling,    /// < check the completion queue at fixed intervals
+  EventDriven /// < spin for a while after the last response and then block until the device notifies that the
+              /// completion queue (or a full submission queue) became available
+};
+
+/// \brief Completion coalescing of the device submission queues: the device packs the responses of the commands of a
+/// queue in a single completion queue entry, sent once maxCompletions_ commands completed or timeout_ after the first
+/// one, whichever comes first. This trades some latency for fewer notifications with many small commands, so the
+/// queues holding latency sensitive streams opt out while they do (see StreamPriority). It needs a device-api 2.7 or
+/// later firmware: the runtime checks the device-api version when it's enabled, regardless of
+/// Options::checkDeviceApiVersion_, and disables it with a warning otherwise
+struct CompletionCoalescing {
+  uint16_t maxCompletions_ = 0;            /// < completions packed per response, 0 or 1 disables the coalescing
+  std::chrono::microseconds timeout_{100}; /// < maximum time a completion is held back by the device
+};
+
 /// \brief This struct will hold parametrization options for Runtime instantiation
 struct ETRT_API Options {
   bool checkMemcpyDeviceOperations_; /// < if set, the runtime will inspect all memcpy operations and throw an
                                      /// exception if invalid device address/size
   bool checkDeviceApiVersion_;
+  ResponseReceiveMode responseReceiveMode_ = ResponseReceiveMode::EventDriven;
+  CompletionCoalescing completionCoalescing_ = {}; /// < disabled by default
 };
 
 /// \brief Returns the default options. See \ref Options
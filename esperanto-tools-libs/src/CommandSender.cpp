@@ -8,13 +8,19 @@
 
 #include <device-layer/IDeviceLayer.h>
 
+#include <chrono>
 #include <functional>
 #include <iomanip>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <thread>
 
 using namespace rt;
+using namespace std::chrono_literals;
+namespace {
+constexpr auto kSqFullTimeout = 1s;
+}
 
 std::string commandString(const std::vector<std::byte>& commandData);
 
@@ -37,11 +43,17 @@ template <typename List> std::string getCommandPtrs(List& commands) {
 }
 
 CommandSender::CommandSender(dev::IDeviceLayer& deviceLayer, profiling::IProfilerRecorder* profiler, int deviceId,
-                             int sqIdx)
+                             int sqIdx, bool sqEventsFromReceiver)
   : deviceLayer_(deviceLayer)
   , profiler_(profiler)
+  , callbackExecutor_(1, false, true, kMaxPendingCallbacks)
   , deviceId_(deviceId)
-  , sqIdx_(sqIdx) {
+  , sqIdx_(sqIdx)
+  , sqEventsFromReceiver_(sqEventsFromReceiver) {
+  callbackExecutor_.pushTask([deviceId, sqIdx] {
+    profiling::IProfilerRecorder::setCurrentThreadName("Device " + std::to_string(deviceId) + " SQ " +
+                                                       std::to_string(sqIdx) + " command sender callback thread");
+  });
   runner_ = std::thread{std::bind(&CommandSender::runnerFunc, this)};
 }
 void CommandSender::setOnCommandSentCallback(CommandSentCallback callback) {
@@ -49,6 +61,13 @@ void CommandSender::setOnCommandSentCallback(CommandSentCallback callback) {
   callback_ = std::move(callback);
 }
 
+void CommandSender::notifySqAvailable() {
+  SpinLock lock(mutex_);
+  sqAvailable_ = true;
+  lock.unlock();
+  condVar_.notify_one();
+}
+
 void CommandSender::send(Command command) {
   SpinLock lock(mutex_);
   RT_VLOG(MID) << "Adding command (send) " << static_cast<int>(command.eventId_) << " to the send list. Enabled? "
@@ -58,6 +77,14 @@ void CommandSender::send(Command command) {
   condVar_.notify_one();
 }
 
+void CommandSender::send(std::vector<Command> commands) {
+  SpinLock lock(mutex_);
+  RT_VLOG(MID) << "Adding " << commands.size() << " commands (send) to the send list.";
+  std::move(begin(commands), end(commands), std::back_inserter(commands_));
+  lock.unlock();
+  condVar_.notify_one();
+}
+
 void CommandSender::sendBefore(EventId existingCommand, Command command) {
   SpinLock lock(mutex_);
   RT_VLOG(MID) << "Adding command (sendBefore) " << static_cast<int>(command.eventId_) << " to the send list. Enabled? "
@@ -137,16 +164,21 @@ void CommandSender::runnerFunc() {
     try {
       SpinLock lock(mutex_);
       if (!commands_.empty() && commands_.front().isEnabled_) {
-        auto& cmd = commands_.front();
-        dev::CmdFlagMM flags;
-        flags.isDma_ = cmd.isDma_;
-        flags.isHpSq_ = false;
-        flags.isP2pDma_ = cmd.isP2P_;
-        RT_VLOG(MID) << ">>> Sending command: " << commandString(cmd.commandData_) << ". DeviceID: " << deviceId_
-                     << " SQ: " << sqIdx_ << " EventId: " << static_cast<int>(cmd.eventId_);
+        // all the consecutive enabled commands are pushed to the submission queue at once
+        batch_.clear();
+        for (auto it = begin(commands_); it != end(commands_) && it->isEnabled_; ++it) {
+          dev::CmdFlagMM flags;
+          flags.isDma_ = it->isDma_;
+          flags.isHpSq_ = false;
+          flags.isP2pDma_ = it->isP2P_;
+          RT_VLOG(MID) << ">>> Sending command: " << commandString(it->commandData_) << ". DeviceID: " << deviceId_
+                       << " SQ: " << sqIdx_ << " EventId: " << static_cast<int>(it->eventId_);
+          batch_.push_back({it->commandData_.data(), it->commandData_.size(), flags});
+        }
         profiling::ProfileEvent event(profiling::Type::Instant, profiling::Class::CommandSent);
-        if (deviceLayer_.sendCommandMasterMinion(deviceId_, sqIdx_, cmd.commandData_.data(), cmd.commandData_.size(),
-                                                 flags)) {
+        auto sent = deviceLayer_.sendCommandsMasterMinion(deviceId_, sqIdx_, batch_.data(), batch_.size());
+        for (size_t i = 0; i < sent; ++i) {
+          auto& cmd = commands_.front();
           RT_VLOG(LOW) << ">>> Command sent: " << commandString(cmd.commandData_) << ". DeviceID: " << deviceId_
                        << " SQ: " << sqIdx_ << " EventId: " << static_cast<int>(cmd.eventId_);
 
@@ -157,15 +189,30 @@ void CommandSender::runnerFunc() {
           profiler_->record(event);
 
           if (callback_) {
-            auto th = std::thread([callback = callback_, cmd, deviceId = deviceId_, threadId = nextCallbackThreadId_] {
-              profiling::IProfilerRecorder::setCurrentThreadName(
-                "Device " + std::to_string(deviceId) + " command sender callback thread " + std::to_string(threadId));
-              callback(&cmd);
-            });
-            th.detach();
-            nextCallbackThreadId_++;
+            sentCommands_.emplace_back(std::move(cmd));
           }
           commands_.pop_front();
+        }
+        if (!sentCommands_.empty()) {
+          // the callbacks could block the runner (back-pressure) so they are pushed without holding the lock; this way
+          // they can still call any CommandSender method
+          auto callback = callback_;
+          lock.unlock();
+          for (auto& cmd : sentCommands_) {
+            callbackExecutor_.pushTask([callback, cmd = std::move(cmd)] { callback(&cmd); });
+          }
+          sentCommands_.clear();
+        }
+        if (sent > 0) {
+          continue;
+        }
+        if (sqEventsFromReceiver_) {
+          RT_LOG(INFO) << "Submission queue " << sqIdx_
+                       << " is full. Can't send command now, blocking the thread till the queue is available.";
+          if (!condVar_.wait_for(lock, kSqFullTimeout, [this] { return !running_ || sqAvailable_; })) {
+            RT_VLOG(LOW) << "Submission queue didn't become available (timedout). Trying to send the command again.";
+          }
+          sqAvailable_ = false;
         } else {
           lock.unlock();
           RT_LOG(INFO) << "Submission queue " << sqIdx_
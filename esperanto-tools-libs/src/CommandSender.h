@@ -9,6 +9,7 @@
 #include "runtime/Types.h"
 
 #include <device-layer/IDeviceLayer.h>
+#include <hostUtils/threadPool/ThreadPool.h>
 
 #include <condition_variable>
 #include <cstddef>
@@ -34,15 +35,22 @@ struct Command {
 
 class CommandSender {
 public:
+  // callbacks are executed in a single thread per CommandSender, in the same order the commands were sent. They must
+  // not wait for commands which will be sent after them, the runner blocks when too many callbacks are pending.
   using CommandSentCallback = std::function<void(Command const*)>;
+  // if sqEventsFromReceiver is set, the sender won't wait for device events itself when the submission queue is full;
+  // instead the response receiver will call notifySqAvailable
   explicit CommandSender(dev::IDeviceLayer& deviceLayer, profiling::IProfilerRecorder* profiler, int deviceId,
-                         int sqIdx);
+                         int sqIdx, bool sqEventsFromReceiver = false);
   ~CommandSender();
 
   std::optional<EventId> getFirstDmaCommand() const;
 
   void send(Command command);
 
+  // adds all the commands at once, so the runner can push them to the submission queue in a single batch
+  void send(std::vector<Command> commands);
+
   void sendBefore(EventId existingCommand, Command command);
 
   // if the Command is not yet running, it will be removed from the queue
@@ -51,6 +59,7 @@ public:
   void setCommandData(EventId command, std::vector<std::byte> data);
   void enable(EventId command);
   void setOnCommandSentCallback(CommandSentCallback callback);
+  void notifySqAvailable();
 
   void setProfiler(profiling::IProfilerRecorder* profiler) {
     profiler_ = profiler;
@@ -66,17 +75,26 @@ private:
   CommandSender(CommandSender&&) = delete;
   CommandSender& operator=(CommandSender&&) = delete;
 
+  // sent callbacks that can be queued in callbackExecutor_, the runner blocks when there are more
+  static constexpr size_t kMaxPendingCallbacks = 1024U;
+
   void runnerFunc();
   mutable std::mutex mutex_;
   std::list<Command> commands_;
+  // descriptors of the enabled commands at the front of commands_, only used by the runner thread
+  std::vector<dev::CmdDescMM> batch_;
+  // commands sent while a callback was set, only used by the runner thread
+  std::vector<Command> sentCommands_;
   std::thread runner_;
   std::condition_variable condVar_;
   dev::IDeviceLayer& deviceLayer_;
   profiling::IProfilerRecorder* profiler_;
   CommandSentCallback callback_;
-  int nextCallbackThreadId_ = 0;
+  threadPool::ThreadPool callbackExecutor_;
   int deviceId_;
   int sqIdx_;
+  bool sqEventsFromReceiver_;
+  bool sqAvailable_ = false;
   bool running_ = true;
 };
 } // namespace rt
@@ -0,0 +1,274 @@
+/*-------------------------------------------------------------------------
+ * Copyright (c) 2025 Ainekko, Co.
+ * SPDX-License-Identifier: Apache-2.0
+ *-------------------------------------------------------------------------*/
+
+#include "CompactTrace.h"
+
+#include "Utils.h"
+
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace rt::profiling {
+
+namespace {
+constexpr std::array<char, 8> kMagic = {'E', 'T', 'R', 'T', 'C', 'P', 'T', 'R'};
+constexpr uint32_t kFormatVersion = 1;
+
+enum class Chunk : uint8_t { Record, Event };
+
+using ExtraValues = ProfileEvent::ExtraValues;
+
+template <typename T>
+constexpr bool kFitsInWord = std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(uint64_t);
+
+static_assert(sizeof(std::thread::id) <= sizeof(uint64_t));
+static_assert(std::variant_size_v<ExtraValues> <= std::numeric_limits<uint8_t>::max());
+
+template <typename T> void writePod(std::ostream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T> bool readPod(std::istream& stream, T& value) {
+  return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+const std::unordered_map<std::string_view, uint8_t>& getKeyIndices() {
+  static const auto s_indices = [] {
+    std::unordered_map<std::string_view, uint8_t> indices;
+    const auto& keys = getCompactTraceKeys();
+    for (size_t i = 0; i < keys.size(); ++i) {
+      indices.emplace(keys[i], static_cast<uint8_t>(i));
+    }
+    return indices;
+  }();
+  return s_indices;
+}
+
+template <size_t I = 0> ExtraValues decodeValue(size_t index, uint64_t word) {
+  if constexpr (I < std::variant_size_v<ExtraValues>) {
+    using T = std::variant_alternative_t<I, ExtraValues>;
+    if (index == I) {
+      if constexpr (kFitsInWord<T>) {
+        T value;
+        std::memcpy(static_cast<void*>(&value), &word, sizeof(T));
+        return ExtraValues{std::in_place_index<I>, value};
+      } else {
+        throw Exception("Invalid compact trace extra value type: " + std::to_string(index));
+      }
+    }
+    return decodeValue<I + 1>(index, word);
+  } else {
+    throw Exception("Invalid compact trace extra value type: " + std::to_string(index));
+  }
+}
+} // namespace
+
+const std::vector<std::string>& getCompactTraceKeys() {
+  static const std::vector<std::string> s_keys = {
+    std::string{ProfileEvent::kVersion},
+    std::string{ProfileEvent::kDuration},
+    std::string{ProfileEvent::kEventId},
+    std::string{ProfileEvent::kParentId},
+    std::string{ProfileEvent::kStreamId},
+    std::string{ProfileEvent::kDeviceId},
+    std::string{ProfileEvent::kKernelId},
+    std::string{ProfileEvent::kResponseType},
+    std::string{ProfileEvent::kLoadAddr},
+    std::string{ProfileEvent::kDeviceCmdStartTs},
+    std::string{ProfileEvent::kDeviceCmdWaitDur},
+    std::string{ProfileEvent::kDeviceCmdExecDur},
+    std::string{ProfileEvent::kTimePointSystem},
+    std::string{ProfileEvent::kServerPid},
+    std::string{ProfileEvent::kBarrier},
+    std::string{ProfileEvent::kAddress},
+    std::string{ProfileEvent::kAddressSrc},
+    std::string{ProfileEvent::kAddressDst},
+    std::string{ProfileEvent::kSize},
+    std::string{ProfileEvent::kAlignment},
+    std::string{ProfileEvent::kMemoryStatsAllocatedMem},
+    std::string{ProfileEvent::kMemoryStatsFreeMem},
+    std::string{ProfileEvent::kMemoryStatsMaxContiguousFreeMem},
+  };
+  return s_keys;
+}
+
+bool encode(const ProfileEvent& event, CompactRecord& record) {
+  const auto& extras = event.getExtras();
+  if (extras.size() > CompactRecord::kMaxExtras) {
+    return false;
+  }
+  const auto& keyIndices = getKeyIndices();
+  auto extra = begin(record.extras_);
+  for (const auto& [key, value] : extras) {
+    auto it = keyIndices.find(key);
+    if (it == end(keyIndices)) {
+      return false;
+    }
+    auto fits = std::visit(
+      [word = &extra->value_](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (kFitsInWord<T>) {
+          *word = 0;
+          std::memcpy(word, &v, sizeof(T));
+          return true;
+        } else {
+          return false;
+        }
+      },
+      value);
+    if (!fits) {
+      return false;
+    }
+    extra->key_ = it->second;
+    extra->valueIndex_ = static_cast<uint8_t>(value.index());
+    ++extra;
+  }
+  record.numExtras_ = static_cast<uint8_t>(extras.size());
+  record.timeStamp_ = event.getTimeStamp().time_since_epoch().count();
+  record.threadId_ = 0;
+  auto threadId = event.getNumericThreadId();
+  std::memcpy(&record.threadId_, &threadId, sizeof(threadId));
+  record.type_ = static_cast<uint8_t>(event.getType());
+  record.class_ = static_cast<uint8_t>(event.getClass());
+  return true;
+}
+
+ProfileEvent decode(const CompactRecord& record, const std::vector<std::string>& keys) {
+  ProfileEvent event;
+  event.setType(static_cast<Type>(record.type_));
+  event.setClass(static_cast<Class>(record.class_));
+  event.setTimeStamp(ProfileEvent::TimePoint{ProfileEvent::Duration{record.timeStamp_}});
+  std::thread::id threadId;
+  std::memcpy(static_cast<void*>(&threadId), &record.threadId_, sizeof(threadId));
+  event.setThreadId(threadId);
+
+  ProfileEvent::ExtraMetadata extras;
+  for (auto i = 0U; i < record.numExtras_; ++i) {
+    const auto& extra = record.extras_[i];
+    if (extra.key_ >= keys.size()) {
+      throw Exception("Invalid compact trace extra key: " + std::to_string(extra.key_));
+    }
+    extras.emplace(keys[extra.key_], decodeValue(extra.valueIndex_, extra.value_));
+  }
+  event.setExtras(std::move(extras));
+  return event;
+}
+
+EventArchive::EventArchive(std::ostream& stream, IProfiler::OutputType outputType) {
+  switch (outputType) {
+  case IProfiler::OutputType::Json:
+    archive_.emplace<cereal::JSONOutputArchive>(stream);
+    break;
+  case IProfiler::OutputType::Binary:
+    archive_.emplace<cereal::PortableBinaryOutputArchive>(stream);
+    break;
+  default:
+    throw Exception("Unknown profiler output type");
+  }
+}
+
+void EventArchive::write(const ProfileEvent& event) {
+  std::visit(
+    [&event](auto&& arch) {
+      using T = std::decay_t<decltype(arch)>;
+      if constexpr (!std::is_same_v<T, std::monostate>) {
+        arch(event);
+      }
+    },
+    archive_);
+}
+
+CompactTraceWriter::CompactTraceWriter(std::ostream& stream)
+  : stream_(stream) {
+  stream_.write(kMagic.data(), kMagic.size());
+  writePod(stream_, kFormatVersion);
+  const auto& keys = getCompactTraceKeys();
+  writePod(stream_, static_cast<uint32_t>(keys.size()));
+  for (const auto& key : keys) {
+    writePod(stream_, static_cast<uint32_t>(key.size()));
+    stream_.write(key.data(), static_cast<std::streamsize>(key.size()));
+  }
+}
+
+void CompactTraceWriter::write(const CompactRecord& record) {
+  writePod(stream_, Chunk::Record);
+  writePod(stream_, record);
+}
+
+void CompactTraceWriter::write(const ProfileEvent& event) {
+  std::ostringstream os(std::ios::binary);
+  {
+    cereal::PortableBinaryOutputArchive archive{os};
+    archive(event);
+  }
+  auto data = os.str();
+  writePod(stream_, Chunk::Event);
+  writePod(stream_, static_cast<uint32_t>(data.size()));
+  stream_.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+void readCompactTrace(std::istream& input, const std::function<void(const ProfileEvent&)>& onEvent) {
+  std::array<char, kMagic.size()> magic;
+  uint32_t version;
+  uint32_t numKeys;
+  if (!input.read(magic.data(), magic.size()) || magic != kMagic || !readPod(input, version) ||
+      version != kFormatVersion || !readPod(input, numKeys)) {
+    throw Exception("Invalid compact trace header");
+  }
+  std::vector<std::string> keys(numKeys);
+  for (auto& key : keys) {
+    uint32_t size;
+    if (!readPod(input, size)) {
+      throw Exception("Truncated compact trace key table");
+    }
+    key.resize(size);
+    if (!input.read(key.data(), size)) {
+      throw Exception("Truncated compact trace key table");
+    }
+  }
+
+  Chunk chunk;
+  while (readPod(input, chunk)) {
+    switch (chunk) {
+    case Chunk::Record: {
+      CompactRecord record;
+      if (!readPod(input, record)) {
+        throw Exception("Truncated compact trace record");
+      }
+      onEvent(decode(record, keys));
+      break;
+    }
+    case Chunk::Event: {
+      uint32_t size;
+      if (!readPod(input, size)) {
+        throw Exception("Truncated compact trace event");
+      }
+      std::string data(size, '\0');
+      if (!input.read(data.data(), size)) {
+        throw Exception("Truncated compact trace event");
+      }
+      std::istringstream is(data, std::ios::binary);
+      cereal::PortableBinaryInputArchive eventArchive{is};
+      ProfileEvent event;
+      eventArchive(event);
+      onEvent(event);
+      break;
+    }
+    default:
+      throw Exception("Invalid compact trace chunk: " + std::to_string(static_cast<int>(chunk)));
+    }
+  }
+}
+
+void convertCompactTrace(std::istream& input, std::ostream& output, IProfiler::OutputType outputType) {
+  EventArchive archive(output, outputType);
+  readCompactTrace(input, [&archive](const ProfileEvent& event) { archive.write(event); });
+}
+
+} // namespace rt::profiling
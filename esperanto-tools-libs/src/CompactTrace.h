@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------------
+ * Copyright (c) 2025 Ainekko, Co.
+ * SPDX-License-Identifier: Apache-2.0
+ *-------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "runtime/IProfileEvent.h"
+#include "runtime/IProfiler.h"
+
+#include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace rt::profiling {
+
+// Fixed size encoding of a ProfileEvent. Extras keys are interned as indices into the trace key table and their values
+// are stored as raw 64 bits words, so encoding an event never allocates.
+struct CompactRecord {
+  static constexpr size_t kMaxExtras = 10;
+  struct Extra {
+    uint8_t key_;
+    uint8_t valueIndex_;
+    uint64_t value_;
+  };
+  int64_t timeStamp_;
+  uint64_t threadId_;
+  uint8_t type_;
+  uint8_t class_;
+  uint8_t numExtras_;
+  std::array<Extra, kMaxExtras> extras_;
+};
+
+// Key table used when encoding. Events with extras not present here can't be encoded as a CompactRecord
+const std::vector<std::string>& getCompactTraceKeys();
+
+// Returns false if the event can't be encoded as a CompactRecord (unknown keys, string or DeviceProperties values or
+// too many extras); those events have to be kept as full ProfileEvents.
+bool encode(const ProfileEvent& event, CompactRecord& record);
+ProfileEvent decode(const CompactRecord& record, const std::vector<std::string>& keys = getCompactTraceKeys());
+
+// Writes ProfileEvents using the cereal based (Json or Binary) trace formats
+class EventArchive {
+public:
+  EventArchive(std::ostream& stream, IProfiler::OutputType outputType);
+  void write(const ProfileEvent& event);
+
+private:
+  std::variant<std::monostate, cereal::JSONOutputArchive, cereal::PortableBinaryOutputArchive> archive_;
+};
+
+// Writes a compact trace: a header with the key table, followed by CompactRecords and the full ProfileEvents which
+// couldn't be encoded. Records are stored in host byte order.
+class CompactTraceWriter {
+public:
+  explicit CompactTraceWriter(std::ostream& stream);
+  void write(const CompactRecord& record);
+  void write(const ProfileEvent& event);
+
+private:
+  std::ostream& stream_;
+};
+
+// Reads a compact trace calling onEvent for each of its events, in the order they were written
+void readCompactTrace(std::istream& input, const std::function<void(const ProfileEvent&)>& onEvent);
+
+} // namespace rt::profiling
@@ -13,6 +13,8 @@ constexpr auto kNumErrorContexts = 2080;
 constexpr auto kExceptionBufferSize = sizeof(ErrorContext) * kNumErrorContexts;
 constexpr auto kNumExecutionCacheBuffers = 5;  // initial number of execution cache buffers
 constexpr auto kAllocFactorTotalMaxMemory = 2; // this will affect the size of memory we allocate for CMA
+// difference of commands in flight between submission queues needed to move an idle stream to the less loaded one
+constexpr auto kStreamMigrationThreshold = 8U;
 
 constexpr auto kCmPrevExecutionPath = "./fw_trace_cm_last_execution";
 constexpr auto kMmPrevExecutionPath = "./fw_trace_mm_last_execution";
@@ -218,16 +218,19 @@ NoteData createNoteData(const rt::StreamError& error, const std::vector<size_t>&
 } // namespace
 
 void CoreDumper::addCodeAddress(DeviceId id, std::byte* address) {
+  std::lock_guard lock(mutex_);
   auto res = codeAddresses_[id].emplace(address);
   LOG_IF(FATAL, !res.second) << "Address already registered. This is likely a bug.";
 }
 
 void CoreDumper::removeCodeAddress(DeviceId id, std::byte* address) {
+  std::lock_guard lock(mutex_);
   auto res = codeAddresses_[id].erase(address);
   LOG_IF(FATAL, res == 0) << "Address not registered. This is likely a bug.";
 }
 
 void CoreDumper::addKernelExecution(const std::string& coreDumpPath, KernelId kernelId, EventId eventId) {
+  std::lock_guard lock(mutex_);
   if (kernelExecutions_.find(eventId) != kernelExecutions_.end()) {
     throw Exception("EventId already registered. This is likely a bug.");
   }
@@ -235,15 +238,23 @@ void CoreDumper::addKernelExecution(const std::string& coreDumpPath, KernelId ke
 }
 
 void CoreDumper::removeKernelExecution(EventId eventId) {
+  std::lock_guard lock(mutex_);
   kernelExecutions_.erase(eventId);
 }
 
 void CoreDumper::dump(EventId eventId, const std::vector<AllocationInfo>& allocations, const rt::StreamError& error,
                       RuntimeImp& runtime) {
-
-  auto it = kernelExecutions_.find(eventId);
-  if (it == end(kernelExecutions_)) {
-    return; // nothing to dump
+  // take a copy of what is needed, the dump itself issues runtime commands and must not hold the lock
+  KernelExecution execution;
+  std::set<std::byte*> codeAddresses;
+  {
+    std::lock_guard lock(mutex_);
+    auto it = kernelExecutions_.find(eventId);
+    if (it == end(kernelExecutions_)) {
+      return; // nothing to dump
+    }
+    execution = it->second;
+    codeAddresses = codeAddresses_[error.device_];
   }
   if (not error.errorContext_.has_value()) {
     RT_LOG(WARNING) << "Device error (no core dump possible). Not dumping a core without any kernel loaded.";
@@ -258,7 +269,7 @@ void CoreDumper::dump(EventId eventId, const std::vector<AllocationInfo>& alloca
 
   RT_LOG(WARNING) << "Dumping the stack is not possible yet.";
 
-  auto [kernelId, coreDumpFilePath] = it->second;
+  auto [kernelId, coreDumpFilePath] = execution;
   unused(kernelId);
 
   // try to open a writing stream
@@ -311,7 +322,7 @@ void CoreDumper::dump(EventId eventId, const std::vector<AllocationInfo>& alloca
     segmentHeader.p_type = PT_LOAD;
 
     // check if this is code or data section
-    if (codeAddresses_[device].find(address) != codeAddresses_[device].end()) {
+    if (codeAddresses.find(address) != codeAddresses.end()) {
       segmentHeader.p_flags = (PF_X | PF_R);
     } else {
       segmentHeader.p_flags = (PF_R | PF_W);
@@ -344,7 +355,7 @@ void CoreDumper::dump(EventId eventId, const std::vector<AllocationInfo>& alloca
     fileOffset += note.size();
   }
 
-  auto stream = runtime.doCreateStream(device);
+  auto stream = runtime.doCreateStream(device, StreamPriority::Normal);
 
   // Dump allocated device memory regions
   segmentIndex = 1;
@@ -6,6 +6,7 @@
 #pragma once
 #include "MemoryManager.h"
 #include "runtime/Types.h"
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -29,5 +30,6 @@ private:
 
   std::unordered_map<DeviceId, std::set<std::byte*>> codeAddresses_; // store all code addresses
   std::unordered_map<EventId, KernelExecution> kernelExecutions_;
+  std::mutex mutex_; // protects codeAddresses_ and kernelExecutions_, taken by every public method
 };
 } // namespace rt
\ No newline at end of file
@@ -17,13 +17,19 @@ using namespace rt;
 
 void EventManager::addOnDispatchCallback(OnDispatchCallback callback) {
   std::unique_lock lock(mutex_);
-  auto& events = callback.eventsWatched_;
-  events.erase(std::remove_if(begin(events), end(events), [this](EventId event) { return isDispatched(event); }),
-               end(events));
-  if (events.empty()) {
+  auto id = nextCallbackId_;
+  size_t pendingEvents = 0;
+  for (auto event : callback.eventsWatched_) {
+    if (!isDispatched(event)) {
+      watchers_[event].emplace_back(id);
+      ++pendingEvents;
+    }
+  }
+  if (pendingEvents == 0) {
     callbackExecutor_.pushTask(std::move(callback.callback_));
   } else {
-    callbacks_.emplace_back(std::move(callback));
+    ++nextCallbackId_;
+    callbacks_.emplace(id, PendingCallback{pendingEvents, std::move(callback.callback_)});
   }
 }
 
@@ -38,6 +44,18 @@ EventId EventManager::getNextId() {
 void EventManager::dispatch(EventId event) {
   EASY_FUNCTION()
   std::unique_lock lock(mutex_);
+  dispatchLocked(event);
+}
+
+void EventManager::dispatch(const std::vector<EventId>& events) {
+  EASY_FUNCTION()
+  std::unique_lock lock(mutex_);
+  for (auto event : events) {
+    dispatchLocked(event);
+  }
+}
+
+void EventManager::dispatchLocked(EventId event) {
   RT_VLOG(LOW) << "Dispatching event " << static_cast<int>(event);
   if (onflyEvents_.erase(event) != 1) {
 
@@ -54,15 +72,16 @@ void EventManager::dispatch(EventId event) {
       RT_LOG(WARNING) << ss.str();
     }
   }
-  for (auto it = begin(callbacks_); it != end(callbacks_);) {
-    auto& events = it->eventsWatched_;
-    events.erase(std::remove_if(begin(events), end(events), [event](EventId e) { return e == event; }), end(events));
-    if (events.empty()) {
-      callbackExecutor_.pushTask(std::move(it->callback_));
-      it = callbacks_.erase(it);
-    } else {
-      ++it;
+  if (auto it = watchers_.find(event); it != end(watchers_)) {
+    for (auto id : it->second) {
+      auto cb = callbacks_.find(id);
+      assert(cb != end(callbacks_));
+      if (--cb->second.pendingEvents_ == 0) {
+        callbackExecutor_.pushTask(std::move(cb->second.callback_));
+        callbacks_.erase(cb);
+      }
     }
+    watchers_.erase(it);
   }
 
   if (auto it = blockedThreads_.find(event); it != end(blockedThreads_)) {
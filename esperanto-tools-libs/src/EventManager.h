@@ -12,8 +12,8 @@
 
 #include <atomic>
 #include <condition_variable>
-#include <set>
 #include <unordered_map>
+#include <unordered_set>
 namespace rt {
 
 class EventManager {
@@ -26,6 +26,8 @@ public:
 
   EventId getNextId();
   void dispatch(EventId event);
+  // dispatches all the events at once, taking the lock a single time
+  void dispatch(const std::vector<EventId>& events);
   // returns false if the timeout is reached; true otherwise
   bool blockUntilDispatched(EventId event, std::chrono::milliseconds timeout);
   void setThrowOnMissingEvent(bool value) {
@@ -36,12 +38,23 @@ public:
   void addOnDispatchCallback(OnDispatchCallback callback);
 
 private:
+  using CallbackId = uint64_t;
+  struct PendingCallback {
+    size_t pendingEvents_; // watched events which are still on fly
+    fu2::unique_function<void()> callback_;
+  };
+
   bool isDispatched(EventId event) const;
+  // mutex_ must be held
+  void dispatchLocked(EventId event);
 
   mutable std::mutex mutex_;
   bool throwOnMissingEvent_ = false;
-  std::set<EventId> onflyEvents_;
-  std::vector<OnDispatchCallback> callbacks_;
+  std::unordered_set<EventId> onflyEvents_;
+  std::unordered_map<CallbackId, PendingCallback> callbacks_;
+  // reverse index, callbacks watching each on fly event; so dispatching only touches the callbacks which depend on it
+  std::unordered_map<EventId, std::vector<CallbackId>> watchers_;
+  CallbackId nextCallbackId_ = 0;
   std::unordered_map<EventId, std::unique_ptr<std::condition_variable>> blockedThreads_;
   std::underlying_type_t<EventId> nextEventId_ = 0;
   threadPool::ThreadPool callbackExecutor_{2};
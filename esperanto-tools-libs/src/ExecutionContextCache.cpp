@@ -49,7 +49,7 @@ ExecutionContextCache::ExecutionContextCache(RuntimeImp* runtime, int initialFre
   std::vector<std::byte> trash;
   std::fill_n(std::back_inserter(trash), bufferSize, std::byte{0xCD});
   for (auto dev : devices) {
-    auto st = runtime_->doCreateStream(dev);
+    auto st = runtime_->doCreateStream(dev, StreamPriority::Normal);
     auto [it, res] = freeBuffers_.try_emplace(dev, std::vector<Buffer*>{});
     (void)res;
     assert(res);
@@ -13,6 +13,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <device-layer/IDeviceLayer.h>
 #include <elfio/elfio.hpp>
 #include <esperanto/device-apis/operations-api/device_ops_api_cxx.h>
@@ -26,9 +27,10 @@ using namespace rt::profiling;
 
 EventId RuntimeImp::doKernelLaunch(StreamId streamId, KernelId kernelId, const std::byte* kernel_args,
                                    size_t kernel_args_size, const KernelLaunchOptionsImp& options) {
-  SpinLock lock(mutex_);
-  const auto& kernel = find(kernels_, kernelId)->second;
-  auto cfg = deviceLayer_->getDeviceConfig(static_cast<int>(kernel->deviceId_));
+  std::shared_lock kernelsLock(kernelsMutex_);
+  auto kernel = *find(kernels_, kernelId)->second;
+  kernelsLock.unlock();
+  auto cfg = deviceLayer_->getDeviceConfig(static_cast<int>(kernel.deviceId_));
   auto validMask = cfg.computeMinionShireMask_;
   if (~validMask & options.shireMask_ || !(validMask & options.shireMask_)) {
     std::stringstream ss;
@@ -62,9 +64,7 @@ EventId RuntimeImp::doKernelLaunch(StreamId streamId, KernelId kernelId, const s
     << "Kernel args size larger than " << maxSizeKernelEmbeddingParameters
     << " implies an extra DMA transfer; try to send less parameters to achieve maximum performance.";
 
-  auto streamInfo = streamManager_.getStreamInfo(streamId);
-
-  if (DeviceId{streamInfo.device_} != kernel->deviceId_) {
+  if (DeviceId{streamManager_.getStreamInfo(streamId).device_} != kernel.deviceId_) {
     throw Exception("Can't execute stream and kernel associated to a different device");
   }
 
@@ -77,13 +77,22 @@ EventId RuntimeImp::doKernelLaunch(StreamId streamId, KernelId kernelId, const s
     optionalArgSize += sizeof(StackConfiguration);
   }
 
+  auto graph = getCapturingGraph(streamId);
+  if (graph && !kernelArgsFit) {
+    throw Exception("Only kernel launches with embedded arguments can be captured");
+  }
+  if (graph && !options.coreDumpFilePath_.empty()) {
+    throw Exception("Kernel launches with core dump can't be captured");
+  }
+
   std::vector<std::byte> cmdBase(sizeof(device_ops_api::device_ops_kernel_launch_cmd_t) + optionalArgSize);
 
-  memset(cmdBase.data(), 0, sizeof(cmdBase));
+  std::memset(cmdBase.data(), 0, sizeof(cmdBase));
 
   auto cmdPtr = reinterpret_cast<device_ops_api::device_ops_kernel_launch_cmd_t*>(cmdBase.data());
 
-  auto pBuffer = executionContextCache_->allocBuffer(kernel->deviceId_);
+  // captured launches get their execution context buffer each time the graph is replayed
+  auto pBuffer = graph ? nullptr : executionContextCache_->allocBuffer(kernel.deviceId_);
   auto pPayload = reinterpret_cast<std::byte*>(cmdPtr->argument_payload);
   if (options.userTraceConfig_) {
     memcpy(pPayload, &*options.userTraceConfig_, sizeof(UserTrace));
@@ -92,7 +101,7 @@ EventId RuntimeImp::doKernelLaunch(StreamId streamId, KernelId kernelId, const s
   if (options.stackConfig_) {
     device_ops_api::kernel_user_stack_cfg_t stackCfg;
 
-    auto memManager = memoryManagers_.at(kernel->deviceId_);
+    const auto& memManager = memoryManagers_.at(kernel.deviceId_);
     auto rawStackBase = reinterpret_cast<std::byte*>(options.stackConfig_->baseAddress_);
     stackCfg.stack_base_offset = memManager.compressPointer(rawStackBase, std::log2(SIZE_4K));
     stackCfg.stack_size = static_cast<uint32_t>(options.stackConfig_->totalSize_ / SIZE_4K);
@@ -100,23 +109,19 @@ EventId RuntimeImp::doKernelLaunch(StreamId streamId, KernelId kernelId, const s
     memcpy(pPayload, &stackCfg, sizeof(device_ops_api::kernel_user_stack_cfg_t));
     pPayload += sizeof(device_ops_api::kernel_user_stack_cfg_t);
   }
+  auto argsOffset = static_cast<size_t>(pPayload - cmdBase.data());
   if (kernelArgsFit) {
     std::copy(kernel_args, kernel_args + kernel_args_size, pPayload);
   } else {
     // we must wait for parameters, but we will use kenelArgsFit instead of modified barrier user option.
     // stage parameters in host buffer
     std::copy(kernel_args, kernel_args + kernel_args_size, begin(pBuffer->hostBuffer_));
+    // the args copy stays in flight in the stream until it's done, so the launch below can't move the stream to
+    // another submission queue before it; the device only keeps the order between them within a queue
     doMemcpyHostToDevice(streamId, pBuffer->hostBuffer_.data(), pBuffer->getParametersPtr(), kernel_args_size, false,
                          defaultCmaCopyFunction);
   }
-  auto event = eventManager_.getNextId();
-  streamManager_.addEvent(streamId, event);
-  executionContextCache_->reserveBuffer(event, pBuffer);
-  if (!options.coreDumpFilePath_.empty()) {
-    coreDumper_.addKernelExecution(options.coreDumpFilePath_, kernelId, event);
-  }
 
-  cmdPtr->command_info.cmd_hdr.tag_id = static_cast<uint16_t>(event);
   cmdPtr->command_info.cmd_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_LAUNCH_CMD;
   cmdPtr->command_info.cmd_hdr.size = sizeof(device_ops_api::device_ops_kernel_launch_cmd_t);
   if (optionalArgSize > 0) {
@@ -141,16 +146,37 @@ EventId RuntimeImp::doKernelLaunch(StreamId streamId, KernelId kernelId, const s
     cmdPtr->command_info.cmd_hdr.flags |= device_ops_api::CMD_FLAGS_KERNEL_LAUNCH_USER_STACK_CFG;
   }
 
+  cmdPtr->code_start_address = kernel.getEntryAddress();
+  cmdPtr->shire_mask = options.shireMask_;
+
+  if (graph) {
+    LaunchGraph::Node node;
+    node.commands_.emplace_back(std::move(cmdBase));
+    node.isKernelLaunch_ = true;
+    node.argsOffset_ = argsOffset;
+    node.argsSize_ = kernel_args_size;
+    return captureNode(*graph, std::move(node));
+  }
+
+  auto event = eventManager_.getNextId();
+  auto streamInfo = streamManager_.getSubmissionInfo(streamId, event);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
+  executionContextCache_->reserveBuffer(event, pBuffer);
+  if (!options.coreDumpFilePath_.empty()) {
+    coreDumper_.addKernelExecution(options.coreDumpFilePath_, kernelId, event);
+  }
+
+  cmdPtr->command_info.cmd_hdr.tag_id = static_cast<uint16_t>(event);
   cmdPtr->exception_buffer = reinterpret_cast<uint64_t>(pBuffer->getExceptionContextPtr());
-  cmdPtr->code_start_address = kernel->getEntryAddress();
   cmdPtr->pointer_to_args = reinterpret_cast<uint64_t>(pBuffer->getParametersPtr());
-  cmdPtr->shire_mask = options.shireMask_;
 
   RT_VLOG(LOW) << "Pushing kernel Launch Command on SQ: " << streamInfo.vq_
                << " EventId: " << cmdPtr->command_info.cmd_hdr.tag_id << std::hex << ", parameters: 0x"
                << cmdPtr->pointer_to_args << ", PC: 0x" << cmdPtr->code_start_address << ", shireMask: 0x"
                << options.shireMask_;
-  auto& commandSender = find(commandSenders_, getCommandSenderIdx(streamInfo.device_, streamInfo.vq_))->second;
   commandSender.send(Command{cmdBase, commandSender, event, event, streamId, false, true});
 
   Sync(event);
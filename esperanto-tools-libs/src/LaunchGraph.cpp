@@ -0,0 +1,139 @@
+/*-------------------------------------------------------------------------
+ * Copyright (c) 2025 Ainekko, Co.
+ * SPDX-License-Identifier: Apache-2.0
+ *-------------------------------------------------------------------------*/
+
+#include "LaunchGraph.h"
+#include "ExecutionContextCache.h"
+#include "RuntimeImp.h"
+#include "Utils.h"
+#include <esperanto/device-apis/operations-api/device_ops_api_cxx.h>
+
+using namespace rt;
+using namespace device_ops_api;
+
+LaunchGraph* RuntimeImp::getCapturingGraph(StreamId stream) const {
+  if (numCapturingStreams_ == 0) {
+    return nullptr;
+  }
+  std::shared_lock lock(graphsMutex_);
+  if (auto it = capturingGraphs_.find(stream); it != end(capturingGraphs_)) {
+    return it->second.get();
+  }
+  return nullptr;
+}
+
+EventId RuntimeImp::captureNode(LaunchGraph& graph, LaunchGraph::Node node) {
+  {
+    std::lock_guard lock(graph.mutex_);
+    graph.nodes_.emplace_back(std::move(node));
+  }
+  // nothing is sent to the device while capturing, the operation event is dispatched right away. It was never added to
+  // the stream, so it skips dispatch(), which would try to remove it from there
+  auto evt = eventManager_.getNextId();
+  eventManager_.dispatch(evt);
+  notify(evt);
+  return evt;
+}
+
+void RuntimeImp::doBeginCapture(StreamId stream) {
+  auto streamInfo = streamManager_.getStreamInfo(stream);
+  std::unique_lock lock(graphsMutex_);
+  if (capturingGraphs_.find(stream) != end(capturingGraphs_)) {
+    throw Exception("Stream is already being captured");
+  }
+  capturingGraphs_.emplace(stream, std::make_unique<LaunchGraph>(DeviceId{streamInfo.device_}));
+  ++numCapturingStreams_;
+}
+
+GraphId RuntimeImp::doEndCapture(StreamId stream) {
+  std::unique_lock lock(graphsMutex_);
+  auto it = find(capturingGraphs_, stream, "Stream is not being captured");
+  auto graphId = GraphId{nextGraphId_++};
+  graphs_.emplace(graphId, std::move(it->second));
+  capturingGraphs_.erase(it);
+  --numCapturingStreams_;
+  RT_VLOG(LOW) << "Captured graph " << static_cast<int>(graphId) << " with " << graphs_[graphId]->nodes_.size()
+               << " nodes";
+  return graphId;
+}
+
+EventId RuntimeImp::doLaunchGraph(StreamId stream, GraphId graphId) {
+  std::shared_lock graphsLock(graphsMutex_);
+  auto graph = find(graphs_, graphId, "Invalid graph")->second;
+  graphsLock.unlock();
+
+  if (DeviceId{streamManager_.getStreamInfo(stream).device_} != graph->device_) {
+    throw Exception("Can't launch a graph on a stream associated to a different device");
+  }
+  if (getCapturingGraph(stream) != nullptr) {
+    throw Exception("Can't launch a graph on a stream which is being captured");
+  }
+
+  // kernel args can't be modified while the commands are being copied
+  std::lock_guard graphLock(graph->mutex_);
+  std::vector<ExecutionContextCache::Buffer*> buffers;
+  for (auto& node : graph->nodes_) {
+    if (node.isKernelLaunch_) {
+      buffers.emplace_back(executionContextCache_->allocBuffer(graph->device_));
+    }
+  }
+
+  auto evt = eventManager_.getNextId();
+  auto streamInfo = streamManager_.getSubmissionInfo(stream, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
+
+  std::vector<Command> commands;
+  std::vector<EventId> nodeEvents;
+  auto itBuffer = begin(buffers);
+  for (auto& node : graph->nodes_) {
+    for (auto& cmd : node.commands_) {
+      auto cmdEvt = eventManager_.getNextId();
+      streamManager_.addEvent(stream, cmdEvt);
+      auto command = cmd;
+      reinterpret_cast<cmn_header_t*>(command.data())->tag_id = static_cast<tag_id_t>(cmdEvt);
+      if (node.isKernelLaunch_) {
+        auto buffer = *itBuffer++;
+        executionContextCache_->reserveBuffer(cmdEvt, buffer);
+        auto cmdPtr = reinterpret_cast<device_ops_kernel_launch_cmd_t*>(command.data());
+        cmdPtr->exception_buffer = reinterpret_cast<uint64_t>(buffer->getExceptionContextPtr());
+        cmdPtr->pointer_to_args = reinterpret_cast<uint64_t>(buffer->getParametersPtr());
+      }
+      auto isDma = !node.isKernelLaunch_ && !node.isDeviceMemoryOp_;
+      commands.emplace_back(Command{std::move(command), commandSender, cmdEvt, evt, stream, isDma, true});
+      nodeEvents.emplace_back(cmdEvt);
+    }
+  }
+  RT_VLOG(LOW) << "Launching graph " << static_cast<int>(graphId) << " with " << commands.size()
+               << " commands. EventId: " << static_cast<int>(evt);
+  commandSender.send(std::move(commands));
+  eventManager_.addOnDispatchCallback({std::move(nodeEvents), [this, evt] { dispatch(evt); }});
+  Sync(evt);
+  return evt;
+}
+
+void RuntimeImp::doSetGraphKernelArgs(GraphId graphId, size_t node, const std::byte* kernel_args,
+                                      size_t kernel_args_size) {
+  std::shared_lock graphsLock(graphsMutex_);
+  auto graph = find(graphs_, graphId, "Invalid graph")->second;
+  graphsLock.unlock();
+
+  std::lock_guard lock(graph->mutex_);
+  if (node >= graph->nodes_.size() || !graph->nodes_[node].isKernelLaunch_) {
+    throw Exception("Graph node " + std::to_string(node) + " is not a kernel launch");
+  }
+  auto& n = graph->nodes_[node];
+  if (kernel_args_size != n.argsSize_) {
+    throw Exception("Kernel args size must be " + std::to_string(n.argsSize_) + " as when the graph was captured");
+  }
+  std::copy(kernel_args, kernel_args + kernel_args_size, n.commands_.front().data() + n.argsOffset_);
+}
+
+void RuntimeImp::doDestroyGraph(GraphId graphId) {
+  std::unique_lock lock(graphsMutex_);
+  // graphs being launched keep their own reference
+  graphs_.erase(find(graphs_, graphId, "Invalid graph"));
+}
@@ -0,0 +1,37 @@
+/*-------------------------------------------------------------------------
+ * Copyright (c) 2025 Ainekko, Co.
+ * SPDX-License-Identifier: Apache-2.0
+ *-------------------------------------------------------------------------*/
+
+#pragma once
+#include "runtime/Types.h"
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace rt {
+// commands captured from a stream (see IRuntime::beginCapture), already validated and encoded. Replaying them only
+// patches the tag ids, the execution context buffers of the kernel launches and the kernel arguments
+struct LaunchGraph {
+  struct Node {
+    // a kernel launch or a device memory op has a single command; a memcpy has one command per DMA list
+    std::vector<std::vector<std::byte>> commands_;
+    bool isKernelLaunch_ = false;
+    // memsets and device to device memcpies don't touch host memory, so they aren't sent as DMA commands
+    bool isDeviceMemoryOp_ = false;
+    // location of the embedded kernel arguments inside the kernel launch command
+    size_t argsOffset_ = 0;
+    size_t argsSize_ = 0;
+  };
+
+  explicit LaunchGraph(DeviceId device)
+    : device_(device) {
+  }
+
+  DeviceId device_;
+  std::vector<Node> nodes_;
+  // kernel arguments can be updated while the graph is being replayed
+  std::mutex mutex_;
+};
+} // namespace rt
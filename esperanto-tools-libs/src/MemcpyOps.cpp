@@ -82,25 +82,71 @@ void MemcpyCommandBuilder::clear() {
   data_.resize(offsetof(device_ops_dma_readlist_cmd_t, list));
 }
 
+std::vector<std::vector<std::byte>> RuntimeImp::encodeRegisteredMemcpy(MemcpyType type, int device,
+                                                                       const std::byte* hostAddr,
+                                                                       const std::byte* deviceAddr, size_t size,
+                                                                       bool barrier) const {
+  auto dmaInfo = deviceLayer_->getDmaInfo(device);
+  std::vector<std::vector<std::byte>> commands;
+  for (size_t pos = 0; pos < size;) {
+    MemcpyCommandBuilder builder(type, barrier, static_cast<uint32_t>(dmaInfo.maxElementCount_));
+    for (auto i = 0UL; i < dmaInfo.maxElementCount_ && pos < size; ++i) {
+      auto chunkSize = std::min(dmaInfo.maxElementSize_, size - pos);
+      builder.addOp(hostAddr + pos, deviceAddr + pos, chunkSize);
+      pos += chunkSize;
+    }
+    commands.emplace_back(builder.build());
+  }
+  return commands;
+}
+
+void RuntimeImp::sendRegisteredMemcpy(StreamId stream, CommandSender& commandSender, EventId evt,
+                                      std::vector<std::vector<std::byte>> commands) {
+  std::vector<EventId> cmdEvents;
+  for (auto& cmd : commands) {
+    auto cmdEvt = eventManager_.getNextId();
+    streamManager_.addEvent(stream, cmdEvt);
+    reinterpret_cast<cmn_header_t*>(cmd.data())->tag_id = static_cast<tag_id_t>(cmdEvt);
+    RT_VLOG(MID) << "Memcpy from / to registered host buffer. Command id: " << static_cast<int>(cmdEvt)
+                 << " parent id: " << static_cast<int>(evt);
+    commandSender.send(Command{std::move(cmd), commandSender, cmdEvt, evt, stream, true, true});
+    cmdEvents.emplace_back(cmdEvt);
+  }
+  eventManager_.addOnDispatchCallback({std::move(cmdEvents), [this, evt] { dispatch(evt); }});
+}
+
 EventId RuntimeImp::doMemcpyHostToDevice(StreamId stream, const std::byte* h_src, std::byte* d_dst, size_t size,
                                          bool barrier, const CmaCopyFunction& cmaCopyFunction) {
   auto streamInfo = streamManager_.getStreamInfo(stream);
-  SpinLock lock(mutex_);
-  if (checkMemcpyDeviceAddress_) {
-    auto& mm = memoryManagers_.at(DeviceId{streamInfo.device_});
-    mm.checkOperation(d_dst, size);
+  checkDeviceOperation(DeviceId{streamInfo.device_}, d_dst, size);
+  auto registered = isRegisteredHostBuffer(DeviceId{streamInfo.device_}, h_src, size);
+  if (auto graph = getCapturingGraph(stream)) {
+    if (!registered) {
+      throw Exception("Only memcpies from registered host buffers can be captured");
+    }
+    LaunchGraph::Node node;
+    node.commands_ = encodeRegisteredMemcpy(MemcpyType::H2D, streamInfo.device_, h_src, d_dst, size, barrier);
+    return captureNode(*graph, std::move(node));
   }
-  auto& commandSender = find(commandSenders_, getCommandSenderIdx(streamInfo.device_, streamInfo.vq_))->second;
-
   auto evt = eventManager_.getNextId();
+  streamInfo = streamManager_.getSubmissionInfo(stream, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
   RT_VLOG(LOW) << "MemcpyHostToDevice stream: " << static_cast<int>(stream) << " EventId: " << static_cast<int>(evt)
                << std::hex << " Host address: " << h_src << " Device address: " << d_dst << " Size: " << size;
-  streamManager_.addEvent(stream, evt);
+
+  if (registered) {
+    sendRegisteredMemcpy(stream, commandSender, evt,
+                         encodeRegisteredMemcpy(MemcpyType::H2D, streamInfo.device_, h_src, d_dst, size, barrier));
+    Sync(evt);
+    return evt;
+  }
 
   // start sending a "ghost" command which will be create the needed barrier in command sender until we have sent all
   // commands. This is needed because we don't know if we will have enough CMA memory to hold all commands with their
   // addresses and sizes in the queue or we will have to chunk them
-
   commandSender.send(Command{{}, commandSender, evt, evt, stream, true});
   RT_VLOG(MID) << "H2D: Added GHOST command id: " << static_cast<int>(evt) << " to CS " << &commandSender;
 
@@ -122,21 +168,35 @@ EventId RuntimeImp::doMemcpyHostToDevice(StreamId stream, const std::byte* h_src
 EventId RuntimeImp::doMemcpyDeviceToHost(StreamId stream, const std::byte* d_src, std::byte* h_dst, size_t size,
                                          bool barrier, const CmaCopyFunction& cmaCopyFunction) {
   auto streamInfo = streamManager_.getStreamInfo(stream);
-  auto& commandSender = find(commandSenders_, getCommandSenderIdx(streamInfo.device_, streamInfo.vq_))->second;
-  SpinLock lock(mutex_);
-  if (checkMemcpyDeviceAddress_) {
-    auto& mm = memoryManagers_.at(DeviceId{streamInfo.device_});
-    mm.checkOperation(d_src, size);
+  checkDeviceOperation(DeviceId{streamInfo.device_}, d_src, size);
+  auto registered = isRegisteredHostBuffer(DeviceId{streamInfo.device_}, h_dst, size);
+  if (auto graph = getCapturingGraph(stream)) {
+    if (!registered) {
+      throw Exception("Only memcpies to registered host buffers can be captured");
+    }
+    LaunchGraph::Node node;
+    node.commands_ = encodeRegisteredMemcpy(MemcpyType::D2H, streamInfo.device_, h_dst, d_src, size, barrier);
+    return captureNode(*graph, std::move(node));
   }
   auto evt = eventManager_.getNextId();
+  streamInfo = streamManager_.getSubmissionInfo(stream, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
   RT_VLOG(LOW) << "MemcpyDeviceToHost stream: " << static_cast<int>(stream) << " EventId: " << static_cast<int>(evt)
                << std::hex << " Host address: " << h_dst << " Device address: " << d_src << " Size: " << size;
-  streamManager_.addEvent(stream, evt);
+
+  if (registered) {
+    sendRegisteredMemcpy(stream, commandSender, evt,
+                         encodeRegisteredMemcpy(MemcpyType::D2H, streamInfo.device_, h_dst, d_src, size, barrier));
+    Sync(evt);
+    return evt;
+  }
 
   // start sending a "ghost" command which will be create the needed barrier in command sender until we have sent all
   // commands. This is needed because we don't know if we will have enough CMA memory to hold all commands with their
   // addresses and sizes in the queue or we will have to chunk them.
-
   commandSender.send(Command{{}, commandSender, evt, evt, stream, true});
   RT_VLOG(MID) << "D2H: Added GHOST command id: " << static_cast<int>(evt) << " to CS " << &commandSender;
 
@@ -160,20 +220,44 @@ EventId RuntimeImp::doMemcpyHostToDevice(StreamId stream, MemcpyList memcpyList,
   auto streamInfo = streamManager_.getStreamInfo(stream);
   checkList(streamInfo.device_, memcpyList);
 
-  SpinLock lock(mutex_);
-  if (checkMemcpyDeviceAddress_) {
-    auto& mm = memoryManagers_.at(DeviceId{streamInfo.device_});
-    for (auto& elem : memcpyList.operations_) {
-      mm.checkOperation(elem.dst_, elem.size_);
+  auto registered = true;
+  for (auto& elem : memcpyList.operations_) {
+    checkDeviceOperation(DeviceId{streamInfo.device_}, elem.dst_, elem.size_);
+    registered = registered && isRegisteredHostBuffer(DeviceId{streamInfo.device_}, elem.src_, elem.size_);
+  }
+  std::vector<std::byte> registeredCommand;
+  if (registered) {
+    // all the host buffers are registered, the whole list is encoded as a single command pointing directly to them
+    MemcpyCommandBuilder builder(MemcpyType::H2D, barrier,
+                                 static_cast<uint32_t>(deviceLayer_->getDmaInfo(streamInfo.device_).maxElementCount_));
+    for (auto& op : memcpyList.operations_) {
+      builder.addOp(op.src_, op.dst_, op.size_);
     }
+    registeredCommand = builder.build();
+  }
+  if (auto graph = getCapturingGraph(stream)) {
+    if (!registered) {
+      throw Exception("Only memcpy lists from registered host buffers can be captured");
+    }
+    LaunchGraph::Node node;
+    node.commands_.emplace_back(std::move(registeredCommand));
+    return captureNode(*graph, std::move(node));
   }
-
-  auto& commandSender = find(commandSenders_, getCommandSenderIdx(streamInfo.device_, streamInfo.vq_))->second;
-
   auto evt = eventManager_.getNextId();
+  streamInfo = streamManager_.getSubmissionInfo(stream, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
   RT_VLOG(LOW) << "MemcpyHostToDevice (list) stream: " << static_cast<int>(stream)
                << " EventId: " << static_cast<int>(evt);
-  streamManager_.addEvent(stream, evt);
+
+  if (registered) {
+    reinterpret_cast<cmn_header_t*>(registeredCommand.data())->tag_id = static_cast<tag_id_t>(evt);
+    commandSender.send(Command{std::move(registeredCommand), commandSender, evt, evt, stream, true, true});
+    Sync(evt);
+    return evt;
+  }
 
   commandSender.send(Command{{}, commandSender, evt, evt, stream, true});
   RT_VLOG(MID) << "H2D: Added command id: " << static_cast<int>(evt) << " to CS " << &commandSender;
@@ -197,19 +281,44 @@ EventId RuntimeImp::doMemcpyDeviceToHost(StreamId stream, MemcpyList memcpyList,
                                          const CmaCopyFunction& cmaCopyFunction) {
   auto streamInfo = streamManager_.getStreamInfo(stream);
   checkList(streamInfo.device_, memcpyList);
-  SpinLock lock(mutex_);
-  if (checkMemcpyDeviceAddress_) {
-    auto& mm = memoryManagers_.at(DeviceId{streamInfo.device_});
-    for (auto& elem : memcpyList.operations_) {
-      mm.checkOperation(elem.src_, elem.size_);
+  auto registered = true;
+  for (auto& elem : memcpyList.operations_) {
+    checkDeviceOperation(DeviceId{streamInfo.device_}, elem.src_, elem.size_);
+    registered = registered && isRegisteredHostBuffer(DeviceId{streamInfo.device_}, elem.dst_, elem.size_);
+  }
+  std::vector<std::byte> registeredCommand;
+  if (registered) {
+    // all the host buffers are registered, the whole list is encoded as a single command pointing directly to them
+    MemcpyCommandBuilder builder(MemcpyType::D2H, barrier,
+                                 static_cast<uint32_t>(deviceLayer_->getDmaInfo(streamInfo.device_).maxElementCount_));
+    for (auto& op : memcpyList.operations_) {
+      builder.addOp(op.dst_, op.src_, op.size_);
     }
+    registeredCommand = builder.build();
+  }
+  if (auto graph = getCapturingGraph(stream)) {
+    if (!registered) {
+      throw Exception("Only memcpy lists to registered host buffers can be captured");
+    }
+    LaunchGraph::Node node;
+    node.commands_.emplace_back(std::move(registeredCommand));
+    return captureNode(*graph, std::move(node));
   }
-  auto& commandSender = find(commandSenders_, getCommandSenderIdx(streamInfo.device_, streamInfo.vq_))->second;
-
   auto evt = eventManager_.getNextId();
+  streamInfo = streamManager_.getSubmissionInfo(stream, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
   RT_VLOG(LOW) << "MemcpyDeviceToHost (list) stream: " << static_cast<int>(stream)
                << " EventId: " << static_cast<int>(evt);
-  streamManager_.addEvent(stream, evt);
+
+  if (registered) {
+    reinterpret_cast<cmn_header_t*>(registeredCommand.data())->tag_id = static_cast<tag_id_t>(evt);
+    commandSender.send(Command{std::move(registeredCommand), commandSender, evt, evt, stream, true, true});
+    Sync(evt);
+    return evt;
+  }
 
   commandSender.send(Command{{}, commandSender, evt, evt, stream, true});
   RT_VLOG(MID) << "D2H: Added GHOST command id: " << static_cast<int>(evt) << " to CS " << &commandSender;
@@ -232,7 +341,6 @@ EventId RuntimeImp::doMemcpyDeviceToHost(StreamId stream, MemcpyList memcpyList,
 EventId RuntimeImp::doMemcpyDeviceToDevice(StreamId streamSrc, DeviceId deviceDst, const std::byte* d_src,
                                            std::byte* d_dst, size_t size, bool barrier) {
   auto streamInfo = streamManager_.getStreamInfo(streamSrc);
-  auto& commandSender = find(commandSenders_, getCommandSenderIdx(streamInfo.device_, streamInfo.vq_))->second;
   if (!doIsP2PEnabled(DeviceId{streamInfo.device_}, deviceDst)) {
     RT_LOG(WARNING) << "Devices " << streamInfo.device_ << " and " << static_cast<int>(deviceDst)
                     << " do not support p2p memcpy operation.";
@@ -244,19 +352,18 @@ EventId RuntimeImp::doMemcpyDeviceToDevice(StreamId streamSrc, DeviceId deviceDs
     throw Exception(ss.str());
   }
   auto dc = deviceLayer_->getDeviceConfig(static_cast<int>(deviceDst));
-  SpinLock lock(mutex_);
-  if (checkMemcpyDeviceAddress_) {
-    const auto& mmSrc = memoryManagers_.at(DeviceId{streamInfo.device_});
-    mmSrc.checkOperation(d_src, size);
+  checkDeviceOperation(DeviceId{streamInfo.device_}, d_src, size);
+  checkDeviceOperation(deviceDst, d_dst, size);
 
-    const auto& mmDst = memoryManagers_.at(deviceDst);
-    mmDst.checkOperation(d_dst, size);
-  }
   auto evt = eventManager_.getNextId();
+  streamInfo = streamManager_.getSubmissionInfo(streamSrc, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
   RT_VLOG(LOW) << "MemcpyDeviceToDevice streamSrc: " << static_cast<int>(streamSrc)
                << " Device destination: " << static_cast<int>(deviceDst) << " EventId: " << static_cast<int>(evt)
                << std::hex << " DeviceSrc address: " << d_src << " DeviceDst address: " << d_dst << " Size: " << size;
-  streamManager_.addEvent(streamSrc, evt);
 
   auto data = std::vector<std::byte>(sizeof(device_ops_p2pdma_readlist_cmd_t) + sizeof(p2pdma_read_node));
   auto dataPtr = reinterpret_cast<device_ops_p2pdma_readlist_cmd_t*>(data.data());
@@ -281,7 +388,6 @@ EventId RuntimeImp::doMemcpyDeviceToDevice(StreamId streamSrc, DeviceId deviceDs
 EventId RuntimeImp::doMemcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDst, const std::byte* d_src,
                                            std::byte* d_dst, size_t size, bool barrier) {
   auto streamInfo = streamManager_.getStreamInfo(streamDst);
-  auto& commandSender = find(commandSenders_, getCommandSenderIdx(streamInfo.device_, streamInfo.vq_))->second;
   if (!doIsP2PEnabled(DeviceId{streamInfo.device_}, deviceSrc)) {
     RT_LOG(WARNING) << "Devices " << streamInfo.device_ << " and " << static_cast<int>(deviceSrc)
                     << " do not support p2p memcpy operation.";
@@ -294,19 +400,18 @@ EventId RuntimeImp::doMemcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDs
     throw Exception(ss.str());
   }
   auto dc = deviceLayer_->getDeviceConfig(static_cast<int>(deviceSrc));
-  SpinLock lock(mutex_);
-  if (checkMemcpyDeviceAddress_) {
-    const auto& mmSrc = memoryManagers_.at(deviceSrc);
-    mmSrc.checkOperation(d_src, size);
+  checkDeviceOperation(deviceSrc, d_src, size);
+  checkDeviceOperation(DeviceId{streamInfo.device_}, d_dst, size);
 
-    const auto& mmDst = memoryManagers_.at(DeviceId{streamInfo.device_});
-    mmDst.checkOperation(d_dst, size);
-  }
   auto evt = eventManager_.getNextId();
+  streamInfo = streamManager_.getSubmissionInfo(streamDst, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
   RT_VLOG(LOW) << "MemcpyDeviceToDevice streamDst: " << static_cast<int>(streamDst)
                << " Device source: " << static_cast<int>(deviceSrc) << " EventId: " << static_cast<int>(evt) << std::hex
                << " DeviceSrc address: " << d_src << " DeviceDst address: " << d_dst << " Size: " << size;
-  streamManager_.addEvent(streamDst, evt);
 
   auto data = std::vector<std::byte>(sizeof(device_ops_p2pdma_writelist_cmd_t) + sizeof(p2pdma_write_node));
   auto dataPtr = reinterpret_cast<device_ops_p2pdma_writelist_cmd_t*>(data.data());
@@ -327,4 +432,84 @@ EventId RuntimeImp::doMemcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDs
   Sync(evt);
   return evt;
 }
+
+EventId RuntimeImp::sendDeviceMemoryCommand(StreamId stream, Stream::Info streamInfo,
+                                            std::vector<std::byte> command) {
+  if (auto graph = getCapturingGraph(stream)) {
+    LaunchGraph::Node node;
+    node.commands_.emplace_back(std::move(command));
+    node.isDeviceMemoryOp_ = true;
+    return captureNode(*graph, std::move(node));
+  }
+  auto evt = eventManager_.getNextId();
+  // the device of a stream never changes, only its queue can, so this just picks the queue to submit to
+  streamInfo = streamManager_.getSubmissionInfo(stream, evt);
+  auto commandSenderIdx = getCommandSenderIdx(streamInfo.device_, streamInfo.vq_);
+  auto& commandSender = find(commandSenders_, commandSenderIdx)->second;
+
+  SpinLock lock(submissionMutexes_.at(commandSenderIdx));
+  reinterpret_cast<cmn_header_t*>(command.data())->tag_id = static_cast<tag_id_t>(evt);
+  RT_VLOG(LOW) << "Device memory op stream: " << static_cast<int>(stream) << " EventId: " << static_cast<int>(evt)
+               << " msg id: " << reinterpret_cast<cmn_header_t*>(command.data())->msg_id;
+
+  // there is no host memory involved so it's not sent as a DMA command
+  commandSender.send(Command{std::move(command), commandSender, evt, evt, stream, false, true});
+
+  Sync(evt);
+  return evt;
+}
+
+EventId RuntimeImp::doMemset(StreamId stream, std::byte* d_dst, uint64_t pattern, size_t size, uint32_t patternSize,
+                             bool barrier) {
+  if (patternSize == 0 || patternSize > DEVICE_OPS_MEMSET_PATTERN_SIZE_MAX || (patternSize & (patternSize - 1)) != 0) {
+    throw Exception("Invalid memset pattern size: " + std::to_string(patternSize) + ". Must be 1, 2, 4 or 8");
+  }
+  if (size == 0) {
+    throw Exception("Memset size must be greater than 0");
+  }
+  checkDeviceMemoryCommandsSupported();
+  auto streamInfo = streamManager_.getStreamInfo(stream);
+  checkDeviceOperation(DeviceId{streamInfo.device_}, d_dst, size);
+
+  auto data = std::vector<std::byte>(sizeof(device_ops_memset_cmd_t));
+  auto dataPtr = reinterpret_cast<device_ops_memset_cmd_t*>(data.data());
+  dataPtr->command_info.cmd_hdr.size = static_cast<msg_size_t>(data.size());
+  dataPtr->command_info.cmd_hdr.msg_id = DEV_OPS_API_MID_DEVICE_OPS_MEMSET_CMD;
+  if (barrier) {
+    dataPtr->command_info.cmd_hdr.flags |= device_ops_api::CMD_FLAGS_BARRIER_ENABLE;
+  }
+  dataPtr->dst_device_phy_addr = reinterpret_cast<uint64_t>(d_dst);
+  dataPtr->size = size;
+  dataPtr->pattern = pattern;
+  dataPtr->pattern_size = static_cast<uint8_t>(patternSize);
+
+  return sendDeviceMemoryCommand(stream, streamInfo, std::move(data));
+}
+
+EventId RuntimeImp::doMemcpyDeviceToDevice(StreamId stream, const std::byte* d_src, std::byte* d_dst, size_t size,
+                                           bool barrier) {
+  if (size == 0) {
+    throw Exception("MemcpyDeviceToDevice size must be greater than 0");
+  }
+  if (d_src < d_dst + size && d_dst < d_src + size) {
+    throw Exception("MemcpyDeviceToDevice source and destination regions can't overlap");
+  }
+  checkDeviceMemoryCommandsSupported();
+  auto streamInfo = streamManager_.getStreamInfo(stream);
+  checkDeviceOperation(DeviceId{streamInfo.device_}, d_src, size);
+  checkDeviceOperation(DeviceId{streamInfo.device_}, d_dst, size);
+
+  auto data = std::vector<std::byte>(sizeof(device_ops_memcpy_d2d_cmd_t));
+  auto dataPtr = reinterpret_cast<device_ops_memcpy_d2d_cmd_t*>(data.data());
+  dataPtr->command_info.cmd_hdr.size = static_cast<msg_size_t>(data.size());
+  dataPtr->command_info.cmd_hdr.msg_id = DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_CMD;
+  if (barrier) {
+    dataPtr->command_info.cmd_hdr.flags |= device_ops_api::CMD_FLAGS_BARRIER_ENABLE;
+  }
+  dataPtr->src_device_phy_addr = reinterpret_cast<uint64_t>(d_src);
+  dataPtr->dst_device_phy_addr = reinterpret_cast<uint64_t>(d_dst);
+  dataPtr->size = size;
+
+  return sendDeviceMemoryCommand(stream, streamInfo, std::move(data));
+}
 } // namespace rt
@@ -45,7 +45,7 @@ MemoryManager::MemoryManager(uint64_t dramBaseAddr, size_t totalMemoryBytes, uin
     RT_LOG(WARNING) << "TotalMemoryBytes is bigger than supported, clamping it to max supported: " << std::hex
                     << totalMemoryBytes_ << " bytes.";
   }
-  free_.emplace_back(FreeChunk{0, static_cast<uint32_t>(totalMemoryBytes_ >> blockSizeLog2_)});
+  insertChunk(FreeChunk{0, static_cast<uint32_t>(totalMemoryBytes_ >> blockSizeLog2_)});
 }
 
 size_t MemoryManager::getNumAllocations() const {
@@ -66,18 +66,26 @@ void MemoryManager::sanityCheck() const {
     return std::string("Address: ") + std::to_string(allocation.first) + "Size: " + std::to_string(allocation.second);
   };
 
+  constexpr auto getChunk = [](const auto& elem) { return FreeChunk{elem.first, elem.second}; };
+
   dbg::Check(getFreeContiguousBytes() <= getFreeBytes(),
              std::string{"There are more contiguos free bytes than total free bytes!"});
-  dbg::Check(std::is_sorted(begin(free_), end(free_)), std::string{"Free list is not sorted!"});
+  dbg::Check(free_.size() == freeBySize_.size(), std::string{"Free chunk indexes have different sizes!"});
 
-  // check all chunks have valid values
+  // check all chunks have valid values and are in both indexes
   for (auto& elem : free_) {
-    dbg::Check(elem.size_ > 0, "Invalid free chunk: " + elem.str());
+    dbg::Check(elem.second > 0, "Invalid free chunk: " + getChunk(elem).str());
+    dbg::Check(freeBySize_.count({elem.second, elem.first}) == 1,
+               "Free chunk not indexed by size: " + getChunk(elem).str());
   }
   // check there are no overlapping chunks
-  for (auto current = begin(free_), next = current + 1; next != end(free_); ++current, ++next) {
-    dbg::Check(current->startAddress_ + current->size_ <= next->startAddress_,
-               "Free list overlapping chunks: \n\tChunk1: " + current->str() + " \n\tChunk2: " + next->str());
+  for (auto current = begin(free_); current != end(free_); ++current) {
+    auto next = std::next(current);
+    if (next != end(free_)) {
+      dbg::Check(current->first + current->second <= next->first, "Free list overlapping chunks: \n\tChunk1: " +
+                                                                    getChunk(*current).str() +
+                                                                    " \n\tChunk2: " + getChunk(*next).str());
+    }
   }
   // check all allocations have valid values
   for (auto& alloc : allocated_) {
@@ -97,18 +105,30 @@ void MemoryManager::sanityCheck() const {
   auto freePtr = begin(free_);
   auto allocPtr = begin(allocated_);
   while (freePtr != end(free_) && allocPtr != end(allocated_)) {
-    if (freePtr->startAddress_ > allocPtr->first) {
-      dbg::Check(allocPtr->first + allocPtr->second <= freePtr->startAddress_,
-                 "Memory collision between allocation and free chunk. \n\tFree Chunk: " + freePtr->str() +
+    if (freePtr->first > allocPtr->first) {
+      dbg::Check(allocPtr->first + allocPtr->second <= freePtr->first,
+                 "Memory collision between allocation and free chunk. \n\tFree Chunk: " + getChunk(*freePtr).str() +
                    "\n\tAllocation: " + getAllocationStr(*allocPtr));
       ++allocPtr;
     } else {
-      dbg::Check(freePtr->startAddress_ + freePtr->size_ <= allocPtr->first,
-                 "Memory collision between allocation and free chunk. \n\tFree Chunk: " + freePtr->str() +
+      dbg::Check(freePtr->first + freePtr->second <= allocPtr->first,
+                 "Memory collision between allocation and free chunk. \n\tFree Chunk: " + getChunk(*freePtr).str() +
                    "\n\tAllocation: " + getAllocationStr(*allocPtr));
       ++freePtr;
     }
   }
+  // check the free and allocated counters match the chunks and allocations
+  auto sumBlocks = [](const auto& blocks) {
+    return std::accumulate(begin(blocks), end(blocks), 0UL,
+                           [](const auto& accumulate, const auto& e) { return accumulate + e.second; });
+  };
+  dbg::Check(sumBlocks(free_) == freeBlocks_, "Free blocks count (" + std::to_string(freeBlocks_) +
+                                                ") doesn't match the free list (" + std::to_string(sumBlocks(free_)) +
+                                                ")");
+  dbg::Check(sumBlocks(allocated_) == allocatedBlocks_,
+             "Allocated blocks count (" + std::to_string(allocatedBlocks_) + ") doesn't match the allocations (" +
+               std::to_string(sumBlocks(allocated_)) + ")");
+
   // check the sum of all allocated + free space equals to total bytes
   auto freeBytes = getFreeBytes();
   auto allocatedBytes = getAllocatedBytes();
@@ -121,13 +141,11 @@ void MemoryManager::sanityCheck() const {
 }
 
 size_t MemoryManager::getFreeContiguousBytes() const {
-  if (free_.empty()) {
+  if (freeBySize_.empty()) {
     return 0UL;
   }
-  auto it = std::max_element(begin(free_), end(free_),
-                             [](const auto& one, const auto& other) { return one.size_ < other.size_; });
   auto blockSize = static_cast<size_t>(getBlockSize());
-  auto freeChunkBlocks = static_cast<size_t>(it->size_);
+  auto freeChunkBlocks = static_cast<size_t>(freeBySize_.rbegin()->first);
   return blockSize * freeChunkBlocks;
 }
 
@@ -136,59 +154,41 @@ size_t MemoryManager::getTotalMemoryBytes() const {
 }
 
 size_t MemoryManager::getFreeBytes() const {
-  return std::accumulate(begin(free_), end(free_), 0UL,
-                         [](const auto& accumulate, const auto& e) { return accumulate + e.size_; }) *
-         getBlockSize();
+  return freeBlocks_ * getBlockSize();
 }
 
 size_t MemoryManager::getAllocatedBytes() const {
-  return std::accumulate(begin(allocated_), end(allocated_), 0UL,
-                         [](const auto& accumulate, const auto& e) { return accumulate + e.second; }) *
-         getBlockSize();
+  return allocatedBlocks_ * getBlockSize();
 }
 
-void MemoryManager::addChunk(FreeChunk chunk) {
-  if (free_.empty()) {
-    free_.emplace_back(chunk);
-    return;
-  }
+void MemoryManager::insertChunk(FreeChunk chunk) {
+  free_.emplace(chunk.startAddress_, chunk.size_);
+  freeBySize_.emplace(chunk.size_, chunk.startAddress_);
+  freeBlocks_ += chunk.size_;
+}
 
-  auto tryToMerge = [](FreeChunk c, FreeChunk& target) {
-    auto c0 = c;
-    auto c1 = target;
-    if (c1.startAddress_ < c0.startAddress_) {
-      std::swap(c0, c1);
-    }
-    if (c0.startAddress_ + c0.size_ == c1.startAddress_) {
-      target.startAddress_ = c0.startAddress_;
-      target.size_ = c0.size_ + c1.size_;
-      return true;
-    }
-    return false;
-  };
+void MemoryManager::removeChunk(FreeList::iterator it) {
+  freeBySize_.erase({it->second, it->first});
+  freeBlocks_ -= it->second;
+  free_.erase(it);
+}
 
-  auto it = std::upper_bound(begin(free_), end(free_), chunk);
-  if (it == begin(free_)) {
-    // try to merge with next chunk, if not emplace at the beginning
-    if (!tryToMerge(chunk, *it)) {
-      free_.emplace(it, chunk);
-    }
-  } else if (it == end(free_)) {
-    if (!tryToMerge(chunk, *(it - 1))) {
-      free_.emplace(it, chunk);
-    }
-  } else {
-    // try to merge with prev and next
-    if (tryToMerge(chunk, *(it - 1))) {
-      // on a merge with previous chunk, then try to merge with the next too
-      if (tryToMerge(*it, *(it - 1))) {
-        // remove the it since it was merged into the previous one
-        free_.erase(it);
-      }
-    } else if (!tryToMerge(chunk, *it)) {
-      free_.emplace(it, chunk);
+void MemoryManager::addChunk(FreeChunk chunk) {
+  auto next = free_.lower_bound(chunk.startAddress_);
+  // try to merge with the previous chunk
+  if (next != begin(free_)) {
+    if (auto prev = std::prev(next); prev->first + prev->second == chunk.startAddress_) {
+      chunk.startAddress_ = prev->first;
+      chunk.size_ += prev->second;
+      removeChunk(prev);
     }
   }
+  // and with the next one
+  if (next != end(free_) && chunk.startAddress_ + chunk.size_ == next->first) {
+    chunk.size_ += next->second;
+    removeChunk(next);
+  }
+  insertChunk(chunk);
 }
 
 void MemoryManager::checkOperation(const std::byte* address, size_t size) const {
@@ -238,6 +238,7 @@ void MemoryManager::free(std::byte* ptr) {
     throw Exception("Ptr not allocated previously or double free");
   }
   addChunk(FreeChunk{it->first, it->second});
+  allocatedBlocks_ -= it->second;
   allocated_.erase(it);
   if (debugMode_) {
     sanityCheck();
@@ -258,35 +259,35 @@ std::byte* MemoryManager::malloc(size_t size, uint32_t alignment) {
 
   auto totalBlocks = countBlocks + extraBlocks;
 
-  // find a suitable chunk, if not return nullptr
-  auto it =
-    std::find_if(begin(free_), end(free_), [totalBlocks](const auto& elem) { return elem.size_ >= totalBlocks; });
-  if (it == end(free_)) {
+  // find the smallest suitable chunk (the lowest one among those with the same size), if not throw
+  auto bestFit = freeBySize_.lower_bound({totalBlocks, 0U});
+  if (bestFit == end(freeBySize_)) {
     throw Exception("Out of memory");
   }
+  auto [chunkSize, addr] = *bestFit;
+  removeChunk(free_.find(addr));
 
   // calculate the alignment in blocks
-  auto addr = it->startAddress_;
   auto tmp = reinterpret_cast<uint64_t>(uncompressPointer(addr));
   auto extraBytes = (tmp % alignment == 0) ? 0 : static_cast<uint32_t>(alignment - tmp % alignment);
 
   // fullfill the requested alignment
   auto missAlignment = extraBytes / blockSize;
 
-  // take countBlocks from freeChunk
-  it->startAddress_ += countBlocks + missAlignment;
-  it->size_ -= countBlocks + missAlignment;
-  if (it->empty()) { // we exhausted all free space, so remove the chunk
-    free_.erase(it);
+  // give back what is left of the chunk after taking countBlocks. Its neighbours are allocated, so there is no need to
+  // merge them
+  if (auto remaining = chunkSize - countBlocks - missAlignment; remaining > 0) {
+    insertChunk(FreeChunk{addr + missAlignment + countBlocks, remaining});
   }
 
   // if we needed extra blocks for alignment, add a freeChunk with those extra blocks (which are actually not used)
   if (missAlignment > 0) {
-    addChunk(FreeChunk{addr, missAlignment});
+    insertChunk(FreeChunk{addr, missAlignment});
   }
   // bookkeep the allocation and return pointer
   addr += missAlignment;
   allocated_.insert({addr, countBlocks});
+  allocatedBlocks_ += countBlocks;
 
   RT_VLOG(LOW) << "Malloc at address: " << std::hex << uncompressPointer(addr) << " size: " << std::dec << size
                << " first block index: " << addr;
@@ -11,6 +11,8 @@
 #include <cstddef>
 #include <limits>
 #include <map>
+#include <set>
+#include <utility>
 #include <vector>
 namespace rt {
 constexpr auto kBlockSize = 4096U;
@@ -89,10 +91,20 @@ private:
     return reinterpret_cast<std::byte*>(tmp);
   }
 
+  using FreeList = std::map<uint32_t, uint32_t>;
+
+  // adds a free chunk, merging it with its neighbours
   void addChunk(FreeChunk chunk);
+  // insert or remove a chunk in both free chunk indexes, keeping free blocks count
+  void insertChunk(FreeChunk chunk);
+  void removeChunk(FreeList::iterator it);
 
   std::map<uint32_t, uint32_t> allocated_;
-  std::vector<FreeChunk> free_;
+  // free chunks, indexed by start address to merge them with their neighbours and by size to find the best fit
+  FreeList free_;
+  std::set<std::pair<uint32_t, uint32_t>> freeBySize_;
+  size_t freeBlocks_ = 0;
+  size_t allocatedBlocks_ = 0;
   uint64_t dramBaseAddr_;
   size_t totalMemoryBytes_;
   uint32_t blockSizeLog2_; // size of the minimum block in log2
@@ -55,6 +55,7 @@ std::string getString(Class cls) {
     STR_PROFILING_CLASS(SyncTime)
     STR_PROFILING_CLASS(IdentifyThread)
     STR_PROFILING_CLASS(MemoryStats)
+    STR_PROFILING_CLASS(Memset)
 
   default:
     RT_LOG(WARNING) << "No stringized unknown profiling::Class. Consider adding it to " __FILE__;
@@ -90,6 +91,10 @@ std::string getString(ResponseType rspType) {
     return "Kernel";
   case ResponseType::DMAP2P:
     return "DMA P2P";
+  case ResponseType::Memset:
+    return "Memset";
+  case ResponseType::MemcpyD2D:
+    return "Memcpy D2D";
   default:
     RT_LOG(WARNING) << "No stringized unknown ResponseType. Consider adding it to " __FILE__;
     return "Unknown response type: " + std::to_string(static_cast<int>(rspType));
@@ -126,6 +131,7 @@ Class class_from_string(const std::string& str) {
     s_map[getString(Class::SyncTime)] = Class::SyncTime;
     s_map[getString(Class::IdentifyThread)] = Class::IdentifyThread;
     s_map[getString(Class::MemoryStats)] = Class::MemoryStats;
+    s_map[getString(Class::Memset)] = Class::Memset;
 
     assert(s_map.size() == static_cast<int>(Class::COUNT));
   });
@@ -154,6 +160,8 @@ ResponseType response_type_from_string(const std::string& str) {
     s_map[getString(ResponseType::DMAWrite)] = ResponseType::DMAWrite;
     s_map[getString(ResponseType::Kernel)] = ResponseType::Kernel;
     s_map[getString(ResponseType::DMAP2P)] = ResponseType::DMAP2P;
+    s_map[getString(ResponseType::Memset)] = ResponseType::Memset;
+    s_map[getString(ResponseType::MemcpyD2D)] = ResponseType::MemcpyD2D;
 
     assert(s_map.size() == static_cast<int>(ResponseType::COUNT));
   });
@@ -186,7 +194,7 @@ ProfileEvent::TimePoint ProfileEvent::getTimeStamp() const {
 std::string ProfileEvent::getThreadId() const {
   return threadId_;
 }
-ProfileEvent::ExtraMetadata ProfileEvent::getExtras() const {
+const ProfileEvent::ExtraMetadata& ProfileEvent::getExtras() const {
   return extra_;
 }
 std::thread::id ProfileEvent::getNumericThreadId() const {
@@ -7,20 +7,41 @@
 
 #include "Utils.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace rt::profiling {
 
+namespace {
+std::atomic<uint64_t> s_nextProfilerId = 0;
+// the recording path doesn't notify the IO thread, it polls the rings at this period when there is nothing to write
+constexpr auto kIdlePeriod = std::chrono::milliseconds(1);
+
+// the rings of the current thread, one per profiler it recorded to; they are retired when the thread exits so the IO
+// threads can free them
+struct ThreadRings {
+  ~ThreadRings() {
+    for (auto& [id, ring] : rings_) {
+      ring->retire();
+    }
+  }
+  std::vector<std::pair<uint64_t, std::shared_ptr<RecordRing>>> rings_;
+};
+thread_local ThreadRings t_rings;
+} // namespace
+
+ProfilerImp::ProfilerImp()
+  : id_(s_nextProfilerId++) {
+}
+
 // IProfiler interface
 void ProfilerImp::start(std::ostream& outputStream, OutputType outputType) {
   if (recording_) {
     throw Exception("Profiler was already started");
   }
   recording_ = true;
-  ioThread_ = std::thread(std::bind(&ProfilerImp::ioThread, this, outputType, &outputStream));
   ProfileEvent evt(Type::Instant, Class::StartProfiling);
   evt.setExtras({{"version", kCurrentVersion}});
-  record(std::move(evt));
 
   SpinLock lock{mutex_};
   while (!delayedEvents_.empty()) {
@@ -28,31 +49,63 @@ void ProfilerImp::start(std::ostream& outputStream, OutputType outputType) {
     events_.emplace(std::move(event));
     delayedEvents_.pop();
   }
+  lock.unlock();
+
+  // the start event is written by the IO thread before anything else
+  ioThread_ = std::thread(std::bind(&ProfilerImp::ioThread, this, outputType, &outputStream, std::move(evt)));
 }
 
 void ProfilerImp::stop() {
   if (recording_) {
-    ProfileEvent evt(Type::Instant, Class::EndProfiling);
-    record(std::move(evt));
+    SpinLock lock{mutex_};
+    endEvent_.emplace(Type::Instant, Class::EndProfiling);
     recording_ = false;
+    lock.unlock();
     cv_.notify_one();
     ioThread_.join();
   }
 }
 
+RecordRing& ProfilerImp::getThreadRing() {
+  auto& rings = t_rings.rings_;
+  for (auto it = rbegin(rings); it != rend(rings); ++it) {
+    if (it->first == id_) {
+      return *it->second;
+    }
+  }
+  // drop the rings of the profilers which were destroyed meanwhile, nobody else holds them anymore
+  rings.erase(std::remove_if(begin(rings), end(rings), [](const auto& entry) { return entry.second.use_count() == 1; }),
+              end(rings));
+  auto ring = std::make_shared<RecordRing>();
+  SpinLock lock{ringsMutex_};
+  rings_.emplace_back(ring);
+  lock.unlock();
+  rings.emplace_back(id_, ring);
+  return *ring;
+}
+
 void ProfilerImp::record(const ProfileEvent& event) {
   if (!recording_) {
     return;
   }
 
-  auto identifyThreadEvent = identifyThread();
+  auto& ring = getThreadRing();
+  auto identifyThreadEvent = identifyThread(ring);
+
+  CompactRecord record;
+  auto pushed = encode(event, record) && ring.push(record);
+  if (pushed && !identifyThreadEvent.has_value()) {
+    return;
+  }
 
   bool wasEmpty;
   {
     SpinLock lock{mutex_};
     wasEmpty = events_.empty();
 
-    events_.push(event);
+    if (!pushed) {
+      events_.push(event);
+    }
 
     if (identifyThreadEvent.has_value()) {
       events_.emplace(std::move(identifyThreadEvent.value()));
@@ -83,60 +136,102 @@ ProfilerImp::~ProfilerImp() {
   }
 }
 
-std::optional<ProfileEvent> ProfilerImp::identifyThread() {
-  if (threadName_.empty()) {
+std::optional<ProfileEvent> ProfilerImp::identifyThread(RecordRing& ring) {
+  if (threadName_.empty() || ring.threadIdentified_) {
     return std::nullopt;
   }
+  ring.threadIdentified_ = true;
 
-  SpinLock lock(identifiedThreadsMutex_);
-  auto [it, inserted] = identifiedThreads_.emplace(std::this_thread::get_id());
-  (void)it;
-  lock.unlock();
-
-  if (inserted) {
-    ProfileEvent identifyThreadEvent{Type::Instant, Class::IdentifyThread};
-    identifyThreadEvent.setThreadName(threadName_);
-    return identifyThreadEvent;
-  } else {
-    return std::nullopt;
-  }
+  ProfileEvent identifyThreadEvent{Type::Instant, Class::IdentifyThread};
+  identifyThreadEvent.setThreadName(threadName_);
+  return identifyThreadEvent;
 }
 
-void ProfilerImp::ioThread(OutputType outputType, std::ostream* stream) {
+void ProfilerImp::ioThread(OutputType outputType, std::ostream* stream, ProfileEvent startEvent) {
   profiling::IProfilerRecorder::setCurrentThreadName("Profiler IO thread");
 
-  std::variant<std::monostate, cereal::JSONOutputArchive, cereal::PortableBinaryOutputArchive> archive;
-  switch (outputType) {
-  case OutputType::Json:
-    archive.emplace<cereal::JSONOutputArchive>(*stream);
-    break;
-  case OutputType::Binary:
-    archive.emplace<cereal::PortableBinaryOutputArchive>(*stream);
-    break;
-  default:
-    throw Exception("Unknown profiler output type");
+  std::optional<EventArchive> archive;
+  std::optional<CompactTraceWriter> compactWriter;
+  if (outputType == OutputType::Compact) {
+    compactWriter.emplace(*stream);
+  } else {
+    archive.emplace(*stream, outputType);
   }
+  auto writeEvent = [&](const ProfileEvent& evt) {
+    if (CompactRecord record; compactWriter && encode(evt, record)) {
+      compactWriter->write(record);
+    } else if (compactWriter) {
+      compactWriter->write(evt);
+    } else {
+      archive->write(evt);
+    }
+  };
+  auto writeRecord = [&](const CompactRecord& record) {
+    if (compactWriter) {
+      compactWriter->write(record);
+    } else {
+      archive->write(decode(record));
+    }
+  };
+
+  writeEvent(startEvent);
+
+  std::vector<RecordRing*> rings;
+  CompactRecord record;
+  std::queue<ProfileEvent> events;
+  while (true) {
+    // everything recorded before the profiler was stopped has to be drained before finishing
+    bool stopping = !recording_;
+    bool written = false;
+
+    // this thread is the only one removing rings, so the pointers stay valid after unlocking
+    SpinLock ringsLock{ringsMutex_};
+    rings.clear();
+    for (auto& ring : rings_) {
+      rings.emplace_back(ring.get());
+    }
+    ringsLock.unlock();
+    bool anyRetired = false;
+    for (auto ring : rings) {
+      anyRetired = anyRetired || ring->isRetired();
+      while (ring->pop(record)) {
+        writeRecord(record);
+        written = true;
+      }
+    }
+    if (anyRetired) {
+      // a ring retired after its check above might still hold records, those are freed on a later iteration
+      ringsLock.lock();
+      rings_.erase(std::remove_if(begin(rings_), end(rings_),
+                                  [](const auto& ring) { return ring->isRetired() && ring->empty(); }),
+                   end(rings_));
+      ringsLock.unlock();
+    }
 
-  SpinLock lock{mutex_};
-  while (recording_ || !events_.empty()) {
-    if (events_.empty()) {
-      cv_.wait(lock, [this] { return !events_.empty() || !recording_; });
+    SpinLock lock{mutex_};
+    std::swap(events, events_);
+    lock.unlock();
+    for (; !events.empty(); events.pop()) {
+      writeEvent(events.front());
+      written = true;
+    }
+
+    if (stopping) {
+      break;
     }
-    if (!events_.empty()) {
-      auto evt = events_.front();
-      events_.pop();
-      lock.unlock();
-      std::visit(
-        [&evt](auto&& arch) {
-          using T = std::decay_t<decltype(arch)>;
-          if constexpr (!std::is_same_v<T, std::monostate>) {
-            arch(evt);
-          }
-        },
-        archive);
+    if (!written) {
       lock.lock();
+      cv_.wait_for(lock, kIdlePeriod, [this] { return !events_.empty() || !recording_; });
     }
   }
+
+  SpinLock lock{mutex_};
+  if (endEvent_.has_value()) {
+    auto endEvent = std::move(endEvent_.value());
+    endEvent_.reset();
+    lock.unlock();
+    writeEvent(endEvent);
+  }
 }
 
 } // namespace rt::profiling
@@ -5,17 +5,19 @@
 
 #pragma once
 
+#include "CompactTrace.h"
 #include "Utils.h"
 #include "runtime/IProfileEvent.h"
 #include "runtime/IProfiler.h"
 #include "runtime/IRuntime.h"
 
-#include <cereal/archives/json.hpp>
-#include <cereal/archives/portable_binary.hpp>
-
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <queue>
-#include <variant>
+#include <vector>
 
 namespace rt::profiling {
 
@@ -38,7 +40,58 @@ public:
   }
 };
 
-// Regular implementation
+// Single producer (the recording thread) single consumer (the profiler IO thread) ring of encoded events
+class RecordRing {
+public:
+  static constexpr uint64_t kSize = 1024;
+
+  // returns false if the ring is full
+  bool push(const CompactRecord& record) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == kSize) {
+      return false;
+    }
+    records_[head % kSize] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // returns false if the ring is empty
+  bool pop(CompactRecord& record) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    record = records_[tail % kSize];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return tail_.load(std::memory_order_relaxed) == head_.load(std::memory_order_acquire);
+  }
+
+  // called by the producer thread when it exits, nothing is pushed afterwards so the IO thread can free the ring once
+  // it is drained
+  void retire() {
+    retired_.store(true, std::memory_order_release);
+  }
+  bool isRetired() const {
+    return retired_.load(std::memory_order_acquire);
+  }
+
+  // only accessed by the producer thread
+  bool threadIdentified_ = false;
+
+private:
+  std::array<CompactRecord, kSize> records_;
+  alignas(64) std::atomic<uint64_t> head_ = 0;
+  alignas(64) std::atomic<uint64_t> tail_ = 0;
+  std::atomic<bool> retired_ = false;
+};
+
+// Regular implementation. Events are encoded into per thread lock-free rings of fixed size records which are drained
+// by the IO thread; events which can't be encoded (or found their ring full) go through a locked queue.
 class ETRT_API ProfilerImp : public IProfilerRecorder {
 public:
   // IProfiler interface
@@ -46,21 +99,28 @@ public:
   void stop() override;
   void record(const ProfileEvent& event) override;
   void recordNowOrAtStart(const ProfileEvent& event) override;
+  ProfilerImp();
   ~ProfilerImp() override;
 
 private:
-  void ioThread(OutputType outputType, std::ostream* stream);
-  std::optional<ProfileEvent> identifyThread();
+  void ioThread(OutputType outputType, std::ostream* stream, ProfileEvent startEvent);
+  RecordRing& getThreadRing();
+  std::optional<ProfileEvent> identifyThread(RecordRing& ring);
+
+  // unique across all profiler instances, identifies the rings of this profiler in each thread
+  const uint64_t id_;
 
   std::mutex mutex_;
   std::queue<ProfileEvent> events_;
   std::queue<ProfileEvent> delayedEvents_;
+  std::optional<ProfileEvent> endEvent_;
   std::condition_variable cv_;
   std::thread ioThread_;
-  bool recording_ = false;
+  std::atomic<bool> recording_ = false;
 
-  std::mutex identifiedThreadsMutex_;
-  std::unordered_set<std::thread::id> identifiedThreads_;
+  // shared with the recording threads, which might outlive the profiler; only the IO thread removes rings
+  std::mutex ringsMutex_;
+  std::vector<std::shared_ptr<RecordRing>> rings_;
 };
 
 } // namespace rt::profiling
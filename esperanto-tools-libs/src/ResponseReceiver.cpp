@@ -11,7 +11,7 @@
 #include <array>
 #include <chrono>
 #include <easy/profiler.h>
-#include <random>
+#include <esperanto/device-apis/operations-api/device_ops_api_cxx.h>
 #include <thread>
 #include <utility>
 
@@ -21,10 +21,61 @@ namespace {
 constexpr auto kResponsePollingIntervalWithEventsOnFly = 50us;
 constexpr auto kResponsePollingIntervalNoEventsOnFly = 500us;
 constexpr auto kResponseNumTriesBeforePolling = 1;
+// In EventDriven mode the receiver keeps polling for a while after the last response before blocking; that time is
+// doubled when a response arrives while polling and halved when it ends up blocking anyway
+constexpr std::chrono::microseconds kMinResponseSpinTime = 5us;
+constexpr std::chrono::microseconds kMaxResponseSpinTime = 200us;
+// These bound how long a missed device notification can delay a response, and how long destruction waits
+constexpr auto kWaitEventsTimeoutWithEventsOnFly = 1ms;
+constexpr auto kWaitEventsTimeoutNoEventsOnFly = 10ms;
 constexpr auto kCheckDevicesInterval = 5s;
 constexpr auto kCheckDevicesPolling = 1ms;
 } // namespace
 
+bool ResponseReceiver::receiveResponses(int deviceId, std::vector<std::byte>& buffer) {
+  int responsesCount = 0;
+  for (int i = 0; i < kResponseNumTriesBeforePolling; ++i) {
+    try {
+      while (deviceLayer_.receiveResponseMasterMinion(deviceId, buffer)) {
+        RT_VLOG(LOW) << "Got response from deviceId: " << deviceId;
+        responsesCount++;
+        auto header = reinterpret_cast<const device_ops_api::rsp_header_t*>(buffer.data());
+        if (header->rsp_hdr.msg_id == device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_BATCHED_RSP) {
+          auto batch = reinterpret_cast<const device_ops_api::device_ops_batched_rsp_t*>(buffer.data());
+          RT_VLOG(LOW) << "Batched response with " << batch->count << " responses";
+          receiverServices_->onResponsesReceived(DeviceId{deviceId}, reinterpret_cast<const std::byte*>(batch->payload),
+                                                 batch->count);
+        } else {
+          receiverServices_->onResponsesReceived(DeviceId{deviceId}, buffer.data(), 1);
+        }
+        RT_VLOG(LOW) << "Response processed";
+      }
+    } catch (const std::exception& e) {
+      RT_LOG(WARNING)
+        << "Exception in device receiver runner thread. DeviceLayer could be in a BAD STATE. Exception message: "
+        << e.what();
+    }
+  }
+  return responsesCount > 0;
+}
+
+void ResponseReceiver::waitForDeviceEvents(int deviceId, bool eventsOnFly) {
+  uint64_t sqBitmap = 0;
+  bool cqAvailable = false;
+  try {
+    deviceLayer_.waitForEpollEventsMasterMinion(
+      deviceId, sqBitmap, cqAvailable, eventsOnFly ? kWaitEventsTimeoutWithEventsOnFly : kWaitEventsTimeoutNoEventsOnFly);
+    // the command senders don't wait for device events in this mode, so they must be told about the SQs with room
+    if (sqBitmap != 0) {
+      receiverServices_->onSubmissionQueuesAvailable(DeviceId{deviceId}, sqBitmap);
+    }
+  } catch (const std::exception& e) {
+    RT_LOG(WARNING) << "Exception waiting for device events. DeviceLayer could be in a BAD STATE. Exception message: "
+                    << e.what();
+    std::this_thread::sleep_for(kResponsePollingIntervalNoEventsOnFly);
+  }
+}
+
 void ResponseReceiver::checkResponses(int deviceId) {
   EASY_THREAD_SCOPE("ResponseReceiver")
   // Max ioctl size is 14b
@@ -34,34 +85,50 @@ void ResponseReceiver::checkResponses(int deviceId) {
 
   std::vector<std::byte> buffer(kMaxMsgSize);
 
-  std::random_device rd;
-  std::mt19937 gen(rd());
+  // with a single CPU, spinning would only delay the threads that produce the responses
+  const bool spinEnabled = std::thread::hardware_concurrency() > 1;
+  auto spinTime = kMinResponseSpinTime;
+  auto spinDeadline = std::chrono::steady_clock::time_point{};
+  bool spinning = false;
 
   while (runReceiver_) {
-    int responsesCount = 0;
-    for (int i = 0; i < kResponseNumTriesBeforePolling; ++i) {
-      try {
-        while (deviceLayer_.receiveResponseMasterMinion(deviceId, buffer)) {
-          RT_VLOG(LOW) << "Got response from deviceId: " << deviceId;
-          responsesCount++;
-          receiverServices_->onResponseReceived(DeviceId{deviceId}, buffer);
-          RT_VLOG(LOW) << "Response processed";
+    auto gotResponses = receiveResponses(deviceId, buffer);
+    if (mode_ == ResponseReceiveMode::Polling) {
+      if (!gotResponses) {
+        // check if there are events on fly
+        auto eventsOnfly = receiverServices_->areEventsOnFly(DeviceId{deviceId});
+        if (!eventsOnfly) {
+          deviceLayer_.hintInactivity(deviceId);
         }
-      } catch (const std::exception& e) {
-        RT_LOG(WARNING)
-          << "Exception in device receiver runner thread. DeviceLayer could be in a BAD STATE. Exception message: "
-          << e.what();
+        std::this_thread::sleep_for(eventsOnfly ? kResponsePollingIntervalWithEventsOnFly
+                                                : kResponsePollingIntervalNoEventsOnFly);
       }
+      continue;
     }
-    if (responsesCount == 0) {
-      // check if there are events on fly
-      auto eventsOnfly = receiverServices_->areEventsOnFly(DeviceId{deviceId});
-      if (!eventsOnfly) {
-        deviceLayer_.hintInactivity(deviceId);
+
+    auto now = std::chrono::steady_clock::now();
+    if (gotResponses) {
+      if (spinning) {
+        spinTime = std::min(spinTime * 2, kMaxResponseSpinTime);
+        spinning = false;
       }
-      std::this_thread::sleep_for(eventsOnfly ? kResponsePollingIntervalWithEventsOnFly
-                                              : kResponsePollingIntervalNoEventsOnFly);
+      spinDeadline = now + spinTime;
+      continue;
+    }
+    auto eventsOnfly = receiverServices_->areEventsOnFly(DeviceId{deviceId});
+    if (spinEnabled && eventsOnfly && now < spinDeadline) {
+      spinning = true;
+      std::this_thread::yield();
+      continue;
+    }
+    if (spinning) {
+      spinTime = std::max(spinTime / 2, kMinResponseSpinTime);
+      spinning = false;
+    }
+    if (!eventsOnfly) {
+      deviceLayer_.hintInactivity(deviceId);
     }
+    waitForDeviceEvents(deviceId, eventsOnfly);
   }
 }
 
@@ -88,9 +155,11 @@ void ResponseReceiver::checkDevices() {
   }
 }
 
-ResponseReceiver::ResponseReceiver(dev::IDeviceLayer& deviceLayer, IReceiverServices* receiverServices)
+ResponseReceiver::ResponseReceiver(dev::IDeviceLayer& deviceLayer, IReceiverServices* receiverServices,
+                                   ResponseReceiveMode mode)
   : deviceLayer_(deviceLayer)
-  , receiverServices_(receiverServices) {
+  , receiverServices_(receiverServices)
+  , mode_(mode) {
 
   auto devCount = deviceLayer_.getDevicesCount();
   for (int i = 0; i < devCount; ++i) {
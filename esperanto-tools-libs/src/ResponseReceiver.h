@@ -20,9 +20,14 @@ public:
     virtual ~IReceiverServices() = default;
     virtual bool areEventsOnFly(DeviceId device) const = 0;
     virtual void checkDevice(DeviceId device) = 0;
-    virtual void onResponseReceived(DeviceId device, const std::vector<std::byte>& response) = 0;
+    // responses are packed back to back, each one starting with its own response header. A batched response from the
+    // device (see CompletionCoalescing) is unpacked by the receiver, so its responses are processed in a single call
+    virtual void onResponsesReceived(DeviceId device, const std::byte* responses, size_t count) = 0;
+    // only called in ResponseReceiveMode::EventDriven, where the receiver is the one waiting for device events
+    virtual void onSubmissionQueuesAvailable(DeviceId device, uint64_t sqBitmap) = 0;
   };
-  explicit ResponseReceiver(dev::IDeviceLayer& deviceLayer, IReceiverServices* receiverServices);
+  explicit ResponseReceiver(dev::IDeviceLayer& deviceLayer, IReceiverServices* receiverServices,
+                            ResponseReceiveMode mode = ResponseReceiveMode::EventDriven);
 
   void startDeviceChecker();
 
@@ -31,6 +36,9 @@ public:
 private:
   void checkResponses(int deviceId);
   void checkDevices();
+  // returns false if there were no responses to receive
+  bool receiveResponses(int deviceId, std::vector<std::byte>& buffer);
+  void waitForDeviceEvents(int deviceId, bool eventsOnFly);
 
   std::vector<std::thread> receivers_;
   std::thread deviceChecker_;
@@ -38,5 +46,6 @@ private:
   bool runReceiver_ = true;
   dev::IDeviceLayer& deviceLayer_;
   IReceiverServices* receiverServices_;
+  ResponseReceiveMode mode_;
 };
 } // namespace rt
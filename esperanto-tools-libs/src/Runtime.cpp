@@ -59,10 +59,20 @@ void IRuntime::freeDevice(DeviceId device, std::byte* buffer) {
   doFreeDevice(device, buffer);
 }
 
-StreamId IRuntime::createStream(DeviceId device) {
+std::byte* IRuntime::registerHostBuffer(DeviceId device, size_t size) {
+  EASY_FUNCTION()
+  return doRegisterHostBuffer(device, size);
+}
+
+void IRuntime::unregisterHostBuffer(DeviceId device, std::byte* buffer) {
+  EASY_FUNCTION()
+  doUnregisterHostBuffer(device, buffer);
+}
+
+StreamId IRuntime::createStream(DeviceId device, StreamPriority priority) {
   EASY_FUNCTION()
   ScopedProfileEvent profileEvent(Class::CreateStream, *profiler_, device);
-  auto st = doCreateStream(device);
+  auto st = doCreateStream(device, priority);
   profileEvent.setStream(st);
   return st;
 }
@@ -231,6 +241,31 @@ bool IRuntime::isP2PEnabled(DeviceId one, DeviceId other) const {
   return doIsP2PEnabled(one, other);
 }
 
+void IRuntime::beginCapture(StreamId stream) {
+  EASY_FUNCTION()
+  doBeginCapture(stream);
+}
+
+GraphId IRuntime::endCapture(StreamId stream) {
+  EASY_FUNCTION()
+  return doEndCapture(stream);
+}
+
+EventId IRuntime::launchGraph(StreamId stream, GraphId graph) {
+  EASY_FUNCTION()
+  return doLaunchGraph(stream, graph);
+}
+
+void IRuntime::setGraphKernelArgs(GraphId graph, size_t node, const std::byte* kernel_args, size_t kernel_args_size) {
+  EASY_FUNCTION()
+  doSetGraphKernelArgs(graph, node, kernel_args, kernel_args_size);
+}
+
+void IRuntime::destroyGraph(GraphId graph) {
+  EASY_FUNCTION()
+  doDestroyGraph(graph);
+}
+
 EventId IRuntime::memcpyDeviceToDevice(StreamId streamSrc, DeviceId deviceDst, const std::byte* d_src, std::byte* d_dst,
                                        size_t size, bool barrier) {
   EASY_FUNCTION()
@@ -249,4 +284,22 @@ EventId IRuntime::memcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDst, c
   return doMemcpyDeviceToDevice(deviceSrc, streamDst, d_src, d_dst, size, barrier);
 }
 
+EventId IRuntime::memcpyDeviceToDevice(StreamId stream, const std::byte* d_src, std::byte* d_dst, size_t size,
+                                       bool barrier) {
+  EASY_FUNCTION()
+  ScopedProfileEvent profileEvent(Class::MemcpyDeviceToDevice, *profiler_, stream, barrier, d_src, d_dst, size);
+  auto eventId = doMemcpyDeviceToDevice(stream, d_src, d_dst, size, barrier);
+  profileEvent.setEventId(eventId);
+  return eventId;
+}
+
+EventId IRuntime::memset(StreamId stream, std::byte* d_dst, uint64_t pattern, size_t size, uint32_t patternSize,
+                         bool barrier) {
+  EASY_FUNCTION()
+  ScopedProfileEvent profileEvent(Class::Memset, *profiler_, stream, barrier, nullptr, d_dst, size);
+  auto eventId = doMemset(stream, d_dst, pattern, size, patternSize, barrier);
+  profileEvent.setEventId(eventId);
+  return eventId;
+}
+
 } // namespace rt
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <device-layer/IDeviceLayer.h>
 #include <easy/arbitrary_value.h>
 #include <easy/details/profiler_colors.h>
@@ -73,6 +74,17 @@ RuntimeImp::RuntimeImp(std::shared_ptr<dev::IDeviceLayer> const& deviceLayer, Op
 
   RT_LOG(INFO) << "Profiler enabled? " << (profiler::isEnabled() ? "True" : "False");
   checkMemcpyDeviceAddress_ = options.checkMemcpyDeviceOperations_;
+  completionCoalescing_ = options.completionCoalescing_;
+  if (completionCoalescing_.maxCompletions_ > DEVICE_OPS_CQ_COALESCE_COUNT_MAX) {
+    throw Exception("Completion coalescing can't pack more than " + std::to_string(DEVICE_OPS_CQ_COALESCE_COUNT_MAX) +
+                    " completions.");
+  }
+  if (completionCoalescing_.maxCompletions_ > 1 &&
+      (completionCoalescing_.timeout_.count() <= 0 ||
+       completionCoalescing_.timeout_.count() > DEVICE_OPS_CQ_COALESCE_TIMEOUT_US_MAX)) {
+    throw Exception("Completion coalescing timeout must be between 1 and " +
+                    std::to_string(DEVICE_OPS_CQ_COALESCE_TIMEOUT_US_MAX) + " microseconds.");
+  }
   auto devicesCount = deviceLayer_->getDevicesCount();
   CHECK(devicesCount > 0);
 
@@ -82,7 +94,9 @@ RuntimeImp::RuntimeImp(std::shared_ptr<dev::IDeviceLayer> const& deviceLayer, Op
     auto sqCount = deviceLayer->getSubmissionQueuesCount(device);
     streamManager_.addDevice(deviceId, sqCount);
     for (int sq = 0; sq < sqCount; ++sq) {
-      commandSenders_.try_emplace(getCommandSenderIdx(device, sq), *deviceLayer_, getProfiler(), device, sq);
+      commandSenders_.try_emplace(getCommandSenderIdx(device, sq), *deviceLayer_, getProfiler(), device, sq,
+                                  options.responseReceiveMode_ == ResponseReceiveMode::EventDriven);
+      submissionMutexes_[getCommandSenderIdx(device, sq)];
     }
   }
 
@@ -100,13 +114,14 @@ RuntimeImp::RuntimeImp(std::shared_ptr<dev::IDeviceLayer> const& deviceLayer, Op
                  << " Check memcpy operations: " << (checkMemcpyDeviceAddress_ ? "True" : "False");
 
     memoryManagers_.try_emplace(d, dramBaseAddress, dramSize, kBlockSize);
+    memoryManagerMutexes_[d];
     deviceTracing_.try_emplace(
       d, DeviceFwTracing{std::make_unique<DmaBufferImp>(devInt, tracingBufferSize, true, *deviceLayer_), nullptr,
                          nullptr});
     auto dmaInfo = deviceLayer_->getDmaInfo(devInt);
     maxElementCount = std::max(maxElementCount, dmaInfo.maxElementCount_);
     totalElementSize += dmaInfo.maxElementSize_;
-    threadPools_.try_emplace(DeviceId{d}, std::make_unique<threadPool::ThreadPool>(4));
+    threadPools_.try_emplace(DeviceId{d}, std::make_unique<threadPool::WorkStealingThreadPool>(4));
     errorHandlingThreadPools_.try_emplace(DeviceId{d}, std::make_unique<threadPool::ThreadPool>(1));
     abortSync_.try_emplace(DeviceId{d});
   }
@@ -137,20 +152,42 @@ RuntimeImp::RuntimeImp(std::shared_ptr<dev::IDeviceLayer> const& deviceLayer, Op
     }
   }
   RT_LOG_IF(FATAL, cmaPerDevice < kBlockSize) << "Error: need at least " << kBlockSize << "B of CMA per device to work";
-  responseReceiver_ = std::make_unique<ResponseReceiver>(*deviceLayer_, this);
+  responseReceiver_ = std::make_unique<ResponseReceiver>(*deviceLayer_, this, options.responseReceiveMode_);
 
   // initialization sequence, need to send abort command to ensure the device is in a proper state
   for (int d = 0; d < devicesCount; ++d) {
     RT_LOG(INFO) << "Initializing device: " << d;
     abortDevice(DeviceId{d});
-    if (options.checkDeviceApiVersion_) {
+    // older firmwares don't know the completion coalescing command, so its version is needed even if the check wasn't
+    // requested
+    if (options.checkDeviceApiVersion_ || completionCoalescing_.maxCompletions_ > 1) {
       running_ = true;
       RT_LOG(INFO) << "Checking device api version for device: " << d;
       checkDeviceApi(DeviceId{d});
     }
+    if (completionCoalescing_.maxCompletions_ > 1 && !isCompletionCoalescingSupported()) {
+      RT_LOG(WARNING) << "Device: " << d << " doesn't support completion coalescing, disabling it on every device";
+      completionCoalescing_.maxCompletions_ = 0;
+    }
+  }
+  for (int d = 0; d < devicesCount; ++d) {
+    if (completionCoalescing_.maxCompletions_ > 1) {
+      RT_LOG(INFO) << "Enabling completion coalescing for device: " << d
+                   << ". Max completions: " << completionCoalescing_.maxCompletions_
+                   << " Timeout: " << completionCoalescing_.timeout_.count() << "us";
+      for (int sq = 0, sqCount = deviceLayer_->getSubmissionQueuesCount(d); sq < sqCount; ++sq) {
+        sendCompletionCoalescingConfig(DeviceId{d}, sq, true);
+      }
+    }
     deviceLayer_->hintInactivity(d);
     RT_LOG(INFO) << "Device: " << d << " initialized.";
   }
+  if (completionCoalescing_.maxCompletions_ > 1) {
+    // latency sensitive streams shouldn't wait for other completions, so their queues opt out while they have any
+    streamManager_.setQueuePriorityCallback([this](DeviceId device, int queue, bool latencySensitive) {
+      sendCompletionCoalescingConfig(device, queue, !latencySensitive);
+    });
+  }
   eventManager_.setThrowOnMissingEvent(true);
   running_ = true;
   executionContextCache_ = std::make_unique<ExecutionContextCache>(
@@ -230,8 +267,6 @@ DeviceProperties RuntimeImp::doGetDeviceProperties(DeviceId device) const {
 }
 
 LoadCodeResult RuntimeImp::doLoadCode(StreamId stream, const std::byte* data, size_t size) {
-  SpinLock lock(mutex_);
-
   auto stInfo = streamManager_.getStreamInfo(stream);
 
   std::vector<std::byte> dataCopy(size);
@@ -303,11 +338,13 @@ LoadCodeResult RuntimeImp::doLoadCode(StreamId stream, const std::byte* data, si
 
   // store the ref
   auto kernelId = static_cast<KernelId>(nextKernelId_++);
+  std::unique_lock kernelsLock(kernelsMutex_);
   auto it = kernels_.find(kernelId);
   if (it != end(kernels_)) {
     throw Exception("Can't create kernel");
   }
   kernels_.emplace(kernelId, std::move(kernel));
+  kernelsLock.unlock();
 
   // fill the struct results
   LoadCodeResult loadCodeResult;
@@ -325,18 +362,19 @@ LoadCodeResult RuntimeImp::doLoadCode(StreamId stream, const std::byte* data, si
 }
 
 void RuntimeImp::doUnloadCode(KernelId kernel) {
-  SpinLock lock(mutex_);
+  std::unique_lock kernelsLock(kernelsMutex_);
   auto it = find(kernels_, kernel);
   auto deviceId = it->second->deviceId_;
   auto deviceBuffer = it->second->deviceBuffer_;
   RT_VLOG(LOW) << "Unloading kernel from deviceId " << static_cast<std::underlying_type_t<DeviceId>>(deviceId)
                << " buffer: " << deviceBuffer;
 
-  // free the buffer
-  doFreeDevice(deviceId, it->second->deviceBuffer_);
-
-  // and remove the kernel
+  // remove the kernel
   kernels_.erase(it);
+  kernelsLock.unlock();
+
+  // and free the buffer
+  doFreeDevice(deviceId, deviceBuffer);
   coreDumper_.removeCodeAddress(deviceId, deviceBuffer);
 }
 
@@ -360,8 +398,8 @@ std::byte* RuntimeImp::doMallocDevice(DeviceId device, size_t size, uint32_t ali
     throw Exception("Alignment must be power of two");
   }
 
-  std::unique_lock lock(mutex_);
   auto it = find(memoryManagers_, device);
+  SpinLock lock(memoryManagerMutexes_.at(device));
   auto ptr = it->second.malloc(size, alignment);
   const size_t free_bytes = it->second.getFreeBytes();
   const size_t max_free_contiguous_bytes = it->second.getFreeContiguousBytes();
@@ -374,8 +412,8 @@ std::byte* RuntimeImp::doMallocDevice(DeviceId device, size_t size, uint32_t ali
 void RuntimeImp::doFreeDevice(DeviceId device, std::byte* buffer) {
   RT_VLOG(LOW) << "Free at device: " << static_cast<std::underlying_type_t<DeviceId>>(device)
                << " buffer address: " << std::hex << buffer;
-  std::unique_lock lock(mutex_);
   auto it = find(memoryManagers_, device);
+  SpinLock lock(memoryManagerMutexes_.at(device));
   it->second.free(buffer);
   const size_t free_bytes = it->second.getFreeBytes();
   const size_t max_free_contiguous_bytes = it->second.getFreeContiguousBytes();
@@ -384,9 +422,49 @@ void RuntimeImp::doFreeDevice(DeviceId device, std::byte* buffer) {
   recordMemoryStats(*getProfiler(), device, free_bytes, max_free_contiguous_bytes, allocated_memory);
 }
 
-StreamId RuntimeImp::doCreateStream(DeviceId device) {
-  RT_VLOG(LOW) << "Creating stream at device: " << static_cast<std::underlying_type_t<DeviceId>>(device);
-  return streamManager_.createStream(device);
+std::byte* RuntimeImp::doRegisterHostBuffer(DeviceId device, size_t size) {
+  RT_VLOG(LOW) << "Register host buffer device: " << static_cast<std::underlying_type_t<DeviceId>>(device)
+               << " size: " << size;
+  if (size == 0) {
+    throw Exception("Can't register a 0-sized host buffer");
+  }
+  find(cmaManagers_, device, "Invalid device");
+  auto buffer = std::make_unique<DmaBufferImp>(static_cast<int>(device), size, true, *deviceLayer_);
+  auto ptr = buffer->getPtr();
+  std::unique_lock lock(hostBuffersMutex_);
+  hostBuffers_[device].emplace(ptr, std::move(buffer));
+  return ptr;
+}
+
+void RuntimeImp::doUnregisterHostBuffer(DeviceId device, std::byte* buffer) {
+  RT_VLOG(LOW) << "Unregister host buffer device: " << static_cast<std::underlying_type_t<DeviceId>>(device)
+               << " buffer address: " << std::hex << buffer;
+  std::unique_lock lock(hostBuffersMutex_);
+  auto it = hostBuffers_.find(device);
+  if (it == end(hostBuffers_) || it->second.erase(buffer) != 1) {
+    throw Exception("Trying to unregister a non registered host buffer");
+  }
+}
+
+bool RuntimeImp::isRegisteredHostBuffer(DeviceId device, const std::byte* address, size_t size) const {
+  std::shared_lock lock(hostBuffersMutex_);
+  auto it = hostBuffers_.find(device);
+  if (it == end(hostBuffers_)) {
+    return false;
+  }
+  // the candidate is the last buffer starting at or before address
+  auto buffer = it->second.upper_bound(address);
+  if (buffer == begin(it->second)) {
+    return false;
+  }
+  --buffer;
+  return address + size <= buffer->first + buffer->second->getSize();
+}
+
+StreamId RuntimeImp::doCreateStream(DeviceId device, StreamPriority priority) {
+  RT_VLOG(LOW) << "Creating stream at device: " << static_cast<std::underlying_type_t<DeviceId>>(device)
+               << (priority == StreamPriority::LatencySensitive ? " (latency sensitive)" : "");
+  return streamManager_.createStream(device, priority);
 }
 
 void RuntimeImp::doDestroyStream(StreamId stream) {
@@ -466,7 +544,7 @@ void RuntimeImp::doSetOnStreamErrorsCallback(StreamErrorCallback callback) {
 }
 
 void RuntimeImp::doSetOnKernelAbortedErrorCallback(const KernelAbortedCallback& callback) {
-  SpinLock lock(mutex_);
+  SpinLock lock(kernelAbortedCallbackMutex_);
   kernelAbortedCallback_ = callback;
 }
 
@@ -475,11 +553,14 @@ void RuntimeImp::handleKernelAbortedCallback(EventId event) {
   auto exceptionContext = (buffer != nullptr ? buffer->getExceptionContextPtr() : nullptr);
 
   RT_LOG(INFO) << "Executing kernel abort callback";
-  auto th = std::thread([event, exceptionContext, this] {
+  SpinLock lock(kernelAbortedCallbackMutex_);
+  auto callback = kernelAbortedCallback_;
+  lock.unlock();
+  auto th = std::thread([event, exceptionContext, callback = std::move(callback), this] {
     static std::atomic<int> threadId = 0;
     profiling::IProfilerRecorder::setCurrentThreadName("Kernel aborted callback thread " + std::to_string(threadId++));
 
-    kernelAbortedCallback_(event, exceptionContext, kExceptionBufferSize,
+    callback(event, exceptionContext, kExceptionBufferSize,
                            [this, event] { executionContextCache_->releaseBuffer(event); });
     RT_LOG(INFO) << "Dispatching event " << int(event);
     dispatch(event);
@@ -538,12 +619,12 @@ void RuntimeImp::processResponseError(DeviceId device, const ResponseError& resp
         if (auto st = streamError.stream_; st.has_value()) {
           // if we reach here, there are no more events in associated stream so we can do the copy
           auto errorContexts = std::vector<ErrorContext>(kNumErrorContexts);
-          auto copyStream = doCreateStream(buffer->device_);
+          auto copyStream = doCreateStream(buffer->device_, StreamPriority::Normal);
           auto e = memcpyDeviceToHost(copyStream, buffer->getExceptionContextPtr(),
                                       reinterpret_cast<std::byte*>(errorContexts.data()), kExceptionBufferSize, false);
           doWaitForEvent(e);
           streamError.errorContext_.emplace(std::move(errorContexts));
-          SpinLock mmlock(mutex_);
+          SpinLock mmlock(memoryManagerMutexes_.at(device));
           auto allocs = memoryManagers_.at(device).getAllocations();
           mmlock.unlock();
           coreDumper_.dump(event, allocs, streamError, *this);
@@ -597,10 +678,28 @@ void RuntimeImp::waitUntilAllowedToProcessResponseErrors(DeviceId device) {
   sync.condVar_.wait(lock, [&sync] { return (sync.numBlockers_ == 0); });
 }
 
-void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte>& response) {
+void RuntimeImp::onResponsesReceived(DeviceId device, const std::byte* responses, size_t count) {
   EASY_FUNCTION()
+  if (count == 1) {
+    if (auto eventId = processResponse(device, responses)) {
+      dispatch(*eventId);
+    }
+    return;
+  }
+  std::vector<EventId> events;
+  events.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (auto eventId = processResponse(device, responses)) {
+      events.emplace_back(*eventId);
+    }
+    responses += sizeof(cmn_header_t) + reinterpret_cast<const rsp_header_t*>(responses)->rsp_hdr.size;
+  }
+  dispatch(events);
+}
+
+std::optional<EventId> RuntimeImp::processResponse(DeviceId device, const std::byte* response) {
   // check the response header
-  auto header = reinterpret_cast<const rsp_header_t*>(response.data());
+  auto header = reinterpret_cast<const rsp_header_t*>(response);
   auto eventId = EventId{header->rsp_hdr.tag_id};
 
   auto recordEvent = [](auto& profiler, const auto& rsp, const auto& evt, ResponseType rspT) {
@@ -621,14 +720,14 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
   bool skipDispatch = false;
   switch (header->rsp_hdr.msg_id) {
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_API_COMPATIBILITY_RSP:
-    if (auto r = reinterpret_cast<const device_ops_api::device_ops_api_compatibility_rsp_t*>(response.data());
+    if (auto r = reinterpret_cast<const device_ops_api::device_ops_api_compatibility_rsp_t*>(response);
         r->status != device_ops_api::DEV_OPS_API_COMPATIBILITY_RESPONSE_SUCCESS) {
       responseWasOk = false;
       RT_LOG(WARNING) << "Error on device api check version: " << r->status
                       << ". Tag id: " << static_cast<int>(eventId);
       processResponseError(device, {convert(header->rsp_hdr.msg_id, r->status), eventId});
     } else {
-      SpinLock lock(mutex_);
+      SpinLock lock(deviceApiVersionMutex_);
       deviceApiVersion_.major = r->major;
       deviceApiVersion_.minor = r->minor;
       deviceApiVersion_.patch = r->patch;
@@ -636,7 +735,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     break;
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_ABORT_RSP:
     unlockProcessingResponseErrors(device, eventId);
-    if (auto r = reinterpret_cast<const device_ops_api::device_ops_kernel_abort_rsp_t*>(response.data());
+    if (auto r = reinterpret_cast<const device_ops_api::device_ops_kernel_abort_rsp_t*>(response);
         r->status != device_ops_api::DEV_OPS_API_KERNEL_ABORT_RESPONSE_SUCCESS) {
       responseWasOk = false;
       RT_LOG(WARNING) << "Error on kernel abort: " << r->status << ". Tag id: " << static_cast<int>(eventId);
@@ -647,7 +746,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     }
     break;
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_RSP: {
-    auto r = reinterpret_cast<const device_ops_api::device_ops_dma_readlist_rsp_t*>(response.data());
+    auto r = reinterpret_cast<const device_ops_api::device_ops_dma_readlist_rsp_t*>(response);
     recordEvent(*getProfiler(), *r, eventId, ResponseType::DMARead);
     if (r->status != device_ops_api::DEV_OPS_API_DMA_RESPONSE_COMPLETE) {
       responseWasOk = false;
@@ -658,7 +757,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
   }
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_ABORT_RSP:
     unlockProcessingResponseErrors(device, eventId);
-    if (auto r = reinterpret_cast<const device_ops_api::device_ops_abort_rsp_t*>(response.data());
+    if (auto r = reinterpret_cast<const device_ops_api::device_ops_abort_rsp_t*>(response);
         r->status != device_ops_api::DEV_OPS_API_ABORT_RESPONSE_SUCCESS) {
       responseWasOk = false;
       RT_LOG(WARNING) << "Error on abort command: " << r->status << ". Tag id: " << static_cast<int>(eventId);
@@ -666,7 +765,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     }
     break;
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_RSP: {
-    auto r = reinterpret_cast<const device_ops_api::device_ops_dma_writelist_rsp_t*>(response.data());
+    auto r = reinterpret_cast<const device_ops_api::device_ops_dma_writelist_rsp_t*>(response);
     recordEvent(*getProfiler(), *r, eventId, ResponseType::DMAWrite);
     if (r->status != device_ops_api::DEV_OPS_API_DMA_RESPONSE_COMPLETE) {
       responseWasOk = false;
@@ -676,7 +775,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     break;
   }
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_KERNEL_LAUNCH_RSP: {
-    auto r = reinterpret_cast<const device_ops_api::device_ops_kernel_launch_rsp_t*>(response.data());
+    auto r = reinterpret_cast<const device_ops_api::device_ops_kernel_launch_rsp_t*>(response);
     recordEvent(*getProfiler(), *r, eventId, ResponseType::Kernel);
     RT_LOG(INFO) << "KernelLaunch Reponse Event: " << int(eventId);
     if (r->status !=
@@ -704,7 +803,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     break;
   }
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONFIG_RSP:
-    if (auto r = reinterpret_cast<const device_ops_api::device_ops_trace_rt_config_rsp_t*>(response.data());
+    if (auto r = reinterpret_cast<const device_ops_api::device_ops_trace_rt_config_rsp_t*>(response);
         r->status != device_ops_api::DEV_OPS_TRACE_RT_CONFIG_RESPONSE::DEV_OPS_TRACE_RT_CONFIG_RESPONSE_SUCCESS) {
       responseWasOk = false;
       RT_LOG(WARNING) << "Error on firmware trace configure: " << r->status
@@ -713,7 +812,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     }
     break;
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_RT_CONTROL_RSP:
-    if (auto r = reinterpret_cast<const device_ops_api::device_ops_trace_rt_control_rsp_t*>(response.data());
+    if (auto r = reinterpret_cast<const device_ops_api::device_ops_trace_rt_control_rsp_t*>(response);
         r->status != device_ops_api::DEV_OPS_TRACE_RT_CONTROL_RESPONSE::DEV_OPS_TRACE_RT_CONTROL_RESPONSE_SUCCESS) {
       responseWasOk = false;
       RT_LOG(WARNING) << "Error on firmware trace control (start/stop): " << r->status
@@ -722,13 +821,13 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     }
     break;
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DEVICE_FW_ERROR: {
-    auto r = reinterpret_cast<const device_ops_api::device_ops_device_fw_error_t*>(response.data());
+    auto r = reinterpret_cast<const device_ops_api::device_ops_device_fw_error_t*>(response);
     RT_LOG(WARNING) << "Reported asynchronous ERROR event from firmware: " << r->error_type;
     processResponseError(device, {convert(header->rsp_hdr.msg_id, r->error_type), eventId});
     break;
   }
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_TRACE_BUFFER_FULL_EVENT: {
-    auto r = reinterpret_cast<const device_ops_api::device_ops_trace_buffer_full_event_t*>(response.data());
+    auto r = reinterpret_cast<const device_ops_api::device_ops_trace_buffer_full_event_t*>(response);
     RT_LOG(WARNING) << "Reported asynchronous event from firmware: Trace buffer full. This is ignored by host runtime. "
                        "Trace buffer type: "
                     << r->buffer_type;
@@ -736,7 +835,7 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
   }
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_READLIST_RSP:
   case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_P2PDMA_WRITELIST_RSP: {
-    auto r = reinterpret_cast<const device_ops_api::device_ops_p2pdma_writelist_rsp_t*>(response.data());
+    auto r = reinterpret_cast<const device_ops_api::device_ops_p2pdma_writelist_rsp_t*>(response);
     recordEvent(*getProfiler(), *r, eventId, ResponseType::DMAP2P);
     if (r->status != device_ops_api::DEV_OPS_API_DMA_RESPONSE_COMPLETE) {
       responseWasOk = false;
@@ -746,6 +845,36 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
     }
     break;
   }
+  case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_MEMSET_RSP: {
+    auto r = reinterpret_cast<const device_ops_api::device_ops_memset_rsp_t*>(response);
+    recordEvent(*getProfiler(), *r, eventId, ResponseType::Memset);
+    if (r->status != device_ops_api::DEV_OPS_API_DMA_RESPONSE_COMPLETE) {
+      responseWasOk = false;
+      RT_LOG(WARNING) << "Error on memset op: " << r->status << ". Tag id: " << static_cast<int>(eventId);
+      processResponseError(device, {convert(header->rsp_hdr.msg_id, r->status), eventId});
+    }
+    break;
+  }
+  case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_RSP: {
+    auto r = reinterpret_cast<const device_ops_api::device_ops_memcpy_d2d_rsp_t*>(response);
+    recordEvent(*getProfiler(), *r, eventId, ResponseType::MemcpyD2D);
+    if (r->status != device_ops_api::DEV_OPS_API_DMA_RESPONSE_COMPLETE) {
+      responseWasOk = false;
+      RT_LOG(WARNING) << "Error on memcpyDeviceToDevice op: " << r->status << ". Tag id: " << static_cast<int>(eventId);
+      processResponseError(device, {convert(header->rsp_hdr.msg_id, r->status), eventId});
+    }
+    break;
+  }
+  case device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_RSP:
+    if (auto r = reinterpret_cast<const device_ops_api::device_ops_cq_coalesce_config_rsp_t*>(response);
+        r->status != device_ops_api::DEV_OPS_API_CQ_COALESCE_CONFIG_RESPONSE_SUCCESS) {
+      RT_LOG(WARNING) << "Error on completion coalescing configuration: " << r->status
+                      << ". Tag id: " << static_cast<int>(eventId);
+    }
+    // the configuration commands don't belong to any stream
+    eventManager_.dispatch(eventId);
+    skipDispatch = true;
+    break;
   default:
     RT_LOG(WARNING) << "Unknown response msg id: " << header->rsp_hdr.msg_id;
     break;
@@ -753,13 +882,16 @@ void RuntimeImp::onResponseReceived(DeviceId device, const std::vector<std::byte
   // If response wasn't ok, then processResponseError will clean events.
   // In addition, abort callbacks delay dispatching to the end of the callback.
   if (responseWasOk and !skipDispatch) {
-    dispatch(eventId);
+    return eventId;
   }
+  return {};
 }
 
 void RuntimeImp::setMemoryManagerDebugMode(DeviceId device, bool enable) {
   RT_LOG(INFO) << "Setting memory manager debug mode: " << (enable ? "True" : "False");
-  find(memoryManagers_, device)->second.setDebugMode(enable);
+  auto it = find(memoryManagers_, device);
+  SpinLock lock(memoryManagerMutexes_.at(device));
+  it->second.setDebugMode(enable);
 }
 
 void RuntimeImp::setSentCommandCallback(DeviceId device, CommandSender::CommandSentCallback callback) {
@@ -775,11 +907,21 @@ bool RuntimeImp::areEventsOnFly(DeviceId device) const {
   return streamManager_.hasEventsOnFly(device);
 }
 
+void RuntimeImp::onSubmissionQueuesAvailable(DeviceId device, uint64_t sqBitmap) {
+  auto deviceInt = static_cast<int>(device);
+  auto sqCount = deviceLayer_->getSubmissionQueuesCount(deviceInt);
+  for (auto sq = 0; sq < sqCount; ++sq) {
+    if (sqBitmap & (1UL << sq)) {
+      find(commandSenders_, getCommandSenderIdx(deviceInt, sq))->second.notifySqAvailable();
+    }
+  }
+}
+
 std::vector<StreamError> RuntimeImp::doRetrieveStreamErrors(StreamId stream) {
   return streamManager_.retrieveErrors(stream);
 }
 void RuntimeImp::checkDeviceApi(DeviceId device) {
-  auto st = doCreateStream(device);
+  auto st = doCreateStream(device, StreamPriority::Normal);
   auto streamInfo = streamManager_.getStreamInfo(st);
   auto evt = eventManager_.getNextId();
   streamManager_.addEvent(st, evt);
@@ -793,16 +935,53 @@ void RuntimeImp::checkDeviceApi(DeviceId device) {
   doWaitForStream(st);
   doDestroyStream(st);
   // now the responsereceiver will put the data into deviceapi field, check that
-  if (!deviceApiVersion_.isValid()) {
+  SpinLock lock(deviceApiVersionMutex_);
+  auto deviceApiVersion = deviceApiVersion_;
+  lock.unlock();
+  if (!deviceApiVersion.isValid()) {
     throw Exception("Runtime couldn't retrieve a valid device-api version.");
   }
-  RT_LOG(INFO) << "Device API version: " << deviceApiVersion_.major << "." << deviceApiVersion_.minor << "."
-               << deviceApiVersion_.patch;
-  if (deviceApiVersion_.major != 2) {
+  RT_LOG(INFO) << "Device API version: " << deviceApiVersion.major << "." << deviceApiVersion.minor << "."
+               << deviceApiVersion.patch;
+  if (deviceApiVersion.major != 2) {
     throw Exception("Incompatible device-api version. This runtime version supports device-api 2.X.Y.");
   }
 }
 
+bool RuntimeImp::isCompletionCoalescingSupported() {
+  SpinLock lock(deviceApiVersionMutex_);
+  return deviceApiVersion_.isAtLeast(DEVICE_OPS_CQ_COALESCE_MIN_API_MAJOR, DEVICE_OPS_CQ_COALESCE_MIN_API_MINOR);
+}
+
+void RuntimeImp::checkDeviceMemoryCommandsSupported() {
+  SpinLock lock(deviceApiVersionMutex_);
+  auto deviceApiVersion = deviceApiVersion_;
+  lock.unlock();
+  if (deviceApiVersion.isValid() &&
+      !deviceApiVersion.isAtLeast(DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MAJOR, DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MINOR)) {
+    throw Exception("Device-api version " + std::to_string(deviceApiVersion.major) + "." +
+                    std::to_string(deviceApiVersion.minor) +
+                    " doesn't support the memset and device to device memcpy commands. They need device-api " +
+                    std::to_string(DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MAJOR) + "." +
+                    std::to_string(DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MINOR) + " or later.");
+  }
+}
+
+void RuntimeImp::sendCompletionCoalescingConfig(DeviceId device, int sq, bool enable) {
+  auto evt = eventManager_.getNextId();
+  std::vector<std::byte> cmd(sizeof(device_ops_api::device_ops_cq_coalesce_config_cmd_t));
+  auto cmdPtr = reinterpret_cast<device_ops_api::device_ops_cq_coalesce_config_cmd_t*>(cmd.data());
+  cmdPtr->command_info.cmd_hdr.tag_id = static_cast<uint16_t>(evt);
+  cmdPtr->command_info.cmd_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD;
+  cmdPtr->command_info.cmd_hdr.size = static_cast<msg_size_t>(cmd.size());
+  cmdPtr->max_count = enable ? completionCoalescing_.maxCompletions_ : 0;
+  cmdPtr->timeout_us = static_cast<uint32_t>(completionCoalescing_.timeout_.count());
+  RT_VLOG(LOW) << (enable ? "Enabling" : "Disabling") << " completion coalescing of device "
+               << static_cast<int>(device) << " SQ " << sq << ". Tag id: " << static_cast<int>(evt);
+  auto& commandSender = find(commandSenders_, getCommandSenderIdx(static_cast<int>(device), sq))->second;
+  commandSender.send(Command{cmd, commandSender, evt, evt, StreamId{-1}, false, true});
+}
+
 EventId RuntimeImp::doAbortCommand(EventId commandId, std::chrono::milliseconds timeout) {
   using namespace std::chrono_literals;
   auto stInfo = streamManager_.getStreamInfo(commandId);
@@ -814,7 +993,7 @@ EventId RuntimeImp::doAbortCommand(EventId commandId, std::chrono::milliseconds
     lockProcessingResponseErrors(DeviceId{stInfo->device_}, evt);
 
     device_ops_api::device_ops_abort_cmd_t cmd;
-    memset(&cmd, 0, sizeof(cmd));
+    std::memset(&cmd, 0, sizeof(cmd));
     cmd.tag_id = static_cast<uint16_t>(commandId);
     cmd.command_info.cmd_hdr.size = sizeof(cmd);
     cmd.command_info.cmd_hdr.flags = device_ops_api::CMD_FLAGS_BARRIER_ENABLE;
@@ -873,6 +1052,26 @@ void RuntimeImp::dispatch(EventId event) {
   notify(event);
 }
 
+void RuntimeImp::dispatch(const std::vector<EventId>& events) {
+  EASY_FUNCTION(profiler::colors::Green)
+  EASY_VALUE("Events", static_cast<int>(events.size()))
+  if (!running_) {
+    RT_LOG(WARNING) << "Trying to dispatch " << events.size()
+                    << " events but runtime is not running. Ignoring the dispatch.";
+    return;
+  }
+  ProfileEvent evt(Type::Instant, Class::DispatchEvent);
+  for (auto event : events) {
+    evt.setEvent(event);
+    getProfiler()->record(evt);
+  }
+  streamManager_.removeEvents(events);
+  eventManager_.dispatch(events);
+  for (auto event : events) {
+    notify(event);
+  }
+}
+
 void RuntimeImp::checkDevice(DeviceId device) {
   auto state = deviceLayer_->getDeviceStateMasterMinion(static_cast<int>(device));
   RT_VLOG(LOW) << "Device state: " << static_cast<int>(state) << " Runtime running: " << (running_ ? "True" : "False");
@@ -895,7 +1094,8 @@ void RuntimeImp::abortDevice(DeviceId device) {
   auto oldRunningState = running_;
   running_ = true;
   for (auto sq = 0, sqCount = deviceLayer_->getSubmissionQueuesCount(static_cast<int>(device)); sq < sqCount; ++sq) {
-    auto st = doCreateStream(device);
+    // the stream is pinned to each SQ, a load based placement would pick the same idle SQ every time
+    auto st = streamManager_.createStream(device, sq);
     auto fakeEvt = eventManager_.getNextId();
     streamManager_.addEvent(st, fakeEvt);
     abortCommand(fakeEvt, 5s);
@@ -906,6 +1106,13 @@ void RuntimeImp::abortDevice(DeviceId device) {
   running_ = oldRunningState;
 }
 
+void RuntimeImp::checkDeviceOperation(DeviceId device, const std::byte* address, size_t size) const {
+  if (checkMemcpyDeviceAddress_) {
+    SpinLock lock(memoryManagerMutexes_.at(device));
+    memoryManagers_.at(device).checkOperation(address, size);
+  }
+}
+
 void RuntimeImp::checkList(int device, const MemcpyList& list) const {
   EASY_FUNCTION()
   auto dmaInfo = deviceLayer_->getDmaInfo(device);
@@ -929,8 +1136,8 @@ void RuntimeImp::checkList(int device, const MemcpyList& list) const {
 
 std::unordered_map<DeviceId, uint64_t> RuntimeImp::getFreeMemory() const {
   std::unordered_map<DeviceId, uint64_t> res;
-  SpinLock lock(mutex_);
   for (auto d : devices_) {
+    SpinLock lock(memoryManagerMutexes_.at(d));
     res.emplace(d, memoryManagers_.at(d).getFreeBytes());
   }
   return res;
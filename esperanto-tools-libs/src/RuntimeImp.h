@@ -8,6 +8,8 @@
 #include "CommandSender.h"
 #include "CoreDumper.h"
 #include "EventManager.h"
+#include "LaunchGraph.h"
+#include "MemcpyOps.h"
 #include "MemoryManager.h"
 #include "Observer.h"
 #include "ProfilerImp.h"
@@ -22,10 +24,16 @@
 #include "runtime/Types.h"
 
 #include <hostUtils/threadPool/ThreadPool.h>
+#include <hostUtils/threadPool/WorkStealingThreadPool.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 
@@ -39,6 +47,9 @@ struct DeviceApiVersion {
   bool isValid() const {
     return major != INVALID && minor != INVALID && patch != INVALID;
   }
+  bool isAtLeast(type minMajor, type minMinor) const {
+    return isValid() && std::tie(major, minor) >= std::tie(minMajor, minMinor);
+  }
   uint32_t major = INVALID;
   uint32_t minor = INVALID;
   uint32_t patch = INVALID;
@@ -58,7 +69,16 @@ public:
   std::byte* doMallocDevice(DeviceId device, size_t size, uint32_t alignment = kCacheLineSize) final;
   void doFreeDevice(DeviceId device, std::byte* buffer) final;
 
-  StreamId doCreateStream(DeviceId device) final;
+  std::byte* doRegisterHostBuffer(DeviceId device, size_t size) final;
+  void doUnregisterHostBuffer(DeviceId device, std::byte* buffer) final;
+
+  void doBeginCapture(StreamId stream) final;
+  GraphId doEndCapture(StreamId stream) final;
+  EventId doLaunchGraph(StreamId stream, GraphId graph) final;
+  void doSetGraphKernelArgs(GraphId graph, size_t node, const std::byte* kernel_args, size_t kernel_args_size) final;
+  void doDestroyGraph(GraphId graph) final;
+
+  StreamId doCreateStream(DeviceId device, StreamPriority priority) final;
   void doDestroyStream(StreamId stream) final;
 
   EventId doKernelLaunch(StreamId stream, KernelId kernel, const std::byte* kernel_args, size_t kernel_args_size,
@@ -75,6 +95,10 @@ public:
                                  size_t size, bool barrier) final;
   EventId doMemcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDst, const std::byte* d_src, std::byte* d_dst,
                                  size_t size, bool barrier) final;
+  EventId doMemcpyDeviceToDevice(StreamId stream, const std::byte* d_src, std::byte* d_dst, size_t size,
+                                 bool barrier) final;
+  EventId doMemset(StreamId stream, std::byte* d_dst, uint64_t pattern, size_t size, uint32_t patternSize,
+                   bool barrier) final;
 
   bool doWaitForEvent(EventId event, std::chrono::seconds timeout = std::chrono::hours(24)) final;
   bool doWaitForStream(StreamId stream, std::chrono::seconds timeout = std::chrono::hours(24)) final;
@@ -101,10 +125,13 @@ public:
 
   // IResponseServices
   bool areEventsOnFly(DeviceId device) const final;
-  void onResponseReceived(DeviceId device, const std::vector<std::byte>& response) final;
+  void onResponsesReceived(DeviceId device, const std::byte* responses, size_t count) final;
+  void onSubmissionQueuesAvailable(DeviceId device, uint64_t sqBitmap) final;
 
   // this method is a helper to call eventManager dispatch and streamManager removeEvent
   void dispatch(EventId event);
+  // same as above for all the events completed by a batched response, taking each lock a single time
+  void dispatch(const std::vector<EventId>& events);
 
   // these methods are intended for debugging, internal use only
   void setMemoryManagerDebugMode(DeviceId device, bool enable);
@@ -169,8 +196,48 @@ private:
 
   void checkDeviceApi(DeviceId d);
 
+  // processes a single response; returns its event if it has to be dispatched
+  std::optional<EventId> processResponse(DeviceId device, const std::byte* response);
+
+  // sends the completion coalescing configuration to the submission queue; the device stops coalescing the queue
+  // completions if enable is false. The command doesn't belong to any stream
+  void sendCompletionCoalescingConfig(DeviceId device, int sq, bool enable);
+  // whether the last checked device-api version knows the completion coalescing configuration command
+  bool isCompletionCoalescingSupported();
+  // throws if the last checked device-api version doesn't know the memset and device to device memcpy commands; they
+  // are let through when the version wasn't checked (see Options::checkDeviceApiVersion_)
+  void checkDeviceMemoryCommandsSupported();
+
   void checkList(int device, const MemcpyList& list) const;
 
+  // returns true if [address, address + size) lies inside a single host buffer registered with the device
+  bool isRegisteredHostBuffer(DeviceId device, const std::byte* address, size_t size) const;
+
+  // encodes the DMA commands of a memcpy from / to a registered host buffer, pointing them directly to the host memory;
+  // the tag ids are not set
+  std::vector<std::vector<std::byte>> encodeRegisteredMemcpy(MemcpyType type, int device, const std::byte* hostAddr,
+                                                             const std::byte* deviceAddr, size_t size,
+                                                             bool barrier) const;
+
+  // queues the given DMA commands tagging each one with a new event; evt is dispatched once all of them are completed.
+  // The submission lock of commandSender must be held
+  void sendRegisteredMemcpy(StreamId stream, CommandSender& commandSender, EventId evt,
+                            std::vector<std::vector<std::byte>> commands);
+
+  // queues a single command executed by the device on its own memory (memset, device to device memcpy), or captures
+  // it if the stream is being captured. streamInfo is the one the caller checked the command against. The tag id is
+  // set here
+  EventId sendDeviceMemoryCommand(StreamId stream, Stream::Info streamInfo, std::vector<std::byte> command);
+
+  // returns the graph being captured from the stream or nullptr if the stream is not being captured
+  LaunchGraph* getCapturingGraph(StreamId stream) const;
+
+  // appends the node to the graph and returns an already dispatched event for the captured operation
+  EventId captureNode(LaunchGraph& graph, LaunchGraph::Node node);
+
+  // checks the device memory operation against the allocations, if checkMemcpyDeviceAddress_ is enabled
+  void checkDeviceOperation(DeviceId device, const std::byte* address, size_t size) const;
+
   uint64_t getCommandSenderIdx(int deviceId, int sqIdx) const {
     return (static_cast<uint64_t>(deviceId) << 32ULL) + static_cast<uint64_t>(sqIdx);
   }
@@ -194,27 +261,47 @@ private:
     int numBlockers_ = 0;
   };
 
-  mutable std::recursive_mutex mutex_;
   std::shared_ptr<dev::IDeviceLayer> deviceLayer_;
   std::unordered_map<DeviceId, std::unique_ptr<CmaManager>> cmaManagers_;
   std::vector<DeviceId> devices_;
   StreamManager streamManager_;
   std::unordered_map<DeviceId, MemoryManager> memoryManagers_;
+  // one lock per memory manager, so allocations on different devices don't contend
+  mutable std::unordered_map<DeviceId, std::mutex> memoryManagerMutexes_;
   std::unordered_map<KernelId, std::unique_ptr<Kernel>> kernels_;
+  // kernels are looked up on every launch but only modified by load/unload code
+  mutable std::shared_mutex kernelsMutex_;
   std::unordered_map<DeviceId, DeviceFwTracing> deviceTracing_;
+  // host buffers registered by the user, by device and start address
+  std::unordered_map<DeviceId, std::map<const std::byte*, std::unique_ptr<IDmaBuffer>>> hostBuffers_;
+  mutable std::shared_mutex hostBuffersMutex_;
+  // graphs being captured by stream, and captured graphs
+  std::unordered_map<StreamId, std::unique_ptr<LaunchGraph>> capturingGraphs_;
+  std::unordered_map<GraphId, std::shared_ptr<LaunchGraph>> graphs_;
+  // fast path for the operations issued while no stream is being captured
+  std::atomic<int> numCapturingStreams_ = 0;
+  int nextGraphId_ = 0;
+  mutable std::shared_mutex graphsMutex_;
   std::unique_ptr<ExecutionContextCache> executionContextCache_;
   std::unordered_map<uint64_t, CommandSender> commandSenders_;
+  // one lock per command sender (device and submission queue); it keeps event ids, stream events and commands in the
+  // same order for all the submissions to that queue
+  std::unordered_map<uint64_t, std::mutex> submissionMutexes_;
 
-  int nextKernelId_ = 0;
+  std::atomic<int> nextKernelId_ = 0;
 
   std::unique_ptr<ResponseReceiver> responseReceiver_;
-  std::unordered_map<DeviceId, std::unique_ptr<threadPool::ThreadPool>> threadPools_;
+  // CMA copies of the memcpies, a large memcpy pushes many small chunk copies at once
+  std::unordered_map<DeviceId, std::unique_ptr<threadPool::WorkStealingThreadPool>> threadPools_;
   std::unordered_map<DeviceId, std::unique_ptr<threadPool::ThreadPool>> errorHandlingThreadPools_;
   std::unordered_map<DeviceId, AbortSync> abortSync_;
   EventManager eventManager_;
   bool running_ = false;
   bool checkMemcpyDeviceAddress_ = false;
+  CompletionCoalescing completionCoalescing_;
+  std::mutex deviceApiVersionMutex_;
   DeviceApiVersion deviceApiVersion_;
+  std::mutex kernelAbortedCallbackMutex_;
   KernelAbortedCallback kernelAbortedCallback_;
   CoreDumper coreDumper_;
 };
@@ -4,15 +4,80 @@
  *-------------------------------------------------------------------------*/
 
 #include "StreamManager.h"
+#include "Constants.h"
 #include "Utils.h"
 #include "runtime/IRuntime.h"
 #include "runtime/Types.h"
+#include <algorithm>
 #include <g3log/loglevels.hpp>
 #include <iterator>
 #include <mutex>
 #include <type_traits>
 using namespace rt;
 
+std::tuple<uint32_t, uint32_t, uint32_t> QueueHelper::cost(const QueueLoad& load, StreamPriority priority) {
+  if (priority == StreamPriority::LatencySensitive) {
+    return {load.normalStreams_, load.latencySensitiveStreams_, load.commandsInFlight_};
+  }
+  return {load.latencySensitiveStreams_, load.commandsInFlight_, load.normalStreams_};
+}
+
+uint32_t& QueueHelper::streamCount(QueueLoad& load, StreamPriority priority) {
+  return priority == StreamPriority::LatencySensitive ? load.latencySensitiveStreams_ : load.normalStreams_;
+}
+
+int QueueHelper::nextQueue(DeviceId device, StreamPriority priority) {
+  auto& loads = find(queues_, device)->second;
+  auto best = std::min_element(begin(loads), end(loads), [priority](const auto& a, const auto& b) {
+    return cost(a, priority) < cost(b, priority);
+  });
+  ++streamCount(*best, priority);
+  return static_cast<int>(std::distance(begin(loads), best));
+}
+
+void QueueHelper::addStream(DeviceId device, int queue, StreamPriority priority) {
+  ++streamCount(find(queues_, device)->second.at(static_cast<size_t>(queue)), priority);
+}
+
+std::optional<int> QueueHelper::migrateQueue(DeviceId device, int queue, StreamPriority priority) {
+  auto& loads = find(queues_, device)->second;
+  auto& current = loads.at(static_cast<size_t>(queue));
+  // don't account the stream itself when comparing with other queues
+  --streamCount(current, priority);
+  auto best = std::min_element(begin(loads), end(loads), [priority](const auto& a, const auto& b) {
+    return cost(a, priority) < cost(b, priority);
+  });
+  auto otherPriority =
+    priority == StreamPriority::Normal ? StreamPriority::LatencySensitive : StreamPriority::Normal;
+  auto currentShared = streamCount(current, otherPriority) > 0;
+  auto bestShared = streamCount(*best, otherPriority) > 0;
+  auto migrate = (currentShared && !bestShared) ||
+                 (currentShared == bestShared &&
+                  current.commandsInFlight_ >= best->commandsInFlight_ + kStreamMigrationThreshold);
+  if (!migrate) {
+    ++streamCount(current, priority);
+    return {};
+  }
+  ++streamCount(*best, priority);
+  return static_cast<int>(std::distance(begin(loads), best));
+}
+
+void QueueHelper::removeStream(DeviceId device, int queue, StreamPriority priority) {
+  --streamCount(find(queues_, device)->second.at(static_cast<size_t>(queue)), priority);
+}
+
+uint32_t QueueHelper::getLatencySensitiveStreams(DeviceId device, int queue) const {
+  return find(queues_, device)->second.at(static_cast<size_t>(queue)).latencySensitiveStreams_;
+}
+
+void QueueHelper::addCommands(DeviceId device, int queue, uint32_t count) {
+  find(queues_, device)->second.at(static_cast<size_t>(queue)).commandsInFlight_ += count;
+}
+
+void QueueHelper::removeCommands(DeviceId device, int queue, uint32_t count) {
+  find(queues_, device)->second.at(static_cast<size_t>(queue)).commandsInFlight_ -= count;
+}
+
 Stream::Info StreamManager::getStreamInfo(StreamId stream) const {
   SpinLock lock(mutex_);
   return find(streams_, stream)->second.info_;
@@ -29,24 +94,110 @@ std::optional<Stream::Info> StreamManager::getStreamInfo(EventId event) const {
   return {};
 }
 
-StreamId StreamManager::createStream(DeviceId device) {
+Stream::Info StreamManager::getSubmissionInfo(StreamId stream, EventId event) {
   SpinLock lock(mutex_);
-  auto vq = queueHelper_.nextQueue(device);
+  auto& st = find(streams_, stream)->second;
+  if (st.submittedEvents_.find(event) != end(st.submittedEvents_)) {
+    throw Exception("Trying to add an event that already exists in the stream");
+  }
+  QueueTransitions transitions;
+  // a stream with commands in flight can't change its queue, the device only keeps the order within each queue
+  if (st.submittedEvents_.empty() && !st.pinned_) {
+    auto device = DeviceId{st.info_.device_};
+    if (auto vq = queueHelper_.migrateQueue(device, st.info_.vq_, st.priority_)) {
+      RT_VLOG(MID) << "Moving stream " << static_cast<int>(stream) << " from submission queue " << st.info_.vq_
+                   << " to " << *vq;
+      if (st.priority_ == StreamPriority::LatencySensitive) {
+        if (queueHelper_.getLatencySensitiveStreams(device, st.info_.vq_) == 0) {
+          transitions.emplace_back(device, st.info_.vq_);
+        }
+        if (queueHelper_.getLatencySensitiveStreams(device, *vq) == 1) {
+          transitions.emplace_back(device, *vq);
+        }
+      }
+      st.info_.vq_ = *vq;
+    }
+  }
+  st.submittedEvents_.emplace(event);
+  queueHelper_.addCommands(DeviceId{st.info_.device_}, st.info_.vq_, 1);
+  auto info = st.info_;
+  lock.unlock();
+  // before returning, so the new queue is configured before the first command of the stream
+  notifyQueuePriorities(transitions);
+  return info;
+}
+
+StreamId StreamManager::createStream(DeviceId device, StreamPriority priority) {
+  SpinLock lock(mutex_);
+  QueueTransitions transitions;
+  auto vq = queueHelper_.nextQueue(device, priority);
+  auto id = emplaceStreamLocked(device, vq, priority, false, transitions);
+  lock.unlock();
+  notifyQueuePriorities(transitions);
+  return id;
+}
+
+StreamId StreamManager::createStream(DeviceId device, int queue, StreamPriority priority) {
+  SpinLock lock(mutex_);
+  QueueTransitions transitions;
+  queueHelper_.addStream(device, queue, priority);
+  auto id = emplaceStreamLocked(device, queue, priority, true, transitions);
+  lock.unlock();
+  notifyQueuePriorities(transitions);
+  return id;
+}
+
+StreamId StreamManager::emplaceStreamLocked(DeviceId device, int vq, StreamPriority priority, bool pinned,
+                                            QueueTransitions& transitions) {
+  if (priority == StreamPriority::LatencySensitive && queueHelper_.getLatencySensitiveStreams(device, vq) == 1) {
+    transitions.emplace_back(device, vq);
+  }
   auto id = StreamId{nextStreamId_++};
-  auto [it, res] = streams_.try_emplace(id, Stream{device, vq, id});
+  auto [it, res] = streams_.try_emplace(id, Stream{device, vq, id, priority});
   if (!res) {
     throw Exception("Error creating stream in device " +
                     std::to_string(static_cast<std::underlying_type<DeviceId>::type>(device)));
   }
+  it->second.pinned_ = pinned;
   return it->first;
 }
 
 void StreamManager::destroyStream(StreamId stream) {
   SpinLock lock(mutex_);
-  auto res = streams_.erase(stream);
-  if (!res) {
+  auto it = streams_.find(stream);
+  if (it == end(streams_)) {
     throw Exception("Trying to destroy a non-existing stream.");
   }
+  auto& info = it->second.info_;
+  queueHelper_.removeCommands(DeviceId{info.device_}, info.vq_,
+                              static_cast<uint32_t>(it->second.submittedEvents_.size()));
+  queueHelper_.removeStream(DeviceId{info.device_}, info.vq_, it->second.priority_);
+  QueueTransitions transitions;
+  if (it->second.priority_ == StreamPriority::LatencySensitive &&
+      queueHelper_.getLatencySensitiveStreams(DeviceId{info.device_}, info.vq_) == 0) {
+    transitions.emplace_back(DeviceId{info.device_}, info.vq_);
+  }
+  streams_.erase(it);
+  lock.unlock();
+  notifyQueuePriorities(transitions);
+}
+
+void StreamManager::notifyQueuePriorities(const QueueTransitions& transitions) {
+  if (transitions.empty()) {
+    return;
+  }
+  std::lock_guard callbackLock(queuePriorityMutex_);
+  if (!queuePriorityCallback_) {
+    return;
+  }
+  for (auto [device, queue] : transitions) {
+    // the queue might have changed again since the transition was recorded; the latest state is the one to report,
+    // any later transition reports its own state after this call
+    SpinLock lock(mutex_);
+    auto latencySensitive = queueHelper_.getLatencySensitiveStreams(device, queue) > 0;
+    lock.unlock();
+    queuePriorityCallback_(device, queue, latencySensitive);
+  }
 }
 
 bool StreamManager::hasEventsOnFly(DeviceId device) const {
@@ -77,19 +228,34 @@ void StreamManager::addDevice(DeviceId device, int queueCount) {
 
 void StreamManager::addEvent(StreamId stream, EventId event) {
   SpinLock lock(mutex_);
-  auto [it, result] = find(streams_, stream)->second.submittedEvents_.emplace(event);
+  auto& st = find(streams_, stream)->second;
+  auto [it, result] = st.submittedEvents_.emplace(event);
   unused(it);
   if (!result) {
     throw Exception("Trying to add an event that already exists in the stream");
   }
+  queueHelper_.addCommands(DeviceId{st.info_.device_}, st.info_.vq_, 1);
 }
 
 void StreamManager::removeEvent(EventId event) {
   SpinLock lock(mutex_);
+  removeEventLocked(event);
+}
+
+void StreamManager::removeEvents(const std::vector<EventId>& events) {
+  SpinLock lock(mutex_);
+  for (auto event : events) {
+    removeEventLocked(event);
+  }
+}
+
+void StreamManager::removeEventLocked(EventId event) {
   for (auto& [id, stream] : streams_) {
     unused(id);
-    if (stream.submittedEvents_.erase(event) > 0)
+    if (stream.submittedEvents_.erase(event) > 0) {
+      queueHelper_.removeCommands(DeviceId{stream.info_.device_}, stream.info_.vq_, 1);
       return;
+    }
   }
   RT_LOG(WARNING) << "Trying to remove a non-existing event: " << static_cast<uint32_t>(event)
                   << ". Perhaps the associated Stream was already destroyed";
@@ -130,6 +296,11 @@ void StreamManager::setErrorCallback(StreamErrorCallback callback) {
   streamErrorCallback_ = std::move(callback);
 }
 
+void StreamManager::setQueuePriorityCallback(QueuePriorityCallback callback) {
+  std::lock_guard lock(queuePriorityMutex_);
+  queuePriorityCallback_ = std::move(callback);
+}
+
 void StreamManager::addError(EventId event, StreamError error) {
   SpinLock lock(mutex_);
   for (auto& [id, stream] : streams_) {
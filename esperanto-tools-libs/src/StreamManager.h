@@ -7,16 +7,21 @@
 #include "Utils.h"
 #include "runtime/Types.h"
 #include <hostUtils/threadPool/ThreadPool.h>
+#include <functional>
 #include <mutex>
+#include <optional>
 #include <set>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace rt {
 struct Stream {
   static_assert(sizeof(std::underlying_type<DeviceId>::type) <= sizeof(int));
-  Stream(DeviceId deviceId, int vq, StreamId id)
-    : info_{static_cast<int>(deviceId), vq, id} {
+  Stream(DeviceId deviceId, int vq, StreamId id, StreamPriority priority)
+    : info_{static_cast<int>(deviceId), vq, id}
+    , priority_{priority} {
   }
   ~Stream() {
     RT_LOG_IF(WARNING, !submittedEvents_.empty()) << "Destroying stream with pending events";
@@ -28,40 +33,59 @@ struct Stream {
     int vq_;
     StreamId id_;
   } info_;
+  StreamPriority priority_;
+  // pinned streams never move to another submission queue
+  bool pinned_ = false;
   std::vector<StreamError> errors_;
 };
 
+// Chooses the submission queue of each stream based on the commands in flight in each queue and the streams priority
 class QueueHelper {
 public:
   void addDevice(DeviceId device, int queueCount) {
-    queues_.try_emplace(device, QueueInfo{queueCount});
-  }
-  int nextQueue(DeviceId device) {
-    return find(queues_, device)->second.getNextQueue();
+    queues_.try_emplace(device, static_cast<size_t>(queueCount));
   }
+  // returns the least loaded queue for a new stream, and accounts the stream in it
+  int nextQueue(DeviceId device, StreamPriority priority);
+  // accounts a new stream in the given queue
+  void addStream(DeviceId device, int queue, StreamPriority priority);
+  // returns the queue an idle stream should be moved to, if its current queue is significantly more loaded than others
+  // or it shares the queue with streams of the other priority. The stream is accounted in the new queue
+  std::optional<int> migrateQueue(DeviceId device, int queue, StreamPriority priority);
+  void removeStream(DeviceId device, int queue, StreamPriority priority);
+  uint32_t getLatencySensitiveStreams(DeviceId device, int queue) const;
+  void addCommands(DeviceId device, int queue, uint32_t count);
+  void removeCommands(DeviceId device, int queue, uint32_t count);
 
 private:
-  struct QueueInfo {
-    explicit QueueInfo(int count)
-      : nextQueue_{0}
-      , queueCount_{count} {
-    }
-    int getNextQueue() {
-      auto res = nextQueue_;
-      nextQueue_ = (nextQueue_ + 1) % queueCount_;
-      return res;
-    }
-    int nextQueue_;
-    const int queueCount_;
+  struct QueueLoad {
+    uint32_t commandsInFlight_ = 0;
+    uint32_t normalStreams_ = 0;
+    uint32_t latencySensitiveStreams_ = 0;
   };
-  std::unordered_map<DeviceId, QueueInfo> queues_;
+  // lower is better; streams avoid the queues with streams of the other priority first, then the busier queues
+  static std::tuple<uint32_t, uint32_t, uint32_t> cost(const QueueLoad& load, StreamPriority priority);
+  static uint32_t& streamCount(QueueLoad& load, StreamPriority priority);
+
+  std::unordered_map<DeviceId, std::vector<QueueLoad>> queues_;
 };
 
 class StreamManager {
 public:
+  // called, without holding the StreamManager lock, when a submission queue gets its first latency sensitive stream
+  // (latencySensitive is true) or loses its last one (false). The calls are serialized and report the state of the
+  // queue at the time of the call, so a queue can be reported twice with the same state but never end up stale
+  using QueuePriorityCallback = std::function<void(DeviceId device, int queue, bool latencySensitive)>;
+
   Stream::Info getStreamInfo(StreamId stream) const;
   std::optional<Stream::Info> getStreamInfo(EventId event) const;
-  StreamId createStream(DeviceId device);
+  StreamId createStream(DeviceId device, StreamPriority priority = StreamPriority::Normal);
+  // creates a stream pinned to the given submission queue, regardless of the queues load
+  StreamId createStream(DeviceId device, int queue, StreamPriority priority = StreamPriority::Normal);
+  // adds the event of a new command to the stream and returns the stream info to submit it. If the stream had no
+  // commands in flight it can be moved to another submission queue first (see QueueHelper::migrateQueue). Both happen
+  // under the same lock, so concurrent submissions to an idle stream can't pick different queues
+  Stream::Info getSubmissionInfo(StreamId stream, EventId event);
   void destroyStream(StreamId stream);
   bool hasEventsOnFly(DeviceId device) const;
   std::unordered_map<DeviceId, uint32_t> getEventCount() const;
@@ -71,8 +95,11 @@ public:
 
   void addEvent(StreamId stream, EventId event);
   void removeEvent(EventId event);
+  // removes all the events at once, taking the lock a single time
+  void removeEvents(const std::vector<EventId>& events);
   std::vector<StreamError> retrieveErrors(StreamId stream);
   void setErrorCallback(StreamErrorCallback callback);
+  void setQueuePriorityCallback(QueuePriorityCallback callback);
   // returns false if there is no callback. If true, it will execute the callback and after that it will execute the
   // "executeAfterCallback"
   bool executeCallback(EventId eventId, const StreamError& error, const std::function<void()>& executeAfterCallback);
@@ -80,12 +107,26 @@ public:
   void addError(const StreamError& error);
 
 private:
+  // mutex_ must be held
+  void removeEventLocked(EventId event);
+  // submission queues whose latency sensitive streams changed from none to some or the other way around
+  using QueueTransitions = std::vector<std::pair<DeviceId, int>>;
+
+  // mutex_ must be held; the stream must be already accounted in the queueHelper_
+  StreamId emplaceStreamLocked(DeviceId device, int vq, StreamPriority priority, bool pinned,
+                               QueueTransitions& transitions);
+  // mutex_ must not be held
+  void notifyQueuePriorities(const QueueTransitions& transitions);
+
   threadPool::ThreadPool threadPool_{2};
   QueueHelper queueHelper_;
   std::unordered_map<StreamId, Stream> streams_;
   std::underlying_type<StreamId>::type nextStreamId_ = 0;
   StreamErrorCallback streamErrorCallback_;
+  QueuePriorityCallback queuePriorityCallback_;
   mutable std::mutex mutex_;
+  // serializes the queuePriorityCallback_ calls, which don't hold mutex_
+  std::mutex queuePriorityMutex_;
 };
 
 } // namespace rt
\ No newline at end of file
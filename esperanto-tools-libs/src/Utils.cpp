@@ -77,6 +77,8 @@ rt::DeviceErrorCode convert(int responseType, uint32_t responseCode) {
     }
   case DEV_OPS_API_MID_DEVICE_OPS_DMA_READLIST_RSP:
   case DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_RSP:
+  case DEV_OPS_API_MID_DEVICE_OPS_MEMSET_RSP:
+  case DEV_OPS_API_MID_DEVICE_OPS_MEMCPY_D2D_RSP:
     switch (responseCode) {
     case DEV_OPS_API_DMA_RESPONSE_UNEXPECTED_ERROR:
       return rt::DeviceErrorCode::DmaUnexpectedError;
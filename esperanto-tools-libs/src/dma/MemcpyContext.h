@@ -9,7 +9,7 @@
 #include "runtime/IProfileEvent.h"
 #include "runtime/Types.h"
 #include <device-layer/IDeviceLayer.h>
-#include <hostUtils/threadPool/ThreadPool.h>
+#include <hostUtils/threadPool/WorkStealingThreadPool.h>
 
 namespace rt {
 struct MemcpyContext {
@@ -20,7 +20,7 @@ struct MemcpyContext {
   class StreamManager& streamManager_;
   class EventManager& eventManager_;
   class CommandSender& commandSender_;
-  threadPool::ThreadPool& threadPool_;
+  threadPool::WorkStealingThreadPool& threadPool_;
   StreamId stream_;
   EventId eventId_;
 };
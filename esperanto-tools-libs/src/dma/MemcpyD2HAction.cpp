@@ -57,6 +57,7 @@ bool MemcpyD2HAction::update() {
            ScopedProfileEvent pevent(profiling::Class::CmaCopy, *rt.getProfiler(), syncId);
            pevent.setParentId(evt);
            copyFunc(cmaPtr + processed, dst + pos + processed, chunkSize, CmaCopyType::FROM_CMA);
+           pevent.recordNow(); // the profiler can be replaced once the event is dispatched
            rt.dispatch(syncId);
          });
        }});
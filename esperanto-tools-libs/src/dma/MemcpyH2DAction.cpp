@@ -56,6 +56,7 @@ bool MemcpyH2DAction::update() {
       ScopedProfileEvent pevent(profiling::Class::CmaCopy, *rt.getProfiler(), syncId);
       pevent.setParentId(evt);
       copyFunction(src + pos + processed, cmaPtr + processed, chunkSize, CmaCopyType::TO_CMA);
+      pevent.recordNow(); // the profiler can be replaced once the event is dispatched
       rt.dispatch(syncId);
     });
 
@@ -56,6 +56,7 @@ bool MemcpyListD2HAction::update() {
            ScopedProfileEvent pevent(profiling::Class::CmaCopy, *rt.getProfiler(), syncId);
            pevent.setParentId(evt);
            copyFunction(cmaPtr + processed, dst, chunkSize, CmaCopyType::FROM_CMA);
+           pevent.recordNow(); // the profiler can be replaced once the event is dispatched
            rt.dispatch(syncId);
          });
        }});
@@ -50,6 +50,7 @@ bool MemcpyListH2DAction::update() {
       ScopedProfileEvent pevent(profiling::Class::CmaCopy, *rt.getProfiler(), syncId);
       pevent.setParentId(evt);
       copyFunction(src, cmaPtr + processed, chunkSize, CmaCopyType::TO_CMA);
+      pevent.recordNow(); // the profiler can be replaced once the event is dispatched
       rt.dispatch(syncId);
     });
     processed += chunkSize;
@@ -14,6 +14,7 @@
 #include "runtime/Types.h"
 
 #include <chrono>
+#include <cstring>
 #include <sstream>
 #include <thread>
 
@@ -22,7 +23,9 @@
 #include <easy/details/profiler_colors.h>
 #include <easy/profiler.h>
 
+#include <fcntl.h>
 #include <poll.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
@@ -68,7 +71,7 @@ Client::Client(const std::string& socketPath) {
   socket_ = socket(AF_UNIX, SOCK_SEQPACKET, 0);
 
   sockaddr_un addr;
-  memset(&addr, 0, sizeof(addr));
+  std::memset(&addr, 0, sizeof(addr));
   addr.sun_family = AF_UNIX;
   RT_LOG(INFO) << "Connecting to socket " << socketPath;
   strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
@@ -267,7 +270,7 @@ req::Id Client::getNextId() {
   return req::IsRegularId(res) ? res : getNextId();
 }
 
-void Client::sendRequest(const req::Request& request) {
+void Client::sendRequest(const req::Request& request, int fd) {
   EASY_FUNCTION()
   EASY_BLOCK("Serialize request")
   RT_VLOG(MID) << "Sending request " << static_cast<uint32_t>(request.type_) << " with id: " << request.id_;
@@ -283,7 +286,21 @@ void Client::sendRequest(const req::Request& request) {
   }
   responseWaiters_[request.id_] = std::make_unique<Waiter>();
   EASY_BLOCK("Write socket")
-  if (auto res = write(socket_, str.data(), str.size()); res < static_cast<long>(str.size())) {
+  iovec iov{str.data(), str.size()};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  if (fd != -1) {
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    auto cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+  }
+  if (auto res = sendmsg(socket_, &msg, 0); res < static_cast<long>(str.size())) {
     auto errorMsg = std::string{strerror(errno)};
     RT_VLOG(LOW) << "Write socket error: " << errorMsg;
     throw NetworkException("Write socket error: " + errorMsg);
@@ -429,12 +446,15 @@ void Client::handShake() {
 
   RT_LOG(INFO) << "Server protocol version: " << major << "." << minor;
 
-  if (major != Protocol::MAJOR || minor < Protocol::MINOR) {
+  if (major != Protocol::MAJOR || minor < Protocol::MIN_MINOR) {
     throw Exception(
       "Unsupported version. Current client version only supports version: >=" + std::to_string(Protocol::MAJOR) + "." +
-      std::to_string(Protocol::MINOR) + ", <" + std::to_string(Protocol::MAJOR + 1) +
+      std::to_string(Protocol::MIN_MINOR) + ", <" + std::to_string(Protocol::MAJOR + 1) +
       ".0. Please update the runtime client library or runtime daemon server.");
   }
+  serverMinor_ = minor;
+  RT_LOG_IF(INFO, minor < Protocol::SHARED_HOST_BUFFERS_MINOR)
+    << "Server doesn't support shared host buffers; registered host buffers will be copied as regular host memory.";
 
   // get deviceLayerProperties now
   auto devices = getDevices();
@@ -462,8 +482,11 @@ EventId Client::doMemcpyDeviceToHost(StreamId st, std::byte const* src, std::byt
   return registerEvent(payload, st);
 }
 
-StreamId Client::doCreateStream(DeviceId deviceId) {
-  auto payload = sendRequestAndWait(req::Type::CREATE_STREAM, req::CreateStream{deviceId});
+StreamId Client::doCreateStream(DeviceId deviceId, StreamPriority priority) {
+  // older servers place every stream as a normal priority one
+  auto payload = serverMinor_ >= Protocol::STREAM_PRIORITY_MINOR
+                   ? sendRequestAndWait(req::Type::CREATE_PRIORITY_STREAM, req::CreatePriorityStream{deviceId, priority})
+                   : sendRequestAndWait(req::Type::CREATE_STREAM, req::CreateStream{deviceId});
   auto st = std::get<resp::CreateStream>(payload).stream_;
   SpinLock lock(mutex_);
   streamToEvents_[st] = {};
@@ -491,6 +514,64 @@ void Client::doFreeDevice(DeviceId device, std::byte* ptr) {
   sendRequestAndWait(req::Type::FREE, req::Free{device, reinterpret_cast<AddressT>(ptr)});
 }
 
+std::byte* Client::doRegisterHostBuffer(DeviceId device, size_t size) {
+  if (static_cast<uint64_t>(device) >= deviceLayerProperties_.size()) {
+    throw Exception("Invalid device");
+  }
+  auto shared = serverMinor_ >= Protocol::SHARED_HOST_BUFFERS_MINOR;
+  void* address;
+  if (shared) {
+    // the buffer is backed by a memfd the server maps too, so it can access the data without reading this process
+    auto fd = memfd_create("etrt_host_buffer", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd == -1) {
+      throw Exception(std::string{"Can't create shared host buffer: "} + strerror(errno));
+    }
+    // the server refuses files that could shrink under its mapping, that would fault the whole server
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0 || fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) != 0) {
+      auto error = std::string{"Can't create shared host buffer: "} + strerror(errno);
+      close(fd);
+      throw Exception(error);
+    }
+    address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      auto error = std::string{"Can't map shared host buffer: "} + strerror(errno);
+      close(fd);
+      throw Exception(error);
+    }
+    try {
+      sendRequestAndWait(req::Type::REGISTER_HOST_BUFFER,
+                         req::HostBuffer{device, reinterpret_cast<AddressT>(address), size}, fd);
+    } catch (...) {
+      close(fd);
+      munmap(address, size);
+      throw;
+    }
+    close(fd);
+  } else {
+    address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED) {
+      throw Exception(std::string{"Can't allocate host buffer: "} + strerror(errno));
+    }
+  }
+  auto buffer = static_cast<std::byte*>(address);
+  SpinLock lock(mutex_);
+  hostBuffers_.emplace(buffer, HostBuffer{size, shared});
+  return buffer;
+}
+
+void Client::doUnregisterHostBuffer(DeviceId device, std::byte* buffer) {
+  SpinLock lock(mutex_);
+  auto it = find(hostBuffers_, buffer, "Host buffer is not registered");
+  auto hostBuffer = it->second;
+  hostBuffers_.erase(it);
+  lock.unlock();
+  if (hostBuffer.shared_) {
+    sendRequestAndWait(req::Type::UNREGISTER_HOST_BUFFER,
+                       req::HostBuffer{device, reinterpret_cast<AddressT>(buffer), hostBuffer.size_});
+  }
+  munmap(buffer, hostBuffer.size_);
+}
+
 EventId Client::doKernelLaunch(StreamId stream, KernelId kernel, const std::byte* kernel_args, size_t kernel_args_size,
                                const KernelLaunchOptionsImp& options) {
   std::vector<std::byte> kernelArgs;
@@ -605,3 +686,25 @@ EventId Client::doMemcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDst, c
                                                    reinterpret_cast<AddressT>(d_dst), size, barrier});
   return registerEvent(payload, streamDst);
 }
+
+EventId Client::doMemcpyDeviceToDevice(StreamId stream, const std::byte* d_src, std::byte* d_dst, size_t size,
+                                       bool barrier) {
+  if (serverMinor_ < Protocol::MEMCPY_D2D_MINOR) {
+    throw Exception("Server doesn't support memcpies within a device. Please update the runtime daemon server.");
+  }
+  auto payload = sendRequestAndWait(
+    req::Type::MEMCPY_D2D,
+    req::Memcpy{stream, reinterpret_cast<AddressT>(d_src), reinterpret_cast<AddressT>(d_dst), size, barrier});
+  return registerEvent(payload, stream);
+}
+
+EventId Client::doMemset(StreamId stream, std::byte* d_dst, uint64_t pattern, size_t size, uint32_t patternSize,
+                         bool barrier) {
+  if (serverMinor_ < Protocol::DEVICE_MEMSET_MINOR) {
+    throw Exception("Server doesn't support memset. Please update the runtime daemon server.");
+  }
+  auto payload =
+    sendRequestAndWait(req::Type::MEMSET, req::Memset{stream, reinterpret_cast<AddressT>(d_dst), pattern, size,
+                                                      patternSize, barrier});
+  return registerEvent(payload, stream);
+}
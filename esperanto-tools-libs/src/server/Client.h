@@ -23,7 +23,9 @@ public:
   std::vector<DeviceId> doGetDevices() final;
   std::byte* doMallocDevice(DeviceId device, size_t size, uint32_t alignment = kCacheLineSize) final;
   void doFreeDevice(DeviceId device, std::byte* buffer) final;
-  StreamId doCreateStream(DeviceId device) final;
+  std::byte* doRegisterHostBuffer(DeviceId device, size_t size) final;
+  void doUnregisterHostBuffer(DeviceId device, std::byte* buffer) final;
+  StreamId doCreateStream(DeviceId device, StreamPriority priority) final;
   void doDestroyStream(StreamId stream) final;
   LoadCodeResult doLoadCode(StreamId stream, const std::byte* elf, size_t elf_size) final;
   void doUnloadCode(KernelId kernel) final;
@@ -44,6 +46,10 @@ public:
                                  size_t size, bool barrier) final;
   EventId doMemcpyDeviceToDevice(DeviceId deviceSrc, StreamId streamDst, const std::byte* d_src, std::byte* d_dst,
                                  size_t size, bool barrier) final;
+  EventId doMemcpyDeviceToDevice(StreamId stream, const std::byte* d_src, std::byte* d_dst, size_t size,
+                                 bool barrier) final;
+  EventId doMemset(StreamId stream, std::byte* d_dst, uint64_t pattern, size_t size, uint32_t patternSize,
+                   bool barrier) final;
 
   bool doWaitForEvent(EventId event, std::chrono::seconds timeout = std::chrono::hours(24)) final;
 
@@ -82,15 +88,17 @@ private:
 
   void onProfilerChanged() final;
 
-  template <typename Payload> resp::Response::Payload_t sendRequestAndWait(req::Type type, Payload payload) {
+  template <typename Payload>
+  resp::Response::Payload_t sendRequestAndWait(req::Type type, Payload payload, int fd = -1) {
     auto reqId = getNextId();
-    sendRequest({type, reqId, std::move(payload)});
+    sendRequest({type, reqId, std::move(payload)}, fd);
     return waitForResponse(reqId);
   }
   void dispatch(EventId event);
   void handShake();
 
-  void sendRequest(const req::Request& request);
+  // if fd is not -1, the file descriptor is sent along the request
+  void sendRequest(const req::Request& request, int fd = -1);
   void processResponse(const resp::Response& response);
 
   void responseProcessor();
@@ -137,6 +145,15 @@ private:
   std::unordered_map<StreamId, std::vector<StreamError>> streamErrors_;
   resp::P2PCompatibility p2pCompatibility_;
 
+  // host buffers returned by doRegisterHostBuffer; they are shared with the server if it supports it, otherwise they are
+  // plain memory copied through CMA as any other host memory
+  struct HostBuffer {
+    size_t size_;
+    bool shared_;
+  };
+  std::unordered_map<std::byte*, HostBuffer> hostBuffers_;
+  uint32_t serverMinor_ = 0;
+
   std::condition_variable eventSync_;
   std::thread listener_;
   std::mutex mutex_;
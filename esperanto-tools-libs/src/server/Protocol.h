@@ -43,7 +43,17 @@ template <class Archive> void serialize(Archive& archive, StreamError& se) {
 
 namespace Protocol {
 static constexpr int MAJOR = 3;
-static constexpr int MINOR = 3;
+static constexpr int MINOR = 7;
+// oldest minor version of the server the client can work with; newer features are only used if the server has them
+static constexpr int MIN_MINOR = 3;
+// first minor version with shared host buffers (REGISTER_HOST_BUFFER / UNREGISTER_HOST_BUFFER)
+static constexpr int SHARED_HOST_BUFFERS_MINOR = 4;
+// first minor version with stream priorities (CREATE_PRIORITY_STREAM)
+static constexpr int STREAM_PRIORITY_MINOR = 5;
+// first minor version with device side memset (MEMSET)
+static constexpr int DEVICE_MEMSET_MINOR = 6;
+// first minor version with memcpies within a device (MEMCPY_D2D)
+static constexpr int MEMCPY_D2D_MINOR = 7;
 } // namespace Protocol
 
 namespace req {
@@ -77,6 +87,11 @@ enum class Type : uint32_t {
   MEMCPY_P2P_WRITE,
   ENABLE_TRACING,
   DISABLE_TRACING,
+  REGISTER_HOST_BUFFER,
+  UNREGISTER_HOST_BUFFER,
+  CREATE_PRIORITY_STREAM,
+  MEMSET,
+  MEMCPY_D2D,
 };
 
 using Id = uint32_t;
@@ -170,6 +185,26 @@ struct CreateStream {
   }
 };
 
+struct CreatePriorityStream {
+  DeviceId device_;
+  StreamPriority priority_;
+  template <class Archive> void serialize(Archive& archive) {
+    archive(device_, priority_);
+  }
+};
+
+struct Memset {
+  StreamId stream_;
+  AddressT dst_;
+  uint64_t pattern_;
+  size_t size_;
+  uint32_t patternSize_;
+  bool barrier_;
+  template <class Archive> void serialize(Archive& archive) {
+    archive(stream_, dst_, pattern_, size_, patternSize_, barrier_);
+  }
+};
+
 struct DestroyStream {
   StreamId stream_;
   template <class Archive> void serialize(Archive& archive) {
@@ -209,6 +244,17 @@ struct Free {
   }
 };
 
+// host buffer shared between client and server. When registering, the memfd backing the buffer is sent along the
+// request as SCM_RIGHTS ancillary data; address_ is where the client mapped it
+struct HostBuffer {
+  DeviceId device_;
+  AddressT address_;
+  size_t size_;
+  template <class Archive> void serialize(Archive& archive) {
+    archive(device_, address_, size_);
+  }
+};
+
 struct AbortStream {
   StreamId streamId_;
   template <class Archive> void serialize(Archive& archive) {
@@ -235,7 +281,8 @@ struct Request {
   Type type_;
   Id id_ = INVALID_REQUEST_ID;
   std::variant<std::monostate, UnloadCode, KernelLaunch, Memcpy, MemcpyList, CreateStream, DestroyStream, LoadCode,
-               Malloc, Free, AbortStream, AbortCommand, DeviceId, EventId, MemcpyP2P>
+               Malloc, Free, AbortStream, AbortCommand, DeviceId, EventId, MemcpyP2P, HostBuffer, CreatePriorityStream,
+               Memset>
     payload_;
   template <class Archive> void serialize(Archive& archive) {
     archive(type_, id_, payload_);
@@ -277,6 +324,11 @@ enum class Type : uint32_t {
   ENABLE_TRACING,
   DISABLE_TRACING,
   TRACING_EVENT,
+  REGISTER_HOST_BUFFER,
+  UNREGISTER_HOST_BUFFER,
+  CREATE_PRIORITY_STREAM,
+  MEMSET,
+  MEMCPY_D2D,
 };
 
 constexpr auto getStr(Type t) {
@@ -316,6 +368,11 @@ constexpr auto getStr(Type t) {
     STR_TYPE(ENABLE_TRACING)
     STR_TYPE(DISABLE_TRACING)
     STR_TYPE(TRACING_EVENT)
+    STR_TYPE(REGISTER_HOST_BUFFER)
+    STR_TYPE(UNREGISTER_HOST_BUFFER)
+    STR_TYPE(CREATE_PRIORITY_STREAM)
+    STR_TYPE(MEMSET)
+    STR_TYPE(MEMCPY_D2D)
 
   default:
     return "Unknown type";
@@ -20,7 +20,10 @@
 #include <g3log/loglevels.hpp>
 
 #include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/poll.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
@@ -68,8 +71,19 @@ Worker::Worker(int socket, RuntimeImp& runtime, Server& server, ucred credential
   pid_ = getpid();
 
   runtime_.attach(this);
-  cmaCopyFunction_ = [pid = credentials.pid](const std::byte* src, std::byte* dst, size_t size, CmaCopyType type) {
+  cmaCopyFunction_ = [sharedBuffers = sharedBuffers_, pid = credentials.pid](const std::byte* src, std::byte* dst,
+                                                                             size_t size, CmaCopyType type) {
     EASY_BLOCK("CMA copy", profiler::colors::Green)
+    // memory shared with the client is copied directly, the remote process is only accessed for the rest
+    if (type == CmaCopyType::TO_CMA) {
+      if (auto [buffer, local] = sharedBuffers->find(src, size); buffer) {
+        std::memcpy(dst, local, size);
+        return;
+      }
+    } else if (auto [buffer, local] = sharedBuffers->find(dst, size); buffer) {
+      std::memcpy(local, src, size);
+      return;
+    }
     iovec local;
     iovec remote;
     local.iov_len = remote.iov_len = size;
@@ -112,6 +126,28 @@ Worker::~Worker() {
   RT_VLOG(LOW) << "Worker dtor ended. Ptr:" << this;
 }
 
+Worker::SharedBuffer::~SharedBuffer() {
+  if (munmap(address_, size_) != 0) {
+    RT_LOG(WARNING) << "Error unmapping shared host buffer: " << strerror(errno);
+  }
+}
+
+std::pair<std::shared_ptr<Worker::SharedBuffer>, std::byte*> Worker::SharedBuffers::find(const std::byte* address,
+                                                                                          size_t size) {
+  auto addr = reinterpret_cast<AddressT>(address);
+  std::lock_guard lock(mutex_);
+  auto it = buffers_.upper_bound(addr);
+  if (it == begin(buffers_)) {
+    return {};
+  }
+  --it;
+  auto& buffer = it->second;
+  if (addr + size > it->first + buffer->size_) {
+    return {};
+  }
+  return {buffer, buffer->address_ + (addr - it->first)};
+}
+
 rt::profiling::RemoteProfiler* Worker::getProfiler() {
   return dynamic_cast<rt::profiling::RemoteProfiler*>(runtime_.getProfiler());
 }
@@ -149,7 +185,19 @@ void Worker::requestProcessor(pid_t clientPID) {
       EASY_END_BLOCK
 
       EASY_BLOCK("read")
-      auto res = read(socket_, requestBuffer.data(), requestBuffer.size());
+      iovec iov{requestBuffer.data(), requestBuffer.size()};
+      alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+      msghdr msg{};
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      auto res = recvmsg(socket_, &msg, MSG_CMSG_CLOEXEC);
+      int fd = -1;
+      if (auto cmsg = CMSG_FIRSTHDR(&msg); res > 0 && cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET &&
+                                           cmsg->cmsg_type == SCM_RIGHTS) {
+        std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+      }
       if (res < 0) {
         auto msg = std::string{"Read socket error: "} + strerror(errno);
         RT_VLOG(LOW) << msg;
@@ -162,13 +210,20 @@ void Worker::requestProcessor(pid_t clientPID) {
         std::istream is(&ms);
         req::Id id{req::INVALID_REQUEST_ID};
         try {
-          cereal::PortableBinaryInputArchive archive{is};
           req::Request request;
-          archive >> request;
+          try {
+            cereal::PortableBinaryInputArchive archive{is};
+            archive >> request;
+          } catch (...) {
+            if (fd != -1) {
+              close(fd);
+            }
+            throw;
+          }
           id = request.id_; // save in case runtime triggers an exception to answer with correct id
           EASY_END_BLOCK
 
-          processRequest(request);
+          processRequest(request, fd);
         } catch (const Exception& e) {
           if (running_) {
             RT_VLOG(LOW) << "Got a runtime exception. Passing that exception to the client.";
@@ -187,8 +242,17 @@ void Worker::requestProcessor(pid_t clientPID) {
   profiler->releaseThisThreadsWorker();
 }
 
-void Worker::processRequest(const req::Request& request) {
+void Worker::processRequest(const req::Request& request, int fd) {
   EASY_FUNCTION(profiler::colors::LightGreen)
+  // the received file descriptor is only needed until REGISTER_HOST_BUFFER maps it
+  struct FdCloser {
+    ~FdCloser() {
+      if (fd_ != -1) {
+        close(fd_);
+      }
+    }
+    int fd_;
+  } fdCloser{fd};
   SpinLock lock(mutex_);
   RT_VLOG(MID) << "Processing request. Type: " << static_cast<uint32_t>(request.type_) << " Id: " << request.id_;
   switch (request.type_) {
@@ -264,6 +328,16 @@ void Worker::processRequest(const req::Request& request) {
     break;
   }
 
+  case req::Type::CREATE_PRIORITY_STREAM: {
+    auto& req = std::get<req::CreatePriorityStream>(request.payload_);
+    auto st = runtime_.createStream(req.device_, req.priority_);
+    auto profiler = getProfiler();
+    profiler->assignRemoteWorkerToStream(st);
+    streams_.insert(st);
+    sendResponse({resp::Type::CREATE_PRIORITY_STREAM, request.id_, resp::CreateStream{st}});
+    break;
+  }
+
   case req::Type::DESTROY_STREAM: {
     auto& req = std::get<req::DestroyStream>(request.payload_);
     auto st = req.stream_;
@@ -429,6 +503,25 @@ void Worker::processRequest(const req::Request& request) {
     break;
   }
 
+  case req::Type::MEMSET: {
+    auto& req = std::get<req::Memset>(request.payload_);
+    auto dst = reinterpret_cast<std::byte*>(req.dst_);
+    auto evt = runtime_.memset(req.stream_, dst, req.pattern_, req.size_, req.patternSize_, req.barrier_);
+    events_.emplace(evt);
+    sendResponse({resp::Type::MEMSET, request.id_, resp::Event{evt}});
+    break;
+  }
+
+  case req::Type::MEMCPY_D2D: {
+    auto& req = std::get<req::Memcpy>(request.payload_);
+    auto src = reinterpret_cast<std::byte*>(req.src_);
+    auto dst = reinterpret_cast<std::byte*>(req.dst_);
+    auto evt = runtime_.memcpyDeviceToDevice(req.stream_, src, dst, req.size_, req.barrier_);
+    events_.emplace(evt);
+    sendResponse({resp::Type::MEMCPY_D2D, request.id_, resp::Event{evt}});
+    break;
+  }
+
   case req::Type::ENABLE_TRACING: {
     auto profiler = getProfiler();
     if (profiler != nullptr) {
@@ -453,6 +546,51 @@ void Worker::processRequest(const req::Request& request) {
     break;
   }
 
+  case req::Type::REGISTER_HOST_BUFFER: {
+    auto& req = std::get<req::HostBuffer>(request.payload_);
+    if (fd == -1) {
+      throw Exception("Host buffer registration without a file descriptor");
+    }
+    // accessing a mapping past the end of the file raises SIGBUS and would bring the whole server down, so only take
+    // files sealed against shrinking and at least as big as the buffer
+    auto seals = fcntl(fd, F_GET_SEALS);
+    if (seals == -1 || (seals & F_SEAL_SHRINK) == 0) {
+      throw Exception("Host buffer file descriptor is not sealed against shrinking");
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+      throw Exception(std::string{"Can't stat shared host buffer: "} + strerror(errno));
+    }
+    if (fileStat.st_size < 0 || static_cast<uint64_t>(fileStat.st_size) < req.size_) {
+      throw Exception("Host buffer file descriptor is smaller than the buffer");
+    }
+    auto address = mmap(nullptr, req.size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      throw Exception(std::string{"Can't map shared host buffer: "} + strerror(errno));
+    }
+    auto buffer = std::make_shared<SharedBuffer>(static_cast<std::byte*>(address), req.size_);
+    std::lock_guard sharedLock(sharedBuffers_->mutex_);
+    if (!sharedBuffers_->buffers_.emplace(req.address_, std::move(buffer)).second) {
+      throw Exception("Host buffer already registered");
+    }
+    RT_VLOG(LOW) << "Registered shared host buffer. Client address: " << std::hex << req.address_
+                 << " server address: " << address << " size: " << req.size_;
+    sendResponse({resp::Type::REGISTER_HOST_BUFFER, request.id_, std::monostate{}});
+    break;
+  }
+
+  case req::Type::UNREGISTER_HOST_BUFFER: {
+    auto& req = std::get<req::HostBuffer>(request.payload_);
+    std::unique_lock sharedLock(sharedBuffers_->mutex_);
+    if (sharedBuffers_->buffers_.erase(req.address_) != 1) {
+      RT_LOG(WARNING) << "Trying to unregister a non previously registered host buffer.";
+      throw Exception("Trying to unregister a non previously registered host buffer.");
+    }
+    sharedLock.unlock();
+    sendResponse({resp::Type::UNREGISTER_HOST_BUFFER, request.id_, std::monostate{}});
+    break;
+  }
+
   default:
     RT_LOG(WARNING) << "Unknown request: " << static_cast<int>(request.type_) << " id: " << request.id_;
     throw Exception("Unknown request: " + std::to_string(static_cast<int>(request.type_)));
@@ -483,6 +621,9 @@ void Worker::freeResources() {
     }
   }
   kernelAbortedFreeResources_.clear();
+
+  std::lock_guard lock(sharedBuffers_->mutex_);
+  sharedBuffers_->buffers_.clear();
 }
 
 void Worker::onStreamError(EventId event, const StreamError& error) {
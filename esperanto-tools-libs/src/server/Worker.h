@@ -8,6 +8,8 @@
 #include "runtime/Types.h"
 #include "server/Protocol.h"
 
+#include <map>
+#include <memory>
 #include <set>
 #include <sys/socket.h>
 #include <thread>
@@ -40,12 +42,36 @@ public:
 private:
   void requestProcessor(pid_t clientPID);
   void freeResources();
-  void processRequest(const req::Request& request);
+  // fd is the file descriptor received along the request, or -1. processRequest takes its ownership
+  void processRequest(const req::Request& request, int fd);
 
   void sendResponse(const resp::Response& response);
 
   rt::profiling::RemoteProfiler* getProfiler();
 
+  // client host buffer (see req::HostBuffer) mapped in the server; unmapped when the last reference is released
+  struct SharedBuffer {
+    SharedBuffer(std::byte* address, size_t size)
+      : address_(address)
+      , size_(size) {
+    }
+    ~SharedBuffer();
+    SharedBuffer(const SharedBuffer&) = delete;
+    SharedBuffer& operator=(const SharedBuffer&) = delete;
+    std::byte* address_;
+    size_t size_;
+  };
+
+  // shared buffers by client address. They are looked up by the CMA copy function, which can run in runtime threads
+  // and outlive the worker; hence its own mutex and shared ownership
+  struct SharedBuffers {
+    // returns the buffer containing [address, address + size) of the client and the corresponding server address; or a
+    // nullptr buffer if that memory is not shared
+    std::pair<std::shared_ptr<SharedBuffer>, std::byte*> find(const std::byte* address, size_t size);
+    std::map<AddressT, std::shared_ptr<SharedBuffer>> buffers_;
+    std::mutex mutex_;
+  };
+
   struct Allocation {
     DeviceId device_;
     std::byte* ptr_;
@@ -63,6 +89,7 @@ private:
   std::set<StreamId> streams_;
   std::set<KernelId> kernels_;
   std::set<EventId> events_;
+  std::shared_ptr<SharedBuffers> sharedBuffers_ = std::make_shared<SharedBuffers>();
   std::thread runner_;
   Server& server_;
   std::recursive_mutex mutex_;
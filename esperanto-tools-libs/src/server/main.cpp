@@ -11,10 +11,12 @@
 #include "runtime/DeviceLayerFake.h"
 #include "runtime/IProfiler.h"
 
+#include <esperanto/device-apis/operations-api/device_ops_api_cxx.h>
 #include <gflags/gflags.h>
 #include <hostUtils/logging/Logger.h>
 #include <sw-sysemu/SysEmuOptions.h>
 
+#include <chrono>
 #include <condition_variable>
 #include <csignal>
 #include <fstream>
@@ -49,7 +51,7 @@ bool validateVerbosity(const char* flagName, int value) {
   return true;
 }
 bool validateTraceMode(const char* flagName, const std::string& value) {
-  if (value != "json" && value != "binary") {
+  if (value != "json" && value != "binary" && value != "compact") {
     printf("Invalid value for --%s: %s\n", flagName, value.c_str());
     return false;
   }
@@ -63,6 +65,22 @@ bool validateNumDevices(const char* flagName, uint32_t value) {
   }
   return true;
 }
+
+bool validateCoalesceCompletions(const char* flagName, uint32_t value) {
+  if (value > DEVICE_OPS_CQ_COALESCE_COUNT_MAX) {
+    printf("Invalid value for --%s: %d\n", flagName, value);
+    return false;
+  }
+  return true;
+}
+
+bool validateCoalesceTimeout(const char* flagName, uint32_t value) {
+  if (value == 0 || value > DEVICE_OPS_CQ_COALESCE_TIMEOUT_US_MAX) {
+    printf("Invalid value for --%s: %d\n", flagName, value);
+    return false;
+  }
+  return true;
+}
 constexpr auto kBootRomTrampolineToBl2Elf = "/BootromTrampolineToBL2.elf";
 constexpr auto kBl2Elf = "/ServiceProcessorBL2_fast-boot.elf";
 constexpr auto kMasterMinionElf = "/MasterMinion.elf";
@@ -87,12 +105,21 @@ DEFINE_string(device_type, "pcie",
 DEFINE_validator(device_type, &validateDeviceType);
 DEFINE_validator(log_verbosity, &validateVerbosity);
 DEFINE_string(tracing_folder, "/var/log/et_runtime", "Folder where will be put the tracing files.");
-DEFINE_string(tracing_mode, "json", "Tracing mode can be json or bin");
+DEFINE_string(tracing_mode, "json", "Tracing mode can be json, binary or compact");
 DEFINE_validator(tracing_mode, &validateTraceMode);
 DEFINE_string(tracing_file, "daemon.trace",
               "File which will be stored in tracing_folder containing the traces, it will be appended with '.json' or "
               "'.bin' depending on tracing_mode");
 DEFINE_bool(enable_tracing, false, "Enables/disables runtime tracing.");
+DEFINE_bool(poll_responses, false,
+            "Polls the device completion queues at fixed intervals instead of waiting for device notifications.");
+DEFINE_uint32(coalesce_completions, 0,
+              "Number of command completions the device packs in a single response (0 or 1 disables the completion "
+              "coalescing). Submission queues used by latency sensitive streams are not coalesced.");
+DEFINE_uint32(coalesce_timeout_us, 100,
+              "Maximum time in microseconds the device holds a completion back when coalescing completions.");
+DEFINE_validator(coalesce_completions, &validateCoalesceCompletions);
+DEFINE_validator(coalesce_timeout_us, &validateCoalesceTimeout);
 DEFINE_string(sysemu_data_folder, "/var/lib/et_runtime",
               "In case of running device_type=sysemu this folder must contain required sysemu elfs: "
               "\n\tBootromTrampolineToBL2.elf\n\tServiceProcessorBL2_fast-boot.elf\n\tMasterMinion."
@@ -206,6 +233,11 @@ int main(int argc, char* argv[]) {
     if (FLAGS_device_type == "fake") {
       opts.checkDeviceApiVersion_ = false;
     }
+    if (FLAGS_poll_responses) {
+      opts.responseReceiveMode_ = rt::ResponseReceiveMode::Polling;
+    }
+    opts.completionCoalescing_.maxCompletions_ = static_cast<uint16_t>(FLAGS_coalesce_completions);
+    opts.completionCoalescing_.timeout_ = std::chrono::microseconds(FLAGS_coalesce_timeout_us);
 
     rt::Server s(FLAGS_socket_path, deviceLayer, opts);
 
@@ -225,7 +257,9 @@ int main(int argc, char* argv[]) {
       profiler->setLocalProfiler(std::move(localProfiler));
 
       auto type = rt::IProfiler::OutputType::Json;
-      if (FLAGS_tracing_mode != "json") {
+      if (FLAGS_tracing_mode == "compact") {
+        type = rt::IProfiler::OutputType::Compact;
+      } else if (FLAGS_tracing_mode != "json") {
         type = rt::IProfiler::OutputType::Binary;
       }
       profiler->start(*traceFileStream, type);
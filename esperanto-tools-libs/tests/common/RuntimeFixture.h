@@ -23,7 +23,7 @@ public:
   enum class RtType { SP, MP };
 
   void SetUp() override {
-    auto options = rt::getDefaultOptions();
+    auto options = options_;
     auto dlCreator = [this] {
       switch (sDlType) {
       case DeviceLayerImp::PCIE:
@@ -176,6 +176,8 @@ private:
 
 protected:
   uint8_t numDevices_ = 1;
+  // derived fixtures can tweak the runtime options before calling RuntimeFixture::SetUp
+  rt::Options options_ = rt::getDefaultOptions();
   std::ofstream traceOut_;
   std::unique_ptr<logging::LoggerDefault> loggerDefault_;
   std::shared_ptr<dev::IDeviceLayer> deviceLayer_; // only set for SP mode
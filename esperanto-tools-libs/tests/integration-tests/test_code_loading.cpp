@@ -100,6 +100,71 @@ TEST_F(TestCodeLoading, MultipleLoads) {
   }
 }
 
+// Capture memcpies and a kernel launch once and replay them with different inputs and kernel args
+TEST_F(TestCodeLoading, LaunchGraph) {
+  if (sRtType == RtType::MP) {
+    RT_LOG(INFO) << "The client runtime doesn't support graph capture, skipping this test";
+    EXPECT_THROW(runtime_->beginCapture(defaultStreams_[0]), rt::Exception);
+    return;
+  }
+  auto kernel = loadKernel("add_vector.elf");
+  auto numElems = 150U;
+  auto size = numElems * sizeof(int);
+  auto stream = defaultStreams_[0];
+  auto hBuffer = runtime_->registerHostBuffer(devices_[0], 3 * size);
+  auto hSrc1 = reinterpret_cast<int*>(hBuffer);
+  auto hSrc2 = reinterpret_cast<int*>(hBuffer + size);
+  auto hDst = reinterpret_cast<int*>(hBuffer + 2 * size);
+  auto dSrc1 = runtime_->mallocDevice(devices_[0], size);
+  auto dSrc2 = runtime_->mallocDevice(devices_[0], size);
+  auto dDst = runtime_->mallocDevice(devices_[0], size);
+
+  struct {
+    void* src1;
+    void* src2;
+    void* dst;
+    int elements;
+  } params{dSrc1, dSrc2, dDst, static_cast<int>(numElems)};
+  runtime_->waitForStream(stream);
+  runtime_->beginCapture(stream);
+  runtime_->memcpyHostToDevice(stream, hBuffer, dSrc1, size);
+  runtime_->memcpyHostToDevice(stream, hBuffer + size, dSrc2, size);
+  runtime_->kernelLaunch(stream, kernel, reinterpret_cast<std::byte*>(&params), sizeof(params), 0x1);
+  runtime_->memcpyDeviceToHost(stream, dDst, hBuffer + 2 * size, size);
+  auto graph = runtime_->endCapture(stream);
+
+  for (auto i = 0; i < 5; ++i) {
+    std::vector<int> src1(numElems);
+    std::vector<int> src2(numElems);
+    randomize(src1, -1000, 1000);
+    randomize(src2, -1000, 1000);
+    std::copy(begin(src1), end(src1), hSrc1);
+    std::copy(begin(src2), end(src2), hSrc2);
+    runtime_->launchGraph(stream, graph);
+    runtime_->waitForStream(stream);
+    for (auto j = 0U; j < numElems; ++j) {
+      ASSERT_EQ(hDst[j], src1[j] + src2[j]);
+    }
+  }
+
+  // second source replaced by the first one
+  params.src2 = dSrc1;
+  runtime_->setGraphKernelArgs(graph, 2, reinterpret_cast<std::byte*>(&params), sizeof(params));
+  EXPECT_THROW(runtime_->setGraphKernelArgs(graph, 2, reinterpret_cast<std::byte*>(&params), 1), rt::Exception);
+  runtime_->launchGraph(stream, graph);
+  runtime_->waitForStream(stream);
+  for (auto j = 0U; j < numElems; ++j) {
+    ASSERT_EQ(hDst[j], 2 * hSrc1[j]);
+  }
+
+  runtime_->destroyGraph(graph);
+  runtime_->unloadCode(kernel);
+  runtime_->freeDevice(devices_[0], dSrc1);
+  runtime_->freeDevice(devices_[0], dSrc2);
+  runtime_->freeDevice(devices_[0], dDst);
+  runtime_->unregisterHostBuffer(devices_[0], hBuffer);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
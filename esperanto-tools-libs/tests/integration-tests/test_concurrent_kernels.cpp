@@ -0,0 +1,103 @@
+//******************************************************************************
+// Copyright (c) 2025 Ainekko, Co.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------------
+
+#include "CompactTrace.h"
+#include "RuntimeFixture.h"
+#include "runtime/IProfileEvent.h"
+#include "runtime/IProfiler.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <unordered_map>
+
+using namespace rt;
+using namespace rt::profiling;
+
+namespace {
+struct Parameters {
+  uint64_t numIters_;
+};
+constexpr auto kNumIters = 200000UL;
+
+class TestConcurrentKernels : public RuntimeFixture {
+public:
+  void SetUp() override {
+    RuntimeFixture::SetUp();
+    // the stream balancer places each new stream on the least loaded submission queue, so these two streams (plus the
+    // default one) end up in different submission queues
+    streams_[0] = runtime_->createStream(devices_[0]);
+    streams_[1] = runtime_->createStream(devices_[0]);
+    kernel_ = loadKernel("jump_loop.elf");
+  }
+  void TearDown() override {
+    for (auto st : streams_) {
+      runtime_->waitForStream(st);
+      runtime_->destroyStream(st);
+    }
+    RuntimeFixture::TearDown();
+  }
+  EventId launch(size_t streamIdx, uint64_t shireMask) {
+    return runtime_->kernelLaunch(streams_[streamIdx], kernel_, reinterpret_cast<const std::byte*>(&params_),
+                                  sizeof(params_), shireMask);
+  }
+  KernelId kernel_;
+  std::array<StreamId, 2> streams_;
+  Parameters params_{kNumIters};
+};
+
+// device timestamps (in cycles) of a kernel launch, from its response
+struct DeviceSpan {
+  uint64_t start_;
+  uint64_t end_;
+};
+} // namespace
+
+// Kernels with disjoint shire masks sent from different submission queues must run at the same time in the device: the
+// time from the first start to the last end must be close to the slower kernel duration, not the sum of both.
+TEST_F(TestConcurrentKernels, disjointShireMasks) {
+  std::stringstream trace(std::ios::in | std::ios::out | std::ios::binary);
+  auto profiler = runtime_->getProfiler();
+  profiler->start(trace, IProfiler::OutputType::Compact);
+
+  // each kernel alone
+  auto evtAlone0 = launch(0, 0x1);
+  runtime_->waitForStream(streams_[0]);
+  auto evtAlone1 = launch(1, 0x2);
+  runtime_->waitForStream(streams_[1]);
+
+  // both at once
+  auto evtBoth0 = launch(0, 0x1);
+  auto evtBoth1 = launch(1, 0x2);
+  runtime_->waitForStream(streams_[0]);
+  runtime_->waitForStream(streams_[1]);
+  profiler->stop();
+
+  std::unordered_map<EventId, DeviceSpan> spans;
+  readCompactTrace(trace, [&spans](const ProfileEvent& evt) {
+    if (evt.getClass() == Class::ResponseReceived && evt.getResponseType() == ResponseType::Kernel) {
+      auto start = evt.getDeviceCmdStartTs().value();
+      spans[evt.getEvent().value()] = DeviceSpan{start, start + evt.getDeviceCmdExecDur().value()};
+    }
+  });
+  for (auto evt : {evtAlone0, evtAlone1, evtBoth0, evtBoth1}) {
+    ASSERT_EQ(spans.count(evt), 1U) << "Missing kernel response for event " << static_cast<int>(evt);
+  }
+
+  auto alone0 = spans[evtAlone0].end_ - spans[evtAlone0].start_;
+  auto alone1 = spans[evtAlone1].end_ - spans[evtAlone1].start_;
+  auto both = std::max(spans[evtBoth0].end_, spans[evtBoth1].end_) -
+              std::min(spans[evtBoth0].start_, spans[evtBoth1].start_);
+  auto slower = std::max(alone0, alone1);
+  auto faster = std::min(alone0, alone1);
+  RT_LOG(INFO) << "Kernel alone: " << alone0 << " and " << alone1 << " cycles. Both at once: " << both << " cycles.";
+  // serialized kernels would take slower + faster
+  EXPECT_LT(both, slower + faster / 2);
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  RuntimeFixture::ParseArguments(argc, argv);
+  return RUN_ALL_TESTS();
+}
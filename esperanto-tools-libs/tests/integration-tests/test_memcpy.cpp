@@ -7,6 +7,7 @@
 #include "RuntimeImp.h"
 #include "common/Constants.h"
 #include "runtime/Types.h"
+#include <algorithm>
 #include <device-layer/IDeviceLayer.h>
 #include <gtest/gtest.h>
 #include <hostUtils/logging/Logger.h>
@@ -147,6 +148,47 @@ TEST_F(TestMemcpy, dmaListSimple) {
   }
 }
 
+TEST_F(TestMemcpy, registeredHostBufferMemcpy) {
+  auto dev = devices_[0];
+  std::mt19937 gen(std::random_device{}());
+  std::uniform_int_distribution<int> dis;
+
+  auto stream = runtime_->createStream(dev);
+  auto numElems = 1024 * 1024 * 4;
+  auto sizeBytes = numElems * sizeof(int);
+  auto h_src = runtime_->registerHostBuffer(dev, sizeBytes);
+  auto h_dst = runtime_->registerHostBuffer(dev, sizeBytes);
+  auto src = reinterpret_cast<int*>(h_src);
+  auto dst = reinterpret_cast<int*>(h_dst);
+  for (int i = 0; i < numElems; ++i) {
+    src[i] = dis(gen);
+    dst[i] = 0;
+  }
+  auto d_buffer = runtime_->mallocDevice(dev, sizeBytes);
+
+  // copy from the registered buffer to device and back to another registered buffer; check they are equal
+  runtime_->memcpyHostToDevice(stream, h_src, d_buffer, sizeBytes);
+  runtime_->memcpyDeviceToHost(stream, d_buffer, h_dst, sizeBytes);
+  runtime_->waitForStream(stream);
+  EXPECT_TRUE(std::equal(src, src + numElems, dst));
+
+  // lists and copies from the middle of a registered buffer go through the same path
+  auto offset = 4096U;
+  rt::MemcpyList list;
+  list.addOp(d_buffer + offset, h_dst, offset);
+  std::fill(dst, dst + numElems, 0);
+  runtime_->memcpyDeviceToHost(stream, list);
+  runtime_->memcpyDeviceToHost(stream, d_buffer, h_dst + offset, sizeBytes - offset);
+  runtime_->waitForStream(stream);
+  EXPECT_TRUE(std::equal(src + offset / sizeof(int), src + 2 * offset / sizeof(int), dst));
+  EXPECT_TRUE(std::equal(src, src + (sizeBytes - offset) / sizeof(int), dst + offset / sizeof(int)));
+
+  runtime_->freeDevice(dev, d_buffer);
+  runtime_->unregisterHostBuffer(dev, h_src);
+  runtime_->unregisterHostBuffer(dev, h_dst);
+  EXPECT_THROW(runtime_->unregisterHostBuffer(dev, h_src), rt::Exception);
+}
+
 TEST_F(TestMemcpy, memcpyD2DCheckExceptions) {
   if (sDlType != RuntimeFixture::DeviceLayerImp::PCIE) { // force multidevice if its not PCIE
     numDevices_ = 2;
@@ -237,6 +279,85 @@ TEST_F(TestMemcpy, simpleMemcpyD2D) {
   ASSERT_EQ(random_trash, result);
 }
 
+TEST_F(TestMemcpy, memsetCheckExceptions) {
+  auto dev = devices_[0];
+  auto stream = runtime_->createStream(dev);
+  auto d_buffer = runtime_->mallocDevice(dev, 1024);
+  EXPECT_THROW(runtime_->memset(stream, d_buffer, 0, 1024, 3);, rt::Exception);
+  EXPECT_THROW(runtime_->memset(stream, d_buffer, 0, 1024, 16);, rt::Exception);
+  EXPECT_THROW(runtime_->memset(stream, d_buffer, 0, 0);, rt::Exception);
+  runtime_->waitForStream(stream);
+}
+
+TEST_F(TestMemcpy, memsetPatterns) {
+  auto dev = devices_[0];
+  auto stream = runtime_->createStream(dev);
+  auto sizeBytes = 3UL * 1024 * 1024 + 77;
+  auto d_buffer = runtime_->mallocDevice(dev, sizeBytes);
+  auto pattern = uint64_t{0x0123456789ABCDEF};
+  // neither the start nor the end of the region are 8 bytes aligned, and it spans several device fill chunks
+  auto offset = 3UL;
+  auto fillSize = sizeBytes - offset - 5;
+
+  for (auto patternSize : {1U, 2U, 4U, 8U}) {
+    auto sentinel = std::vector<std::byte>(sizeBytes, std::byte{0x5A});
+    runtime_->memcpyHostToDevice(stream, sentinel.data(), d_buffer, sizeBytes);
+    runtime_->memset(stream, d_buffer + offset, pattern, fillSize, patternSize, true);
+    auto result = std::vector<std::byte>(sizeBytes);
+    runtime_->memcpyDeviceToHost(stream, d_buffer, result.data(), sizeBytes);
+    runtime_->waitForStream(stream);
+    ASSERT_TRUE(runtime_->retrieveStreamErrors(stream).empty());
+
+    auto expected = sentinel;
+    auto patternBytes = reinterpret_cast<const std::byte*>(&pattern);
+    for (auto i = 0UL; i < fillSize; ++i) {
+      expected[offset + i] = patternBytes[i % patternSize];
+    }
+    ASSERT_EQ(expected, result) << "Pattern size: " << patternSize;
+  }
+}
+
+TEST_F(TestMemcpy, memcpyD2DSameDeviceCheckExceptions) {
+  auto dev = devices_[0];
+  auto stream = runtime_->createStream(dev);
+  auto d_buffer = runtime_->mallocDevice(dev, 2048);
+  EXPECT_THROW(runtime_->memcpyDeviceToDevice(stream, d_buffer, d_buffer + 512, 1024);, rt::Exception);
+  EXPECT_THROW(runtime_->memcpyDeviceToDevice(stream, d_buffer, d_buffer + 1024, 0);, rt::Exception);
+  runtime_->waitForStream(stream);
+}
+
+TEST_F(TestMemcpy, memcpyD2DSameDevice) {
+  std::mt19937 gen(std::random_device{}());
+  std::uniform_int_distribution<int> dis(0, 255);
+
+  auto dev = devices_[0];
+  auto stream = runtime_->createStream(dev);
+  auto sizeBytes = 5UL * 1024 * 1024 + 13;
+  auto src = std::vector<std::byte>(sizeBytes);
+  for (auto& b : src) {
+    b = std::byte(dis(gen));
+  }
+  auto d_src = runtime_->mallocDevice(dev, sizeBytes);
+  auto d_dst = runtime_->mallocDevice(dev, sizeBytes);
+
+  // neither the addresses nor the size are aligned, and the copy spans several device copy chunks
+  auto srcOffset = 7UL;
+  auto dstOffset = 3UL;
+  auto copySize = sizeBytes - srcOffset - 1;
+  auto sentinel = std::vector<std::byte>(sizeBytes, std::byte{0x5A});
+  runtime_->memcpyHostToDevice(stream, src.data(), d_src, sizeBytes);
+  runtime_->memcpyHostToDevice(stream, sentinel.data(), d_dst, sizeBytes);
+  runtime_->memcpyDeviceToDevice(stream, d_src + srcOffset, d_dst + dstOffset, copySize);
+  auto result = std::vector<std::byte>(sizeBytes);
+  runtime_->memcpyDeviceToHost(stream, d_dst, result.data(), sizeBytes);
+  runtime_->waitForStream(stream);
+  ASSERT_TRUE(runtime_->retrieveStreamErrors(stream).empty());
+
+  auto expected = sentinel;
+  std::copy_n(begin(src) + static_cast<long>(srcOffset), copySize, begin(expected) + static_cast<long>(dstOffset));
+  ASSERT_EQ(expected, result);
+}
+
 int main(int argc, char** argv) {
   RuntimeFixture::ParseArguments(argc, argv);
   testing::InitGoogleTest(&argc, argv);
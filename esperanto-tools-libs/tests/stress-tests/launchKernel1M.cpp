@@ -4,6 +4,7 @@
 //------------------------------------------------------------------------------
 
 #include "RuntimeFixture.h"
+#include <chrono>
 #include <gtest/gtest.h>
 
 TEST_F(RuntimeFixture, Launch_100k_Kernels_withBarrier_NOSYSEMU) {
@@ -43,6 +44,56 @@ TEST_F(RuntimeFixture, Launch_100k_Kernels_noBarrier_NOSYSEMU) {
   runtime_->waitForStream(defaultStreams_[0]);
 }
 
+struct LaunchKernelCoalescing : RuntimeFixture {
+  // launches many small kernels without barriers and reports the achieved throughput
+  void launchSmallKernels(uint32_t count) {
+    auto kernel = loadKernel("empty.elf");
+    auto args = std::array<std::byte, 32>{};
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = 0U; i < count; ++i) {
+      try {
+        runtime_->kernelLaunch(defaultStreams_[0], kernel, args.data(), args.size(), 0x1);
+      } catch (const rt::Exception&) {
+        runtime_->waitForStream(defaultStreams_[0]);
+        --i;
+      }
+    }
+    runtime_->waitForStream(defaultStreams_[0]);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    RT_LOG(INFO) << "Coalescing " << options_.completionCoalescing_.maxCompletions_ << " completions. Launched "
+                 << count << " kernels in " << elapsed.count() << "s: " << count / elapsed.count() << " kernels/s";
+  }
+};
+
+struct LaunchKernelNoCoalescing : LaunchKernelCoalescing {};
+
+struct LaunchKernelCoalescing8 : LaunchKernelCoalescing {
+  void SetUp() override {
+    options_.completionCoalescing_ = {8, std::chrono::microseconds{100}};
+    RuntimeFixture::SetUp();
+  }
+};
+
+struct LaunchKernelCoalescing16 : LaunchKernelCoalescing {
+  void SetUp() override {
+    options_.completionCoalescing_ = {16, std::chrono::microseconds{200}};
+    RuntimeFixture::SetUp();
+  }
+};
+
+// the three runs are meant to be compared against each other, the kernels/s are printed on the log
+TEST_F(LaunchKernelNoCoalescing, Launch_Small_Kernels) {
+  launchSmallKernels(sDlType == DeviceLayerImp::SYSEMU ? 1000 : 10000);
+}
+
+TEST_F(LaunchKernelCoalescing8, Launch_Small_Kernels) {
+  launchSmallKernels(sDlType == DeviceLayerImp::SYSEMU ? 1000 : 10000);
+}
+
+TEST_F(LaunchKernelCoalescing16, Launch_Small_Kernels) {
+  launchSmallKernels(sDlType == DeviceLayerImp::SYSEMU ? 1000 : 10000);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   RuntimeFixture::ParseArguments(argc, argv);
@@ -0,0 +1,69 @@
+//******************************************************************************
+// Copyright (c) 2025 Ainekko, Co.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------------
+
+#include "RuntimeFixture.h"
+#include "RuntimeImp.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <unordered_map>
+
+TEST_F(RuntimeFixture, Send_100k_Commands_withSentCallback_NOSYSEMU) {
+  if (sDlType == DeviceLayerImp::SYSEMU) {
+    RT_LOG(INFO) << "Not running this test on sysemu, its too slow";
+    return;
+  }
+  auto rimp = static_cast<rt::RuntimeImp*>(runtime_.get());
+  constexpr auto kNumCommands = 100000U;
+  constexpr auto kSize = 64U;
+  auto hostMem = std::vector<std::byte>(kSize);
+  auto devMem = runtime_->mallocDevice(devices_[0], kSize);
+  runtime_->waitForStream(defaultStreams_[0]);
+
+  std::mutex mutex;
+  std::unordered_map<rt::CommandSender const*, rt::EventId> lastEventPerSq;
+  std::atomic<uint32_t> callbacks = 0;
+  std::atomic<bool> ordered = true;
+  rimp->setSentCommandCallback(devices_[0], [&](rt::Command const* cmd) {
+    std::lock_guard lock(mutex);
+    // callbacks of each submission queue must be called in the same order the commands were sent. Event ids wrap
+    // around, so they are compared modulo 2^16
+    auto [it, inserted] = lastEventPerSq.try_emplace(&cmd->parent_, cmd->eventId_);
+    if (!inserted) {
+      auto delta = static_cast<uint16_t>(static_cast<uint16_t>(cmd->eventId_) - static_cast<uint16_t>(it->second));
+      if (delta == 0 || delta >= 0x8000) {
+        ordered = false;
+      }
+      it->second = cmd->eventId_;
+    }
+    ++callbacks;
+  });
+
+  RT_LOG(INFO) << "Sending " << kNumCommands << " commands with a sent command callback installed.";
+  for (auto i = 0U; i < kNumCommands; ++i) {
+    try {
+      runtime_->memcpyHostToDevice(defaultStreams_[0], hostMem.data(), devMem, kSize);
+    } catch (const rt::Exception&) {
+      runtime_->waitForStream(defaultStreams_[0]);
+      --i;
+    }
+  }
+  runtime_->waitForStream(defaultStreams_[0]);
+  // callbacks run asynchronously, give them some time to finish
+  for (auto i = 0; i < 500 && callbacks < kNumCommands; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  rimp->setSentCommandCallback(devices_[0], rt::CommandSender::CommandSentCallback());
+  EXPECT_GE(callbacks, kNumCommands);
+  EXPECT_TRUE(ordered);
+  runtime_->freeDevice(devices_[0], devMem);
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  RuntimeFixture::ParseArguments(argc, argv);
+  g3::log_levels::disable(DEBUG);
+  return RUN_ALL_TESTS();
+}
@@ -11,6 +11,67 @@
 #include <hostUtils/logging/Logging.h>
 #include <tools/IBenchmarker.h>
 
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <thread>
+#define ET_TRACE_DECODER_IMPL
+#include <esperanto/et-trace/decoder.h>
+
+namespace {
+// returns the latest per channel DMA counters logged by the MasterMinion in its stats trace buffer
+std::optional<dma_chan_stats_sample> getDmaChanStats(dev::IDeviceLayer& deviceLayer) {
+  std::vector<std::byte> traceBuf;
+  if (!deviceLayer.getTraceBufferServiceProcessor(0, dev::TraceBufferType::TraceBufferMMStats, traceBuf)) {
+    return std::nullopt;
+  }
+  std::optional<dma_chan_stats_sample> sample;
+  auto header = reinterpret_cast<const trace_buffer_std_header_t*>(traceBuf.data());
+  for (auto entry = Trace_Decode(header, nullptr); entry; entry = Trace_Decode(header, entry)) {
+    auto event = reinterpret_cast<const trace_custom_event_t*>(entry);
+    if (entry->type == TRACE_TYPE_CUSTOM_EVENT && event->custom_type == TRACE_CUSTOM_TYPE_MM_DMA_CHAN_STATS &&
+        event->payload_size == sizeof(dma_chan_stats_sample)) {
+      sample.emplace();
+      std::memcpy(&*sample, event->payload, sizeof(dma_chan_stats_sample));
+    }
+  }
+  return sample;
+}
+
+int countUpdatedChannels(const dma_chan_counters (&before)[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT],
+                         const dma_chan_counters (&after)[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT]) {
+  auto count = 0;
+  for (auto i = 0; i < TRACE_DMA_CHAN_STATS_CHANNEL_COUNT; ++i) {
+    if (after[i].transfers > before[i].transfers && after[i].bytes > before[i].bytes) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+uint64_t sumBytes(const dma_chan_counters (&before)[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT],
+                  const dma_chan_counters (&after)[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT]) {
+  uint64_t bytes = 0;
+  for (auto i = 0; i < TRACE_DMA_CHAN_STATS_CHANNEL_COUNT; ++i) {
+    bytes += after[i].bytes - before[i].bytes;
+  }
+  return bytes;
+}
+
+// returns true when every channel moved the same amount of data, which is what happens when each command is striped
+// evenly over all the channels of the direction
+bool allChannelsEven(const dma_chan_counters (&before)[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT],
+                     const dma_chan_counters (&after)[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT]) {
+  for (auto i = 1; i < TRACE_DMA_CHAN_STATS_CHANNEL_COUNT; ++i) {
+    if (after[i].bytes - before[i].bytes != after[0].bytes - before[0].bytes ||
+        after[i].transfers - before[i].transfers != after[0].transfers - before[0].transfers) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 TEST(BenchmarkerTool, sysemu) {
   std::shared_ptr<dev::IDeviceLayer> deviceLayer =
     dev::IDeviceLayer::createSysEmuDeviceLayer(getSysemuDefaultOptions());
@@ -24,6 +85,113 @@ TEST(BenchmarkerTool, sysemu) {
   runBenchmarker(rt.get(), options);
 }
 
+TEST(BenchmarkerTool, sysemuD2D) {
+  std::shared_ptr<dev::IDeviceLayer> deviceLayer =
+    dev::IDeviceLayer::createSysEmuDeviceLayer(getSysemuDefaultOptions());
+  rt::IBenchmarker::Options options;
+  options.bytesD2H = 0;
+  options.bytesH2D = 0;
+  options.bytesD2D = 64 << 20;
+  options.numWorkloadsPerThread = 8;
+  options.numThreads = 1;
+  options.useDmaBuffers = false;
+  auto rt = rt::IRuntime::create(deviceLayer);
+  runBenchmarker(rt.get(), options);
+}
+
+TEST(BenchmarkerTool, sysemuDmaStriping) {
+  // transfers below the MasterMinion stripe size (256KB) use a single DMA channel, bigger ones are striped across all
+  // the idle channels; log the bandwidth per transfer size to see how it scales
+  std::shared_ptr<dev::IDeviceLayer> deviceLayer =
+    dev::IDeviceLayer::createSysEmuDeviceLayer(getSysemuDefaultOptions());
+  auto rt = rt::IRuntime::create(deviceLayer);
+  auto benchmarker = rt::IBenchmarker::create(rt.get());
+  for (size_t bytes : {64UL << 10, 256UL << 10, 1UL << 20, 4UL << 20, 16UL << 20, 64UL << 20}) {
+    rt::IBenchmarker::Options options;
+    options.bytesD2H = bytes;
+    options.bytesH2D = bytes;
+    options.numWorkloadsPerThread = 4;
+    options.numThreads = 1;
+    options.useDmaBuffers = false;
+    auto res = benchmarker->run(options);
+    ET_LOG(BENCHMARKER, INFO) << "Transfer size: " << bytes << " bytes"
+                              << "\n\tBytes sent per second: " << res.bytesSentPerSecond
+                              << "\n\tBytes received per second: " << res.bytesReceivedPerSecond;
+    EXPECT_GT(res.bytesSentPerSecond, 0.0f);
+    EXPECT_GT(res.bytesReceivedPerSecond, 0.0f);
+  }
+
+  // a single 4MB transfer each way must be striped, so more than one channel per direction has to move data. The
+  // counters are sampled periodically by the MasterMinion, so poll until the sample catches up with the transfer
+  auto before = getDmaChanStats(*deviceLayer);
+  ASSERT_TRUE(before.has_value());
+  rt::IBenchmarker::Options options;
+  options.bytesD2H = 4UL << 20;
+  options.bytesH2D = 4UL << 20;
+  options.numWorkloadsPerThread = 1;
+  options.numThreads = 1;
+  options.useDmaBuffers = false;
+  benchmarker->run(options);
+  auto readChannels = 0;
+  auto writeChannels = 0;
+  for (auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+       std::chrono::steady_clock::now() < deadline && (readChannels <= 1 || writeChannels <= 1);
+       std::this_thread::sleep_for(std::chrono::milliseconds(100))) {
+    auto after = getDmaChanStats(*deviceLayer);
+    ASSERT_TRUE(after.has_value());
+    readChannels = countUpdatedChannels(before->read, after->read);
+    writeChannels = countUpdatedChannels(before->write, after->write);
+  }
+  EXPECT_GT(readChannels, 1);
+  EXPECT_GT(writeChannels, 1);
+}
+
+TEST(BenchmarkerTool, sysemuDmaStripingContended) {
+  // two streams moving large transfers at the same time: a striped command leaves a channel idle for the other
+  // stream instead of taking all of them, so both workers have to make progress
+  std::shared_ptr<dev::IDeviceLayer> deviceLayer =
+    dev::IDeviceLayer::createSysEmuDeviceLayer(getSysemuDefaultOptions());
+  auto rt = rt::IRuntime::create(deviceLayer);
+  auto benchmarker = rt::IBenchmarker::create(rt.get());
+  auto before = getDmaChanStats(*deviceLayer);
+  ASSERT_TRUE(before.has_value());
+  rt::IBenchmarker::Options options;
+  options.bytesD2H = 16UL << 20;
+  options.bytesH2D = 16UL << 20;
+  options.numWorkloadsPerThread = 2;
+  options.numThreads = 2;
+  options.useDmaBuffers = false;
+  auto res = benchmarker->run(options);
+  ASSERT_EQ(res.workerResults.size(), 2UL);
+  for (const auto& workerResult : res.workerResults) {
+    ET_LOG(BENCHMARKER, INFO) << "Bytes sent per second: " << workerResult.bytesSentPerSecond
+                              << "\n\tBytes received per second: " << workerResult.bytesReceivedPerSecond;
+    EXPECT_GT(workerResult.bytesSentPerSecond, 0.0f);
+    EXPECT_GT(workerResult.bytesReceivedPerSecond, 0.0f);
+  }
+
+  // the commands are still striped, so every channel of each direction moves data. Had each command been striped over
+  // all the channels of its direction, they would all have moved the same bytes in the same number of transfers; the
+  // channel left idle for the other stream breaks that balance. Poll until the MasterMinion sample holds all the bytes
+  // of the run, an older sample could show a balance that the full run doesn't have
+  auto totalBytes = options.bytesH2D * options.numWorkloadsPerThread * options.numThreads;
+  std::optional<dma_chan_stats_sample> after;
+  for (auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+       std::chrono::steady_clock::now() < deadline &&
+       (!after || sumBytes(before->read, after->read) < totalBytes ||
+        sumBytes(before->write, after->write) < totalBytes);
+       std::this_thread::sleep_for(std::chrono::milliseconds(100))) {
+    after = getDmaChanStats(*deviceLayer);
+    ASSERT_TRUE(after.has_value());
+  }
+  ASSERT_GE(sumBytes(before->read, after->read), totalBytes);
+  ASSERT_GE(sumBytes(before->write, after->write), totalBytes);
+  EXPECT_EQ(countUpdatedChannels(before->read, after->read), TRACE_DMA_CHAN_STATS_CHANNEL_COUNT);
+  EXPECT_EQ(countUpdatedChannels(before->write, after->write), TRACE_DMA_CHAN_STATS_CHANNEL_COUNT);
+  EXPECT_FALSE(allChannelsEven(before->read, after->read));
+  EXPECT_FALSE(allChannelsEven(before->write, after->write));
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   g3::log_levels::disable(DEBUG);
@@ -15,7 +15,8 @@ inline void runBenchmarker(rt::IRuntime* runtime, rt::IBenchmarker::Options opti
   options.useDmaBuffers = false;
   ET_LOG(BENCHMARKER, INFO) << "Results without using DMA Buffers (non-zero copy): "
                             << "\n\tBytes sent per second: " << res.bytesSentPerSecond
-                            << "\n\tBytes received per second: " << res.bytesReceivedPerSecond;
+                            << "\n\tBytes received per second: " << res.bytesReceivedPerSecond
+                            << "\n\tBytes copied within the device per second: " << res.bytesCopiedPerSecond;
 
 #if 0 // not enabled because useDmaBuffers is not supported yet
   options.useDmaBuffers = true;
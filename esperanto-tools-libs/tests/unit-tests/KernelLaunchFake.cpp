@@ -7,11 +7,16 @@
 #include "runtime/DeviceLayerFake.h"
 #include "runtime/IRuntime.h"
 #include "runtime/Types.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <gtest/gtest.h>
 #include <hostUtils/logging/Logger.h>
+#include <optional>
+#include <queue>
 #include <thread>
+#include <unordered_map>
 
 #pragma GCC diagnostic push
 #ifdef __clang__
@@ -27,8 +32,11 @@ using namespace testing;
 using namespace std::chrono;
 struct KernelLaunchF : Test {
   void SetUp() override {
-    deviceLayer_ = std::shared_ptr<dev::IDeviceLayer>(new dev::DeviceLayerFake);
-    runtime_ = rt::IRuntime::create(deviceLayer_, rt::Options{false, false});
+    setUp(std::shared_ptr<dev::IDeviceLayer>(new dev::DeviceLayerFake), rt::Options{false, false});
+  }
+  void setUp(std::shared_ptr<dev::IDeviceLayer> deviceLayer, rt::Options options) {
+    deviceLayer_ = std::move(deviceLayer);
+    runtime_ = rt::IRuntime::create(deviceLayer_, options);
     runtime_->setOnStreamErrorsCallback([](auto, const auto&) { FAIL(); });
     device_ = runtime_->getDevices()[0];
     stream_ = runtime_->createStream(device_);
@@ -137,6 +145,223 @@ TEST_F(KernelLaunchF, simpleOptions) {
   sendH2D_K_D2H_WithOptions(1, 64, 1024, opts);
 }
 
+// packs the pending responses of each submission queue in batched responses, the same way the firmware does once
+// completion coalescing is enabled on that submission queue
+struct DeviceLayerFakeBatched : dev::DeviceLayerFake {
+  static constexpr size_t kEntrySize = 64;
+  static constexpr size_t kMaxEntries = DEVICE_OPS_CQ_COALESCE_PAYLOAD_MAX / kEntrySize;
+
+  // a latency sensitive stream gets a submission queue of its own, while the other one keeps coalescing
+  int getSubmissionQueuesCount(int) const override {
+    return 2;
+  }
+
+  bool sendCommandMasterMinion(int device, int sq, std::byte* command, size_t size, dev::CmdFlagMM flags) override {
+    trackCommand(sq, command);
+    return dev::DeviceLayerFake::sendCommandMasterMinion(device, sq, command, size, flags);
+  }
+
+  size_t sendCommandsMasterMinion(int device, int sq, const dev::CmdDescMM* commands, size_t count) override {
+    for (size_t i = 0; i < count; ++i) {
+      trackCommand(sq, commands[i].command_);
+    }
+    return dev::DeviceLayerFake::sendCommandsMasterMinion(device, sq, commands, count);
+  }
+
+  bool receiveResponseMasterMinion(int device, std::vector<std::byte>& response) override {
+    auto single = receiveSingle(device);
+    if (!single) {
+      return false;
+    }
+    auto sq = single->first;
+    if (!isCoalescing(sq)) {
+      response.clear();
+      appendPadded(response, single->second);
+      trackResponse(single->second, false);
+      return true;
+    }
+    std::vector<std::byte> payload;
+    size_t count = 0;
+    // a batch only packs responses of the same submission queue, the first one of another queue is kept for later
+    for (; single && single->first == sq && count < kMaxEntries; single = receiveSingle(device)) {
+      appendPadded(payload, single->second);
+      trackResponse(single->second, true);
+      ++count;
+    }
+    if (single) {
+      held_[device] = std::move(*single);
+    }
+    response.assign(sizeof(device_ops_api::device_ops_batched_rsp_t), std::byte{0});
+    response.insert(response.end(), payload.begin(), payload.end());
+    auto batch = reinterpret_cast<device_ops_api::device_ops_batched_rsp_t*>(response.data());
+    batch->response_info.rsp_hdr.msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_BATCHED_RSP;
+    batch->response_info.rsp_hdr.size =
+      static_cast<device_ops_api::msg_size_t>(response.size() - sizeof(device_ops_api::cmn_header_t));
+    batch->count = static_cast<uint16_t>(count);
+    ++batches_;
+    return true;
+  }
+
+  bool isCoalescing(int sq) const {
+    std::lock_guard lock(mutex_);
+    auto it = coalescing_.find(sq);
+    return it != end(coalescing_) && it->second;
+  }
+
+  // whether the response of the command was packed in a batched response, empty if it wasn't received yet
+  std::optional<bool> wasBatched(EventId event) const {
+    std::lock_guard lock(mutex_);
+    auto it = batched_.find(static_cast<device_ops_api::tag_id_t>(event));
+    return it != end(batched_) ? std::optional{it->second} : std::nullopt;
+  }
+
+  std::atomic<size_t> batches_ = 0;
+  // device-api minor version reported by the fake firmware
+  uint32_t apiMinor_ = DEVICE_OPS_API_MINOR;
+
+private:
+  // the fake responses are only headers; pad them so the status fields read as success
+  void appendPadded(std::vector<std::byte>& out, const std::vector<std::byte>& single) const {
+    auto offset = out.size();
+    out.resize(offset + kEntrySize);
+    std::memcpy(out.data() + offset, single.data(), single.size());
+    auto rsp = reinterpret_cast<device_ops_api::rsp_header_t*>(out.data() + offset);
+    rsp->rsp_hdr.size = kEntrySize - sizeof(device_ops_api::rsp_header_t);
+    // the runtime checks the device-api version before enabling the coalescing
+    if (rsp->rsp_hdr.msg_id == device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_API_COMPATIBILITY_RSP) {
+      auto version = reinterpret_cast<device_ops_api::device_ops_api_compatibility_rsp_t*>(rsp);
+      version->major = DEVICE_OPS_API_MAJOR;
+      version->minor = apiMinor_;
+      version->patch = DEVICE_OPS_API_PATCH;
+    }
+  }
+
+  void trackResponse(const std::vector<std::byte>& response, bool batched) {
+    auto rsp = reinterpret_cast<const device_ops_api::rsp_header_t*>(response.data());
+    std::lock_guard lock(mutex_);
+    batched_[rsp->rsp_hdr.tag_id] = batched;
+  }
+
+  // called before the command is forwarded, so its response can always be traced back to its submission queue
+  void trackCommand(int sq, const std::byte* command) {
+    auto cmd = reinterpret_cast<const device_ops_api::device_ops_cq_coalesce_config_cmd_t*>(command);
+    std::lock_guard lock(mutex_);
+    sqsByTag_[cmd->command_info.cmd_hdr.tag_id].push(sq);
+    if (cmd->command_info.cmd_hdr.msg_id == device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_CQ_COALESCE_CONFIG_CMD) {
+      coalescing_[sq] = cmd->max_count > 1;
+    }
+  }
+
+  // returns the next pending response along with its submission queue
+  std::optional<std::pair<int, std::vector<std::byte>>> receiveSingle(int device) {
+    if (auto it = held_.find(device); it != end(held_)) {
+      auto single = std::move(it->second);
+      held_.erase(it);
+      return single;
+    }
+    std::vector<std::byte> response;
+    if (!dev::DeviceLayerFake::receiveResponseMasterMinion(device, response)) {
+      return {};
+    }
+    auto rsp = reinterpret_cast<const device_ops_api::rsp_header_t*>(response.data());
+    std::lock_guard lock(mutex_);
+    // the same tag can be in flight on several submission queues (i.e. the abort commands), the fake answers in order
+    auto& sqs = sqsByTag_.at(rsp->rsp_hdr.tag_id);
+    auto sq = sqs.front();
+    sqs.pop();
+    return std::make_pair(sq, std::move(response));
+  }
+
+  mutable std::mutex mutex_;
+  std::unordered_map<int, bool> coalescing_;
+  std::unordered_map<device_ops_api::tag_id_t, std::queue<int>> sqsByTag_;
+  std::unordered_map<device_ops_api::tag_id_t, bool> batched_;
+  // only accessed by the response receiver thread
+  std::unordered_map<int, std::pair<int, std::vector<std::byte>>> held_;
+};
+
+struct KernelLaunchBatchedF : KernelLaunchF {
+  void SetUp() override {
+    deviceLayerBatched_ = std::make_shared<DeviceLayerFakeBatched>();
+    auto options = rt::Options{false, false};
+    options.completionCoalescing_ = {8, 100us};
+    setUp(deviceLayerBatched_, options);
+  }
+  std::shared_ptr<DeviceLayerFakeBatched> deviceLayerBatched_;
+};
+
+TEST_F(KernelLaunchBatchedF, onlyKernels10K) {
+  send_K(1e4, 32);
+  EXPECT_GT(deviceLayerBatched_->batches_.load(), 0U);
+}
+
+TEST_F(KernelLaunchBatchedF, H2D_K_D2H_thousands_iters) {
+  sendH2D_K_D2H(5000, 128, 1024);
+  EXPECT_GT(deviceLayerBatched_->batches_.load(), 0U);
+}
+
+TEST_F(KernelLaunchBatchedF, latencySensitiveStreamOptsOut) {
+  constexpr auto kLaunches = 1000;
+  auto rt = static_cast<RuntimeImp*>(runtime_.get());
+  auto stream = runtime_->createStream(device_, StreamPriority::LatencySensitive);
+  dummy_.resize(32);
+  std::vector<EventId> latencySensitiveEvents;
+  std::vector<EventId> normalEvents;
+  for (auto i = 0; i < kLaunches; ++i) {
+    latencySensitiveEvents.emplace_back(runtime_->kernelLaunch(stream, kernel_, dummy_.data(), dummy_.size(), 0x3));
+    normalEvents.emplace_back(runtime_->kernelLaunch(stream_, kernel_, dummy_.data(), dummy_.size(), 0x3));
+  }
+  runtime_->waitForStream(stream);
+  runtime_->waitForStream(stream_);
+  // the opt out is sent on the submission queue before the first command of the stream
+  auto vq = rt->streamManager_.getStreamInfo(stream).vq_;
+  ASSERT_NE(vq, rt->streamManager_.getStreamInfo(stream_).vq_);
+  EXPECT_FALSE(deviceLayerBatched_->isCoalescing(vq));
+  // the normal stream keeps being coalesced meanwhile, the latency sensitive one gets every response on its own
+  EXPECT_TRUE(std::any_of(begin(normalEvents), end(normalEvents),
+                          [this](auto evt) { return deviceLayerBatched_->wasBatched(evt) == true; }));
+  for (auto evt : latencySensitiveEvents) {
+    EXPECT_EQ(deviceLayerBatched_->wasBatched(evt), false);
+  }
+  runtime_->destroyStream(stream);
+  auto start = steady_clock::now();
+  while (!deviceLayerBatched_->isCoalescing(vq) && steady_clock::now() - start < 5s) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_TRUE(deviceLayerBatched_->isCoalescing(vq));
+  send_K(100, 32);
+}
+
+TEST(KernelLaunchBatched, olderDeviceApiDisablesCoalescing) {
+  auto deviceLayer = std::make_shared<DeviceLayerFakeBatched>();
+  deviceLayer->apiMinor_ = DEVICE_OPS_CQ_COALESCE_MIN_API_MINOR - 1;
+  auto options = rt::Options{false, false};
+  options.completionCoalescing_ = {8, 100us};
+  auto runtime = rt::IRuntime::create(deviceLayer, options);
+  auto device = runtime->getDevices()[0];
+  auto stream = runtime->createStream(device, StreamPriority::LatencySensitive);
+  runtime->destroyStream(stream);
+  for (auto sq = 0; sq < deviceLayer->getSubmissionQueuesCount(0); ++sq) {
+    EXPECT_FALSE(deviceLayer->isCoalescing(sq));
+  }
+  EXPECT_EQ(deviceLayer->batches_.load(), 0U);
+}
+
+TEST(KernelLaunchBatched, olderDeviceApiRejectsDeviceMemoryCommands) {
+  auto deviceLayer = std::make_shared<DeviceLayerFakeBatched>();
+  deviceLayer->apiMinor_ = DEVICE_OPS_DEVICE_MEM_OPS_MIN_API_MINOR - 1;
+  auto runtime = rt::IRuntime::create(deviceLayer, rt::Options{false, true});
+  auto device = runtime->getDevices()[0];
+  auto stream = runtime->createStream(device);
+  auto src = runtime->mallocDevice(device, 4096);
+  auto dst = runtime->mallocDevice(device, 4096);
+  EXPECT_THROW(runtime->memset(stream, dst, 0xAB, 4096), rt::Exception);
+  EXPECT_THROW(runtime->memcpyDeviceToDevice(stream, src, dst, 4096), rt::Exception);
+  runtime->freeDevice(device, src);
+  runtime->freeDevice(device, dst);
+  runtime->destroyStream(stream);
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   g3::log_levels::disable(DEBUG);
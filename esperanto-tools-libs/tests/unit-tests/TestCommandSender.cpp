@@ -4,6 +4,7 @@
  *-------------------------------------------------------------------------*/
 
 #include "runtime/DeviceLayerFake.h"
+#include <atomic>
 #include <chrono>
 #include <esperanto/device-apis/device_apis_message_types.h>
 #include <hostUtils/logging/Logger.h>
@@ -112,6 +113,111 @@ TEST(CommandSender, checkSendBefore) {
   }
 }
 
+TEST(CommandSender, sentCallbacksOrdered) {
+  std::vector<std::byte> commandData(64);
+  auto header = reinterpret_cast<device_ops_api::cmn_header_t*>(commandData.data());
+  // dummy msg_id to make it work on deviceLayerFake
+  header->msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD;
+  // the blocking one, enough to fill the pending callbacks, one blocking the runner and one left behind
+  auto numCommands = static_cast<int>(CommandSender::kMaxPendingCallbacks) + 3;
+  auto deviceLayer = std::shared_ptr<dev::IDeviceLayer>(new dev::DeviceLayerFake);
+  profiling::DummyProfiler profiler;
+  std::vector<EventId> sent;
+  std::atomic<size_t> numSent = 0;
+  std::atomic<bool> blocked = false;
+  std::atomic<bool> release = false;
+  auto waitFor = [](const auto& condition) {
+    for (int i = 0; i < 100 && !condition(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  };
+  {
+    CommandSender cs(*deviceLayer, &profiler, 0, 0);
+    cs.setOnCommandSentCallback([&sent, &numSent, &blocked, &release, &cs](Command const* cmd) {
+      // the first callback blocks, so the following ones have to be queued; it also checks callbacks can use the sender
+      if (sent.empty()) {
+        cs.getFirstDmaCommand();
+        blocked = true;
+        while (!release) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+      sent.emplace_back(cmd->eventId_);
+      ++numSent;
+    });
+    auto sendCommand = [&](int i) {
+      header->tag_id = device_ops_api::tag_id_t(i + 1);
+      auto evt = EventId(i + 1);
+      cs.send(Command{commandData, cs, evt, evt, StreamId{0}, false, true});
+    };
+    sendCommand(0);
+    waitFor([&blocked] { return blocked.load(); });
+    EXPECT_TRUE(blocked);
+    // the first callback isn't pending anymore, so these fill the pending callbacks without blocking the runner
+    for (auto i = 1; i <= static_cast<int>(CommandSender::kMaxPendingCallbacks); ++i) {
+      sendCommand(i);
+    }
+    waitFor([&cs] { return cs.getCurrentSize() == 0; });
+    EXPECT_EQ(cs.getCurrentSize(), 0U);
+    // the runner takes this one but blocks pushing its callback
+    sendCommand(numCommands - 2);
+    waitFor([&cs] { return cs.getCurrentSize() == 0; });
+    EXPECT_EQ(cs.getCurrentSize(), 0U);
+    // so this one isn't sent till the first callback returns
+    sendCommand(numCommands - 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(cs.getCurrentSize(), 1U);
+    release = true;
+    waitFor([&numSent, numCommands] { return numSent == static_cast<size_t>(numCommands); });
+  }
+  ASSERT_EQ(sent.size(), static_cast<size_t>(numCommands));
+  for (auto i = 0; i < numCommands; ++i) {
+    ASSERT_EQ(sent[static_cast<size_t>(i)], EventId(i + 1));
+  }
+}
+
+TEST(CommandSender, sentCallbacksDrained) {
+  std::vector<std::byte> commandData(64);
+  auto header = reinterpret_cast<device_ops_api::cmn_header_t*>(commandData.data());
+  // dummy msg_id to make it work on deviceLayerFake
+  header->msg_id = device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_DMA_WRITELIST_CMD;
+  auto numCommands = 100;
+  auto deviceLayer = std::shared_ptr<dev::IDeviceLayer>(new dev::DeviceLayerFake);
+  profiling::DummyProfiler profiler;
+  std::vector<EventId> sent;
+  std::atomic<bool> release = false;
+  std::thread releaser;
+  {
+    CommandSender cs(*deviceLayer, &profiler, 0, 0);
+    cs.setOnCommandSentCallback([&sent, &release](Command const* cmd) {
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      sent.emplace_back(cmd->eventId_);
+    });
+    for (device_ops_api::tag_id_t i = 0; i < numCommands; ++i) {
+      header->tag_id = device_ops_api::tag_id_t(i + 1);
+      auto evt = EventId(i + 1);
+      cs.send(Command{commandData, cs, evt, evt, StreamId{0}, false, true});
+    }
+    // less commands than pending callbacks allowed, so they are all sent while the first callback is blocked
+    for (int i = 0; i < 100 && cs.getCurrentSize() > 0; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(cs.getCurrentSize(), 0U);
+    // the callbacks are released once the sender is being destroyed, it must still run all of them
+    releaser = std::thread([&release] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      release = true;
+    });
+  }
+  releaser.join();
+  ASSERT_EQ(sent.size(), static_cast<size_t>(numCommands));
+  for (auto i = 0; i < numCommands; ++i) {
+    ASSERT_EQ(sent[static_cast<size_t>(i)], EventId(i + 1));
+  }
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   testing::InitGoogleTest(&argc, argv);
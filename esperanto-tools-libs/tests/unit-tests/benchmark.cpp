@@ -5,11 +5,13 @@
 #include "Utils.h"
 #include "runtime/DeviceLayerFake.h"
 #include "runtime/IRuntime.h"
+#include <array>
 #include <chrono>
 #include <functional>
 #include <gtest/gtest.h>
 #include <hostUtils/logging/Logger.h>
 #include <thread>
+#include <vector>
 
 using namespace rt;
 using namespace testing;
@@ -24,9 +26,17 @@ using namespace std::chrono;
 #include "RuntimeImp.h"
 #undef private
 
+// one submission queue per submitting thread of the multi-threaded benchmark
+struct DeviceLayerFakeQueues : dev::DeviceLayerFake {
+  int getSubmissionQueuesCount(int) const override {
+    return kQueues;
+  }
+  static constexpr int kQueues = 8;
+};
+
 struct RuntimeBenchmark : Test {
   void SetUp() override {
-    deviceLayer_ = std::shared_ptr<dev::IDeviceLayer>(new dev::DeviceLayerFake);
+    deviceLayer_ = std::make_shared<DeviceLayerFakeQueues>();
     runtime_ = rt::IRuntime::create(deviceLayer_, Options{false, false});
     runtime_->setOnStreamErrorsCallback([](auto, const auto&) { FAIL(); });
     device_ = runtime_->getDevices()[0];
@@ -92,6 +102,48 @@ TEST_F(RuntimeBenchmark, H2D_K_D2H_NoSync_On_Iters) {
   runtime_->waitForStream(stream_);
 }
 
+// Each thread submits on its own stream pinned to its own submission queue, so the submissions don't share a command
+// sender
+void sendFromThreads(int numThreads, int iterations, DeviceId device, KernelId kernel, RuntimePtr& runtime) {
+  std::vector<StreamId> streams;
+  // host buffers must outlive the commands, which complete after the submitting threads have finished
+  std::vector<std::array<std::byte, 16>> buffers(static_cast<size_t>(numThreads));
+  auto rt = static_cast<RuntimeImp*>(runtime.get());
+  for (int i = 0; i < numThreads; ++i) {
+    streams.emplace_back(rt->streamManager_.createStream(device, i));
+  }
+  auto start = steady_clock::now();
+  std::vector<std::thread> threads;
+  for (auto i = 0U; i < streams.size(); ++i) {
+    threads.emplace_back([=, &runtime, &buffer = buffers[i]] {
+      std::array<std::byte, 64> args{};
+      for (int j = 0; j < iterations; ++j) {
+        runtime->memcpyHostToDevice(streams[i], buffer.data(), nullptr, buffer.size());
+        runtime->kernelLaunch(streams[i], kernel, args.data(), args.size(), 0x3);
+        runtime->memcpyDeviceToHost(streams[i], nullptr, buffer.data(), buffer.size());
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto submitted = steady_clock::now();
+  for (auto stream : streams) {
+    runtime->waitForStream(stream);
+    runtime->destroyStream(stream);
+  }
+  auto elapsed = duration_cast<microseconds>(submitted - start).count();
+  auto commands = 3 * iterations * numThreads;
+  RT_LOG(INFO) << "Threads: " << numThreads << " submitted " << commands << " commands in " << elapsed
+               << "us: " << (commands * 1e6 / static_cast<double>(elapsed)) << " commands/s";
+}
+
+TEST_F(RuntimeBenchmark, H2D_K_D2H_MultiThread_Submission) {
+  for (auto numThreads : {1, 2, 4, DeviceLayerFakeQueues::kQueues}) {
+    sendFromThreads(numThreads, 1e3, device_, kernel_, runtime_);
+  }
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   g3::log_levels::disable(DEBUG);
@@ -0,0 +1,45 @@
+//******************************************************************************
+// Copyright (c) 2025 Ainekko, Co.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------------
+#include "common/MpOrchestrator.h"
+#include "runtime/DeviceLayerFake.h"
+#include "runtime/Types.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+TEST(mp_host_buffers, register_memcpy_unregister_10clients) {
+  MpOrchestrator orch;
+  orch.createServer([] { return std::make_unique<dev::DeviceLayerFake>(); }, rt::Options{true, false});
+  for (int i = 0; i < 10; ++i) {
+    orch.createClient([](rt::IRuntime* rt) {
+      auto dev = rt::DeviceId{0};
+      auto size = 1UL << 20;
+      auto st = rt->createStream(dev);
+      auto h_src = rt->registerHostBuffer(dev, size);
+      auto h_dst = rt->registerHostBuffer(dev, size);
+      ASSERT_NE(h_src, nullptr);
+      ASSERT_NE(h_dst, nullptr);
+      std::fill(h_src, h_src + size, std::byte{0xAB});
+      auto d_buffer = rt->mallocDevice(dev, size);
+      for (auto j = 0; j < 10; ++j) {
+        rt->memcpyHostToDevice(st, h_src, d_buffer, size);
+        rt->memcpyDeviceToHost(st, d_buffer, h_dst, size);
+        rt::MemcpyList list;
+        list.addOp(h_src + 4096, d_buffer, 4096);
+        rt->memcpyHostToDevice(st, list);
+      }
+      ASSERT_TRUE(rt->waitForStream(st));
+      rt->freeDevice(dev, d_buffer);
+      rt->unregisterHostBuffer(dev, h_src);
+      ASSERT_THROW(rt->unregisterHostBuffer(dev, h_src), rt::Exception);
+      // h_dst is left registered on purpose, the server must release it when the client ends
+      rt->destroyStream(st);
+    });
+  }
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
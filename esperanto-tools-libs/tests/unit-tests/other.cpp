@@ -35,6 +35,62 @@ TEST_F(RuntimeFixture, checkStackConfigBadBaseAddressException) {
   EXPECT_THROW(opts.setStackConfig(baseAddrptr, kTraceBytesPerHart), rt::Exception);
 }
 
+TEST_F(RuntimeFixture, registeredHostBuffer) {
+  auto dev = devices_[0];
+  auto size = 1UL << 24;
+  auto stream = runtime_->createStream(dev);
+  auto h_buffer = runtime_->registerHostBuffer(dev, size);
+  auto d_buffer = runtime_->mallocDevice(dev, size);
+
+  runtime_->memcpyHostToDevice(stream, h_buffer, d_buffer, size);
+  runtime_->memcpyDeviceToHost(stream, d_buffer, h_buffer + 4096, 4096);
+  MemcpyList list;
+  list.addOp(h_buffer, d_buffer, 4096);
+  list.addOp(h_buffer + size - 4096, d_buffer + 4096, 4096);
+  runtime_->memcpyHostToDevice(stream, list);
+  EXPECT_TRUE(runtime_->waitForStream(stream, std::chrono::seconds(10)));
+
+  runtime_->freeDevice(dev, d_buffer);
+  runtime_->destroyStream(stream);
+  EXPECT_THROW(runtime_->unregisterHostBuffer(dev, h_buffer + 1), rt::Exception);
+  runtime_->unregisterHostBuffer(dev, h_buffer);
+  EXPECT_THROW(runtime_->unregisterHostBuffer(dev, h_buffer), rt::Exception);
+}
+
+TEST_F(RuntimeFixture, launchGraph) {
+  auto dev = devices_[0];
+  auto size = 1UL << 20;
+  auto stream = runtime_->createStream(dev);
+  auto h_buffer = runtime_->registerHostBuffer(dev, size);
+  auto d_buffer = runtime_->mallocDevice(dev, size);
+  std::vector<std::byte> notRegistered(4096);
+
+  runtime_->beginCapture(stream);
+  EXPECT_THROW(runtime_->beginCapture(stream), rt::Exception);
+  runtime_->memcpyHostToDevice(stream, h_buffer, d_buffer, size);
+  MemcpyList list;
+  list.addOp(d_buffer, h_buffer, 4096);
+  list.addOp(d_buffer + 4096, h_buffer + size - 4096, 4096);
+  runtime_->memcpyDeviceToHost(stream, list);
+  EXPECT_THROW(runtime_->memcpyHostToDevice(stream, notRegistered.data(), d_buffer, 4096), rt::Exception);
+  auto graph = runtime_->endCapture(stream);
+  EXPECT_THROW(runtime_->endCapture(stream), rt::Exception);
+
+  for (int i = 0; i < 10; ++i) {
+    runtime_->launchGraph(stream, graph);
+  }
+  EXPECT_TRUE(runtime_->waitForStream(stream, std::chrono::seconds(10)));
+  EXPECT_THROW(runtime_->setGraphKernelArgs(graph, 0, notRegistered.data(), 8), rt::Exception);
+  EXPECT_THROW(runtime_->setGraphKernelArgs(graph, 2, notRegistered.data(), 8), rt::Exception);
+
+  runtime_->destroyGraph(graph);
+  EXPECT_THROW(runtime_->launchGraph(stream, graph), rt::Exception);
+  EXPECT_THROW(runtime_->destroyGraph(graph), rt::Exception);
+  runtime_->freeDevice(dev, d_buffer);
+  runtime_->destroyStream(stream);
+  runtime_->unregisterHostBuffer(dev, h_buffer);
+}
+
 int main(int argc, char** argv) {
   RuntimeFixture::sDlType = RuntimeFixture::DeviceLayerImp::FAKE;
   testing::InitGoogleTest(&argc, argv);
@@ -126,6 +126,72 @@ TEST_F(EventManagerF, blockingThreads) {
   EXPECT_EQ(unblockedThreads.load(), nThreads);
 }
 
+TEST_F(EventManagerF, benchmark_many_callbacks) {
+  // resembles a big chunked memcpy: every chunk registers a callback watching its own event and the last event
+  constexpr auto numCallbacks = 20000U;
+  std::atomic<uint32_t> executedCallbacks = 0;
+  for (auto i = 0U; i < numCallbacks; ++i) {
+    events_.emplace_back(em_.getNextId());
+  }
+  auto lastEvent = em_.getNextId();
+  for (auto evt : events_) {
+    em_.addOnDispatchCallback({{evt, lastEvent}, [&executedCallbacks] { executedCallbacks.fetch_add(1); }});
+  }
+  EXPECT_EQ(em_.callbacks_.size(), numCallbacks);
+
+  auto start = std::chrono::steady_clock::now();
+  for (auto evt : events_) {
+    em_.dispatch(evt);
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  RT_LOG(INFO) << "Dispatched " << numCallbacks << " events with " << numCallbacks
+               << " outstanding callbacks. Elapsed: " << elapsed.count() << "us";
+  EXPECT_EQ(executedCallbacks.load(), 0U);
+
+  em_.dispatch(lastEvent);
+  EXPECT_TRUE(em_.callbacks_.empty());
+  EXPECT_TRUE(em_.watchers_.empty());
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (executedCallbacks.load() < numCallbacks && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(executedCallbacks.load(), numCallbacks);
+}
+
+TEST_F(EventManagerF, batchDispatch) {
+  // resembles a batched completion: several events dispatched at once, with threads and callbacks waiting on them
+  auto nEvents = 16U;
+  auto nThreads = 64U;
+  std::atomic<uint32_t> unblockedThreads = 0;
+  std::atomic<uint32_t> executedCallbacks = 0;
+  createBlockedThreadsAndEvents(nEvents, nThreads, false, [&unblockedThreads]() { unblockedThreads.fetch_add(1); });
+  em_.addOnDispatchCallback({events_, [&executedCallbacks] { executedCallbacks.fetch_add(1); }});
+
+  // dispatch the first half in a batch; the callback must wait for the rest
+  auto half = std::vector<EventId>(events_.begin(), events_.begin() + nEvents / 2);
+  em_.dispatch(half);
+  for (auto i = 0U; i < nEvents; ++i) {
+    EXPECT_EQ(em_.isDispatched(events_[i]), i < nEvents / 2);
+  }
+  EXPECT_EQ(executedCallbacks.load(), 0U);
+
+  em_.dispatch(std::vector<EventId>(events_.begin() + nEvents / 2, events_.end()));
+  for (auto& t : threads_) {
+    t.join();
+  }
+  EXPECT_EQ(unblockedThreads.load(), nThreads);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (executedCallbacks.load() < 1 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(executedCallbacks.load(), 1U);
+  EXPECT_TRUE(em_.callbacks_.empty());
+
+  // once dispatched the events are no longer onfly
+  em_.setThrowOnMissingEvent(true);
+  EXPECT_THROW(em_.dispatch(half), Exception);
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   testing::InitGoogleTest(&argc, argv);
@@ -171,6 +171,14 @@ std::ostream& operator<<(std::ostream& os, const FreeChunk& chunk) {
 }
 } // namespace rt
 
+std::vector<FreeChunk> getFreeChunks(const MemoryManager& mm) {
+  std::vector<FreeChunk> chunks;
+  for (auto [address, size] : mm.free_) {
+    chunks.emplace_back(FreeChunk{address, size});
+  }
+  return chunks;
+}
+
 TEST(MemoryManager, addChunk) {
   auto totalRam = 1UL << 34;
   for (auto baseAddr : {0UL, 1UL << 13, 1UL << 20}) {
@@ -180,40 +188,42 @@ TEST(MemoryManager, addChunk) {
       auto chunk3 = FreeChunk{5000, 30};
       auto mm = MemoryManager(baseAddr, totalRam, minAllocation);
       mm.free_.clear();
+      mm.freeBySize_.clear();
+      mm.freeBlocks_ = 0;
       mm.addChunk(chunk1);
-      EXPECT_EQ(mm.free_.front(), chunk1);
+      EXPECT_EQ(getFreeChunks(mm).front(), chunk1);
       mm.addChunk(chunk2);
-      EXPECT_EQ(mm.free_.front(), chunk1);
-      EXPECT_EQ(mm.free_.back(), chunk2);
+      EXPECT_EQ(getFreeChunks(mm).front(), chunk1);
+      EXPECT_EQ(getFreeChunks(mm).back(), chunk2);
       mm.addChunk(chunk3);
-      EXPECT_EQ(mm.free_.front(), chunk1);
-      EXPECT_EQ(mm.free_.back(), chunk3);
+      EXPECT_EQ(getFreeChunks(mm).front(), chunk1);
+      EXPECT_EQ(getFreeChunks(mm).back(), chunk3);
       EXPECT_EQ(mm.free_.size(), 3);
 
       // add a chunk which should merge with first chunk
       auto addSize = 100u;
       mm.addChunk({chunk1.startAddress_ + chunk1.size_, addSize});
       EXPECT_EQ(mm.free_.size(), 3);
-      EXPECT_EQ(mm.free_.front().size_, chunk1.size_ + addSize);
+      EXPECT_EQ(getFreeChunks(mm).front().size_, chunk1.size_ + addSize);
 
       // add a chunk which should be put next to chunk2
       mm.addChunk({chunk2.startAddress_ + chunk2.size_ + 1, addSize});
       EXPECT_EQ(mm.free_.size(), 4);
-      EXPECT_EQ(mm.free_[2].size_, addSize);
-      EXPECT_EQ(mm.free_[2].startAddress_, chunk2.startAddress_ + chunk2.size_ + 1);
+      EXPECT_EQ(getFreeChunks(mm)[2].size_, addSize);
+      EXPECT_EQ(getFreeChunks(mm)[2].startAddress_, chunk2.startAddress_ + chunk2.size_ + 1);
 
       auto addedAddress = 6000u;
       // add a chunk which should be put after last chunk
       mm.addChunk({chunk3.startAddress_ + addedAddress, addSize});
       EXPECT_EQ(mm.free_.size(), 5);
-      EXPECT_EQ(mm.free_.back().size_, addSize);
-      EXPECT_EQ(mm.free_.back().startAddress_, chunk3.startAddress_ + 6000);
+      EXPECT_EQ(getFreeChunks(mm).back().size_, addSize);
+      EXPECT_EQ(getFreeChunks(mm).back().startAddress_, chunk3.startAddress_ + 6000);
 
       // add a chunk which should reduce the number of chunks in 1 (filling the gap between last and the one before)
       auto newChunkAddr = chunk3.startAddress_ + chunk3.size_;
-      mm.addChunk({chunk3.startAddress_ + chunk3.size_, mm.free_.back().startAddress_ - newChunkAddr});
+      mm.addChunk({chunk3.startAddress_ + chunk3.size_, getFreeChunks(mm).back().startAddress_ - newChunkAddr});
       EXPECT_EQ(mm.free_.size(), 4);
-      auto b = mm.free_.back();
+      auto b = getFreeChunks(mm).back();
       EXPECT_EQ(b.startAddress_, chunk3.startAddress_);
       EXPECT_EQ(b.size_, addedAddress + addSize);
     }
@@ -411,6 +421,45 @@ TEST(MemoryManager, get_allocations) {
   ASSERT_EQ(mm.getAllocations().size(), 0);
 }
 
+TEST(MemoryManager, benchmark_many_allocations) {
+  auto totalRam = 1UL << 34;
+  auto mm = MemoryManager(1 << 12, totalRam);
+  std::default_random_engine e1(4242);
+  std::uniform_int_distribution<size_t> sizeDist(1, 1UL << 20);
+  std::uniform_int_distribution<uint32_t> alignmentDist(6, 16);
+  constexpr auto numAllocations = 20000U;
+  constexpr auto numRounds = 10U;
+
+  std::vector<std::byte*> ptrs;
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0U; i < numAllocations; ++i) {
+    ptrs.emplace_back(mm.malloc(sizeDist(e1), 1U << alignmentDist(e1)));
+  }
+  // keep the number of live allocations while fragmenting the free list, querying free bytes as the runtime does
+  // after each malloc / free
+  for (auto round = 0U; round < numRounds; ++round) {
+    std::shuffle(begin(ptrs), end(ptrs), e1);
+    for (auto i = 0U; i < numAllocations / 2; ++i) {
+      mm.free(ptrs[i]);
+      ASSERT_LE(mm.getFreeContiguousBytes(), mm.getFreeBytes());
+    }
+    for (auto i = 0U; i < numAllocations / 2; ++i) {
+      ptrs[i] = mm.malloc(sizeDist(e1), 1U << alignmentDist(e1));
+      ASSERT_LE(mm.getFreeContiguousBytes(), mm.getFreeBytes());
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  RT_LOG(INFO) << "Allocations: " << mm.getNumAllocations() << " free chunks: " << mm.getNumFreeChunks()
+               << " elapsed: " << elapsed.count() << "ms";
+  ASSERT_NO_THROW(mm.sanityCheck());
+
+  for (auto p : ptrs) {
+    mm.free(p);
+  }
+  ASSERT_EQ(mm.getNumFreeChunks(), 1);
+  ASSERT_EQ(mm.getFreeBytes(), totalRam);
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,185 @@
+/*-------------------------------------------------------------------------
+ * Copyright (c) 2025 Ainekko, Co.
+ * SPDX-License-Identifier: Apache-2.0
+ *-------------------------------------------------------------------------*/
+
+#include "CompactTrace.h"
+#pragma GCC diagnostic push
+#ifdef __clang__
+#pragma GCC diagnostic ignored "-Wkeyword-macro"
+#endif
+#define private public
+#pragma GCC diagnostic pop
+#include "ProfilerImp.h"
+#undef private
+
+#include <cereal/archives/json.hpp>
+#include <gtest/gtest.h>
+#include <hostUtils/logging/Logging.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace rt;
+using namespace rt::profiling;
+
+TEST(Profiler, compactRecordRoundTrip) {
+  ProfileEvent evt(Type::Complete, Class::MemcpyHostToDevice, StreamId{3}, EventId{42});
+  evt.setDuration(std::chrono::microseconds(17));
+  evt.setParentId(EventId{41});
+  evt.setBarrier(true);
+  evt.setSize(1UL << 40);
+  evt.setAlignment(64);
+  evt.setResponseType(ResponseType::DMAWrite);
+
+  CompactRecord record;
+  ASSERT_TRUE(encode(evt, record));
+  auto decoded = decode(record);
+  EXPECT_EQ(decoded.getType(), evt.getType());
+  EXPECT_EQ(decoded.getClass(), evt.getClass());
+  EXPECT_EQ(decoded.getTimeStamp(), evt.getTimeStamp());
+  EXPECT_EQ(decoded.getThreadId(), evt.getThreadId());
+  EXPECT_EQ(decoded.getExtras().size(), evt.getExtras().size());
+  EXPECT_EQ(decoded.getStream(), evt.getStream());
+  EXPECT_EQ(decoded.getEvent(), evt.getEvent());
+  EXPECT_EQ(decoded.getDuration(), evt.getDuration());
+  EXPECT_EQ(decoded.getParentId(), evt.getParentId());
+  EXPECT_EQ(decoded.getBarrier(), evt.getBarrier());
+  EXPECT_EQ(decoded.getSize(), evt.getSize());
+  EXPECT_EQ(decoded.getAlignment(), evt.getAlignment());
+  EXPECT_EQ(decoded.getResponseType(), evt.getResponseType());
+}
+
+TEST(Profiler, compactRecordFallback) {
+  ProfileEvent evt(Type::Instant, Class::IdentifyThread);
+  evt.setThreadName("some thread");
+  CompactRecord record;
+  EXPECT_FALSE(encode(evt, record));
+
+  ProfileEvent unknownKey(Type::Instant, Class::Pmc);
+  unknownKey.setExtras({{"unknown_key", uint64_t{1}}});
+  EXPECT_FALSE(encode(unknownKey, record));
+}
+
+TEST(Profiler, compactTraceManyThreads) {
+  constexpr auto kNumThreads = 8;
+  // more events than fit in a ring, so some of them go through the locked queue
+  constexpr auto kEventsPerThread = 5 * RecordRing::kSize;
+
+  std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+  ProfilerImp profiler;
+  profiler.start(ss, IProfiler::OutputType::Compact);
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&profiler, i] {
+      for (auto j = 0UL; j < kEventsPerThread; ++j) {
+        ProfileEvent evt(Type::Instant, Class::KernelLaunch, StreamId{i}, EventId(j));
+        profiler.record(evt);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  profiler.stop();
+
+  std::vector<ProfileEvent> events;
+  readCompactTrace(ss, [&events](const ProfileEvent& evt) { events.emplace_back(evt); });
+  // the recorded events plus start and end
+  ASSERT_EQ(events.size(), kNumThreads * kEventsPerThread + 2);
+  EXPECT_EQ(events.front().getClass(), Class::StartProfiling);
+  EXPECT_EQ(events.back().getClass(), Class::EndProfiling);
+
+  std::vector<size_t> eventsPerStream(kNumThreads);
+  for (const auto& evt : events) {
+    if (evt.getClass() == Class::KernelLaunch) {
+      ++eventsPerStream.at(static_cast<size_t>(evt.getStream().value()));
+    }
+  }
+  for (auto count : eventsPerStream) {
+    EXPECT_EQ(count, kEventsPerThread);
+  }
+}
+
+TEST(Profiler, ringsOfExitedThreadsAreFreed) {
+  constexpr auto kNumThreads = 16;
+  constexpr auto kEventsPerThread = 100UL;
+
+  std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+  ProfilerImp profiler;
+  profiler.start(ss, IProfiler::OutputType::Compact);
+  for (auto i = 0; i < kNumThreads; ++i) {
+    std::thread([&profiler, i] {
+      for (auto j = 0UL; j < kEventsPerThread; ++j) {
+        profiler.record(ProfileEvent(Type::Instant, Class::KernelLaunch, StreamId{i}, EventId(j)));
+      }
+    }).join();
+  }
+  // the IO thread frees the rings once it has drained them
+  auto numRings = [&profiler] {
+    std::lock_guard lock(profiler.ringsMutex_);
+    return profiler.rings_.size();
+  };
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (numRings() > 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(numRings(), 0UL);
+  profiler.stop();
+
+  auto numEvents = 0UL;
+  readCompactTrace(ss, [&numEvents](const ProfileEvent& evt) { numEvents += evt.getClass() == Class::KernelLaunch; });
+  EXPECT_EQ(numEvents, kNumThreads * kEventsPerThread);
+}
+
+TEST(Profiler, convertCompactTraceToJson) {
+  constexpr auto kNumEvents = 10UL;
+
+  std::stringstream compact(std::ios::in | std::ios::out | std::ios::binary);
+  ProfilerImp profiler;
+  profiler.start(compact, IProfiler::OutputType::Compact);
+  for (auto i = 0UL; i < kNumEvents; ++i) {
+    ProfileEvent evt(Type::Complete, Class::MemcpyHostToDevice, StreamId{1}, EventId(i));
+    evt.setDuration(std::chrono::microseconds(i));
+    evt.setSize(i * 1024);
+    profiler.record(evt);
+  }
+  // doesn't fit in a compact record, so it's stored as a serialized event
+  ProfileEvent fallback(Type::Instant, Class::IdentifyThread);
+  fallback.setThreadName("some thread");
+  profiler.record(fallback);
+  profiler.stop();
+
+  std::vector<ProfileEvent> expected;
+  readCompactTrace(compact, [&expected](const ProfileEvent& evt) { expected.emplace_back(evt); });
+  // the recorded events plus start and end
+  ASSERT_EQ(expected.size(), kNumEvents + 3);
+
+  compact.clear();
+  compact.seekg(0);
+  std::stringstream json;
+  convertCompactTrace(compact, json, IProfiler::OutputType::Json);
+
+  cereal::JSONInputArchive archive(json);
+  for (const auto& evt : expected) {
+    ProfileEvent converted;
+    archive(converted);
+    EXPECT_EQ(converted.getType(), evt.getType());
+    EXPECT_EQ(converted.getClass(), evt.getClass());
+    EXPECT_EQ(converted.getTimeStamp(), evt.getTimeStamp());
+    EXPECT_EQ(converted.getThreadId(), evt.getThreadId());
+    EXPECT_EQ(converted.getStream(), evt.getStream());
+    EXPECT_EQ(converted.getEvent(), evt.getEvent());
+    EXPECT_EQ(converted.getDuration(), evt.getDuration());
+    EXPECT_EQ(converted.getSize(), evt.getSize());
+    EXPECT_EQ(converted.getThreadName(), evt.getThreadName());
+  }
+}
+
+int main(int argc, char** argv) {
+  logging::LoggerDefault logger_;
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
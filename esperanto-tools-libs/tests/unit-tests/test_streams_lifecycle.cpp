@@ -13,14 +13,20 @@
 #endif
 #define private public
 #pragma GCC diagnostic pop
+#include "Constants.h"
 #include "MemoryManager.h"
 #include "RuntimeImp.h"
+#include "StreamManager.h"
 #include "common/Constants.h"
 #include "runtime/IRuntime.h"
 #undef private
 #include <chrono>
 #include <cstdio>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #if __has_include(<filesystem>)
 #include <filesystem>
@@ -72,6 +78,144 @@ TEST(StreamsLifeCycle, create_and_destroy_10k_streams) {
   EXPECT_TRUE(rt->streamManager_.streams_.empty());
 }
 
+TEST(StreamsLifeCycle, submission_queue_load_balancing) {
+  StreamManager streamManager;
+  auto device = DeviceId{0};
+  streamManager.addDevice(device, 2);
+  auto busy = streamManager.createStream(device);
+  auto other = streamManager.createStream(device);
+  auto shared = streamManager.createStream(device);
+  // idle queues are assigned round robin
+  auto busyVq = streamManager.getStreamInfo(busy).vq_;
+  EXPECT_NE(streamManager.getStreamInfo(other).vq_, busyVq);
+  EXPECT_EQ(streamManager.getStreamInfo(shared).vq_, busyVq);
+
+  // new streams go to the queue with less commands in flight
+  for (auto i = 0U; i < kStreamMigrationThreshold; ++i) {
+    streamManager.addEvent(busy, EventId(i));
+  }
+  EXPECT_NE(streamManager.getStreamInfo(streamManager.createStream(device)).vq_, busyVq);
+  EXPECT_NE(streamManager.getStreamInfo(streamManager.createStream(device)).vq_, busyVq);
+
+  // an idle stream sharing the busy queue moves away when it submits again, a stream with commands in flight never
+  // moves
+  auto sharedEvt = EventId(kStreamMigrationThreshold);
+  auto sharedVq = streamManager.getSubmissionInfo(shared, sharedEvt).vq_;
+  EXPECT_NE(sharedVq, busyVq);
+  EXPECT_EQ(streamManager.getSubmissionInfo(busy, EventId(kStreamMigrationThreshold + 1)).vq_, busyVq);
+
+  // the event is added together with the queue choice, so the next submission stays in the same queue even if it
+  // became the busiest one meanwhile
+  for (auto i = 0U; i < 3 * kStreamMigrationThreshold; ++i) {
+    streamManager.addEvent(other, EventId(kStreamMigrationThreshold + 2 + i));
+  }
+  EXPECT_EQ(streamManager.getSubmissionInfo(shared, EventId(4 * kStreamMigrationThreshold + 2)).vq_, sharedVq);
+
+  for (auto i = 0U; i < 4 * kStreamMigrationThreshold + 3; ++i) {
+    streamManager.removeEvent(EventId(i));
+  }
+}
+
+TEST(StreamsLifeCycle, latency_sensitive_streams) {
+  StreamManager streamManager;
+  auto device = DeviceId{0};
+  streamManager.addDevice(device, 2);
+  std::vector<StreamId> normal;
+  for (auto i = 0; i < 4; ++i) {
+    normal.emplace_back(streamManager.createStream(device));
+  }
+  auto latencySensitive = streamManager.createStream(device, StreamPriority::LatencySensitive);
+  auto lsVq = streamManager.getStreamInfo(latencySensitive).vq_;
+  // idle normal streams leave the latency sensitive stream queue as soon as they submit
+  auto evt = 0;
+  for (auto st : normal) {
+    EXPECT_NE(streamManager.getSubmissionInfo(st, EventId(evt++)).vq_, lsVq);
+  }
+  EXPECT_EQ(streamManager.getSubmissionInfo(latencySensitive, EventId(evt++)).vq_, lsVq);
+  // and new normal streams avoid it
+  EXPECT_NE(streamManager.getStreamInfo(streamManager.createStream(device)).vq_, lsVq);
+  for (auto i = 0; i < evt; ++i) {
+    streamManager.removeEvent(EventId(i));
+  }
+}
+
+TEST(StreamsLifeCycle, pinned_streams) {
+  StreamManager streamManager;
+  auto device = DeviceId{0};
+  streamManager.addDevice(device, 4);
+  for (auto sq = 0; sq < 4; ++sq) {
+    auto st = streamManager.createStream(device, sq);
+    EXPECT_EQ(streamManager.getStreamInfo(st).vq_, sq);
+    // pinned streams don't move even if their queue is not the least loaded
+    EXPECT_EQ(streamManager.getSubmissionInfo(st, EventId(sq)).vq_, sq);
+    streamManager.removeEvent(EventId(sq));
+    streamManager.destroyStream(st);
+  }
+}
+
+TEST(StreamsLifeCycle, queue_priority_callback_runs_unlocked) {
+  StreamManager streamManager;
+  auto device = DeviceId{0};
+  streamManager.addDevice(device, 2);
+  std::vector<std::pair<int, bool>> calls;
+  streamManager.setQueuePriorityCallback([&streamManager, &calls](DeviceId, int queue, bool latencySensitive) {
+    // the callback sends commands to the device, it can't block the other stream operations meanwhile
+    auto locked = streamManager.mutex_.try_lock();
+    EXPECT_TRUE(locked);
+    if (locked) {
+      streamManager.mutex_.unlock();
+    }
+    calls.emplace_back(queue, latencySensitive);
+  });
+  auto normal = streamManager.createStream(device);
+  EXPECT_TRUE(calls.empty());
+  auto latencySensitive = streamManager.createStream(device, StreamPriority::LatencySensitive);
+  auto lsVq = streamManager.getStreamInfo(latencySensitive).vq_;
+  streamManager.getSubmissionInfo(latencySensitive, EventId(0));
+  streamManager.removeEvent(EventId(0));
+  streamManager.destroyStream(latencySensitive);
+  streamManager.destroyStream(normal);
+  EXPECT_EQ(calls, (std::vector<std::pair<int, bool>>{{lsVq, true}, {lsVq, false}}));
+}
+
+// counts the abort commands sent to each submission queue
+struct DeviceLayerFakeQueues : dev::DeviceLayerFake {
+  bool sendCommandMasterMinion(int device, int sq, std::byte* command, size_t size, dev::CmdFlagMM flags) override {
+    if (reinterpret_cast<device_ops_api::cmn_header_t*>(command)->msg_id ==
+        device_ops_api::DEV_OPS_API_MID_DEVICE_OPS_ABORT_CMD) {
+      std::lock_guard lock(abortsMutex_);
+      ++aborts_[sq];
+    }
+    return dev::DeviceLayerFake::sendCommandMasterMinion(device, sq, command, size, flags);
+  }
+  int getSubmissionQueuesCount(int) const override {
+    return kQueues;
+  }
+  static constexpr int kQueues = 4;
+  std::mutex abortsMutex_;
+  std::unordered_map<int, int> aborts_;
+};
+
+TEST(StreamsLifeCycle, abort_device_reaches_every_submission_queue) {
+  auto deviceLayer = std::make_shared<DeviceLayerFakeQueues>();
+  auto runtime = rt::IRuntime::create(deviceLayer, Options{true, false});
+  runtime->setOnStreamErrorsCallback([](auto, const auto&) { FAIL(); });
+  auto checkOneAbortPerQueue = [&deviceLayer] {
+    std::lock_guard lock(deviceLayer->abortsMutex_);
+    ASSERT_EQ(deviceLayer->aborts_.size(), static_cast<size_t>(DeviceLayerFakeQueues::kQueues));
+    for (auto sq = 0; sq < DeviceLayerFakeQueues::kQueues; ++sq) {
+      EXPECT_EQ(deviceLayer->aborts_[sq], 1) << "Submission queue: " << sq;
+    }
+    deviceLayer->aborts_.clear();
+  };
+  // the initialization sequence aborts every queue
+  checkOneAbortPerQueue();
+  // and so does the recovery of a device which is not ready
+  auto rt = static_cast<RuntimeImp*>(runtime.get());
+  rt->abortDevice(runtime->getDevices()[0]);
+  checkOneAbortPerQueue();
+}
+
 int main(int argc, char** argv) {
   logging::LoggerDefault logger_;
   testing::InitGoogleTest(&argc, argv);
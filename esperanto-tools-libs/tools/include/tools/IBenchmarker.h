@@ -16,6 +16,9 @@ public:
     size_t bytesH2D = 4096;
     // total number of bytes transferred from device to host. If 0 then the workload won't do D2H transfers
     size_t bytesD2H = 4096;
+    // total number of bytes copied from device to device, within the same device. If 0 then the workload won't do D2D
+    // copies
+    size_t bytesD2D = 0;
     // number of commands for each transfer -use memcpylist- H2D
     size_t numH2D = 1;
     // number of commands for each transfer -use memcpylist- H2D
@@ -64,11 +67,13 @@ public:
     DeviceId device;               // device corresponding to these results
     float bytesSentPerSecond;
     float bytesReceivedPerSecond;
+    float bytesCopiedPerSecond;
     float workloadsPerSecond;
   };
   struct SummaryResults {
     float bytesSentPerSecond;
     float bytesReceivedPerSecond;
+    float bytesCopiedPerSecond;
     float workloadsPerSecond;
     std::vector<WorkerResult> workerResults;
   };
@@ -67,8 +67,9 @@ IBenchmarker::SummaryResults BenchmarkerImp::run(Options options, DeviceMask mas
     if (mask.isEnabled(d)) {
       BM_LOG(INFO) << "\t Device " << static_cast<int>(d) << " is enabled. Creating workers.";
       for (int i = 0; i < options.numThreads; ++i) {
-        workers.emplace_back(std::make_unique<Worker>(options.bytesH2D, options.bytesD2H, options.numH2D,
-                                                      options.numD2H, d, *runtime_, options.kernelPath));
+        workers.emplace_back(std::make_unique<Worker>(options.bytesH2D, options.bytesD2H, options.bytesD2D,
+                                                      options.numH2D, options.numD2H, d, *runtime_,
+                                                      options.kernelPath));
       }
     }
   }
@@ -94,6 +95,7 @@ IBenchmarker::SummaryResults BenchmarkerImp::run(Options options, DeviceMask mas
   auto totalWl = workers.size() * options.numWorkloadsPerThread;
   summary.bytesReceivedPerSecond = options.bytesD2H * totalWl / secs;
   summary.bytesSentPerSecond = options.bytesH2D * totalWl / secs;
+  summary.bytesCopiedPerSecond = options.bytesD2D * totalWl / secs;
   summary.workloadsPerSecond = totalWl / secs;
   return summary;
 }
@@ -11,15 +11,16 @@
 #include <hostUtils/logging/Logging.h>
 using namespace rt;
 
-Worker::Worker(size_t bytesH2D, size_t bytesD2H, size_t numH2D, size_t numD2H, DeviceId device, IRuntime& runtime,
-               const std::string& kernelPath)
+Worker::Worker(size_t bytesH2D, size_t bytesD2H, size_t bytesD2D, size_t numH2D, size_t numD2H, DeviceId device,
+               IRuntime& runtime, const std::string& kernelPath)
   : runtime_(runtime)
   , device_(device)
   , numH2D_(numH2D)
-  , numD2H_(numD2H) {
+  , numD2H_(numD2H)
+  , bytesD2D_(bytesD2D) {
   auto devices = runtime.getDevices();
   BM_LOG_IF(FATAL, std::find(begin(devices), end(devices), device_) == end(devices)) << "Invalid DeviceId";
-  BM_LOG_IF(FATAL, bytesH2D == 0 && bytesD2H == 0) << "H2D and D2H can't be both zero";
+  BM_LOG_IF(FATAL, bytesH2D == 0 && bytesD2H == 0 && bytesD2D == 0) << "H2D, D2H and D2D can't be all zero";
   if (numH2D_ > 1) {
     bytesH2D = bytesH2D + numH2D_ - 1;
   }
@@ -34,6 +35,10 @@ Worker::Worker(size_t bytesH2D, size_t bytesD2H, size_t numH2D, size_t numD2H, D
     hD2H_.resize(bytesD2H);
     dD2H_ = runtime_.mallocDevice(device_, bytesD2H);
   }
+  if (bytesD2D_ > 0) {
+    dD2DSrc_ = runtime_.mallocDevice(device_, bytesD2D_);
+    dD2DDst_ = runtime_.mallocDevice(device_, bytesD2D_);
+  }
   stream_ = runtime_.createStream(device_);
   result_.device = device_;
 
@@ -88,6 +93,12 @@ void Worker::doIteration(bool computeOpStats, uint64_t shireMask, std::vector<rt
       opstats.emplace_back(OpStats{evt});
     }
   }
+  if (dD2DSrc_) {
+    auto evt = runtime_.memcpyDeviceToDevice(stream_, dD2DSrc_, dD2DDst_, bytesD2D_);
+    if (computeOpStats) {
+      opstats.emplace_back(OpStats{evt});
+    }
+  }
   if (dD2H_) {
     if (numD2H_ > 1) {
       for (auto& op : listD2H) {
@@ -153,6 +164,7 @@ void Worker::start(int numIterations, bool computeOpStats, bool discardFirst) {
     auto secs = us.count() / 1e6f;
     result_.bytesReceivedPerSecond = hD2H_.size() * numIterations / secs;
     result_.bytesSentPerSecond = hH2D_.size() * numIterations / secs;
+    result_.bytesCopiedPerSecond = bytesD2D_ * numIterations / secs;
     result_.workloadsPerSecond = numIterations / secs;
     result_.opStats_ = std::move(opstats);
   });
@@ -170,5 +182,9 @@ Worker::~Worker() {
   if (dH2D_) {
     runtime_.freeDevice(device_, dH2D_);
   }
+  if (dD2DSrc_) {
+    runtime_.freeDevice(device_, dD2DSrc_);
+    runtime_.freeDevice(device_, dD2DDst_);
+  }
   runtime_.destroyStream(stream_);
 }
\ No newline at end of file
@@ -11,8 +11,8 @@
 
 class Worker {
 public:
-  explicit Worker(size_t bytesH2D, size_t bytesD2H, size_t numH2D, size_t numD2H, rt::DeviceId device,
-                  rt::IRuntime& runtime, const std::string& kernelPath);
+  explicit Worker(size_t bytesH2D, size_t bytesD2H, size_t bytesD2D, size_t numH2D, size_t numD2H,
+                  rt::DeviceId device, rt::IRuntime& runtime, const std::string& kernelPath);
   void start(int numIterations, bool computeOpStats, bool discardFirst = true);
   rt::IBenchmarker::WorkerResult wait();
   ~Worker();
@@ -36,6 +36,10 @@ private:
   std::vector<std::byte> hD2H_;
   std::byte* dD2H_ = nullptr;
 
+  size_t bytesD2D_ = 0;
+  std::byte* dD2DSrc_ = nullptr;
+  std::byte* dD2DDst_ = nullptr;
+
   struct Parameters {
     std::byte* src;
     size_t srcSize;
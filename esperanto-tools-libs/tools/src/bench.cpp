@@ -28,6 +28,7 @@ using namespace rt;
 
 DEFINE_uint64(h2d, 16 << 20, "transfer size from host to device");
 DEFINE_uint64(d2h, 16 << 20, "transfer size from device to host");
+DEFINE_uint64(d2d, 0, "copy size from device to device, within the same device");
 DEFINE_uint32(dmask, -1, "device mask to enable/disable devices to benchmark");
 DEFINE_uint64(th, 2, "number of threads per device");
 DEFINE_uint64(wl, 10, "number of workloads to execute per thread");
@@ -125,6 +126,7 @@ int main(int argc, char* argv[]) {
   // opts.useDmaBuffers = FLAGS_dma;
   opts.bytesD2H = FLAGS_d2h;
   opts.bytesH2D = FLAGS_h2d;
+  opts.bytesD2D = FLAGS_d2d;
   opts.numThreads = FLAGS_th;
   opts.numD2H = FLAGS_numd2h;
   opts.numH2D = FLAGS_numh2d;
@@ -144,6 +146,7 @@ int main(int argc, char* argv[]) {
     std::cout << "Summary: " << std::setprecision(2) << std::fixed << "\n * H2D: " << results.bytesSentPerSecond / 1e6
               << "MB/s"
               << "\n * D2H: " << results.bytesReceivedPerSecond / 1e6 << "MB/s"
+              << "\n * D2D: " << results.bytesCopiedPerSecond / 1e6 << "MB/s"
               << "\n * Workloads/s: " << results.workloadsPerSecond << std::endl;
   }
 }
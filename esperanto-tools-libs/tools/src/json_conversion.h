@@ -10,6 +10,7 @@ namespace rt {
 void to_json(nlohmann::json& j, const IBenchmarker::Options& options) {
   j = nlohmann::json{{"bytesD2H", options.bytesD2H},
                      {"bytesH2D", options.bytesH2D},
+                     {"bytesD2D", options.bytesD2D},
                      {"numThreads", options.numThreads},
                      {"workloadsPerThread", options.numWorkloadsPerThread},
                      {"runtimeTracePath", options.runtimeTracePath},
@@ -29,6 +30,7 @@ void to_json(nlohmann::json& j, const IBenchmarker::OpStats& result) {
 void to_json(nlohmann::json& j, const IBenchmarker::WorkerResult& result) {
   j = nlohmann::json{{"MBpsReceived", result.bytesReceivedPerSecond / static_cast<float>(1 << 20)},
                      {"MBpsSent", result.bytesSentPerSecond / static_cast<float>(1 << 20)},
+                     {"MBpsCopied", result.bytesCopiedPerSecond / static_cast<float>(1 << 20)},
                      {"WLps", result.workloadsPerSecond},
                      {"DeviceId", result.device},
                      {"OpStats", result.opStats_}};
@@ -36,6 +38,7 @@ void to_json(nlohmann::json& j, const IBenchmarker::WorkerResult& result) {
 void to_json(nlohmann::json& j, const IBenchmarker::SummaryResults& result) {
   j = nlohmann::json{{"TotalMBpsReceived", result.bytesReceivedPerSecond / static_cast<float>(1 << 20)},
                      {"TotalMBpsSent", result.bytesSentPerSecond / static_cast<float>(1 << 20)},
+                     {"TotalMBpsCopied", result.bytesCopiedPerSecond / static_cast<float>(1 << 20)},
                      {"TotalWLps", result.workloadsPerSecond},
                      {"WorkersResults", result.workerResults}};
 }
@@ -103,7 +103,10 @@ enum mm2sp_error_type_e {
     MM_RECOVERABLE_OPS_API_ABORT = 15,
     MM_RECOVERABLE_OPS_API_CM_RESET = 16,
     MM_RECOVERABLE_OPS_API_TRACE_RT_CONFIG = 17,
-    MM_RECOVERABLE_OPS_API_TRACE_RT_CONTROL = 18
+    MM_RECOVERABLE_OPS_API_TRACE_RT_CONTROL = 18,
+    MM_RECOVERABLE_OPS_API_MEMSET = 19,
+    MM_RECOVERABLE_OPS_API_MEMCPY_D2D = 20,
+    MM_RECOVERABLE_OPS_API_CQ_COALESCE_CONFIG = 21
 };
 
 /*********************************
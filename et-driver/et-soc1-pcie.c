@@ -134,6 +134,64 @@ static __poll_t esperanto_pcie_ops_poll(struct file *fp, poll_table *wait)
 	return mask;
 }
 
+/**
+ * ops_push_sq() - Validates a command descriptor and forwards the command on SQ
+ * @et_dev: Pointer to struct et_pci_dev
+ * @ops: Pointer to struct et_ops_dev
+ * @cmd_info: Command descriptor copied from user-space
+ *
+ * Return: Number of bytes written on success, negative error on failure
+ */
+static long ops_push_sq(struct et_pci_dev *et_dev, struct et_ops_dev *ops,
+			struct cmd_desc *cmd_info)
+{
+	long rv;
+
+	if (!cmd_info->cmd || !cmd_info->size ||
+	    cmd_info->flags & CMD_DESC_FLAG_MM_RESET ||
+	    cmd_info->flags & CMD_DESC_FLAG_ETSOC_RESET ||
+	    ((cmd_info->flags & CMD_DESC_FLAG_DMA ||
+	      cmd_info->flags & CMD_DESC_FLAG_P2PDMA) &&
+	     cmd_info->flags & CMD_DESC_FLAG_HIGH_PRIORITY))
+		return -EINVAL;
+
+	if (cmd_info->flags & CMD_DESC_FLAG_HIGH_PRIORITY) {
+		if (cmd_info->sq_index >=
+		    ops->vq_data.vq_common.hp_sq_count)
+			return -EINVAL;
+
+		rv = et_squeue_copy_from_user(
+			et_dev, false /* ops_dev */,
+			true /* high priority SQ */, cmd_info->sq_index,
+			(char __user __force *)cmd_info->cmd,
+			cmd_info->size);
+	} else {
+		if (cmd_info->sq_index >=
+		    ops->vq_data.vq_common.sq_count)
+			return -EINVAL;
+
+		if (cmd_info->flags & CMD_DESC_FLAG_P2PDMA)
+			rv = et_p2pdma_move_data(
+				et_dev, cmd_info->sq_index,
+				(char __user __force *)cmd_info->cmd,
+				cmd_info->size);
+		else if (cmd_info->flags & CMD_DESC_FLAG_DMA)
+			rv = et_dma_move_data(
+				et_dev, cmd_info->sq_index,
+				(char __user __force *)cmd_info->cmd,
+				cmd_info->size);
+		else
+			rv = et_squeue_copy_from_user(
+				et_dev, false /* ops_dev */,
+				false /* normal SQ */,
+				cmd_info->sq_index,
+				(char __user __force *)cmd_info->cmd,
+				cmd_info->size);
+	}
+
+	return rv;
+}
+
 /**
  * esperanto_pcie_ops_ioctl() - Ops device IOCTLs
  * @cmd: IOCTL commands
@@ -153,6 +211,7 @@ static __poll_t esperanto_pcie_ops_poll(struct file *fp, poll_table *wait)
  * - ETSOC1_IOCTL_GET_DEVICE_CONFIGURATION: Provides general device
  *   configuration received from the device in DIRs
  * - ETSOC1_IOCTL_PUSH_SQ: Forwards user command on SQ
+ * - ETSOC1_IOCTL_PUSH_SQ_LIST: Forwards several user commands, in order
  * - ETSOC1_IOCTL_POP_CQ: Pops out the response message from CQ to user
  * - ETSOC1_IOCTL_GET_SQ_AVAIL_BITMAP: Provides SQ availability bitmap
  * - ETSOC1_IOCTL_GET_CQ_AVAIL_BITMAP: Provides CQ availability bitmap
@@ -170,11 +229,13 @@ static long esperanto_pcie_ops_ioctl(struct file *fp, unsigned int cmd,
 	struct et_ops_dev *ops;
 	struct dram_info user_dram;
 	struct cmd_desc cmd_info;
+	struct cmd_desc_list cmd_list;
 	struct rsp_desc rsp_info;
 	struct sq_threshold sq_threshold_info;
 	struct et_mapped_region *region;
 	void __user *usr_arg = (void __user *)arg;
 	u16 sq_idx;
+	u16 i;
 	u16 max_size;
 	u32 ops_state;
 	u8 trace_type;
@@ -360,48 +421,35 @@ static long esperanto_pcie_ops_ioctl(struct file *fp, unsigned int cmd,
 			return -EFAULT;
 		}
 
-		if (!cmd_info.cmd || !cmd_info.size ||
-		    cmd_info.flags & CMD_DESC_FLAG_MM_RESET ||
-		    cmd_info.flags & CMD_DESC_FLAG_ETSOC_RESET ||
-		    ((cmd_info.flags & CMD_DESC_FLAG_DMA ||
-		      cmd_info.flags & CMD_DESC_FLAG_P2PDMA) &&
-		     cmd_info.flags & CMD_DESC_FLAG_HIGH_PRIORITY))
-			return -EINVAL;
+		rv = ops_push_sq(et_dev, ops, &cmd_info);
+		break;
 
-		if (cmd_info.flags & CMD_DESC_FLAG_HIGH_PRIORITY) {
-			if (cmd_info.sq_index >=
-			    ops->vq_data.vq_common.hp_sq_count)
-				return -EINVAL;
+	case ETSOC1_IOCTL_PUSH_SQ_LIST:
+		if (copy_from_user(&cmd_list, usr_arg, _IOC_SIZE(cmd))) {
+			dev_err(&et_dev->pdev->dev,
+				"ops_ioctl[%u]: failed to copy from user!\n",
+				_IOC_NR(cmd));
+			return -EFAULT;
+		}
 
-			rv = et_squeue_copy_from_user(
-				et_dev, false /* ops_dev */,
-				true /* high priority SQ */, cmd_info.sq_index,
-				(char __user __force *)cmd_info.cmd,
-				cmd_info.size);
-		} else {
-			if (cmd_info.sq_index >=
-			    ops->vq_data.vq_common.sq_count)
-				return -EINVAL;
-
-			if (cmd_info.flags & CMD_DESC_FLAG_P2PDMA)
-				rv = et_p2pdma_move_data(
-					et_dev, cmd_info.sq_index,
-					(char __user __force *)cmd_info.cmd,
-					cmd_info.size);
-			else if (cmd_info.flags & CMD_DESC_FLAG_DMA)
-				rv = et_dma_move_data(
-					et_dev, cmd_info.sq_index,
-					(char __user __force *)cmd_info.cmd,
-					cmd_info.size);
-			else
-				rv = et_squeue_copy_from_user(
-					et_dev, false /* ops_dev */,
-					false /* normal SQ */,
-					cmd_info.sq_index,
-					(char __user __force *)cmd_info.cmd,
-					cmd_info.size);
+		if (!cmd_list.cmds || !cmd_list.count)
+			return -EINVAL;
+
+		for (i = 0; i < cmd_list.count; i++) {
+			if (copy_from_user(&cmd_info,
+					   (struct cmd_desc __user __force *)
+						   cmd_list.cmds + i,
+					   sizeof(cmd_info))) {
+				rv = -EFAULT;
+				break;
+			}
+			rv = ops_push_sq(et_dev, ops, &cmd_info);
+			if (rv < 0)
+				break;
 		}
 
+		if (i)
+			rv = i;
 		break;
 
 	case ETSOC1_IOCTL_POP_CQ:
@@ -382,6 +382,21 @@ static void parse_cm_err_syndrome(struct device_mgmt_event_msg_t *event_msg,
 			"OPS API Trace RT Control Error (error code: %d)\n",
 			(s32)event_msg->event_syndrome[1]);
 		break;
+	case MM_RECOVERABLE_OPS_API_MEMSET:
+		sprintf(dbg_msg->syndrome,
+			"OPS API Memset Error (error code: %d)\n",
+			(s32)event_msg->event_syndrome[1]);
+		break;
+	case MM_RECOVERABLE_OPS_API_MEMCPY_D2D:
+		sprintf(dbg_msg->syndrome,
+			"OPS API Memcpy D2D Error (error code: %d)\n",
+			(s32)event_msg->event_syndrome[1]);
+		break;
+	case MM_RECOVERABLE_OPS_API_CQ_COALESCE_CONFIG:
+		sprintf(dbg_msg->syndrome,
+			"OPS API CQ Coalesce Config Error (error code: %d)\n",
+			(s32)event_msg->event_syndrome[1]);
+		break;
 	default:
 		sprintf(dbg_msg->syndrome, "Undefined Error (error code: %d)\n",
 			(s32)event_msg->event_syndrome[1]);
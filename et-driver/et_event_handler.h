@@ -161,7 +161,10 @@ enum sp2mm_error_type {
 	MM_RECOVERABLE_OPS_API_ABORT,
 	MM_RECOVERABLE_OPS_API_CM_RESET,
 	MM_RECOVERABLE_OPS_API_TRACE_RT_CONFIG,
-	MM_RECOVERABLE_OPS_API_TRACE_RT_CONTROL
+	MM_RECOVERABLE_OPS_API_TRACE_RT_CONTROL,
+	MM_RECOVERABLE_OPS_API_MEMSET,
+	MM_RECOVERABLE_OPS_API_MEMCPY_D2D,
+	MM_RECOVERABLE_OPS_API_CQ_COALESCE_CONFIG
 };
 
 /**
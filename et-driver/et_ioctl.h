@@ -111,6 +111,20 @@ struct cmd_desc {
 	__u8 flags;
 };
 
+/**
+ * struct cmd_desc_list - Descriptor for ETSOC1_IOCTL_PUSH_SQ_LIST
+ * @cmds: Pointer to an array of struct cmd_desc in user-space
+ * @count: Number of descriptors in the array
+ *
+ * The commands are pushed in order. The IOCTL returns the number of commands
+ * pushed, which is less than @count if a command couldn't be pushed (e.g. the
+ * SQ is full); the error is only returned if it was the first command.
+ */
+struct cmd_desc_list {
+	struct cmd_desc *cmds;
+	__u16 count;
+};
+
 /**
  * struct rsp_desc - Descriptor for ETSOC1_IOCTL_POP_CQ
  * @rsp: Pointer to response memory in user-space
@@ -235,4 +249,7 @@ struct trace_desc {
 #define ETSOC1_IOCTL_GET_P2PDMA_DEVICE_COMPAT_BITMAP                           \
 	_IOR(ESPERANTO_PCIE_IOCTL_MAGIC, 15, __u64)
 
+#define ETSOC1_IOCTL_PUSH_SQ_LIST                                              \
+	_IOW(ESPERANTO_PCIE_IOCTL_MAGIC, 16, struct cmd_desc_list)
+
 #endif
@@ -172,6 +172,7 @@ enum trace_custom_type_sp {
 enum trace_custom_type_mm {
     TRACE_CUSTOM_TYPE_MM_START = 1000,
     TRACE_CUSTOM_TYPE_MM_COMPUTE_RESOURCES,
+    TRACE_CUSTOM_TYPE_MM_DMA_CHAN_STATS,
     TRACE_CUSTOM_TYPE_MM_COUNT,
     TRACE_CUSTOM_TYPE_MM_END = 1999
 };
@@ -516,6 +517,30 @@ struct compute_resources_sample
   struct resource_value l2_l3_write_bw;
 } __attribute__((packed, aligned(8)));
 
+/*! \def TRACE_DMA_CHAN_STATS_CHANNEL_COUNT
+    \brief Number of PCIe DMA channels per direction reported in dma_chan_stats_sample
+*/
+#define TRACE_DMA_CHAN_STATS_CHANNEL_COUNT 4
+
+/*! \struct dma_chan_counters
+    \brief Utilization counters of a single DMA channel, accumulated from the last stats reset
+*/
+struct dma_chan_counters
+{
+  uint64_t bytes;
+  uint64_t busy_cycles;
+  uint64_t transfers;
+} __attribute__((packed, aligned(8)));
+
+/*! \struct dma_chan_stats_sample
+    \brief Per channel utilization counters of the PCIe DMA read and write engines
+*/
+struct dma_chan_stats_sample
+{
+  struct dma_chan_counters read[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT];
+  struct dma_chan_counters write[TRACE_DMA_CHAN_STATS_CHANNEL_COUNT];
+} __attribute__((packed, aligned(8)));
+
 /*! \struct trace_custom_event_t
     \brief A Trace packet strucure for logging a custom event in trace buffer.
 */
@@ -0,0 +1,88 @@
+/*-------------------------------------------------------------------------
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*-------------------------------------------------------------------------*/
+
+#ifndef BEMU_BB_CACHE_H
+#define BEMU_BB_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "decode_cache.h"
+
+namespace bemu {
+
+
+//
+// A straight-line sequence of decoded instructions, starting at a physical
+// address and ending at the first instruction that may redirect the control
+// flow or change the execution environment (branches, jumps, system
+// instructions, CSR accesses and tensor operations).
+//
+// Blocks are built incrementally while they execute. Each instruction is
+// still fetched before it is executed, and a pre-decoded instruction is only
+// reused if its bits match the fetched bits; otherwise the block is truncated
+// at that point and rebuilt.
+//
+struct Basic_block {
+    struct Insn {
+        insn_exec_funct_t exec_fn;
+        uint32_t          bits;
+        uint16_t          flags;
+        uint8_t           size;
+    };
+
+    static constexpr size_t max_insns = 32;
+
+    void reset(uint64_t addr) noexcept {
+        paddr = addr;
+        count = 0;
+        complete = false;
+        next[0] = next[1] = nullptr;
+    }
+
+    void truncate(size_t pos) noexcept {
+        count = pos;
+        complete = false;
+        next[0] = next[1] = nullptr;
+    }
+
+    uint64_t      paddr = ~0ull;
+    size_t        count = 0;
+    bool          complete = false;
+
+    // Chained successors: next[0] is the fall-through block, next[1] is the
+    // last taken target. They are hints only and must be validated by
+    // comparing their physical address before use.
+    Basic_block*  next[2] = {nullptr, nullptr};
+
+    std::array<Insn, max_insns>  insns;
+};
+
+
+//
+// Direct-mapped cache of basic blocks, indexed and tagged by the physical
+// address of their first instruction.
+//
+struct Block_cache {
+    static constexpr size_t num_blocks = 64;
+
+    Basic_block& block(uint64_t paddr) noexcept
+    { return m_blocks[(paddr >> 1) % num_blocks]; }
+
+    void invalidate() noexcept {
+        for (auto& bb : m_blocks) {
+            bb.reset(~0ull);
+        }
+    }
+
+private:
+    std::array<Basic_block, num_blocks>  m_blocks;
+};
+
+
+} // namespace bemu
+
+#endif // BEMU_BB_CACHE_H
@@ -21,8 +21,8 @@ std::vector<std::string> fw_elfs = {
 
 class SysEmuBenchmark : public benchmark::Fixture {
 public:
-    SysEmuBenchmark(std::vector<std::string> elfs_to_preload)
-        : elfs_to_preload(std::move(elfs_to_preload))
+    SysEmuBenchmark(std::vector<std::string> elfs_to_preload, bool bb_exec = false)
+        : elfs_to_preload(std::move(elfs_to_preload)), bb_exec(bb_exec)
     {}
 
     void SetUp(benchmark::State& state) override {
@@ -32,6 +32,7 @@ public:
         cmd_options.l2_scp_check = state.range(0);
         cmd_options.flb_check = state.range(0);
         cmd_options.tstore_check = state.range(1);
+        cmd_options.bb_exec = bb_exec;
         // Push the ELF files to cmd_options.elf_files
         for (const auto& elf_file : elfs_to_preload) {
             cmd_options.elf_files.push_back(elf_file);
@@ -50,6 +51,7 @@ public:
 
 protected:
     std::vector<std::string> elfs_to_preload;
+    bool bb_exec;
     std::unique_ptr<sys_emu> emu;
 };
 
@@ -201,6 +203,41 @@ BENCHMARK_REGISTER_F(Inst_TENSORS_Benchmark, BM_main_internal_inst_seq)
     ->ArgsProduct({{false, true}, {false, true}})
     ->ArgNames({"mem_check+l1_scp_check+l2_scp_check+flb_check", "tstore_check"});
 
+/* Basic block execution (-bb_exec), the "elfs" argument selects the ELF files to preload:
+   0 FW boot, 1 rv64i, 2 rv64m */
+std::vector<std::vector<std::string>> bb_exec_elfs = {
+    fw_elfs,
+    {std::string{DEVICE_KERNELS_DIR} + std::string{"rv64i.elf"}},
+    {std::string{DEVICE_KERNELS_DIR} + std::string{"rv64m.elf"}}
+};
+
+class BBExecBenchmark : public SysEmuBenchmark {
+public:
+    BBExecBenchmark() : SysEmuBenchmark({}, true) {}
+
+    void SetUp(benchmark::State& state) override {
+        elfs_to_preload = bb_exec_elfs.at(static_cast<size_t>(state.range(2)));
+        SysEmuBenchmark::SetUp(state);
+    }
+};
+
+BENCHMARK_DEFINE_F(BBExecBenchmark, BM_main_internal_bb_exec)(benchmark::State& state) {
+    int status = EXIT_SUCCESS;
+    for (auto _ : state) {
+        // Run the benchmark
+        benchmark::DoNotOptimize(status = emu->main_internal());
+        benchmark::ClobberMemory();
+        if (status != EXIT_SUCCESS) {
+            state.SkipWithError("Failed to run emulator!");
+            break; // Needed to skip the rest of the iteration.
+        }
+    }
+};
+
+BENCHMARK_REGISTER_F(BBExecBenchmark, BM_main_internal_bb_exec)
+    ->ArgsProduct({{false, true}, {false, true}, {0, 1, 2}})
+    ->ArgNames({"mem_check+l1_scp_check+l2_scp_check+flb_check", "tstore_check", "elfs"});
+
 /* RISCV Instructions: rv64a*/
 // class Inst_RV64A_Benchmark : public SysEmuBenchmark {
 // public:
@@ -0,0 +1,63 @@
+/*-------------------------------------------------------------------------
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*-------------------------------------------------------------------------*/
+
+#ifndef BEMU_DECODE_CACHE_H
+#define BEMU_DECODE_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bemu {
+
+
+// Forward declaration
+struct Hart;
+
+
+// Instruction execution function
+using insn_exec_funct_t = void (*)(Hart&);
+
+
+//
+// Cache of decoded instructions, indexed and tagged by physical PC.
+//
+// An entry is only reused if the fetched instruction bits match the bits
+// that were decoded, so a stale entry (e.g., after self-modifying code or a
+// change of the V2P mappings) can never be executed, it is just a miss.
+// Entries are also dropped explicitly when the instruction caches are
+// invalidated or the address translation registers are written.
+//
+struct Decode_cache {
+    struct Entry {
+        uint64_t          paddr = ~0ull;
+        insn_exec_funct_t exec_fn = nullptr;
+        uint32_t          bits = 0;
+        uint16_t          flags = 0;
+        uint8_t           size = 0;
+    };
+
+    static constexpr size_t num_entries = 256;
+
+    Entry& entry(uint64_t paddr) noexcept
+    { return m_entries[(paddr >> 1) % num_entries]; }
+
+    const Entry* lookup(uint64_t paddr, uint32_t bits) const noexcept
+    {
+        const Entry& e = m_entries[(paddr >> 1) % num_entries];
+        return ((e.paddr == paddr) && (e.bits == bits)) ? &e : nullptr;
+    }
+
+    void invalidate() noexcept
+    { m_entries.fill(Entry{}); }
+
+private:
+    std::array<Entry, num_entries>  m_entries;
+};
+
+
+} // namespace bemu
+
+#endif // BEMU_DECODE_CACHE_H
@@ -3,9 +3,11 @@
 
 emu_hdrs := \
 	atomics.h \
+	bb_cache.h \
 	cache.h \
 	csrs.h \
 	decode.h \
+	decode_cache.h \
 	devices/DW_apb_timers.h \
 	devices/cru.h \
 	devices/efuse.h \
@@ -26,6 +28,7 @@ emu_hdrs := \
 	devices/uart.h \
 	emu_defines.h \
 	emu_gio.h \
+	host_page_cache.h \
 	esrs.h \
 	gold.h \
 	insn.h \
@@ -50,6 +53,7 @@ emu_hdrs := \
 	sysreg_error.h \
 	system.h \
 	tensor.h \
+	tlb.h \
 	traps.h \
 	utility.h
 
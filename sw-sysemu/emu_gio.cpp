@@ -5,6 +5,7 @@
 
 #include <cstdarg>
 #include <cstdio>
+#include <mutex>
 
 #include "emu_defines.h"
 #include "emu_gio.h"
@@ -23,6 +24,10 @@ void lprintf(logLevel level, const Agent& agent, const char* fmt, ...)
     (void)vsnprintf(lbuf, 4096, fmt, ap);
     va_end(ap);
 
+    // Harts of different shires may log concurrently
+    static std::mutex lmutex;
+    std::lock_guard<std::mutex> lock(lmutex);
+
     auto& logger = agent.chip->log;
     logger << level << "[" << agent.name() << "] " << lbuf << endm;
 
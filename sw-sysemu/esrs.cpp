@@ -937,6 +937,7 @@ void System::esr_write(const Agent& agent, uint64_t addr, uint64_t value)
                 break;
             case ESR_SC_SCP_CACHE_CTL:
                 shire_cache_esrs[shire].bank[b].sc_scp_cache_ctl = value;
+                memory.invalidate_host_pointers();
                 LOG_AGENT(DEBUG, agent, "S%u:B%u:sc_scp_cache_ctl = 0x%" PRIx64,
                           SHIREID(shire), b, shire_cache_esrs[shire].bank[b].sc_scp_cache_ctl);
                 break;
@@ -47,6 +47,15 @@ extern "C" float32_t f32_subMulSub(float32_t, float32_t, float32_t);
 float32_t f1632_mulAdd2(float16_t, float16_t, float16_t, float16_t);
 float32_t f1632_mulAdd3(float16_t, float16_t, float16_t, float16_t, float32_t);
 
+// Rows of the tensor operations computed with host SIMD instructions.
+// f32_mulAddRow() computes c[j] = a*b[j] if mul is set, or c[j] = a*b[j]+c[j]
+// for all b[j] that are not +0, rounding to nearest-even. It returns false
+// without modifying c when some operand or result is not handled, and then
+// the row must be computed with softfloat. i8_dotRow() computes dot[j] as the
+// dot product of a[0..3] and b[4*j..4*j+3], unsigned if ua/ub are set.
+bool f32_mulAddRow(float32_t a, const float32_t* b, float32_t* c, unsigned n, bool mul);
+void i8_dotRow(const uint8_t* a, bool ua, const uint8_t* b, bool ub, int32_t* dot, unsigned n);
+
 
 // ---------------------------------------------------------------------------
 // RISC-V single-precision extension operations
@@ -169,6 +178,8 @@ namespace fpu {
 
 using ::f1632_mulAdd2;
 using ::f1632_mulAdd3;
+using ::f32_mulAddRow;
+using ::i8_dotRow;
 
 } // namespace fpu
 
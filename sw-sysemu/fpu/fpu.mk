@@ -26,6 +26,7 @@ fpu_cpp_srcs := \
 	fpu/fxp1516_to_f32.cpp \
 	fpu/fxp1714_rcpStep.cpp \
 	fpu/tensors.cpp \
+	fpu/tensors_simd.cpp \
 	fpu/ttrans.cpp
 
 fpu_c_srcs := \
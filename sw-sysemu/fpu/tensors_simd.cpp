@@ -0,0 +1,238 @@
+/*-------------------------------------------------------------------------
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*-------------------------------------------------------------------------*/
+
+// Rows of the tensor operations computed with host SIMD instructions. The
+// results must be bit-exact with the softfloat implementation, so the
+// floating-point rows only handle operands and results that IEEE-754 and the
+// softfloat configuration of the emulator (denormals-are-zero,
+// flush-to-zero, default NaN) treat the same way.
+
+#include <cfenv>
+#include <cmath>
+#include <cstring>
+
+#include "fpu.h"
+#include "softfloat/platform.h"
+#include "softfloat/internals.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FPU_HOST_X86 1
+#endif
+
+
+namespace {
+
+// Maximum number of elements in a row (TFMA_MAX_BCOLS)
+constexpr unsigned max_row = 16;
+
+
+// Zero or a normal number
+inline bool f32_isRegularUI(uint_fast32_t ui)
+{
+    uint_fast32_t exp = expF32UI(ui);
+    return (exp != 0xFF) && (exp || !fracF32UI(ui));
+}
+
+
+// Zero or a normal number that is not within a rounding step of the
+// underflow threshold, which softfloat flushes to zero
+inline bool f32_isSafeResultUI(uint_fast32_t ui)
+{
+    uint_fast32_t exp = expF32UI(ui);
+    return (exp != 0xFF) && ((exp > 1) || !(ui & 0x7FFFFFFF));
+}
+
+
+void f32_mulAddRow_generic(float a, const float* b, const float* c, float* z,
+                           unsigned n, bool mul)
+{
+    for (unsigned j = 0; j < n; ++j) {
+        z[j] = mul ? (a * b[j]) : std::fma(a, b[j], c[j]);
+    }
+}
+
+
+void i8_dotRow_generic(const int32_t* a, const uint8_t* b, bool ub,
+                       int32_t* dot, unsigned n)
+{
+    for (unsigned j = 0; j < n; ++j) {
+        int32_t sum = 0;
+        for (unsigned x = 0; x < 4; ++x) {
+            int32_t bx = ub ? int32_t(b[j*4+x]) : int32_t(int8_t(b[j*4+x]));
+            sum += a[x] * bx;
+        }
+        dot[j] = sum;
+    }
+}
+
+
+#ifdef FPU_HOST_X86
+
+__attribute__((target("avx512f")))
+void f32_mulAddRow_avx512(float a, const float* b, const float* c, float* z,
+                          unsigned n, bool mul)
+{
+    __mmask16 m = __mmask16((1u << n) - 1);
+    __m512 va = _mm512_set1_ps(a);
+    __m512 vb = _mm512_maskz_loadu_ps(m, b);
+    __m512 vz = mul ? _mm512_mul_ps(va, vb)
+                    : _mm512_fmadd_ps(va, vb, _mm512_maskz_loadu_ps(m, c));
+    _mm512_mask_storeu_ps(z, m, vz);
+}
+
+
+__attribute__((target("avx2,fma")))
+void f32_mulAddRow_avx2(float a, const float* b, const float* c, float* z,
+                        unsigned n, bool mul)
+{
+    __m256 va = _mm256_set1_ps(a);
+    unsigned j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256 vb = _mm256_loadu_ps(b + j);
+        __m256 vz = mul ? _mm256_mul_ps(va, vb)
+                        : _mm256_fmadd_ps(va, vb, _mm256_loadu_ps(c + j));
+        _mm256_storeu_ps(z + j, vz);
+    }
+    if (j < n) {
+        f32_mulAddRow_generic(a, b + j, c + j, z + j, n - j, mul);
+    }
+}
+
+
+// Each group of 8 columns is 32 bytes of B: the bytes of 4 columns are
+// widened to 16 bits and multiplied by the 4 bytes of A, and the pairs of
+// partial sums are then added and put back in column order.
+__attribute__((target("avx2")))
+void i8_dotRow_avx2(const int32_t* a, const uint8_t* b, bool ub,
+                    int32_t* dot, unsigned n)
+{
+    const __m256i va = _mm256_setr_epi16(
+        int16_t(a[0]), int16_t(a[1]), int16_t(a[2]), int16_t(a[3]),
+        int16_t(a[0]), int16_t(a[1]), int16_t(a[2]), int16_t(a[3]),
+        int16_t(a[0]), int16_t(a[1]), int16_t(a[2]), int16_t(a[3]),
+        int16_t(a[0]), int16_t(a[1]), int16_t(a[2]), int16_t(a[3]));
+    const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    unsigned j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j*4));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j*4 + 16));
+        __m256i wlo = ub ? _mm256_cvtepu8_epi16(lo) : _mm256_cvtepi8_epi16(lo);
+        __m256i whi = ub ? _mm256_cvtepu8_epi16(hi) : _mm256_cvtepi8_epi16(hi);
+        __m256i sum = _mm256_hadd_epi32(_mm256_madd_epi16(wlo, va),
+                                        _mm256_madd_epi16(whi, va));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dot + j),
+                            _mm256_permutevar8x32_epi32(sum, order));
+    }
+    if (j < n) {
+        i8_dotRow_generic(a, b + j*4, ub, dot + j, n - j);
+    }
+}
+
+
+// The SSE/AVX status flags are in MXCSR; fenv also handles the x87 ones
+inline void host_clearFlags()
+{ _mm_setcsr(_mm_getcsr() & ~0x3Fu); }
+
+inline bool host_testFlags(bool& inexact)
+{
+    unsigned csr = _mm_getcsr();
+    inexact = csr & 0x20;                       // PE
+    return !(csr & (0x01 | 0x08 | 0x10));       // IE, OE, UE
+}
+
+
+using f32_mulAddRow_fn = void (*)(float, const float*, const float*, float*, unsigned, bool);
+using i8_dotRow_fn = void (*)(const int32_t*, const uint8_t*, bool, int32_t*, unsigned);
+
+// Initialized before the CPU features are, so initialize them explicitly
+f32_mulAddRow_fn select_f32_mulAddRow()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return f32_mulAddRow_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return f32_mulAddRow_avx2;
+    return f32_mulAddRow_generic;
+}
+
+
+i8_dotRow_fn select_i8_dotRow()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? i8_dotRow_avx2 : i8_dotRow_generic;
+}
+
+
+const f32_mulAddRow_fn f32_mulAddRow_host = select_f32_mulAddRow();
+const i8_dotRow_fn i8_dotRow_host = select_i8_dotRow();
+
+#else
+
+constexpr auto f32_mulAddRow_host = f32_mulAddRow_generic;
+constexpr auto i8_dotRow_host = i8_dotRow_generic;
+
+inline void host_clearFlags()
+{ std::feclearexcept(FE_ALL_EXCEPT); }
+
+inline bool host_testFlags(bool& inexact)
+{
+    int flags = std::fetestexcept(FE_ALL_EXCEPT);
+    inexact = flags & FE_INEXACT;
+    return !(flags & (FE_INVALID | FE_OVERFLOW | FE_UNDERFLOW));
+}
+
+#endif // FPU_HOST_X86
+
+} // namespace
+
+
+bool f32_mulAddRow(float32_t a, const float32_t* b, float32_t* c, unsigned n, bool mul)
+{
+    if (!f32_isRegularUI(a.v))
+        return false;
+
+    float fa, fb[max_row], fc[max_row], fz[max_row];
+    for (unsigned j = 0; j < n; ++j) {
+        if (!f32_isRegularUI(b[j].v) || (!mul && !f32_isRegularUI(c[j].v)))
+            return false;
+    }
+    std::memcpy(&fa, &a, sizeof(fa));
+    std::memcpy(fb, b, n * sizeof(float));
+    if (!mul)
+        std::memcpy(fc, c, n * sizeof(float));
+
+    // The host floating-point environment is assumed to be the default one
+    // (round to nearest-even, no flush-to-zero)
+    bool inexact;
+    host_clearFlags();
+    f32_mulAddRow_host(fa, fb, fc, fz, n, mul);
+    if (!host_testFlags(inexact))
+        return false;
+
+    float32_t z[max_row];
+    std::memcpy(z, fz, n * sizeof(float));
+    for (unsigned j = 0; j < n; ++j) {
+        if (!f32_isSafeResultUI(z[j].v))
+            return false;
+        // Accumulation is skipped if the product is 0 because B is +0
+        if (!mul && !b[j].v)
+            z[j] = c[j];
+    }
+    std::memcpy(c, z, n * sizeof(float32_t));
+    if (inexact)
+        softfloat_raiseFlags(softfloat_flag_inexact);
+    return true;
+}
+
+
+void i8_dotRow(const uint8_t* a, bool ua, const uint8_t* b, bool ub, int32_t* dot, unsigned n)
+{
+    int32_t wa[4];
+    for (unsigned x = 0; x < 4; ++x) {
+        wa[x] = ua ? int32_t(a[x]) : int32_t(int8_t(a[x]));
+    }
+    i8_dotRow_host(wa, b, ub, dot, n);
+}
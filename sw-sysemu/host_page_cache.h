@@ -0,0 +1,48 @@
+/*-------------------------------------------------------------------------
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*-------------------------------------------------------------------------*/
+
+#ifndef BEMU_HOST_PAGE_CACHE_H
+#define BEMU_HOST_PAGE_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bemu {
+
+
+//
+// Direct-mapped cache of host pointers to the storage that backs physical
+// pages of DRAM and scratchpad, as returned by MainMemory::host_pointer().
+//
+// Pages without direct access are cached too (with a null pointer), and all
+// entries are tagged with the MainMemory host generation they were obtained
+// in, so that allocating storage or reconfiguring the scratchpad makes them
+// miss.
+//
+struct Host_page_cache {
+    struct Entry {
+        uint64_t        page = ~0ull;
+        uint64_t        generation = 0;
+        unsigned char*  ptr = nullptr;
+    };
+
+    static constexpr size_t   num_entries = 16;
+    static constexpr uint64_t page_size = 4096;
+
+    Entry& entry(uint64_t page) noexcept
+    { return m_entries[(page / page_size) % num_entries]; }
+
+    void invalidate() noexcept
+    { m_entries.fill(Entry{}); }
+
+private:
+    std::array<Entry, num_entries>  m_entries;
+};
+
+
+} // namespace bemu
+
+#endif // BEMU_HOST_PAGE_CACHE_H
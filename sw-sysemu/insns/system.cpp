@@ -106,6 +106,9 @@ void insn_sfence_vma(Hart& cpu)
 {
     DISASM_RS1_RS2("sfence.vma");
 
+    // The rest of the fence is emulated by mcode, but the translations
+    // cached by the emulator are dropped here
+    cpu.flush_tlb();
     throw trap_mcode_instruction(cpu.inst.bits);
 }
 
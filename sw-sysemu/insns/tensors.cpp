@@ -1216,6 +1216,43 @@ void tensor_store_execute(Hart& cpu)
 
 // ----- TensorFMA emulation ---------------------------------------------------
 
+// Rows are computed with host SIMD instructions unless a checker follows the
+// tensor operations, then the scalar paths are kept as the reference
+static bool tensor_host_simd_allowed(Hart& cpu)
+{
+#ifdef SYS_EMU
+    return !(SYS_EMU_PTR->get_mem_check() || SYS_EMU_PTR->get_l1_scp_check() ||
+             SYS_EMU_PTR->get_l2_scp_check() || SYS_EMU_PTR->get_flb_check() ||
+             SYS_EMU_PTR->get_tstore_check());
+#else
+    (void) cpu;
+    return true;
+#endif
+}
+
+
+// Dot products of the 4 bytes of A with every column of B
+static void tensor_ima8a32_dot_row(const uint8_t* a, bool ua, const uint8_t* b, bool ub,
+                                   int32_t* dot, int bcols, bool host_simd)
+{
+    if (host_simd) {
+        fpu::i8_dotRow(a, ua, b, ub, dot, bcols);
+        return;
+    }
+    int32_t a1 = ua ? a[0] : sext8_2(a[0]);
+    int32_t a2 = ua ? a[1] : sext8_2(a[1]);
+    int32_t a3 = ua ? a[2] : sext8_2(a[2]);
+    int32_t a4 = ua ? a[3] : sext8_2(a[3]);
+    for (int j = 0; j < bcols; ++j) {
+        int32_t b1 = ub ? b[j*4+0] : sext8_2(b[j*4+0]);
+        int32_t b2 = ub ? b[j*4+1] : sext8_2(b[j*4+1]);
+        int32_t b3 = ub ? b[j*4+2] : sext8_2(b[j*4+2]);
+        int32_t b4 = ub ? b[j*4+3] : sext8_2(b[j*4+3]);
+        dot[j] = (a1 * b1) + (a2 * b2) + (a3 * b3) + (a4 * b4);
+    }
+}
+
+
 static void tensor_fma32_execute(Hart& cpu)
 {
     bool usemsk     = (cpu.core->tmul.value >> 63) & 0x1;
@@ -1244,6 +1281,8 @@ static void tensor_fma32_execute(Hart& cpu)
              get_rounding_mode(cpu, cpu.core->tmul.frm), tmask.to_ulong());
 
     set_rounding_mode(cpu, cpu.core->tmul.frm);
+    bool host_simd = (softfloat_roundingMode == softfloat_round_near_even) &&
+                     tensor_host_simd_allowed(cpu);
     for (int k = 0; k < acols; ++k) {
         notify_tensor_fma_new_pass(cpu);
 
@@ -1279,7 +1318,30 @@ static void tensor_fma32_execute(Hart& cpu)
 
             // If first_pass is 1 and this is the first iteration we do FMUL
             // instead of FMA
-            if (first_pass && !k) {
+            bool mul = first_pass && !k;
+
+            // If the product will be 0, we can skip the operation
+            if (!mul && (fpu::UI32(a) == 0))
+                continue;
+
+            // Rows of regular numbers are computed with host SIMD
+            // instructions, which give the same results as softfloat when
+            // rounding to nearest-even
+            std::array<float32_t, TFMA_MAX_BCOLS> row;
+            if (host_simd && !mul) {
+                for (int j = 0; j < bcols; ++j)
+                    row[j] = FREGS[i*TFMA_REGS_PER_ROW+j/VLENW].f32[j%VLENW];
+            }
+            if (host_simd && fpu::f32_mulAddRow(a, tmpb.f32.data(), row.data(), bcols, mul)) {
+                for (int j = 0; j < bcols; ++j) {
+                    // If the product will be 0, we skip the operation
+                    if (!mul && (fpu::UI32(tmpb.f32[j]) == 0))
+                        continue;
+                    FREGS[i*TFMA_REGS_PER_ROW+j/VLENW].u32[j%VLENW] = fpu::UI32(row[j]);
+                    notify_tensor_fma_write(cpu, k, true, i*TFMA_REGS_PER_ROW+j/VLENW, j%VLENW, FREGS[i*TFMA_REGS_PER_ROW+j/VLENW].u32[j%VLENW]);
+                    written[j/VLENW] = true;
+                }
+            } else if (mul) {
                 for (int j = 0; j < bcols; ++j) {
                     float32_t b = tmpb.f32[j];
                     float32_t c = fpu::f32_mul(a, b);
@@ -1288,10 +1350,6 @@ static void tensor_fma32_execute(Hart& cpu)
                     written[j/VLENW] = true;
                 }
             } else {
-                // If the product will be 0, we can skip the operation
-                if (fpu::UI32(a) == 0)
-                    continue;
-
                 for (int j = 0; j < bcols; ++j) {
                     float32_t b = tmpb.f32[j];
                     // If the product will be 0, we can skip the operation
@@ -1447,6 +1505,7 @@ static void tensor_ima8a32_execute(Hart& cpu)
              usemsk, bcols, arows, acols, aoffset, tenc2rf, ub, ua, tenb,
              bstart, astart, first_pass, tmask.to_ulong());
 
+    bool host_simd = tensor_host_simd_allowed(cpu);
     for (int k = 0; k < acols; k += 4) {
         notify_tensor_fma_new_pass(cpu);
 
@@ -1490,21 +1549,12 @@ static void tensor_ima8a32_execute(Hart& cpu)
             // If first_pass is 1 and this is the first iteration we do
             // a1*b1+a2*b2+a3*b3+a4*b4 instead of c0+a1*b1+a2*b2+a3*b3+a4*b4
             else if (first_pass && !k) {
-#define ASRC(x) SCP[(astart+i) % L1_SCP_ENTRIES].u8[(aoffset+k+(x)) % L1D_LINE_SIZE]
-                int32_t a1 = ua ? ASRC(0) : sext8_2(ASRC(0));
-                int32_t a2 = ua ? ASRC(1) : sext8_2(ASRC(1));
-                int32_t a3 = ua ? ASRC(2) : sext8_2(ASRC(2));
-                int32_t a4 = ua ? ASRC(3) : sext8_2(ASRC(3));
-#undef ASRC
+                const uint8_t* asrc = &SCP[(astart+i) % L1_SCP_ENTRIES].u8[(aoffset+k) % L1D_LINE_SIZE];
                 LOG_SCP_32x1(":", (astart+i) % L1_SCP_ENTRIES, ((aoffset+k) % L1D_LINE_SIZE) / 4);
+                std::array<int32_t, TFMA_MAX_BCOLS> dot;
+                tensor_ima8a32_dot_row(asrc, ua, tmpb.u8.data(), ub, dot.data(), bcols, host_simd);
                 for (int j = 0; j < bcols; ++j) {
-#define BSRC(x) tmpb.u8[j*4+(x)]
-                    int32_t b1 = ub ? BSRC(0) : sext8_2(BSRC(0));
-                    int32_t b2 = ub ? BSRC(1) : sext8_2(BSRC(1));
-                    int32_t b3 = ub ? BSRC(2) : sext8_2(BSRC(2));
-                    int32_t b4 = ub ? BSRC(3) : sext8_2(BSRC(3));
-#undef BSRC
-                    int32_t c = (a1 * b1) + (a2 * b2) + (a3 * b3) + (a4 * b4);
+                    int32_t c = dot[j];
                     dst[i*TFMA_REGS_PER_ROW+j/VLENW].i32[j%VLENW] = c;
                     notify_tensor_fma_write(cpu, k/4, write_freg, i*TFMA_REGS_PER_ROW+j/VLENW, j%VLENW, uint32_t(c));
                     written[j/VLENW] = true;
@@ -1515,22 +1565,13 @@ static void tensor_ima8a32_execute(Hart& cpu)
             // be copied to FREGS and this is the last iteration. NB: The detection
             // is done at 32-bit granularity, not at element (8-bit) granularity.
             else if (write_freg || SCP[(astart+i) % L1_SCP_ENTRIES].u32[((aoffset+k)/4) % (L1D_LINE_SIZE/4)]) {
-#define ASRC(x) SCP[(astart+i) % L1_SCP_ENTRIES].u8[(aoffset+k+(x)) % L1D_LINE_SIZE]
-                int32_t a1 = ua ? ASRC(0) : sext8_2(ASRC(0));
-                int32_t a2 = ua ? ASRC(1) : sext8_2(ASRC(1));
-                int32_t a3 = ua ? ASRC(2) : sext8_2(ASRC(2));
-                int32_t a4 = ua ? ASRC(3) : sext8_2(ASRC(3));
-#undef ASRC
+                const uint8_t* asrc = &SCP[(astart+i) % L1_SCP_ENTRIES].u8[(aoffset+k) % L1D_LINE_SIZE];
                 LOG_SCP_32x1(":", (astart+i) % L1_SCP_ENTRIES, ((aoffset+k) % L1D_LINE_SIZE) / 4);
                 LOG_CREG(":", i*TFMA_REGS_PER_ROW);
                 if (bcols > 1) LOG_CREG(":", i*TFMA_REGS_PER_ROW + 1);
+                std::array<int32_t, TFMA_MAX_BCOLS> dot;
+                tensor_ima8a32_dot_row(asrc, ua, tmpb.u8.data(), ub, dot.data(), bcols, host_simd);
                 for (int j = 0; j < bcols; ++j) {
-#define BSRC(x) tmpb.u8[j*4+(x)]
-                    int32_t b1 = ub ? BSRC(0) : sext8_2(BSRC(0));
-                    int32_t b2 = ub ? BSRC(1) : sext8_2(BSRC(1));
-                    int32_t b3 = ub ? BSRC(2) : sext8_2(BSRC(2));
-                    int32_t b4 = ub ? BSRC(3) : sext8_2(BSRC(3));
-#undef BSRC
                     // If all products are 0 for both column @j and column @j+8 or @j-8, we can skip the
                     // operation, except if TenC must be copied to FREGS and this is the last iteration.
                     // NB: The detection is done at 32-bit granularity, not at element (8-bit) granularity
@@ -1542,7 +1583,7 @@ static void tensor_ima8a32_execute(Hart& cpu)
                             continue;
                     }
                     int32_t c0 = TENC[i*TFMA_REGS_PER_ROW+j/VLENW].i32[j%VLENW];
-                    int32_t c = c0 + (a1 * b1) + (a2 * b2) + (a3 * b3) + (a4 * b4);
+                    int32_t c = int32_t(uint32_t(c0) + uint32_t(dot[j]));
                     dst[i*TFMA_REGS_PER_ROW+j/VLENW].i32[j%VLENW] = c;
                     notify_tensor_fma_write(cpu, k/4, write_freg, i*TFMA_REGS_PER_ROW+j/VLENW, j%VLENW, uint32_t(c));
                     written[j/VLENW] = true;
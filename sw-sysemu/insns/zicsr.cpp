@@ -556,6 +556,17 @@ static uint64_t csrget(Hart& cpu, uint16_t csr)
 }
 
 
+// Flush the TLBs of the harts that share the address translation registers
+static void flush_core_tlbs(Hart& cpu)
+{
+    int first_hart = EMU_THREADS_PER_MINION * core_index(cpu);
+    int last_hart = std::min(first_hart + EMU_THREADS_PER_MINION, EMU_NUM_THREADS);
+    for (int i = first_hart; i < last_hart; ++i) {
+        cpu.chip->cpu[i].flush_tlb();
+    }
+}
+
+
 static uint64_t csrset(Hart& cpu, uint16_t csr, uint64_t val)
 {
     uint64_t msk = 0;
@@ -596,10 +607,14 @@ static uint64_t csrset(Hart& cpu, uint16_t csr, uint64_t val)
         if ((((val >> 13) & 0x3) == 0x3) || (((val >> 15) & 0x3) == 0x3)) {
             val |= 0x8000000000000000ULL;
         }
-        // Invalidate the fetch buffer when changing VM mode or permissions
+        // Invalidate the fetch buffer when changing VM mode or permissions,
+        // and the TLBs when changing mxr or sum
         if ((cpu.mstatus & 0xE0000) != (val & 0xE0000)) {
             cpu.fetch_pc = -1;
         }
+        if ((cpu.mstatus ^ val) & ((1ULL << MSTATUS_MXR) | (1ULL << MSTATUS_SUM))) {
+            cpu.flush_tlb();
+        }
         cpu.mstatus = val;
         // Return 'sstatus' view of 'mstatus'
         val &= 0x80000003000DE133ULL;
@@ -654,6 +669,8 @@ static uint64_t csrset(Hart& cpu, uint16_t csr, uint64_t val)
         case SATP_MODE_SV39:
         case SATP_MODE_SV48:
             cpu.core->satp = val;
+            cpu.core->flush_decoded_insns();
+            flush_core_tlbs(cpu);
             break;
         default: // reserved
             // do not write the register if attempting to set an unsupported mode
@@ -675,10 +692,14 @@ static uint64_t csrset(Hart& cpu, uint16_t csr, uint64_t val)
         // Attempting to set mpp to 2 will set it to 0 instead
         if (((val >> 11) & 0x3) == 0x2)
             val &= ~(0x3ULL << 11);
-        // Invalidate the fetch buffer when changing VM mode or permissions
+        // Invalidate the fetch buffer when changing VM mode or permissions,
+        // and the TLBs when changing mxr or sum
         if ((cpu.mstatus & 0xE0000) != (val & 0xE0000)) {
             cpu.fetch_pc = -1;
         }
+        if ((cpu.mstatus ^ val) & ((1ULL << MSTATUS_MXR) | (1ULL << MSTATUS_SUM))) {
+            cpu.flush_tlb();
+        }
         cpu.mstatus = val;
         break;
     case CSR_MISA:
@@ -926,6 +947,8 @@ static uint64_t csrset(Hart& cpu, uint16_t csr, uint64_t val)
             case MATP_MODE_MV39:
             case MATP_MODE_MV48:
                 cpu.core->matp = val;
+                cpu.core->flush_decoded_insns();
+                flush_core_tlbs(cpu);
                 break;
             default: // reserved
                 // do not write the register if attempting to set an unsupported mode
@@ -945,11 +968,13 @@ static uint64_t csrset(Hart& cpu, uint16_t csr, uint64_t val)
     case CSR_CACHE_INVALIDATE:
         val &= 0x3;
         if (val & 1) {
-            // invalidate the fetch buffers of all harts in the neighborhood
+            // invalidate the fetch buffers and decoded instructions of all
+            // harts in the neighborhood
             int first_hart = EMU_THREADS_PER_NEIGH * neigh_index(cpu);
             int last_hart = std::min(first_hart + EMU_THREADS_PER_NEIGH, EMU_NUM_THREADS);
             for (int i = first_hart; i < last_hart; ++i) {
                 cpu.chip->cpu[i].fetch_pc = -1;
+                cpu.chip->cpu[i].core->flush_decoded_insns();
             }
         }
         break;
@@ -1166,6 +1191,10 @@ static uint64_t csrset(Hart& cpu, uint16_t csr, uint64_t val)
 #endif
         break;
     case CSR_VALIDATION1:
+        // Prints to the console and injects interrupts in other shires
+        if (cpu.chip->is_parallel()) {
+            throw deferred_access();
+        }
         switch ((val >> 56) & 0xFF) {
         case ET_DIAG_PUTCHAR:
             val = val & 0xFF;
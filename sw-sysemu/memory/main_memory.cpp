@@ -20,6 +20,8 @@ namespace bemu {
 
 void MainMemory::reset()
 {
+    invalidate_host_pointers();
+
     size_t pos = 0;
     regions[pos++].reset(new MaxionRegion<pu_maxion_base, 256_MiB>());
     regions[pos++].reset(new PeripheralRegion<pu_io_base, 256_MiB>());
@@ -121,6 +121,22 @@ struct MainMemory {
         elem->init(agent, addr - elem->first(), n, reinterpret_cast<const_pointer>(source));
     }
 
+    // Returns a pointer to the host storage that backs the @n bytes at
+    // @addr, or nullptr if they must be accessed through read()/write().
+    // Pointers remain valid until host_generation() changes.
+    pointer host_pointer(const Agent& agent, addr_type addr, size_type n) {
+        auto lo = std::lower_bound(regions.cbegin(), regions.cend(), addr, above);
+        if ((lo == regions.cend()) || ((*lo)->first() > addr) || (addr+n-1 > (*lo)->last()))
+            return nullptr;
+        return (*lo)->host_pointer(agent, addr - (*lo)->first(), n);
+    }
+
+    // Bumped whenever a pointer returned by host_pointer(), or the lack of
+    // one, may have become stale (regions reset, storage allocated, or
+    // scratchpad reconfigured)
+    uint64_t host_generation() const { return m_host_generation; }
+    void invalidate_host_pointers() { ++m_host_generation; }
+
     addr_type first() const { return regions.front()->first(); }
     addr_type last() const { return regions.back()->last(); }
 
@@ -212,6 +228,8 @@ protected:
 #else
     std::array<std::unique_ptr<MemoryRegion>, 7> regions{};
 #endif
+
+    uint64_t m_host_generation = 0;
 };
 
 
@@ -20,6 +20,11 @@ struct memory_error {
 };
 
 
+// Signals that an access may have effects beyond the shire of the agent, and
+// must be retried when harts of different shires do not run concurrently
+struct deferred_access { };
+
+
 } // namespace bemu
 
 #endif // BEMU_MEMORY_ERROR_H
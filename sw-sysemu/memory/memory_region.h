@@ -43,6 +43,11 @@ struct MemoryRegion
     // Outputs region data to a stream
     virtual void dump_data(const Agent& agent, std::ostream& os, size_type pos, size_type n) const = 0;
 
+    // Returns a pointer to the host storage that backs the @n bytes starting
+    // at offset @pos, or nullptr if they cannot be accessed directly (e.g.,
+    // because accesses have side effects or the storage is not allocated)
+    virtual pointer host_pointer(const Agent&, size_type, size_type) { return nullptr; }
+
     static void default_value(pointer result, size_type n,
                               const reset_value_type& pattern, size_type offset)
     {
@@ -66,6 +66,14 @@ struct ScratchRegion : public MemoryRegion
         }
     }
 
+    pointer host_pointer(const Agent& agent, size_type pos, size_type n) override {
+        size_type bucket = slice(pos);
+        size_type offset = pos % 8_MiB;
+        if (!Writeable || out_of_range(agent.chip, bucket, offset, n) || storage[bucket].empty())
+            return nullptr;
+        return storage[bucket].data() + offset;
+    }
+
     // For exposition only
     storage_type  storage;
 
@@ -84,15 +92,20 @@ protected:
         return true;
     }
 
-    bool write_impl(const System* chip, size_type pos, size_type n, const_pointer source) {
+    bool write_impl(System* chip, size_type pos, size_type n, const_pointer source) {
         size_type bucket = slice(pos);
         size_type offset = pos % 8_MiB;
         if (out_of_range(chip, bucket, offset, n)) {
             return false;
         }
         if (storage[bucket].empty()) {
+            // Allocation invalidates the host pointers of all harts
+            if (chip->is_parallel()) {
+                throw deferred_access();
+            }
             storage[bucket].allocate();
             storage[bucket].fill_pattern(chip->memory_reset_value, MEM_RESET_PATTERN_SIZE);
+            chip->memory.invalidate_host_pointers();
         }
         std::copy_n(source, n, storage[bucket].begin() + offset);
         return true;
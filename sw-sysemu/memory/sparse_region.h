@@ -84,6 +84,14 @@ struct SparseRegion : public MemoryRegion
                         1 + ((pos + n - 1) % M) - offset, agent.chip->memory_reset_value[0]);
     }
 
+    pointer host_pointer(const Agent&, size_type pos, size_type n) override {
+        size_type bucket = pos / M;
+        size_type offset = pos % M;
+        if (!Writeable || (n > M - offset) || storage[bucket].empty())
+            return nullptr;
+        return storage[bucket].data() + offset;
+    }
+
     // For exposition only
     storage_type  storage;
 
@@ -103,8 +111,13 @@ protected:
                            size_type count, const_pointer source)
     {
         if (storage[bucket].empty()) {
+            // Allocation invalidates the host pointers of all harts
+            if (system->is_parallel()) {
+                throw deferred_access();
+            }
             storage[bucket].allocate();
             storage[bucket].fill_pattern(system->memory_reset_value, MEM_RESET_PATTERN_SIZE);
+            system->memory.invalidate_host_pointers();
         }
         std::copy_n(source, count, storage[bucket].begin() + pos);
         return count;
@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <type_traits>
 #include <climits>
+#include <cstring>
 
 #include "cache.h"
 #include "emu_gio.h"
@@ -248,6 +249,48 @@ static inline uint64_t pma_dram_limit(bool spio, uint8_t mprot)
 }
 
 
+// Host pointer to the storage that backs @n bytes of DRAM or scratchpad at
+// physical address @addr, or nullptr if they must be accessed through
+// MainMemory. Must be called after the PMA checks.
+static inline unsigned char* host_pointer(const Hart& cpu, uint64_t addr, size_t n)
+{
+    const uint64_t page = addr & ~(Host_page_cache::page_size - 1);
+    if ((addr - page) + n > Host_page_cache::page_size)
+        return nullptr;
+    if (!paddr_is_dram(addr) && !paddr_is_scratchpad(addr))
+        return nullptr;
+
+    MainMemory& memory = cpu.chip->memory;
+    Host_page_cache::Entry& entry = cpu.host_pages.entry(page);
+    if ((entry.page != page) || (entry.generation != memory.host_generation())) {
+        entry.page = page;
+        entry.generation = memory.host_generation();
+        entry.ptr = memory.host_pointer(cpu, page, Host_page_cache::page_size);
+    }
+    return entry.ptr ? (entry.ptr + (addr - page)) : nullptr;
+}
+
+
+static inline void memory_read(const Hart& cpu, uint64_t addr, size_t n, void* result)
+{
+    if (const unsigned char* ptr = host_pointer(cpu, addr, n)) {
+        std::memcpy(result, ptr, n);
+    } else {
+        cpu.chip->memory.read(cpu, addr, n, result);
+    }
+}
+
+
+static inline void memory_write(const Hart& cpu, uint64_t addr, size_t n, const void* source)
+{
+    if (unsigned char* ptr = host_pointer(cpu, addr, n)) {
+        std::memcpy(ptr, source, n);
+    } else {
+        cpu.chip->memory.write(cpu, addr, n, source);
+    }
+}
+
+
 static uint64_t pma_check_data_access(const Hart& cpu, uint64_t vaddr,
                                       uint64_t addr, size_t size,
                                       mem_access_type macc,
@@ -263,6 +306,12 @@ static uint64_t pma_check_data_access(const Hart& cpu, uint64_t vaddr,
     bool amo_l    = (macc == Mem_Access_AtomicL);
     bool ts_tl_co = (macc >= Mem_Access_TxLoad) && (macc <= Mem_Access_CacheOp);
 
+    // Global atomics synchronize harts of different shires, so they are not
+    // performed while shires run concurrently
+    if ((macc == Mem_Access_AtomicG) && cpu.chip->is_parallel()) {
+        throw deferred_access();
+    }
+
     if (paddr_is_dram(addr)) {
 
         if (paddr_is_dram_uncacheable(addr)) {
@@ -383,6 +432,11 @@ static uint64_t pma_check_data_access(const Hart& cpu, uint64_t vaddr,
         return addr;
     }
 
+    // System registers and devices may affect other shires
+    if (cpu.chip->is_parallel()) {
+        throw deferred_access();
+    }
+
     if (paddr_is_esr_space(addr)) {
         if (amo
             || ts_tl_co
@@ -584,6 +638,27 @@ static uint64_t pma_check_ptw_access(const Hart& cpu, uint64_t vaddr,
 }
 
 
+// TLB permission required by each access type
+static inline uint8_t tlb_perm(mem_access_type macc)
+{
+    switch (macc) {
+    case Mem_Access_Store:
+        return Tlb::perm_store;
+    case Mem_Access_StoreL:
+    case Mem_Access_StoreG:
+    case Mem_Access_TxStore:
+    case Mem_Access_AtomicL:
+    case Mem_Access_AtomicG:
+    case Mem_Access_CacheOp:
+        return Tlb::perm_write;
+    case Mem_Access_Fetch:
+        return Tlb::perm_fetch;
+    default:
+        return Tlb::perm_load;
+    }
+}
+
+
 static uint64_t vmemtranslate(const Hart& cpu, uint64_t vaddr, size_t size,
                               mem_access_type macc)
 {
@@ -616,6 +691,15 @@ static uint64_t vmemtranslate(const Hart& cpu, uint64_t vaddr, size_t size,
         return vaddr & PA_M;
     }
 
+    // Look up the TLB first. Only canonical addresses are ever inserted, so
+    // a hit does not need the sign-extension check below.
+    const uint64_t vpn  = vaddr >> PG_OFFSET_SIZE;
+    const uint8_t  perm = tlb_perm(macc);
+    Tlb& tlb = (macc == Mem_Access_Fetch) ? cpu.itlb : cpu.dtlb;
+    if (const Tlb::Entry* e = tlb.lookup(vpn, atp, uint8_t(curprv), perm)) {
+        return ((e->ppn << PG_OFFSET_SIZE) | (vaddr & PG_OFFSET_M)) & PA_M;
+    }
+
     int64_t sign = 0;
     int Num_Levels = 0;
     int PTE_top_Idx_Size = 0;
@@ -664,7 +748,7 @@ static uint64_t vmemtranslate(const Hart& cpu, uint64_t vaddr, size_t size,
         // Read PTE
         pte_addr = (ppn << PG_OFFSET_SIZE) + vpn*PTE_Size;
         try {
-            cpu.chip->memory.read(cpu, pma_check_ptw_access(cpu, vaddr, pte_addr, macc), 8, &pte);
+            memory_read(cpu, pma_check_ptw_access(cpu, vaddr, pte_addr, macc), 8, &pte);
             LOG_MEMREAD(64, pte_addr, pte);
         }
         catch (const memory_error&) {
@@ -777,6 +861,29 @@ static uint64_t vmemtranslate(const Hart& cpu, uint64_t vaddr, size_t size,
     // Final physical address only uses 40 bits
     paddr &= PA_M;
     LOG_HART(DEBUG, cpu, "\tPTW: Paddr = 0x%016" PRIx64, paddr);
+
+    // Remember the translation, and which access types the leaf PTE permits
+    // with the current privilege level and mstatus.mxr/sum
+    const bool prv_ok = (curprv == Privilege::M)
+        || ((curprv == Privilege::U) && pte_u)
+        || ((curprv == Privilege::S) && (!pte_u || sum));
+    uint8_t perms = 0;
+    if (prv_ok && (pte_r || (mxr && pte_x)))
+        perms |= Tlb::perm_load;
+    if (prv_ok && pte_w)
+        perms |= pte_d ? (Tlb::perm_write | Tlb::perm_store) : Tlb::perm_write;
+    if (pte_x && ((curprv == Privilege::M)
+                  || ((curprv == Privilege::U) && pte_u)
+                  || ((curprv == Privilege::S) && !pte_u)))
+        perms |= Tlb::perm_fetch;
+
+    Tlb::Entry& entry = tlb.entry(vpn);
+    entry.vpn = vpn;
+    entry.ppn = paddr >> PG_OFFSET_SIZE;
+    entry.atp = atp;
+    entry.prv = uint8_t(curprv);
+    entry.perms = perms;
+
     return paddr;
 }
 
@@ -790,7 +897,8 @@ static void ensure_fetch_cache(Hart& cpu, uint64_t vaddr)
     try {
         uint64_t paddr = vmemtranslate(cpu, cpu.fetch_pc, 32, Mem_Access_Fetch);
         uint64_t addr = pma_check_fetch_access(cpu, cpu.fetch_pc, paddr, 32);
-        cpu.chip->memory.read(cpu, addr, 32, &cpu.fetch_cache);
+        memory_read(cpu, addr, 32, &cpu.fetch_cache);
+        cpu.fetch_paddr = addr;
     }
     catch (const trap_instruction_access_fault&) {
         throw trap_instruction_access_fault(vaddr);
@@ -860,13 +968,13 @@ static T mmu_load_impl(const Hart& cpu, uint64_t eaddr, mem_access_type macc)
     if (len >= sizeof(T)) {
         // Access does not cross cache line boundary
         uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, sizeof(T), macc);
-        cpu.chip->memory.read(cpu, addr, sizeof(T), &value);
+        memory_read(cpu, addr, sizeof(T), &value);
     } else {
         // Access crosses cache line boundary
         uint64_t addr1 = pma_check_data_access(cpu, vaddr, paddr, len, macc);
         uint64_t addr2 = pma_check_data_access(cpu, vaddr + len, paddr + len, sizeof(T) - len, macc);
-        cpu.chip->memory.read(cpu, addr1, len, &value);
-        cpu.chip->memory.read(cpu, addr2, sizeof(T) - len, reinterpret_cast<char*>(&value) + len);
+        memory_read(cpu, addr1, len, &value);
+        memory_read(cpu, addr2, sizeof(T) - len, reinterpret_cast<char*>(&value) + len);
     }
     LOG_MEMREAD(CHAR_BIT*sizeof(T), paddr, value);
     notify_mem_read(cpu, true, sizeof(T), vaddr, paddr);
@@ -885,7 +993,7 @@ static T mmu_aligned_load_impl(const Hart& cpu, uint64_t eaddr, mem_access_type
     uint64_t paddr = vmemtranslate(cpu, vaddr, sizeof(T), macc);
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, sizeof(T), macc);
     T value {};
-    cpu.chip->memory.read(cpu, addr, sizeof(T), &value);
+    memory_read(cpu, addr, sizeof(T), &value);
     LOG_MEMREAD(CHAR_BIT*sizeof(T), paddr, value);
     notify_mem_read(cpu, true, sizeof(T), vaddr, paddr);
     return value;
@@ -899,7 +1007,7 @@ static uint64_t mmu_tensor_load_impl(const Hart& cpu, uint64_t eaddr, uint32_t*
     assert(addr_is_size_aligned(vaddr, Nbytes));
     uint64_t paddr = vmemtranslate(cpu, vaddr, Nbytes, macc);
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, Nbytes, macc);
-    cpu.chip->memory.read(cpu, addr, Nbytes, data);
+    memory_read(cpu, addr, Nbytes, data);
     return paddr;
 }
 
@@ -980,7 +1088,7 @@ void mmu_loadVLEN(const Hart& cpu, uint64_t eaddr, freg_t& data, mreg_t mask, me
         uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, VLENB, macc, mask);
         for (size_t e = 0; e < MLEN; ++e) {
             if (mask[e]) {
-                cpu.chip->memory.read(cpu, addr + 4*e, 4, &data.u32[e]);
+                memory_read(cpu, addr + 4*e, 4, &data.u32[e]);
                 LOG_MEMREAD(32, paddr + 4*e, data.u32[e]);
             }
             notify_mem_read(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e);
@@ -990,7 +1098,7 @@ void mmu_loadVLEN(const Hart& cpu, uint64_t eaddr, freg_t& data, mreg_t mask, me
         for (size_t e = 0; e < MLEN; ++e) {
             if (mask[e]) {
                 uint64_t addr = pma_check_data_access(cpu, vaddr + 4*e, paddr + 4*e, 4, macc);
-                cpu.chip->memory.read(cpu, addr, 4, &data.u32[e]);
+                memory_read(cpu, addr, 4, &data.u32[e]);
                 LOG_MEMREAD(32, paddr + 4*e, data.u32[e]);
             }
             notify_mem_read(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e);
@@ -1002,8 +1110,8 @@ void mmu_loadVLEN(const Hart& cpu, uint64_t eaddr, freg_t& data, mreg_t mask, me
             if (mask[e]) {
                 uint64_t addr1 = pma_check_data_access(cpu, vaddr + 4*e, paddr + 4*e, len, macc);
                 uint64_t addr2 = pma_check_data_access(cpu, vaddr + 4*e + len, paddr + 4*e + len, 4 - len, macc);
-                cpu.chip->memory.read(cpu, addr1, len, &data.u8[4*e]);
-                cpu.chip->memory.read(cpu, addr2, 4 - len, &data.u8[4*e + len]);
+                memory_read(cpu, addr1, len, &data.u8[4*e]);
+                memory_read(cpu, addr2, 4 - len, &data.u8[4*e + len]);
                 LOG_MEMREAD(32, paddr + 4*e, data.u32[e]);
             }
             notify_mem_read(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e);
@@ -1026,7 +1134,7 @@ void mmu_aligned_loadVLEN(const Hart& cpu, uint64_t eaddr, freg_t& data, mreg_t
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, VLENB, macc, mask);
     for (size_t e = 0; e < MLEN; ++e) {
         if (mask[e]) {
-            cpu.chip->memory.read(cpu, addr + 4*e, 4, &data.u32[e]);
+            memory_read(cpu, addr + 4*e, 4, &data.u32[e]);
             LOG_MEMREAD(32, paddr + 4*e, data.u32[e]);
         }
         notify_mem_read(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e);
@@ -1044,13 +1152,13 @@ static void mmu_store_impl(const Hart& cpu, uint64_t eaddr, T data, mem_access_t
     if (len >= sizeof(T)) {
         // Access does not cross cache line boundary
         uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, sizeof(T), macc);
-        cpu.chip->memory.write(cpu, addr, sizeof(T), &data);
+        memory_write(cpu, addr, sizeof(T), &data);
     } else {
         // Access crosses cache line boundary
         uint64_t addr1 = pma_check_data_access(cpu, vaddr, paddr, len, macc);
         uint64_t addr2 = pma_check_data_access(cpu, vaddr + len, paddr + len, sizeof(T) - len, macc);
-        cpu.chip->memory.write(cpu, addr1, len, &data);
-        cpu.chip->memory.write(cpu, addr2, sizeof(T) - len, reinterpret_cast<char*>(&data) + len);
+        memory_write(cpu, addr1, len, &data);
+        memory_write(cpu, addr2, sizeof(T) - len, reinterpret_cast<char*>(&data) + len);
     }
     LOG_MEMWRITE(CHAR_BIT*sizeof(T), paddr, data);
     notify_mem_write(cpu, true, sizeof(T), vaddr, paddr, data);
@@ -1067,7 +1175,7 @@ static void mmu_aligned_store_impl(const Hart& cpu, uint64_t eaddr, T data, mem_
     }
     uint64_t paddr = vmemtranslate(cpu, vaddr, sizeof(T), macc);
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, sizeof(T), macc);
-    cpu.chip->memory.write(cpu, addr, sizeof(T), &data);
+    memory_write(cpu, addr, sizeof(T), &data);
     LOG_MEMWRITE(CHAR_BIT*sizeof(T), paddr, data);
     notify_mem_write(cpu, true, sizeof(T), vaddr, paddr, data);
 }
@@ -1080,7 +1188,7 @@ static uint64_t mmu_tensor_store_impl(const Hart& cpu, uint64_t eaddr, const uin
     assert(addr_is_size_aligned(vaddr, Nbytes));
     uint64_t paddr = vmemtranslate(cpu, vaddr, Nbytes, macc);
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, Nbytes, macc);
-    cpu.chip->memory.write(cpu, addr, Nbytes, data);
+    memory_write(cpu, addr, Nbytes, data);
     if (macc == Mem_Access_TxStore) {
         static constexpr unsigned n_words = Nbytes / 4;
         for (unsigned i = 0; i < n_words; ++i) {
@@ -1167,7 +1275,7 @@ void mmu_storeVLEN(const Hart& cpu, uint64_t eaddr, const freg_t& data, mreg_t m
         uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, VLENB, macc, mask);
         for (size_t e = 0; e < MLEN; ++e) {
             if (mask[e]) {
-                cpu.chip->memory.write(cpu, addr + 4*e, 4, &data.u32[e]);
+                memory_write(cpu, addr + 4*e, 4, &data.u32[e]);
                 LOG_MEMWRITE(32, paddr + 4*e, data.u32[e]);
             }
             notify_mem_write(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e, data.u32[e]);
@@ -1177,7 +1285,7 @@ void mmu_storeVLEN(const Hart& cpu, uint64_t eaddr, const freg_t& data, mreg_t m
         for (size_t e = 0; e < MLEN; ++e) {
             if (mask[e]) {
                 uint64_t addr = pma_check_data_access(cpu, vaddr + 4*e, paddr + 4*e, 4, macc);
-                cpu.chip->memory.write(cpu, addr, 4, &data.u32[e]);
+                memory_write(cpu, addr, 4, &data.u32[e]);
                 LOG_MEMWRITE(32, paddr + 4*e, data.u32[e]);
             }
             notify_mem_write(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e, data.u32[e]);
@@ -1189,8 +1297,8 @@ void mmu_storeVLEN(const Hart& cpu, uint64_t eaddr, const freg_t& data, mreg_t m
             if (mask[e]) {
                 uint64_t addr1 = pma_check_data_access(cpu, vaddr + 4*e, paddr + 4*e, len, macc);
                 uint64_t addr2 = pma_check_data_access(cpu, vaddr + 4*e + len, paddr + 4*e + len, 4 - len, macc);
-                cpu.chip->memory.write(cpu, addr1, len, &data.u8[4*e]);
-                cpu.chip->memory.write(cpu, addr2, 4 - len, &data.u8[4*e + len]);
+                memory_write(cpu, addr1, len, &data.u8[4*e]);
+                memory_write(cpu, addr2, 4 - len, &data.u8[4*e + len]);
                 LOG_MEMWRITE(32, paddr + 4*e, data.u32[e]);
             }
             notify_mem_write(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e, data.u32[e]);
@@ -1213,7 +1321,7 @@ void mmu_aligned_storeVLEN(const Hart& cpu, uint64_t eaddr, const freg_t& data,
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, VLENB, macc, mask);
     for (size_t e = 0; e < MLEN; ++e) {
         if (mask[e]) {
-            cpu.chip->memory.write(cpu, addr + 4*e, 4, &data.u32[e]);
+            memory_write(cpu, addr + 4*e, 4, &data.u32[e]);
             LOG_MEMWRITE(32, paddr + 4*e, data.u32[e]);
         }
         notify_mem_write(cpu, mask[e], 4, vaddr + 4*e, paddr + 4*e, data.u32[e]);
@@ -1232,10 +1340,10 @@ T mmu_atomic_impl(const Hart& cpu, uint64_t eaddr, T data, std::function<T(T, T)
     uint64_t paddr = vmemtranslate(cpu, vaddr, sizeof(T), M);
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, sizeof(T), M);
     T oldval {};
-    cpu.chip->memory.read(cpu, addr, sizeof(T), &oldval);
+    memory_read(cpu, addr, sizeof(T), &oldval);
     LOG_MEMREAD(CHAR_BIT*sizeof(T), paddr, oldval);
     T newval = fn(oldval, data);
-    cpu.chip->memory.write(cpu, addr, sizeof(T), &newval);
+    memory_write(cpu, addr, sizeof(T), &newval);
     LOG_MEMWRITE(CHAR_BIT*sizeof(T), paddr, newval);
     notify_mem_read_write(cpu, true, sizeof(T), vaddr, paddr, data);
     return oldval;
@@ -1281,10 +1389,10 @@ T mmu_compare_exchange_impl(const Hart& cpu, uint64_t eaddr, T expected, T desir
     }
     uint64_t paddr = vmemtranslate(cpu, vaddr, sizeof(T), M);
     uint64_t addr = pma_check_data_access(cpu, vaddr, paddr, sizeof(T), M);
-    cpu.chip->memory.read(cpu, addr, sizeof(T), &oldval);
+    memory_read(cpu, addr, sizeof(T), &oldval);
     LOG_MEMREAD(CHAR_BIT*sizeof(T), paddr, oldval);
     if (oldval == expected) {
-        cpu.chip->memory.write(cpu, addr, sizeof(T), &desired);
+        memory_write(cpu, addr, sizeof(T), &desired);
         LOG_MEMWRITE(CHAR_BIT*sizeof(T), paddr, desired);
     }
     notify_mem_read_write(cpu, true, sizeof(T), vaddr, paddr, desired);
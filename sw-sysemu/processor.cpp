@@ -52,9 +52,6 @@ static inline void clear_hastatus0(Hart& cpu, unsigned offset)
 void configure_port(Hart&, unsigned, uint32_t);
 
 
-// Instruction execution function
-using insn_exec_funct_t = void (*)(Hart&);
-
 // Instruction decode function
 using insn_decode_func_t = insn_exec_funct_t (*)(uint32_t, uint16_t&);
 
@@ -1211,36 +1208,53 @@ static const insn_decode_func_t functab16b[32] = {
 };
 
 
+static inline insn_exec_funct_t decode_bits(uint32_t bits, uint16_t& flags)
+{
+    if ((bits & 0x3) == 0x3) {
+        int idx = ((bits >> 2) & 0x1f);
+        return functab32b[idx](bits, flags);
+    }
+    int idx = ((bits >> 11) & 0x1c) | (bits & 0x03);
+    return functab16b[idx](bits, flags);
+}
+
+
 // FIXME: we need a better place to put this code, but it uses all these
 // decode tables only visible to this file...
 uintptr_t decode(uint32_t bits)
 {
-    Instruction inst = { bits, 0 };
-    insn_exec_funct_t exec_fn = nullptr;
-
-    if ((inst.bits & 0x3) == 0x3) {
-        int idx = ((inst.bits >> 2) & 0x1f);
-        exec_fn = functab32b[idx](inst.bits, inst.flags);
-    } else {
-        int idx = ((inst.bits >> 11) & 0x1c) | (inst.bits & 0x03);
-        exec_fn = functab16b[idx](inst.bits, inst.flags);
-    }
-    return reinterpret_cast<uintptr_t>(exec_fn);
+    uint16_t flags = 0;
+    return reinterpret_cast<uintptr_t>(decode_bits(bits, flags));
 }
 
 
 void Hart::execute()
 {
-    // Decode the fetched bits
+    // Decode the fetched bits, or reuse a previous decode of the same bits
+    // at the same physical address. Instructions that are not entirely
+    // contained in the fetch buffer (or come from the program buffer) are
+    // always decoded.
     insn_exec_funct_t exec_fn = nullptr;
-    if ((inst.bits & 0x3) == 0x3) {
-        int idx = ((inst.bits >> 2) & 0x1f);
-        exec_fn = functab32b[idx](inst.bits, inst.flags);
-        npc = sextVA(pc + 4);
+    if ((pc & ~31ULL) == fetch_pc) {
+        const uint64_t paddr = fetch_paddr | (pc & 31);
+        const Decode_cache::Entry* hit = core->decode_cache.lookup(paddr, inst.bits);
+        if (hit) {
+            exec_fn = hit->exec_fn;
+            inst.flags = hit->flags;
+            npc = sextVA(pc + hit->size);
+        } else {
+            exec_fn = decode_bits(inst.bits, inst.flags);
+            npc = sextVA(pc + inst.size());
+            Decode_cache::Entry& entry = core->decode_cache.entry(paddr);
+            entry.paddr = paddr;
+            entry.exec_fn = exec_fn;
+            entry.bits = inst.bits;
+            entry.flags = inst.flags;
+            entry.size = inst.size();
+        }
     } else {
-        int idx = ((inst.bits >> 11) & 0x1c) | (inst.bits & 0x03);
-        exec_fn = functab16b[idx](inst.bits, inst.flags);
-        npc = sextVA(pc + 2);
+        exec_fn = decode_bits(inst.bits, inst.flags);
+        npc = sextVA(pc + inst.size());
     }
     if ((minstmask >> 32) != 0) {
         if (((inst.bits ^ minstmatch) & uint32_t(minstmask)) == 0)
@@ -1250,6 +1264,148 @@ void Hart::execute()
 }
 
 
+// -----------------------------------------------------------------------------
+//
+// Basic block execution
+//
+// -----------------------------------------------------------------------------
+
+// Instructions that may redirect the control flow or change the state that
+// the following instructions depend upon terminate a basic block
+static inline bool ends_basic_block(uint32_t bits, uint16_t flags)
+{
+    if (flags & (Instruction::flag_CSR_READ | Instruction::flag_CSR_WRITE |
+                 Instruction::flag_REDUCE | Instruction::flag_TENSOR_LOAD |
+                 Instruction::flag_TENSOR_QUANT | Instruction::flag_TENSOR_STORE |
+                 Instruction::flag_TENSOR_FMA | Instruction::flag_FLB))
+        return true;
+
+    if ((bits & 0x3) == 0x3) {
+        switch ((bits >> 2) & 0x1f) {
+        case 0x03: // fence, fence.i
+        case 0x18: // branches
+        case 0x19: // jalr
+        case 0x1b: // jal
+        case 0x1c: // system
+            return true;
+        default:
+            return false;
+        }
+    }
+    switch (((bits >> 11) & 0x1c) | (bits & 0x03)) {
+    case 0x15: // c.j
+    case 0x19: // c.beqz
+    case 0x1d: // c.bnez
+        return true;
+    case 0x12: // c.jr, c.jalr, c.ebreak (c.mv and c.add have rs2 != 0)
+        return ((bits >> 2) & 0x1f) == 0;
+    default:
+        return false;
+    }
+}
+
+
+// Execute up to max_insns instructions, following chained basic blocks.
+// Stops early if the hart stops being runnable. Pending interrupts for the
+// first instruction must be checked by the caller, as in execute().
+void Hart::execute_block(unsigned max_insns)
+{
+    if (!core->block_cache) {
+        core->block_cache.reset(new Block_cache);
+    }
+
+    const uint8_t retired_event = PMU_MINION_EVENT_RETIRED_INST0 + (mhartid & 1);
+
+    Basic_block* bb = nullptr;      // block being executed
+    Basic_block* prev = nullptr;    // previous block, for chaining
+    unsigned     exit = 0;          // how the previous block was left
+    size_t       pos = 0;           // next instruction in the block
+    uint64_t     next_paddr = 0;    // expected address of the next instruction
+
+    for (unsigned n = 0; n < max_insns; ++n) {
+        if (n != 0) {
+            check_pending_interrupts();
+        }
+        fetch();
+
+        // Instructions that cross a fetch buffer line are not cached
+        if ((pc & ~31ULL) != fetch_pc) {
+            execute();
+            notify_pmu_minion_event(retired_event);
+            advance_pc();
+            return;
+        }
+
+        const uint64_t paddr = fetch_paddr | (pc & 31);
+
+        // The block was left, or continues at a non-contiguous address
+        if (bb && (paddr != next_paddr)) {
+            bb = nullptr;
+            prev = nullptr;
+        }
+
+        // Find the block that starts here, preferably through the chain
+        if (!bb) {
+            Basic_block* chained = prev ? prev->next[exit] : nullptr;
+            if (chained && (chained->paddr == paddr)) {
+                bb = chained;
+            } else {
+                bb = &core->block_cache->block(paddr);
+                if (bb->paddr != paddr) {
+                    bb->reset(paddr);
+                }
+                if (prev) {
+                    prev->next[exit] = bb;
+                }
+            }
+            pos = 0;
+        }
+
+        // Reuse the decoded instruction, or (re)build the block from here
+        if ((pos >= bb->count) || (bb->insns[pos].bits != inst.bits)) {
+            bb->truncate(pos);
+            Basic_block::Insn& insn = bb->insns[pos];
+            insn.exec_fn = decode_bits(inst.bits, inst.flags);
+            insn.bits = inst.bits;
+            insn.flags = inst.flags;
+            insn.size = inst.size();
+            bb->count = pos + 1;
+            bb->complete = (bb->count == Basic_block::max_insns)
+                || ends_basic_block(insn.bits, insn.flags);
+        }
+
+        const Basic_block::Insn& insn = bb->insns[pos];
+        const bool last = bb->complete && (pos + 1 == bb->count);
+        const uint64_t fallthrough = sextVA(pc + insn.size);
+
+        inst.flags = insn.flags;
+        npc = fallthrough;
+        if ((minstmask >> 32) != 0) {
+            if (((inst.bits ^ minstmatch) & uint32_t(minstmask)) == 0)
+                throw trap_mcode_instruction(inst.bits);
+        }
+        (insn.exec_fn)(*this);
+        notify_pmu_minion_event(retired_event);
+        advance_pc();
+
+        if (!is_active() || is_waiting() || debug_mode || is_blocked()
+            || chip->get_emu_done())
+            return;
+
+        ++pos;
+        next_paddr = paddr + insn.size;
+        if (last) {
+            prev = bb;
+            exit = (pc == fallthrough) ? 0 : 1;
+            bb = nullptr;
+        } else if (pc != fallthrough) {
+            prev = nullptr;
+            bb = nullptr;
+        }
+    }
+}
+
+
 // -----------------------------------------------------------------------------
 //
 // Trap execution
@@ -1528,6 +1684,27 @@ void Hart::notify_pmu_minion_event(uint8_t event)
 //
 // -----------------------------------------------------------------------------
 
+bool Hart::can_access(const Hart& other) const
+{
+    return !chip->is_parallel() || (shire_index(other) == shire_index(*this));
+}
+
+
+// Harts of different shires may move between lists concurrently
+static inline void move_to_list(Hart& cpu, intrusive::List<Hart, &Hart::links>& list)
+{
+    std::lock_guard<std::mutex> lock(cpu.chip->hart_lists_mutex);
+    list.push_back(cpu);
+}
+
+
+static inline void unlink_from_list(Hart& cpu)
+{
+    std::lock_guard<std::mutex> lock(cpu.chip->hart_lists_mutex);
+    cpu.links.unlink();
+}
+
+
 void Hart::become_nonexistent()
 {
     if (index_in_core(*this) == 0) {
@@ -1542,7 +1719,7 @@ void Hart::become_nonexistent()
     }
     waits = Waiting::none;
     state = State::nonexistent;
-    links.unlink();
+    unlink_from_list(*this);
 }
 
 
@@ -1567,7 +1744,7 @@ void Hart::become_unavailable()
     }
     waits = Waiting::none;
     state = State::unavailable;
-    links.unlink();
+    unlink_from_list(*this);
 }
 
 
@@ -1592,10 +1769,10 @@ void Hart::start_running()
         return;
     }
     if (!is_waiting() || has_active_coprocessor()) {
-        chip->awaking.push_back(*this);
+        move_to_list(*this, chip->awaking);
         state = State::active;
     } else {
-        chip->sleeping.push_back(*this);
+        move_to_list(*this, chip->sleeping);
         state = State::sleeping;
     }
 }
@@ -1622,10 +1799,10 @@ void Hart::enter_debug_mode(Debug_entry::Cause cause)
         return;
     }
     if (!is_waiting() || has_active_coprocessor()) {
-        chip->awaking.push_back(*this);
+        move_to_list(*this, chip->awaking);
         state = State::active;
     } else {
-        chip->sleeping.push_back(*this);
+        move_to_list(*this, chip->sleeping);
         state = State::sleeping;
     }
 }
@@ -1768,7 +1945,7 @@ void Hart::maybe_sleep()
 {
     if (!is_sleeping() && is_waiting() && !has_active_coprocessor()) {
         assert(is_active());
-        chip->sleeping.push_back(*this);
+        move_to_list(*this, chip->sleeping);
         state = State::sleeping;
         LOG_HART(DEBUG, *this, "%s", "Going to sleep");
     }
@@ -1778,7 +1955,7 @@ void Hart::maybe_sleep()
 void Hart::maybe_wakeup()
 {
     if (!is_active() && (!is_waiting() || has_active_coprocessor())) {
-        chip->awaking.push_back(*this);
+        move_to_list(*this, chip->awaking);
         state = State::active;
         LOG_HART(DEBUG, *this, "%s", "Waking up");
     }
@@ -1801,7 +1978,7 @@ void Hart::warm_reset()
     if (state != State::nonexistent) {
         state = State::unavailable;
         waits = Hart::Waiting::none;
-        links.unlink();
+        unlink_from_list(*this);
     }
 
     // Check if in program buffer
@@ -1819,8 +1996,9 @@ void Hart::warm_reset()
     // Currently executing instruction
     inst = Instruction { 0, 0 };
 
-    // Fetch buffer
+    // Fetch buffer and TLBs
     fetch_pc = -1;
+    flush_tlb();
 
     // RISCV control and status registers
     scounteren = 0;
@@ -1868,6 +2046,7 @@ void Hart::warm_reset()
     // Reset core-shared state
     if (index_in_core(*this) == 0) {
         core->matp = 0;
+        core->flush_decoded_insns();
         core->menable_shadows = 0;
         core->excl_mode = 0;
         core->mcache_control = 0;
@@ -12,16 +12,21 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <sstream>
 
 #include "support/intrusive/list.h"
 #include "agent.h"
+#include "bb_cache.h"
 #include "cache.h"
+#include "decode_cache.h"
 #include "emu_defines.h"
+#include "host_page_cache.h"
 #include "insn.h"
 #include "mmu.h"
 #include "state.h"
 #include "tensor.h"
+#include "tlb.h"
 #include "traps.h"
 
 namespace bemu {
@@ -248,6 +253,20 @@ struct Core {
     std::array<TLoad, 2>  tload_a;
     TLoad                 tload_b;
     TQueue                tqueue;
+
+    // Decoded instructions, shared by both threads of the core
+    Decode_cache          decode_cache;
+
+    // Basic blocks for block execution mode (allocated on first use)
+    std::unique_ptr<Block_cache>  block_cache;
+
+    // Drop all decoded instructions of this core
+    void flush_decoded_insns() {
+        decode_cache.invalidate();
+        if (block_cache) {
+            block_cache->invalidate();
+        }
+    }
 };
 
 
@@ -328,7 +347,13 @@ struct Hart : public Agent {
     void fetch();
     void async_execute();
     void execute();
+    void execute_block(unsigned max_insns);
     void take_trap(const Trap&);
+    void flush_tlb();
+
+    // Whether the state of another hart can be accessed, which is not the
+    // case for harts of other shires while shires run concurrently
+    bool can_access(const Hart& other) const;
     void raise_interrupt(int cause, uint64_t data = 0);
     void clear_interrupt(int cause);
     void notify_pmu_minion_event(uint8_t event);
@@ -391,8 +416,17 @@ struct Hart : public Agent {
 
     // Fetch buffer
     uint64_t              fetch_pc;
+    uint64_t              fetch_paddr;
     std::array<char, 32>  fetch_cache;
 
+    // Translation lookaside buffers for fetches and data accesses (filled
+    // by the page walker, which only has a const Hart)
+    mutable Tlb           itlb;
+    mutable Tlb           dtlb;
+
+    // Host pointers to recently accessed DRAM and scratchpad pages
+    mutable Host_page_cache  host_pages;
+
     // Register files
     std::array<uint64_t,NXREGS>   xregs;
     std::array<freg_t,NFREGS>     fregs;
@@ -533,6 +567,13 @@ inline void Hart::advance_pc()
 }
 
 
+inline void Hart::flush_tlb()
+{
+    itlb.invalidate();
+    dtlb.invalidate();
+}
+
+
 inline void Hart::activate_breakpoints()
 {
     uint64_t mcontrol = tdata1;
@@ -660,7 +701,9 @@ inline void Hart::async_execute()
         }
         break;
     case TQueue::Instruction::reduce:
-        if (core->reduce.state == TReduce::State::ready_to_receive) {
+        if ((core->reduce.state == TReduce::State::ready_to_receive)
+            && can_access(*core->reduce.hart))
+        {
             auto& send = core->reduce.hart->core->reduce;
             if (send.state == TReduce::State::ready_to_send) {
                 if (send.hart == this) {
@@ -18,10 +18,26 @@ void ISysEmu::IHostListener::memoryWriteFromHost(uint64_t address, size_t size,
   auto dst = reinterpret_cast<std::byte*>(address);
   std::copy(src, src + size, dst);
 }
+std::byte* ISysEmu::IHostListener::hostMemoryPointer(uint64_t, size_t) {
+  return nullptr;
+}
+
 void ISysEmu::IHostListener::onSysemuFatalError(const std::string& error) {
   SE_LOG(ERROR) << "Got a FATAL error from sysemu: " << error;
 }
 
+void ISysEmu::mmioReadv(const MmioRead* reads, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    mmioRead(reads[i].address, reads[i].size, reads[i].dst);
+  }
+}
+
+void ISysEmu::mmioWritev(const MmioWrite* writes, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    mmioWrite(writes[i].address, writes[i].size, writes[i].src);
+  }
+}
+
 std::unique_ptr<ISysEmu> ISysEmu::create(const SysEmuOptions& options, const std::array<uint64_t, 8>& barAddresses,
                                          IHostListener* hostListener) {
   return std::make_unique<SysEmuImp>(options, barAddresses, hostListener);
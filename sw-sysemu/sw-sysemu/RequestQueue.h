@@ -0,0 +1,119 @@
+//******************************************************************************
+// Copyright (c) 2025 Ainekko, Co.
+// SPDX-License-Identifier: Apache-2.0
+//------------------------------------------------------------------------------
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace emu {
+
+// Bounded lock-free queue of requests from host threads (any number of
+// producers) to the emulation thread (the only consumer). Each slot carries a
+// sequence number that tells whether it is free for the producer that
+// reserved its position, or holds a request ready for the consumer.
+class RequestQueue {
+public:
+  using Request = std::function<void()>;
+  static constexpr size_t kCapacity = 256;
+
+  RequestQueue() {
+    for (size_t i = 0; i < kCapacity; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  RequestQueue(const RequestQueue&) = delete;
+  RequestQueue& operator=(const RequestQueue&) = delete;
+
+  // Producers: enqueue a request, yielding while the queue is full
+  void push(Request&& request) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos % kCapacity];
+      auto diff = static_cast<intptr_t>(slot.seq.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.request = std::move(request);
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return;
+        }
+      } else if (diff < 0) {
+        std::this_thread::yield();
+        pos = head_.load(std::memory_order_relaxed);
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer: dequeue the oldest request, if there is any
+  bool tryPop(Request& request) {
+    Slot& slot = slots_[tail_ % kCapacity];
+    if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) {
+      return false;
+    }
+    request = std::move(slot.request);
+    slot.request = nullptr;
+    slot.seq.store(tail_ + kCapacity, std::memory_order_release);
+    ++tail_;
+    return true;
+  }
+
+private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    Request request;
+  };
+
+  std::array<Slot, kCapacity> slots_;
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) size_t tail_ = 0;
+};
+
+// Completion of a request that a host thread waits for. The waiter spins for
+// a while, since most requests are served at the next poll of the emulation
+// thread, before blocking on the condition variable.
+class RequestCompletion {
+public:
+  void set(std::exception_ptr error = nullptr) {
+    error_ = error;
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_.store(true, std::memory_order_release);
+    condVar_.notify_one();
+  }
+
+  // Waits for the request and rethrows its exception, if any
+  void wait() {
+    for (int i = 0; i < kSpins && !done_.load(std::memory_order_acquire); ++i) {
+      std::this_thread::yield();
+    }
+    {
+      // Also waits for set() to release the mutex, as the completion is
+      // usually destroyed right after this returns
+      std::unique_lock<std::mutex> lock(mutex_);
+      condVar_.wait(lock, [this]() { return done_.load(std::memory_order_acquire); });
+    }
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+private:
+  static constexpr int kSpins = 1000;
+
+  std::atomic<bool> done_{false};
+  std::exception_ptr error_;
+  std::mutex mutex_;
+  std::condition_variable condVar_;
+};
+
+} // namespace emu
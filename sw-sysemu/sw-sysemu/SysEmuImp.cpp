@@ -166,6 +166,37 @@ bool iatuTranslate(bemu::System* chip, uint64_t pci_addr, uint64_t size, uint64_
   return false;
 }
 
+/**
+ * Access device memory through the iATUs.
+ * The access is split at iATU region boundaries, and `access(device_addr, access_size, offset)` is called for each
+ * part, where `offset` is the offset of the part within the host buffer.
+ */
+template <typename Access>
+void iatuAccess(bemu::System* chip, bemu::Noagent& agent, uint64_t address, size_t size, Access&& access) {
+  auto pci_addr = address;
+  uint64_t host_access_offset = 0;
+  int64_t remaining = size;
+  while (remaining > 0) {
+    uint64_t device_addr, access_size;
+    if (!iatuTranslate(chip, pci_addr, remaining, device_addr, access_size)) {
+      LOG_AGENT(WARN, agent, "iATU: Could not find translation for host address: 0x%" PRIx64 ", size: 0x%" PRIx64,
+                pci_addr, remaining);
+      iatusPrint(chip);
+      break;
+    }
+    access(device_addr, access_size, host_access_offset);
+
+    pci_addr += access_size;
+    host_access_offset += access_size;
+    remaining -= access_size;
+  }
+  if (remaining > 0) {
+    throw emu::Exception(
+      "Invalid IATU translation. Size too big to be covered fully by iATUs / translation failure. Address: " +
+      std::to_string(address) + " size: " + std::to_string(remaining));
+  }
+}
+
 /**
  * Warn about runtime options that may be ignored.
  * This parses a vector of user-supplied runtime options and makes sure
@@ -199,103 +230,74 @@ void SysEmuImp::set_system(bemu::System* system) {
 }
 
 void SysEmuImp::process() {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (!requests_.empty()) {
+  // Drain all the requests queued since the last poll
+  RequestQueue::Request request;
+  while (requests_.tryPop(request)) {
     SE_LOG(INFO) << "Processing request...";
-    auto&& req = requests_.front();
-    req();
-    requests_.pop();
+    request();
   }
   if (should_pause_) {
     using namespace std::chrono_literals;
-    condVar_.wait_for(lock, 100ms);
+    std::unique_lock<std::mutex> lock(mutex_);
+    // keep emulating every 100ms while paused so the device timers still run
+    pauseCondVar_.wait_for(lock, 100ms, [this]() { return !should_pause_ || !running_; });
   }
 }
 
 void SysEmuImp::mmioRead(uint64_t address, size_t size, std::byte* dst) {
-  resume();
-  std::promise<void> p;
-  auto request = [=, &p]() {
-    SE_LOG(INFO) << "Device memory read at: " << std::hex << address << " size: " << size << " host dst: " << dst;
-    auto pci_addr = address;
-    uint64_t host_access_offset = 0;
-    int64_t readSize = size;
-    while (readSize > 0) {
-
-      uint64_t device_addr, access_size;
-
-      if (!iatuTranslate(chip_, pci_addr, readSize, device_addr, access_size)) {
-        LOG_AGENT(WARN, agent_, "iATU: Could not find translation for host address: 0x%" PRIx64 ", size: 0x%" PRIx64,
-                  pci_addr, readSize);
-        iatusPrint(chip_);
-        break;
-      }
-
-      try {
-        chip_->memory.read(agent_, device_addr, access_size, dst + host_access_offset);
-      } catch (...) {
-        p.set_exception(std::current_exception());
-        return;
-      }
+  MmioRead read{address, size, dst};
+  mmioReadv(&read, 1);
+}
 
-      pci_addr += access_size;
-      host_access_offset += access_size;
-      readSize -= access_size;
-    }
+void SysEmuImp::mmioWrite(uint64_t address, size_t size, const std::byte* src) {
+  MmioWrite write{address, size, src};
+  mmioWritev(&write, 1);
+}
 
-    if (readSize > 0) {
-      p.set_exception(std::make_exception_ptr(emu::Exception(
-        "Invalid IATU translation. Size too big to be covered fully by iATUs / translation failure. Address: " +
-        std::to_string(address) + " size: " + std::to_string(readSize))));
+void SysEmuImp::mmioReadv(const MmioRead* reads, size_t count) {
+  resume();
+  RequestCompletion done;
+  requests_.push([=, &done]() {
+    try {
+      for (size_t i = 0; i < count; ++i) {
+        const auto& read = reads[i];
+        SE_LOG(INFO) << "Device memory read at: " << std::hex << read.address << " size: " << read.size
+                     << " host dst: " << read.dst;
+        iatuAccess(chip_, agent_, read.address, read.size,
+                   [this, &read](uint64_t device_addr, uint64_t access_size, uint64_t offset) {
+                     chip_->memory.read(agent_, device_addr, access_size, read.dst + offset);
+                   });
+      }
+    } catch (...) {
+      done.set(std::current_exception());
       return;
     }
-    p.set_value();
-  };
-  std::unique_lock<std::mutex> lock(mutex_);
-  requests_.emplace(std::move(request));
-  lock.unlock();
-  p.get_future().get();
+    done.set();
+  });
+  done.wait();
 }
 
-void SysEmuImp::mmioWrite(uint64_t address, size_t size, const std::byte* src) {
+void SysEmuImp::mmioWritev(const MmioWrite* writes, size_t count) {
   resume();
-  std::promise<void> p;
-  auto request = [=, &p]() {
-    SE_LOG(INFO) << "Device memory write at: " << std::hex << address << " size: " << size << " host src: " << src;
-    auto pci_addr = address;
-    uint64_t host_access_offset = 0;
-    int64_t readSize = size;
-    while (readSize > 0) {
-      uint64_t device_addr, access_size;
-      if (!iatuTranslate(chip_, pci_addr, size, device_addr, access_size)) {
-        LOG_AGENT(WARN, agent_, "iATU: Could not find translation for host address: 0x%" PRIx64 ", size: 0x%" PRIx64,
-                  pci_addr, size);
-        iatusPrint(chip_);
-        break;
-      }
-      try {
-        chip_->memory.write(agent_, device_addr, access_size, src + host_access_offset);
-      } catch (...) {
-        p.set_exception(std::current_exception());
-        return;
+  RequestCompletion done;
+  requests_.push([=, &done]() {
+    try {
+      for (size_t i = 0; i < count; ++i) {
+        const auto& write = writes[i];
+        SE_LOG(INFO) << "Device memory write at: " << std::hex << write.address << " size: " << write.size
+                     << " host src: " << write.src;
+        iatuAccess(chip_, agent_, write.address, write.size,
+                   [this, &write](uint64_t device_addr, uint64_t access_size, uint64_t offset) {
+                     chip_->memory.write(agent_, device_addr, access_size, write.src + offset);
+                   });
       }
-
-      pci_addr += access_size;
-      host_access_offset += access_size;
-      readSize -= access_size;
-    }
-    if (readSize > 0) {
-      p.set_exception(std::make_exception_ptr(emu::Exception(
-        "Invalid IATU translation. Size too big to be covered fully by iATUs / translation failure. Address: " +
-        std::to_string(address) + " size: " + std::to_string(readSize))));
+    } catch (...) {
+      done.set(std::current_exception());
       return;
     }
-    p.set_value();
-  };
-  std::unique_lock<std::mutex> lock(mutex_);
-  requests_.emplace(std::move(request));
-  lock.unlock();
-  p.get_future().get();
+    done.set();
+  });
+  done.wait();
 }
 
 void SysEmuImp::raiseDevicePuPlicPcieMessageInterrupt() {
@@ -305,8 +307,7 @@ void SysEmuImp::raiseDevicePuPlicPcieMessageInterrupt() {
     LOG_AGENT(INFO, agent_, "raise_device_interrupt(type = %s)", "PU");
     chip_->memory.pu_trg_pcie_mmm_int_inc(agent_);
   };
-  std::lock_guard<std::mutex> lock(mutex_);
-  requests_.emplace(std::move(request));
+  requests_.push(std::move(request));
 }
 
 uint32_t SysEmuImp::waitForInterrupt(uint32_t bitmap) {
@@ -338,8 +339,7 @@ void SysEmuImp::raiseDeviceSpioPlicPcieMessageInterrupt() {
     LOG_AGENT(INFO, agent_, "raise_device_interrupt(type = %s)", "SP");
     chip_->memory.pu_trg_pcie_ipi_trigger(agent_);
   };
-  std::lock_guard<std::mutex> lock(mutex_);
-  requests_.emplace(std::move(request));
+  requests_.push(std::move(request));
 }
 
 bool SysEmuImp::host_memory_read(uint64_t host_addr, uint64_t size, void* data) {
@@ -360,6 +360,10 @@ bool SysEmuImp::host_memory_write(uint64_t host_addr, uint64_t size, const void*
   return true;
 }
 
+void* SysEmuImp::host_memory_pointer(uint64_t host_addr, uint64_t size) {
+  return hostListener_ ? hostListener_->hostMemoryPointer(host_addr, size) : nullptr;
+}
+
 void SysEmuImp::notify_iatu_ctrl_2_reg_write(int pcie_id, uint32_t iatu, uint32_t value) {
   LOG_AGENT(DEBUG, agent_, "notify_iatu_ctrl_2_reg_write: %d, 0x%x, 0x%x", pcie_id, iatu, value);
   // We only care about PCIE0
@@ -371,31 +375,28 @@ void SysEmuImp::notify_iatu_ctrl_2_reg_write(int pcie_id, uint32_t iatu, uint32_
 }
 
 SysEmuImp::~SysEmuImp() {
-  std::promise<void> p;
-  auto request = [=, &p]() {
+  RequestCompletion done;
+  requests_.push([this, &done]() {
     try {
       chip_->set_emu_done(true);
-      p.set_value();
+      done.set();
     } catch (...) {
-      p.set_exception(std::current_exception());
+      done.set(std::current_exception());
     }
-  };
+  });
   std::unique_lock<std::mutex> lock(mutex_);
-  requests_.emplace(std::move(request));
   stop();
   lock.unlock();
   // Wait until set_emu_done is called
-  p.get_future().get();
-  // Empty request queue
-  lock.lock();
-  while (!requests_.empty()) {
-    requests_.pop();
-  }
-  lock.unlock();
+  done.wait();
 
   SE_LOG(INFO) << "Waiting for sysemu thread to finish.";
   sysEmuThread_.join();
   SE_LOG(INFO) << "Sysemu thread finished.";
+  // Empty request queue
+  RequestQueue::Request request;
+  while (requests_.tryPop(request)) {
+  }
   if (sysEmuError_) {
     std::rethrow_exception(sysEmuError_);
   }
@@ -517,21 +518,25 @@ void SysEmuImp::notify_fatal_error(const std::string& error) {
 
 void SysEmuImp::stop() {
   running_ = false;
-  // Wake host interrupt waiters
+  // Wake host interrupt waiters and the paused sysemu thread
   condVar_.notify_all();
+  pauseCondVar_.notify_all();
 }
 
 void SysEmuImp::pause() {
   if (!should_pause_) {
     SE_LOG(INFO) << "Pause sysemu thread";
+    std::lock_guard<std::mutex> lock(mutex_);
     should_pause_ = true;
   }
 }
 
 void SysEmuImp::resume() {
+  // checked without the lock first, resume() is called on every host access
   if (should_pause_) {
     SE_LOG(INFO) << "Resume sysemu thread";
+    std::lock_guard<std::mutex> lock(mutex_);
     should_pause_ = false;
-    condVar_.notify_one();
+    pauseCondVar_.notify_all();
   }
 }
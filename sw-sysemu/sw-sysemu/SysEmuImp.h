@@ -4,16 +4,16 @@
 //------------------------------------------------------------------------------
 
 #pragma once
+#include "RequestQueue.h"
 #include "api_communicate.h"
 #include "sw-sysemu/ISysEmu.h"
 #include "sys_emu.h"
 #include "system.h"
 #include "agent.h"
+#include <atomic>
 #include <condition_variable>
-#include <functional>
 #include <future>
 #include <mutex>
-#include <queue>
 #include <thread>
 
 namespace emu {
@@ -28,6 +28,8 @@ public:
   // ISysEmu interface
   void mmioRead(uint64_t address, size_t size, std::byte* dst) override;
   void mmioWrite(uint64_t address, size_t size, const std::byte* src) override;
+  void mmioReadv(const MmioRead* reads, size_t count) override;
+  void mmioWritev(const MmioWrite* writes, size_t count) override;
   void raiseDevicePuPlicPcieMessageInterrupt() override;
   void raiseDeviceSpioPlicPcieMessageInterrupt() override;
   uint32_t waitForInterrupt(uint32_t bitmask) override;
@@ -42,6 +44,7 @@ public:
   bool raise_host_interrupt(uint32_t bitmap) override;
   bool host_memory_read(uint64_t host_addr, uint64_t size, void* data) override;
   bool host_memory_write(uint64_t host_addr, uint64_t size, const void* data) override;
+  void* host_memory_pointer(uint64_t host_addr, uint64_t size) override;
   void notify_iatu_ctrl_2_reg_write(int pcie_id, uint32_t iatu, uint32_t value) override;
   void notify_fatal_error(const std::string& error) override;
 
@@ -57,12 +60,13 @@ private:
 
   std::mutex mutex_;
   bool running_ = true;
-  bool should_pause_ = false;
+  std::atomic<bool> should_pause_{false};
   uint32_t pendingInterruptsBitmask_ = 0;
   uint64_t raised_interrupt_count_ = 0;
   std::condition_variable condVar_;
+  std::condition_variable pauseCondVar_; // wakes the sysemu thread when should_pause_ is cleared
   IHostListener* hostListener_ = nullptr;
-  std::queue<std::function<void()>> requests_;
+  RequestQueue requests_;
   std::promise<void> iatusReady_;
 };
 } // namespace emu
@@ -26,13 +26,32 @@ public:
     // we provide a simple implementation of read and write functions
     virtual void memoryReadFromHost(uint64_t address, size_t size, std::byte* dst);
     virtual void memoryWriteFromHost(uint64_t address, size_t size, const std::byte* src);
+    // direct access to host memory for DMA transfers, without bounce buffers. The default implementation returns
+    // nullptr, so that sysemu uses memoryReadFromHost/memoryWriteFromHost instead
+    virtual std::byte* hostMemoryPointer(uint64_t address, size_t size);
     virtual void onSysemuFatalError(const std::string& error);
     virtual ~IHostListener() = default;
   };
 
+  struct MmioRead {
+    uint64_t address;
+    size_t size;
+    std::byte* dst;
+  };
+  struct MmioWrite {
+    uint64_t address;
+    size_t size;
+    const std::byte* src;
+  };
+
   virtual uint32_t waitForInterrupt(uint32_t bitmask) = 0;
   virtual void mmioRead(uint64_t address, size_t size, std::byte* dst) = 0;
   virtual void mmioWrite(uint64_t address, size_t size, const std::byte* src) = 0;
+
+  // vectored accesses, done in order in a single round trip with the emulation thread. The default implementation
+  // calls mmioRead/mmioWrite for each access
+  virtual void mmioReadv(const MmioRead* reads, size_t count);
+  virtual void mmioWritev(const MmioWrite* writes, size_t count);
   virtual void raiseDevicePuPlicPcieMessageInterrupt() = 0;
   virtual void raiseDeviceSpioPlicPcieMessageInterrupt() = 0;
   virtual void stop() = 0;
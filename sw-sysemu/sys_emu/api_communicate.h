@@ -23,6 +23,13 @@ public:
     virtual bool raise_host_interrupt(uint32_t bitmap) = 0;
     virtual bool host_memory_read(uint64_t host_addr, uint64_t size, void *data) = 0;
     virtual bool host_memory_write(uint64_t host_addr, uint64_t size, const void *data) = 0;
+    // Direct access to host memory, or nullptr if it must be accessed
+    // through host_memory_read()/host_memory_write()
+    virtual void* host_memory_pointer(uint64_t host_addr, uint64_t size) {
+        (void) host_addr;
+        (void) size;
+        return nullptr;
+    }
     virtual void notify_iatu_ctrl_2_reg_write(int pcie_id, uint32_t iatu, uint32_t value) = 0;
     virtual void notify_fatal_error(const std::string& = "") = 0;
 };
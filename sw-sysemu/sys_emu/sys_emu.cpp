@@ -6,6 +6,7 @@
 #include "sys_emu.h"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
@@ -19,6 +20,7 @@
 #include <sys/types.h>
 #include <tuple>
 #include <unistd.h>
+#include <vector>
 
 #include "api_communicate.h"
 #include "checkers/l2_scp_checker.h"
@@ -36,11 +38,16 @@
 #include "preload.h"
 #include "sys_emu.h"
 #include "support/lz4_stream.h"
+#include "worker_pool.h"
 #ifdef HAVE_BACKTRACE
 #include "crash_handler.h"
 #endif
 
 
+// Maximum number of instructions per hart and cycle in basic block mode
+static constexpr unsigned bb_exec_max_insns = 256;
+
+
 static void
 halt_all_threads(bemu::System& chip)
 {
@@ -448,6 +455,248 @@ sys_emu::sys_emu(const sys_emu_cmd_options &cmd_options, api_communicate *api_co
 // Main function implementation
 ////////////////////////////////////////////////////////////////////////////////
 
+// Runs one cycle of a hart: its coprocessor operations and one instruction,
+// or a run of basic blocks
+sys_emu::Step sys_emu::step_hart(bemu::Hart& hart, bool& gdb_enabled, bool bb_exec)
+{
+    auto thread_id = hart_index(hart);
+
+    // This should happen even if the hart is sleeping or blocked
+    try {
+        hart.async_execute();
+    }
+    catch (const bemu::deferred_access) {
+        return Step::deferred;
+    }
+
+    //GDB server can be enabled by PC or by the first transition to user mode.
+    if (!gdb_enabled && cmd_options.gdb &&
+        ((hart.pc == cmd_options.gdb_at_pc) ||
+         (cmd_options.gdb_on_umode && (hart.prv == bemu::Privilege::U)))) {
+        // Break and connect the debugger in the next iteration!
+        gdb_enabled = true;
+        return Step::stop;
+    }
+
+    // Fetch and interrupts are blocked because another hart of this core is in exclusive mode
+    if (hart.is_blocked()) {
+        return Step::next;
+    }
+
+    // If the hart is halted either do nothing or fetch and execute from the program buffer
+    if (hart.is_halted()) {
+        if (!hart.in_progbuf()) {
+            return Step::next;
+        }
+        using Progbuf = bemu::Hart::Progbuf;
+        try {
+            hart.fetch_progbuf();
+            hart.execute();
+            hart.advance_progbuf();
+        }
+        catch (const bemu::Trap& t) {
+            WARN_AGENT(debug, hart, "Program buffer trapped: %s", t.what());
+            hart.exit_progbuf(Progbuf::exception);
+        }
+        catch (const bemu::instruction_restart) {
+            LOG_AGENT(DEBUG, hart, "%s", "Instruction killed and will be restarted");
+        }
+        catch (const bemu::deferred_access) {
+            return Step::deferred;
+        }
+        catch (const bemu::memory_error& e) {
+            WARN_AGENT(debug, hart, "Program buffer bus error: 0x%" PRIx64, e.addr);
+            hart.exit_progbuf(Progbuf::exception);
+        }
+        catch (const std::exception& e) {
+            LOG_AGENT(FTL, hart, "%s", e.what());
+        }
+        return Step::next;
+    }
+
+    try {
+        hart.check_pending_interrupts();
+        if (bb_exec && !hart.is_waiting()) {
+            // Executes a run of basic blocks in one go
+            hart.execute_block(bb_exec_max_insns);
+        }
+        else if (!hart.is_waiting()) {
+            // Gets instruction and sets state
+            hart.fetch();
+
+            // Check for breakpoints
+            if ((gdbstub_get_status() == GDBSTUB_STATUS_RUNNING) && breakpoint_exists(hart.pc)) {
+                LOG_AGENT(DEBUG, hart, "Hit breakpoint at address 0x%" PRIx64, hart.pc);
+                gdbstub_signal_break(thread_id);
+                halt_all_threads(chip);
+                return Step::next;
+            }
+
+            // Dumping when M0:T0 reaches a PC
+            if (!cmd_options.dump_at_pc.empty()) {
+                auto range = cmd_options.dump_at_pc.equal_range(thread_get_pc(0));
+                for (auto it = range.first; it != range.second; ++it) {
+                    bemu::dump_data(chip.memory, agent,
+                                    it->second.file.c_str(), it->second.addr, it->second.size);
+                }
+            }
+
+            // Logging
+            if ((cmd_options.log_at_pc != ~0ull) || (cmd_options.stop_log_at_pc != ~0ull)) {
+                if (thread_get_pc(0) == cmd_options.log_at_pc) {
+                    get_logger().setLogLevel(LOG_DEBUG);
+                } else if (thread_get_pc(0) == cmd_options.stop_log_at_pc) {
+                    get_logger().setLogLevel(LOG_INFO);
+                }
+            }
+
+            // Executes the instruction
+            hart.execute();
+            hart.notify_pmu_minion_event(PMU_MINION_EVENT_RETIRED_INST0 + (thread_id & 1));
+            hart.advance_pc();
+        }
+    }
+    catch (const bemu::Debug_entry& e) {
+        hart.enter_debug_mode(e.cause);
+    }
+    catch (const bemu::Trap& t) {
+        uint64_t old_pc = hart.pc;
+        hart.take_trap(t);
+        hart.advance_pc();
+        if (hart.pc == old_pc) {
+            LOG_AGENT(FTL, hart, "Trapping to the same address that "
+                      "caused a trap (0x%" PRIx64 "). Avoiding "
+                      "infinite trap recursion.", hart.pc);
+        }
+    }
+    catch (const bemu::instruction_restart) {
+        LOG_AGENT(DEBUG, hart, "%s", "Instruction killed and will be restarted");
+    }
+    catch (const bemu::deferred_access) {
+        return Step::deferred;
+    }
+    catch (const bemu::memory_error& e) {
+        hart.advance_pc();
+        hart.raise_interrupt(BUS_ERROR_INTERRUPT, e.addr);
+    }
+    catch (const std::exception& e) {
+        LOG_AGENT(FTL, hart, "%s", e.what());
+    }
+
+    // Check for single-step mode
+    if ((gdbstub_get_status() == GDBSTUB_STATUS_RUNNING) && single_step[thread_id]) {
+        if (!step_range[thread_id].contains(hart.pc)) {
+            LOG_AGENT(DEBUG, hart, "%s", "Single-step done");
+            gdbstub_signal_break(thread_id);
+            single_step[thread_id] = false;
+            hart.enter_debug_mode(bemu::Debug_entry::Cause::haltreq);
+            return Step::next;
+        }
+    }
+    return Step::next;
+}
+
+
+// Runs a quantum of cycles with the minion shires distributed across the
+// worker pool. Harts only access state of their own shire, DRAM and the
+// scratchpads while shires run concurrently; those that attempt anything
+// else (see bemu::deferred_access) are deferred, and run the rest of the
+// quantum one at a time together with the service processor.
+void sys_emu::run_quantum(Worker_pool& pool, bool bb_exec)
+{
+    const uint64_t quantum = std::min(cmd_options.quantum, cmd_options.max_cycles - emu_cycle);
+
+    // Runtime API: Process new commands
+    if (api_listener) {
+        api_listener->process();
+    }
+
+    // Update peripherals/devices
+    for (uint64_t cycle = 0; cycle < quantum; ++cycle) {
+        chip.tick_peripherals(emu_cycle + cycle);
+    }
+
+    chip.active.splice(chip.active.cend(), chip.awaking);
+
+    // Running harts of each minion shire. Harts that wake up during the
+    // quantum are in the sleeping list.
+    std::array<std::vector<bemu::Hart*>, EMU_NUM_MINION_SHIRES> shire_harts;
+    for (auto list : {&chip.active, &chip.sleeping}) {
+        for (auto& hart : *list) {
+            if (shire_index(hart) < EMU_NUM_MINION_SHIRES) {
+                shire_harts[shire_index(hart)].push_back(&hart);
+            }
+        }
+    }
+    std::vector<unsigned> shires;
+    for (unsigned shire = 0; shire < EMU_NUM_MINION_SHIRES; ++shire) {
+        if (!shire_harts[shire].empty()) {
+            std::sort(shire_harts[shire].begin(), shire_harts[shire].end());
+            shires.push_back(shire);
+        }
+    }
+
+    // Cycle of the quantum from which each hart runs serially
+    std::vector<uint64_t> serial_from(EMU_NUM_THREADS, quantum);
+    serial_from[EMU_IO_SHIRE_SP_THREAD] = 0;
+
+    const auto run_shires = [&](unsigned worker) {
+        bool gdb_enabled = false;
+        for (unsigned n = worker; n < shires.size(); n += pool.size()) {
+            const auto& harts = shire_harts[shires[n]];
+            for (uint64_t cycle = 0; (cycle < quantum) && !chip.get_emu_done(); ++cycle) {
+                for (auto hart : harts) {
+                    auto& from = serial_from[hart_index(*hart)];
+                    if (!hart->is_active() || (from != quantum)) {
+                        continue;
+                    }
+                    if (step_hart(*hart, gdb_enabled, bb_exec) == Step::deferred) {
+                        from = cycle;
+                    }
+                }
+            }
+        }
+    };
+
+    chip.set_parallel(true);
+    if (shires.size() > 1) {
+        pool.run(run_shires);
+    } else {
+        run_shires(0);
+    }
+    chip.set_parallel(false);
+
+    std::vector<bemu::Hart*> serial;
+    for (unsigned id = 0; id < EMU_NUM_THREADS; ++id) {
+        if (serial_from[id] != quantum) {
+            serial.push_back(&chip.cpu[id]);
+        }
+    }
+
+    bool gdb_enabled = false;
+    for (uint64_t cycle = 0; (cycle < quantum) && !chip.get_emu_done(); ++cycle) {
+        for (auto hart : serial) {
+            if (hart->is_active() && (serial_from[hart_index(*hart)] <= cycle)) {
+                step_hart(*hart, gdb_enabled, bb_exec);
+            }
+        }
+    }
+
+    // Tensor reductions between shires complete while harts run serially
+    serial.clear();
+    for (auto& hart : chip.active) {
+        if (hart.core->tqueue.front() == bemu::TQueue::Instruction::reduce) {
+            serial.push_back(&hart);
+        }
+    }
+    for (auto hart : serial) {
+        hart->async_execute();
+    }
+
+    emu_cycle += quantum;
+}
+
+
 int sys_emu::main_internal() {
 #ifdef HAVE_BACKTRACE
     Crash_handler __crash_handler;
@@ -466,6 +715,41 @@ int sys_emu::main_internal() {
         gdbstub_init(this, &chip);
     }
 
+    // Basic block execution skips the per-instruction hooks, so fall back to
+    // one instruction per cycle when any of them is in use
+    const bool bb_exec = cmd_options.bb_exec && !cmd_options.gdb
+        && cmd_options.dump_at_pc.empty()
+        && (cmd_options.log_at_pc == ~0ull)
+        && (cmd_options.stop_log_at_pc == ~0ull)
+        && !chip.log_dynamic;
+
+    if (cmd_options.bb_exec && !bb_exec) {
+        WARN_AGENT(other, agent, "%s", "Ignoring -bb_exec, incompatible with the debug options in use");
+    }
+
+    // Shires can only run concurrently when the per-instruction hooks and
+    // the checkers are not in use
+    const bool parallel = (cmd_options.threads > 1) && !cmd_options.gdb
+        && cmd_options.dump_at_pc.empty()
+        && (cmd_options.log_at_pc == ~0ull)
+        && (cmd_options.stop_log_at_pc == ~0ull)
+        && !chip.log_dynamic
+        && (chip.log.getLogLevel() > LOG_DEBUG)
+        && !mem_check && !l1_scp_check && !l2_scp_check && !flb_check && !tstore_check
+#ifndef SDK_RELEASE
+        && !vpurf_checker
+#endif
+        ;
+
+    if ((cmd_options.threads > 1) && !parallel) {
+        WARN_AGENT(other, agent, "%s", "Ignoring -threads, incompatible with the debug options in use");
+    }
+
+    std::unique_ptr<Worker_pool> pool;
+    if (parallel) {
+        pool.reset(new Worker_pool(std::min(cmd_options.threads, unsigned(EMU_NUM_MINION_SHIRES))));
+    }
+
     LOG_AGENT(INFO, agent, "%s", "Starting emulation");
 
     double total_time = 0.0;
@@ -480,6 +764,11 @@ int sys_emu::main_internal() {
                        || chip.pu_rvtimer_is_active()
                        || chip.spio_rvtimer_is_active()))))
     {
+        if (pool) {
+            run_quantum(*pool, bb_exec);
+            continue;
+        }
+
         if (gdb_enabled) {
             switch (gdbstub_get_status()) {
             case GDBSTUB_STATUS_WAITING_CLIENT:
@@ -513,7 +802,7 @@ int sys_emu::main_internal() {
         }
 
         // Runtime API: Process new commands
-        if (api_listener) {
+        if (api_listener && (emu_cycle % cmd_options.api_poll == 0)) {
             api_listener->process();
         }
 
@@ -525,121 +814,9 @@ int sys_emu::main_internal() {
         auto current_hart = chip.active.begin();
         while (current_hart != chip.active.end()) {
             auto hart = current_hart++;
-            auto thread_id = hart_index(*hart);
-
-            // This should happen even if the hart is sleeping or blocked
-            hart->async_execute();
-
-            //GDB server can be enabled by PC or by the first transition to user mode.
-            if (!gdb_enabled && cmd_options.gdb &&
-                ((hart->pc == cmd_options.gdb_at_pc) ||
-                 (cmd_options.gdb_on_umode && (hart->prv == bemu::Privilege::U)))) {
-                // Break and connect the debugger in the next iteration!
-                gdb_enabled = true;
+            if (step_hart(*hart, gdb_enabled, bb_exec) == Step::stop) {
                 break;
             }
-
-            // Fetch and interrupts are blocked because another hart of this core is in exclusive mode
-            if (hart->is_blocked()) {
-                continue;
-            }
-
-            // If the hart is halted either do nothing or fetch and execute from the program buffer
-            if (hart->is_halted()) {
-                if (!hart->in_progbuf()) {
-                    continue;
-                }
-                using Progbuf = bemu::Hart::Progbuf;
-                try {
-                    hart->fetch_progbuf();
-                    hart->execute();
-                    hart->advance_progbuf();
-                }
-                catch (const bemu::Trap& t) {
-                    WARN_AGENT(debug, *hart, "Program buffer trapped: %s", t.what());
-                    hart->exit_progbuf(Progbuf::exception);
-                }
-                catch (const bemu::instruction_restart) {
-                    LOG_AGENT(DEBUG, *hart, "%s", "Instruction killed and will be restarted");
-                }
-                catch (const bemu::memory_error& e) {
-                    WARN_AGENT(debug, *hart, "Program buffer bus error: 0x%" PRIx64, e.addr);
-                    hart->exit_progbuf(Progbuf::exception);
-                }
-                catch (const std::exception& e) {
-                    LOG_AGENT(FTL, *hart, "%s", e.what());
-                }
-                continue;
-            }
-
-            try {
-                hart->check_pending_interrupts();
-                if (!hart->is_waiting()) {
-                    // Gets instruction and sets state
-                    hart->fetch();
-
-                    // Check for breakpoints
-                    if ((gdbstub_get_status() == GDBSTUB_STATUS_RUNNING) && breakpoint_exists(hart->pc)) {
-                        LOG_AGENT(DEBUG, *hart, "Hit breakpoint at address 0x%" PRIx64, hart->pc);
-                        gdbstub_signal_break(thread_id);
-                        halt_all_threads(chip);
-                        continue;
-                    }
-
-                    // Dumping when M0:T0 reaches a PC
-                    auto range = cmd_options.dump_at_pc.equal_range(thread_get_pc(0));
-                    for (auto it = range.first; it != range.second; ++it) {
-                        bemu::dump_data(chip.memory, agent,
-                                        it->second.file.c_str(), it->second.addr, it->second.size);
-                    }
-
-                    // Logging
-                    if (thread_get_pc(0) == cmd_options.log_at_pc) {
-                        get_logger().setLogLevel(LOG_DEBUG);
-                    } else if (thread_get_pc(0) == cmd_options.stop_log_at_pc) {
-                        get_logger().setLogLevel(LOG_INFO);
-                    }
-
-                    // Executes the instruction
-                    hart->execute();
-                    hart->notify_pmu_minion_event(PMU_MINION_EVENT_RETIRED_INST0 + (thread_id & 1));
-                    hart->advance_pc();
-                }
-            }
-            catch (const bemu::Debug_entry& e) {
-                hart->enter_debug_mode(e.cause);
-            }
-            catch (const bemu::Trap& t) {
-                uint64_t old_pc = hart->pc;
-                hart->take_trap(t);
-                hart->advance_pc();
-                if (hart->pc == old_pc) {
-                    LOG_AGENT(FTL, *hart, "Trapping to the same address that "
-                              "caused a trap (0x%" PRIx64 "). Avoiding "
-                              "infinite trap recursion.", hart->pc);
-                }
-            }
-            catch (const bemu::instruction_restart) {
-                LOG_AGENT(DEBUG, *hart, "%s", "Instruction killed and will be restarted");
-            }
-            catch (const bemu::memory_error& e) {
-                hart->advance_pc();
-                hart->raise_interrupt(BUS_ERROR_INTERRUPT, e.addr);
-            }
-            catch (const std::exception& e) {
-                LOG_AGENT(FTL, *hart, "%s", e.what());
-            }
-
-            // Check for single-step mode
-            if ((gdbstub_get_status() == GDBSTUB_STATUS_RUNNING) && single_step[thread_id]) {
-                if (!step_range[thread_id].contains(hart->pc)) {
-                    LOG_AGENT(DEBUG, *hart, "%s", "Single-step done");
-                    gdbstub_signal_break(thread_id);
-                    single_step[thread_id] = false;
-                    hart->enter_debug_mode(bemu::Debug_entry::Cause::haltreq);
-                    continue;
-                }
-            }
         }
 
         ++emu_cycle;
@@ -29,6 +29,8 @@
 #endif
 #include "ISysEmuExport.hpp"
 
+class Worker_pool;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Defines
 ////////////////////////////////////////////////////////////////////////////////
@@ -90,6 +92,10 @@ struct sys_emu_cmd_options {
     std::vector<set_xreg_info> set_xreg;
     bool        coherency_check              = false;
     uint64_t    max_cycles                   = 10000000;
+    bool        bb_exec                      = false;
+    unsigned    threads                      = 1;
+    uint64_t    quantum                      = 1000;
+    uint64_t    api_poll                     = 64;
     bool        mins_dis                     = false;
     bool        sp_dis                       = false;
     uint32_t    mem_reset                    = 0;
@@ -226,6 +232,16 @@ protected:
 
 private:
 
+    // Outcome of running one cycle of a hart
+    enum class Step {
+        next,       // continue with the next hart
+        stop,       // stop the current cycle (the debugger must connect)
+        deferred,   // retry when harts of different shires run serially
+    };
+
+    Step step_hart(bemu::Hart& hart, bool& gdb_enabled, bool bb_exec);
+    void run_quantum(Worker_pool& pool, bool bb_exec);
+
     struct Addr_range {
         uint64_t start;
         uint64_t end;
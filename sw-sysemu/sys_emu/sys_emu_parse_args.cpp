@@ -47,6 +47,10 @@ static const char * help_msg =
 "     -set_xreg <t>,<r>,<val>  Sets the xregister (integer) <r> of thread <t> to value <val>. <t> can be 'sp' for the Service Processor\n"
 #endif
 "     -max_cycles <cycles>     Stops execution after provided number of cycles (default: 10M)\n"
+"     -bb_exec                 Execute whole basic blocks per hart and scheduling cycle instead of one instruction (faster, not cycle exact; ignored with -gdb, -dump_at_pc_*, -log_at_pc and -ltrigger_*)\n"
+"     -threads <n>             Run the Minion Shires on <n> host threads, synchronizing every quantum (faster, not cycle exact; ignored with -gdb, debug logging and checkers; default: 1)\n"
+"     -quantum <cycles>        Cycles that Shires run independently of each other with -threads (default: 1000)\n"
+"     -api_poll <cycles>       Cycles between polls of the runtime API requests (default: 64)\n"
 #ifndef SDK_RELEASE
 "     -mem_reset <byte>        Reset value of main memory (default: 0)\n"
 "     -mem_reset32 <uint32>    Reset value of main memory (default: 0)\n"
@@ -170,6 +174,10 @@ sys_emu::parse_command_line_arguments(int argc, char* argv[])
         {"set_xreg",               required_argument, nullptr, 0},
 #endif
         {"max_cycles",             required_argument, nullptr, 0},
+        {"bb_exec",                no_argument,       nullptr, 0},
+        {"threads",                required_argument, nullptr, 0},
+        {"quantum",                required_argument, nullptr, 0},
+        {"api_poll",               required_argument, nullptr, 0},
 #ifndef SDK_RELEASE
         {"mem_reset",              required_argument, nullptr, 0},
         {"mem_reset32",            required_argument, nullptr, 0},
@@ -393,6 +401,31 @@ sys_emu::parse_command_line_arguments(int argc, char* argv[])
         {
             sscanf(optarg, "%" SCNu64, &cmd_options.max_cycles);
         }
+        else if (!strcmp(name, "bb_exec"))
+        {
+            cmd_options.bb_exec = true;
+        }
+        else if (!strcmp(name, "threads"))
+        {
+            cmd_options.threads = atoi(optarg);
+            if (cmd_options.threads == 0) {
+                SE_ERROR("Command line option '-threads': Invalid number of threads");
+            }
+        }
+        else if (!strcmp(name, "quantum"))
+        {
+            cmd_options.quantum = strtoull(optarg, nullptr, 0);
+            if (cmd_options.quantum == 0) {
+                SE_ERROR("Command line option '-quantum': Invalid number of cycles");
+            }
+        }
+        else if (!strcmp(name, "api_poll"))
+        {
+            cmd_options.api_poll = strtoull(optarg, nullptr, 0);
+            if (cmd_options.api_poll == 0) {
+                SE_ERROR("Command line option '-api_poll': Invalid number of cycles");
+            }
+        }
         else if (!strcmp(name, "mem_reset"))
         {
           cmd_options.mem_reset = strtol(optarg, NULL, 0) & 0xFF;
@@ -13,7 +13,8 @@ sysemu_hdrs := \
     sys_emu/log.h \
     sys_emu/sys_emu.h \
     sys_emu/testLog.h \
-    sys_emu/utils.h
+    sys_emu/utils.h \
+    sys_emu/worker_pool.h
 
 sysemu_cpp_srcs := \
     sys_emu/checkers/flb_checker.cpp \
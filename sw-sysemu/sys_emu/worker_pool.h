@@ -0,0 +1,93 @@
+/*-------------------------------------------------------------------------
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*-------------------------------------------------------------------------*/
+
+#ifndef _WORKER_POOL_H
+#define _WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// A fixed set of host threads that run the same job in lock step: run()
+// calls the job once per worker, passing the worker index, and returns when
+// all workers are done. Worker 0 is the calling thread.
+//
+class Worker_pool {
+public:
+    explicit Worker_pool(unsigned size) : m_size(size) {
+        for (unsigned i = 1; i < m_size; ++i) {
+            m_threads.emplace_back(&Worker_pool::worker, this, i);
+        }
+    }
+
+    ~Worker_pool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    Worker_pool(const Worker_pool&) = delete;
+    Worker_pool& operator=(const Worker_pool&) = delete;
+
+    unsigned size() const { return m_size; }
+
+    void run(const std::function<void(unsigned)>& job) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            m_pending = m_size - 1;
+            ++m_generation;
+        }
+        m_start.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_pending == 0; });
+        m_job = nullptr;
+    }
+
+private:
+    void worker(unsigned index) {
+        uint64_t generation = 0;
+        for (;;) {
+            const std::function<void(unsigned)>* job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [&] { return m_stop || (m_generation != generation); });
+                if (m_stop) {
+                    return;
+                }
+                generation = m_generation;
+                job = m_job;
+            }
+            (*job)(index);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_pending;
+            }
+            m_done.notify_one();
+        }
+    }
+
+    unsigned                 m_size;
+    std::vector<std::thread> m_threads;
+    std::mutex               m_mutex;
+    std::condition_variable  m_start;
+    std::condition_variable  m_done;
+    const std::function<void(unsigned)>* m_job = nullptr;
+    uint64_t                 m_generation = 0;
+    unsigned                 m_pending = 0;
+    bool                     m_stop = false;
+};
+
+#endif // _WORKER_POOL_H
@@ -391,6 +391,11 @@ void System::copy_memory_from_host_to_device(uint64_t from_addr, uint64_t to_add
 #ifdef SYS_EMU
     api_communicate *api_comm = emu()->get_api_communicate();
     if (api_comm) {
+        // Copy straight from host memory if the host exposes it
+        if (const void* src = api_comm->host_memory_pointer(from_addr, size)) {
+            memory.write(noagent, to_addr, size, src);
+            return;
+        }
         uint8_t *buff = new uint8_t[size];
         api_comm->host_memory_read(from_addr, size, buff);
         memory.write(noagent, to_addr, size, buff);
@@ -411,6 +416,11 @@ void System::copy_memory_from_device_to_host(uint64_t from_addr, uint64_t to_add
 #ifdef SYS_EMU
     api_communicate *api_comm = emu()->get_api_communicate();
     if (api_comm) {
+        // Copy straight to host memory if the host exposes it
+        if (void* dst = api_comm->host_memory_pointer(to_addr, size)) {
+            memory.read(noagent, from_addr, size, dst);
+            return;
+        }
         uint8_t *buff = new uint8_t[size];
         memory.read(noagent, from_addr, size, buff);
         api_comm->host_memory_write(to_addr, size, buff);
@@ -9,8 +9,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <array>
+#include <atomic>
 #include <vector>
 #include <bitset>
+#include <mutex>
 
 #include "support/intrusive/list.h"
 #include "memory/main_memory.h"
@@ -134,6 +136,10 @@ public:
     bool get_emu_fail() const;
     void set_emu_done(bool value, bool failure = false);
 
+    // Harts of different shires run concurrently (see deferred_access)
+    bool is_parallel() const;
+    void set_parallel(bool value);
+
     bool has_active_harts() const;
     bool has_sleeping_harts() const;
     bool has_available_harts() const;
@@ -250,6 +256,10 @@ public:
     intrusive::List<Hart, &Hart::links> awaking;
     intrusive::List<Hart, &Hart::links> sleeping;
 
+    // Harts add and remove themselves from the lists above while harts of
+    // different shires run concurrently
+    std::mutex hart_lists_mutex;
+
     // Main memory
     MainMemory                                memory {};
     typename MemoryRegion::reset_value_type   memory_reset_value {};
@@ -303,8 +313,9 @@ private:
     // ----- Private system state -----
 
     // Simulation control
-    bool m_emu_done {false};
-    bool m_emu_fail {false};
+    std::atomic<bool> m_emu_done {false};
+    std::atomic<bool> m_emu_fail {false};
+    bool m_parallel {false};
 
     // Minionshire debug module
     uint32_t dmctrl;
@@ -338,7 +349,21 @@ inline bool System::get_emu_fail() const
 inline void System::set_emu_done(bool value, bool failure)
 {
     m_emu_done = value;
-    m_emu_fail |= failure;
+    if (failure) {
+        m_emu_fail = true;
+    }
+}
+
+
+inline bool System::is_parallel() const
+{
+    return m_parallel;
+}
+
+
+inline void System::set_parallel(bool value)
+{
+    m_parallel = value;
 }
 
 
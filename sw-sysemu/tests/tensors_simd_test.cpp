@@ -0,0 +1,137 @@
+/*-------------------------------------------------------------------------
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*-------------------------------------------------------------------------*/
+
+// Differential test of the host SIMD rows of TensorFMA32 and TensorIMA8A32
+// against the scalar paths they replace: softfloat for the floating-point
+// rows and the plain int8 dot products for the integer ones.
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "fpu/fpu.h"
+
+namespace {
+
+constexpr unsigned max_row = 16;
+constexpr unsigned num_rows = 1u << 20;
+
+std::mt19937 rng{0x5eed};
+
+// Random single-precision operands, biased towards the values the SIMD
+// rows must hand back to softfloat or compute carefully
+float32_t random_f32()
+{
+    uint32_t sign = (rng() & 1) << 31;
+    uint32_t frac = rng() & 0x7FFFFF;
+    uint32_t exp;
+    switch (rng() % 10) {
+    case 0:  return float32_t{sign};                          // zero
+    case 1:  exp = 0; break;                                  // subnormal
+    case 2:  exp = 0xFF; frac = (rng() & 1) ? frac : 0; break; // NaN, infinity
+    case 3:  exp = 250 + rng() % 5; break;                    // near overflow
+    case 4:  exp = 1 + rng() % 64; break;                     // near underflow
+    default: exp = 100 + rng() % 56; break;                   // around 1.0
+    }
+    return float32_t{sign | (exp << 23) | frac};
+}
+
+// A row is only checked when the SIMD path takes it, the other rows are
+// computed with softfloat by the emulator
+bool check_f32_row(unsigned& accepted)
+{
+    float32_t a = random_f32();
+    float32_t b[max_row], c[max_row], z[max_row], ref[max_row];
+    unsigned n = 1 + rng() % max_row;
+    bool mul = rng() & 1;
+    for (unsigned j = 0; j < n; ++j) {
+        b[j] = random_f32();
+        // Some accumulators cancel the product
+        c[j] = (rng() % 8) ? random_f32() : fpu::f32_mul(a, float32_t{b[j].v ^ 0x80000000});
+        z[j] = c[j];
+    }
+
+    softfloat_roundingMode = softfloat_round_near_even;
+    softfloat_exceptionFlags = 0;
+    if (!fpu::f32_mulAddRow(a, b, z, n, mul))
+        return true;
+    ++accepted;
+    uint_fast8_t flags = softfloat_exceptionFlags;
+
+    softfloat_exceptionFlags = 0;
+    for (unsigned j = 0; j < n; ++j) {
+        if (mul)
+            ref[j] = fpu::f32_mul(a, b[j]);
+        else
+            ref[j] = b[j].v ? fpu::f32_mulAdd(a, b[j], c[j]) : c[j];
+    }
+    uint_fast8_t ref_flags = softfloat_exceptionFlags;
+
+    bool ok = (flags == ref_flags);
+    for (unsigned j = 0; j < n; ++j) {
+        ok = ok && (z[j].v == ref[j].v);
+    }
+    if (!ok) {
+        std::printf("f32 mismatch: a=%08" PRIx32 " mul=%d flags=%x/%x\n", a.v, mul, flags, ref_flags);
+        for (unsigned j = 0; j < n; ++j) {
+            std::printf("  b=%08" PRIx32 " c=%08" PRIx32 " simd=%08" PRIx32 " softfloat=%08" PRIx32 "\n",
+                        b[j].v, c[j].v, z[j].v, ref[j].v);
+        }
+    }
+    return ok;
+}
+
+int32_t sext8(uint8_t x, bool u)
+{
+    return u ? int32_t(x) : int32_t(int8_t(x));
+}
+
+bool check_i8_row()
+{
+    uint8_t a[4], b[4 * max_row];
+    int32_t dot[max_row];
+    unsigned n = 1 + rng() % max_row;
+    bool ua = rng() & 1;
+    bool ub = rng() & 1;
+    for (auto& x : a) x = uint8_t(rng());
+    for (unsigned j = 0; j < 4 * n; ++j) b[j] = uint8_t(rng());
+
+    fpu::i8_dotRow(a, ua, b, ub, dot, n);
+
+    bool ok = true;
+    for (unsigned j = 0; j < n; ++j) {
+        int32_t ref = 0;
+        for (unsigned x = 0; x < 4; ++x) {
+            ref += sext8(a[x], ua) * sext8(b[j*4+x], ub);
+        }
+        if (dot[j] != ref) {
+            std::printf("i8 mismatch: ua=%d ub=%d col=%u simd=%" PRId32 " scalar=%" PRId32 "\n",
+                        ua, ub, j, dot[j], ref);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    unsigned errors = 0;
+    unsigned accepted = 0;
+    for (unsigned i = 0; i < num_rows; ++i) {
+        errors += !check_f32_row(accepted);
+        errors += !check_i8_row();
+    }
+    std::printf("%u rows, %u computed with host SIMD, %u mismatches\n", num_rows, accepted, errors);
+
+    // The SIMD path must actually be exercised for the comparison to mean anything
+    if (accepted < num_rows / 16) {
+        std::printf("too few rows computed with host SIMD\n");
+        return EXIT_FAILURE;
+    }
+    return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
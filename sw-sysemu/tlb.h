@@ -0,0 +1,65 @@
+/*-------------------------------------------------------------------------
+* Copyright (c) 2025 Ainekko, Co.
+* SPDX-License-Identifier: Apache-2.0
+*-------------------------------------------------------------------------*/
+
+#ifndef BEMU_TLB_H
+#define BEMU_TLB_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bemu {
+
+
+//
+// Direct-mapped cache of V2P translations of 4KiB pages (superpages are
+// cached as their 4KiB sub-pages).
+//
+// Entries are tagged by the virtual page number, the value of the address
+// translation register (matp or satp) that was used and the effective
+// privilege level, and record which access types passed the permission and
+// A/D checks during the page walk. An access type that is not recorded is a
+// miss, so that the page walk raises the appropriate page fault, or refills
+// the entry if the page table has been updated.
+//
+struct Tlb {
+    enum : uint8_t {
+        perm_load  = 1,     // loads, prefetches
+        perm_write = 2,     // stores and AMOs that do not need the D bit
+        perm_store = 4,     // regular stores (need the D bit)
+        perm_fetch = 8,     // instruction fetches
+    };
+
+    struct Entry {
+        uint64_t  vpn = ~0ull;
+        uint64_t  ppn = 0;
+        uint64_t  atp = 0;
+        uint8_t   prv = 0;
+        uint8_t   perms = 0;
+    };
+
+    static constexpr size_t num_entries = 32;
+
+    Entry& entry(uint64_t vpn) noexcept
+    { return m_entries[vpn % num_entries]; }
+
+    const Entry* lookup(uint64_t vpn, uint64_t atp, uint8_t prv, uint8_t perm) const noexcept
+    {
+        const Entry& e = m_entries[vpn % num_entries];
+        return ((e.vpn == vpn) && (e.atp == atp) && (e.prv == prv) && (e.perms & perm))
+            ? &e : nullptr;
+    }
+
+    void invalidate() noexcept
+    { m_entries.fill(Entry{}); }
+
+private:
+    std::array<Entry, num_entries>  m_entries;
+};
+
+
+} // namespace bemu
+
+#endif // BEMU_TLB_H